@@ -0,0 +1,235 @@
+/**
+ * @file IRCodeStore.ino
+ * @brief Example demonstrating the SPI NOR flash IR code store of the UIRBcore library.
+ * 
+ * This example stores a few IR codes by ID, reads them back, replaces and removes some of them and prints 
+ * the store statistics. It runs on a simulated flash device by default, so it can be tried in simavr 
+ * (`pio debug` with the provided `platformio.ini`) without any flash chip connected.
+ * 
+ * **Features:**
+ * - Mounting the store and formatting it when no valid index is found.
+ * - Storing, loading, replacing and removing codes by 16-bit ID.
+ * - Printing code count, index journal usage and data sector erase counts.
+ * 
+ * **Hardware:**
+ * - Define `IR_CODE_STORE_EXAMPLE_JEDEC` to use a JEDEC SPI NOR flash chip on the SPI pins.
+ * - The chip select is #PIN_PROG here, as #PIN_TX is used by `Serial`. Toggling #PIN_PROG disturbs the charger, 
+ *   so only use the flash while USB is disconnected, or wire the chip select to #PIN_TX and stop `Serial` first.
+ * 
+ * @note Requires the `UIRB_CORE_SPI_FLASH` build flag.
+ * 
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+
+/* Use namespace to prevent typing uirbcore:: before each member. */
+using namespace uirbcore;
+
+#if !defined(UIRB_CORE_SPI_FLASH)
+    #error "This example requires the UIRB_CORE_SPI_FLASH build flag."
+#endif  // !defined(UIRB_CORE_SPI_FLASH)
+
+/**
+ * @brief Instance of `UIRB` class.
+ */
+UIRB& uirb = UIRB::getInstance();
+
+#if defined(IR_CODE_STORE_EXAMPLE_JEDEC)
+/**
+ * @brief JEDEC SPI NOR flash chip with #PIN_PROG as chip select.
+ */
+JedecSPIFlash flash(PIN_PROG);
+#else
+/**
+ * @brief Backing memory of the simulated flash, 6 sectors of 128 bytes with 32 byte pages.
+ * 
+ * One sector per index copy leaves 4 data sectors and room for 6 codes with the default journal size.
+ */
+uint8_t flashMemory[6 * 128];
+
+/**
+ * @brief Simulated flash device, erased at startup.
+ */
+SimulatedSPIFlash flash(flashMemory, sizeof(flashMemory), 128, 32);
+#endif  // defined(IR_CODE_STORE_EXAMPLE_JEDEC)
+
+/**
+ * @brief IR code store on the flash device.
+ */
+IRCodeStore store(flash);
+
+/**
+ * @brief Example IR codes, NEC frames as address/command bytes followed by raw mark/space pairs.
+ */
+const uint8_t POWER_CODE[] = {0x04, 0xFB, 0x08, 0xF7, 0x5A, 0x2D, 0x0B, 0x0B};
+const uint8_t VOLUME_UP_CODE[] = {0x04, 0xFB, 0x02, 0xFD, 0x5A, 0x2D, 0x0B, 0x21, 0x0B, 0x0B};
+const uint8_t VOLUME_DOWN_CODE[] = {0x04, 0xFB, 0x03, 0xFC, 0x5A, 0x2D, 0x0B, 0x21, 0x0B, 0x21};
+
+/**
+ * @brief Prints the result of a store operation.
+ * 
+ * @param[in] operation Operation description.
+ * @param[in] id Code ID.
+ * @param[in] result Operation result.
+ */
+void printResult(const __FlashStringHelper* operation, const uint16_t id, const StoreResult result)
+{
+    Serial.print(operation);
+    Serial.print(F(" code "));
+    Serial.print(id);
+    Serial.print(F(": "));
+    Serial.println(result == StoreResult::SUCCESS ? F("OK") : F("FAILED"));
+}
+
+/**
+ * @brief Loads a code and prints it in hexadecimal.
+ * 
+ * @param[in] id Code ID.
+ */
+void printCode(const uint16_t id)
+{
+    uint8_t buffer[32];
+    uint16_t length;
+    StoreResult result = store.load(id, buffer, sizeof(buffer), length);
+
+    Serial.print(F("Code "));
+    Serial.print(id);
+    if (result == StoreResult::ERROR_NOT_FOUND)
+    {
+        Serial.println(F(": not found"));
+        return;
+    }
+    if (result != StoreResult::SUCCESS)
+    {
+        Serial.println(F(": load failed"));
+        return;
+    }
+
+    Serial.print(F(" ("));
+    Serial.print(length);
+    Serial.print(F(" bytes):"));
+    for (uint16_t i = 0; i < length; i++)
+    {
+        Serial.print(' ');
+        if (buffer[i] < 0x10)
+        {
+            Serial.print('0');
+        }
+        Serial.print(buffer[i], HEX);
+    }
+    Serial.println();
+}
+
+/**
+ * @brief Prints the store statistics.
+ */
+void printStats()
+{
+    StoreStats stats;
+    if (store.getStats(stats) != StoreResult::SUCCESS)
+    {
+        return;
+    }
+
+    Serial.print(F("Codes: "));
+    Serial.print(stats.codes);
+    Serial.print('/');
+    Serial.print(stats.max_codes);
+    Serial.print(F(", bytes: "));
+    Serial.print(stats.live_bytes);
+    Serial.print('/');
+    Serial.print(stats.max_live_bytes);
+    Serial.print(F(", journal: "));
+    Serial.print(stats.journal_entries);
+    Serial.print(F(", free sectors: "));
+    Serial.print(stats.free_sectors);
+    Serial.print('/');
+    Serial.print(stats.data_sectors);
+    Serial.print(F(", erase count: "));
+    Serial.print(stats.min_erase_count);
+    Serial.print('-');
+    Serial.println(stats.max_erase_count);
+}
+
+void setup()
+{
+    Serial.begin(1000000);
+
+    if (uirb.begin() != CoreResult::SUCCESS)
+    {
+        Serial.println(F("UIRB initialization failed."));
+    }
+
+#if defined(IR_CODE_STORE_EXAMPLE_JEDEC)
+    if (!flash.begin())
+    {
+        Serial.println(F("No SPI flash chip detected."));
+        while (1);
+    }
+#endif  // defined(IR_CODE_STORE_EXAMPLE_JEDEC)
+
+    if (store.begin() != StoreResult::SUCCESS)
+    {
+        Serial.println(F("No valid store found, formatting..."));
+        if (store.format() != StoreResult::SUCCESS)
+        {
+            Serial.println(F("Format failed."));
+            while (1);
+        }
+    }
+    printStats();
+
+    printResult(F("Store"), 1, store.store(1, POWER_CODE, sizeof(POWER_CODE)));
+    printResult(F("Store"), 2, store.store(2, VOLUME_UP_CODE, sizeof(VOLUME_UP_CODE)));
+    printResult(F("Store"), 3, store.store(3, VOLUME_DOWN_CODE, sizeof(VOLUME_DOWN_CODE)));
+    printCode(1);
+    printCode(2);
+    printCode(3);
+
+    printResult(F("Replace"), 1, store.store(1, VOLUME_DOWN_CODE, sizeof(VOLUME_DOWN_CODE)));
+    printResult(F("Remove"), 2, store.remove(2));
+    printCode(1);
+    printCode(2);
+    printStats();
+}
+
+void loop()
+{
+    /* Rewrite the codes to show sector reclaim and wear leveling. */
+    static uint16_t iteration = 0;
+    const uint16_t id = 10 + (iteration++ % 4);
+    store.store(id, POWER_CODE, sizeof(POWER_CODE));
+
+    if (iteration % 50 == 0)
+    {
+        printCode(id);
+        printStats();
+    }
+    delay(10);
+}
@@ -0,0 +1,286 @@
+/**
+ * @file IRCodeStorePowerLoss.ino
+ * @brief Example injecting a power loss into every flash operation of the UIRBcore IR code store.
+ *
+ * This example runs a fixed workload of stores and removes on a simulated flash device, which forces journal
+ * merges and data sector reclaims. The workload is repeated with a simulated power loss after 0, 1, 2, ... program
+ * and erase operations, until it completes without one. After every power loss the store is mounted again, as
+ * after a reset, and each code is checked against the operations which reported success.
+ *
+ * **Features:**
+ * - Power loss injection with `SimulatedSPIFlash::failAfter()` at every operation of the workload.
+ * - Checking that `IRCodeStore::begin()` recovers every committed code, and that the code of the interrupted
+ *   operation is either its old or its new version.
+ * - Checking that the recovered store accepts new codes.
+ *
+ * **Output:**
+ * - One line per failing power loss point, then `PASS` or `FAIL` with the number of points checked.
+ * - Runs in simavr (`pio debug` with the provided `platformio.ini`), no flash chip is needed.
+ *
+ * @note Requires the `UIRB_CORE_SPI_FLASH` build flag.
+ *
+ * @author
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ *
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+
+/* Use namespace to prevent typing uirbcore:: before each member. */
+using namespace uirbcore;
+
+#if !defined(UIRB_CORE_SPI_FLASH)
+    #error "This example requires the UIRB_CORE_SPI_FLASH build flag."
+#endif  // !defined(UIRB_CORE_SPI_FLASH)
+
+/**
+ * @brief Number of code IDs used by the workload, 1 to CODE_IDS.
+ */
+constexpr uint8_t CODE_IDS = 5;
+
+/**
+ * @brief Number of codes stored before the power loss injection starts.
+ */
+constexpr uint8_t BASELINE_CODES = 3;
+
+/**
+ * @brief Number of stores and removes of the workload.
+ */
+constexpr uint8_t WORKLOAD_OPERATIONS = 40;
+
+/**
+ * @brief Length of every code, 4 records of 20 bytes fill a data sector.
+ */
+constexpr uint8_t CODE_LENGTH = 12;
+
+/**
+ * @brief Version of a code ID which is not stored.
+ */
+constexpr uint8_t ABSENT = 0;
+
+/**
+ * @brief Instance of `UIRB` class.
+ */
+UIRB& uirb = UIRB::getInstance();
+
+/**
+ * @brief Backing memory of the simulated flash, 6 sectors of 128 bytes with 32 byte pages.
+ *
+ * One sector per index copy leaves 4 data sectors, the workload keeps at most 5 codes of 20 bytes live.
+ */
+uint8_t flashMemory[6 * 128];
+
+/**
+ * @brief Simulated flash device, erased at startup.
+ */
+SimulatedSPIFlash flash(flashMemory, sizeof(flashMemory), 128, 32);
+
+/**
+ * @brief Version of each code ID whose last operation reported success, index 0 is ID 1.
+ */
+uint8_t committed[CODE_IDS];
+
+/**
+ * @brief Version of each code ID requested by the interrupted operation, equal to @ref committed otherwise.
+ */
+uint8_t attempted[CODE_IDS];
+
+/**
+ * @brief Fills a code buffer with content unique to an ID and version.
+ *
+ * @param[in] id Code ID.
+ * @param[in] version Code version, any value except @ref ABSENT.
+ * @param[out] code Buffer of @ref CODE_LENGTH bytes.
+ */
+void makeCode(const uint16_t id, const uint8_t version, uint8_t* code)
+{
+    for (uint8_t i = 0; i < CODE_LENGTH; i++)
+    {
+        code[i] = static_cast<uint8_t>((id << 5) ^ (version * 7U) ^ i);
+    }
+}
+
+/**
+ * @brief Runs one operation of the workload and records its outcome.
+ *
+ * Every seventh operation removes a code, the others store a new version of a code. The IDs rotate so the
+ * journal fills up and old records become stale, forcing index merges and sector reclaims.
+ *
+ * @param[in] store Mounted store.
+ * @param[in] operation Number of the operation within the workload.
+ * @return bool `false` if the operation failed, i.e. the simulated power was lost.
+ */
+bool runOperation(IRCodeStore& store, const uint8_t operation)
+{
+    const uint16_t id = 1 + (operation * 3U) % CODE_IDS;
+    const uint8_t slot = id - 1;
+    StoreResult result;
+
+    if (operation % 7 == 6)
+    {
+        attempted[slot] = ABSENT;
+        result = store.remove(id);
+        if (result == StoreResult::ERROR_NOT_FOUND && committed[slot] == ABSENT)
+        {
+            return true;
+        }
+    }
+    else
+    {
+        uint8_t code[CODE_LENGTH];
+        attempted[slot] = static_cast<uint8_t>(operation + 1);
+        makeCode(id, attempted[slot], code);
+        result = store.store(id, code, sizeof(code));
+    }
+
+    if (result != StoreResult::SUCCESS)
+    {
+        return false;
+    }
+    committed[slot] = attempted[slot];
+    return true;
+}
+
+/**
+ * @brief Checks if a stored code matches a version.
+ *
+ * @param[in] store Mounted store.
+ * @param[in] id Code ID.
+ * @param[in] version Expected version, @ref ABSENT if the code must not be stored.
+ * @return bool `true` if the code matches.
+ */
+bool codeMatches(IRCodeStore& store, const uint16_t id, const uint8_t version)
+{
+    uint8_t buffer[CODE_LENGTH];
+    uint8_t expected[CODE_LENGTH];
+    uint16_t length;
+    const StoreResult result = store.load(id, buffer, sizeof(buffer), length);
+
+    if (version == ABSENT)
+    {
+        return result == StoreResult::ERROR_NOT_FOUND;
+    }
+    makeCode(id, version, expected);
+    return result == StoreResult::SUCCESS && length == CODE_LENGTH && memcmp(buffer, expected, CODE_LENGTH) == 0;
+}
+
+/**
+ * @brief Runs the workload with a power loss after the given number of flash operations and checks the recovery.
+ *
+ * @param[in] operations Program and erase operations allowed before the power loss.
+ * @param[out] completed Set when the workload finished before the power loss.
+ * @return bool `true` if the store recovered every committed code.
+ */
+bool checkPowerLoss(const uint16_t operations, bool& completed)
+{
+    IRCodeStore store(flash);
+    uint8_t code[CODE_LENGTH];
+
+    flash.failAfter(SimulatedSPIFlash::NEVER_FAIL);
+    if (store.format() != StoreResult::SUCCESS)
+    {
+        return false;
+    }
+    for (uint8_t slot = 0; slot < CODE_IDS; slot++)
+    {
+        committed[slot] = ABSENT;
+        if (slot < BASELINE_CODES)
+        {
+            makeCode(slot + 1, 0xFF, code);
+            if (store.store(slot + 1, code, sizeof(code)) != StoreResult::SUCCESS)
+            {
+                return false;
+            }
+            committed[slot] = 0xFF;
+        }
+        attempted[slot] = committed[slot];
+    }
+
+    flash.failAfter(operations);
+    completed = true;
+    for (uint8_t operation = 0; operation < WORKLOAD_OPERATIONS; operation++)
+    {
+        if (!runOperation(store, operation))
+        {
+            completed = false;
+            break;
+        }
+    }
+    flash.failAfter(SimulatedSPIFlash::NEVER_FAIL);
+
+    // A new instance keeps nothing from before the power loss, like the store after a reset
+    IRCodeStore recovered(flash);
+    if (recovered.begin() != StoreResult::SUCCESS)
+    {
+        return false;
+    }
+    for (uint8_t slot = 0; slot < CODE_IDS; slot++)
+    {
+        if (!codeMatches(recovered, slot + 1, committed[slot]) && !codeMatches(recovered, slot + 1, attempted[slot]))
+        {
+            return false;
+        }
+    }
+
+    // The interrupted operation may have left a partial record or journal entry behind, which must not block new codes
+    makeCode(CODE_IDS + 1, 1, code);
+    return recovered.store(CODE_IDS + 1, code, sizeof(code)) == StoreResult::SUCCESS && codeMatches(recovered, CODE_IDS + 1, 1);
+}
+
+void setup()
+{
+    Serial.begin(1000000);
+
+    if (uirb.begin() != CoreResult::SUCCESS)
+    {
+        Serial.println(F("UIRB initialization failed."));
+    }
+
+    uint16_t failures = 0;
+    uint16_t operations = 0;
+    bool completed = false;
+    while (!completed)
+    {
+        if (!checkPowerLoss(operations, completed))
+        {
+            Serial.print(F("Power loss after "));
+            Serial.print(operations);
+            Serial.println(F(" operations: codes not recovered"));
+            failures++;
+        }
+        operations++;
+    }
+
+    Serial.print(failures == 0 ? F("PASS") : F("FAIL"));
+    Serial.print(F(", power loss points checked: "));
+    Serial.print(operations);
+    Serial.print(F(", erase count: "));
+    Serial.println(flash.getEraseCount());
+}
+
+void loop()
+{
+}
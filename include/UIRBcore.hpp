@@ -63,6 +63,11 @@
  * @brief Example demonstrating the calibration and usage of the 1.1V internal reference using the UIRBcore library.
  */
 
+/**
+ * @example examples/IRCodeStore/IRCodeStore.ino
+ * @brief Example demonstrating the SPI NOR flash IR code store on a simulated flash device.
+ */
+
 #ifndef UIRBcore_hpp
 #define UIRBcore_hpp
 
@@ -118,7 +123,33 @@
 #include <UIRBcore_Pins.h>
 #include <UIRBcore_Version.h>
 #include <UIRBcore_PowerInfoData.hpp>
+#include <UIRBcore_Coroutine.hpp>
+#include <UIRBcore_Tasks.hpp>
 #include <UIRBcore_EEPROM.hpp>
+#include <UIRBcore_Watchdog.hpp>
+#include <UIRBcore_WarmRestart.hpp>
+#include <UIRBcore_Profiler.hpp>
+#include <UIRBcore_Trace.hpp>
+#include <UIRBcore_Stack.hpp>
+#include <UIRBcore_SelfTest.hpp>
+#include <UIRBcore_PinArbiter.hpp>
+#include <UIRBcore_Timers.hpp>
+#include <UIRBcore_TimerWheel.hpp>
+#include <UIRBcore_Deferred.hpp>
+#include <UIRBcore_PinChange.hpp>
+#include <UIRBcore_IRGate.hpp>
+#include <UIRBcore_BatteryHealth.hpp>
+#include <UIRBcore_ChargeLog.hpp>
+#include <UIRBcore_DischargeProtection.hpp>
+#include <UIRBcore_PowerMonitor.hpp>
+#include <UIRBcore_AdcCalibration.hpp>
+#include <UIRBcore_SPIFlash.hpp>
+#include <UIRBcore_IRCodeStore.hpp>
+
+#if defined(UIRB_CORE_STATIC_WAKEUP_VECTORS) && !defined(__DOXYGEN__)
+// Declared ahead so that the library owned external interrupt can be a friend of UIRB
+extern "C" void INT0_vect(void) __attribute__((signal, used, externally_visible));
+#endif  // defined(UIRB_CORE_STATIC_WAKEUP_VECTORS) && !defined(__DOXYGEN__)
 
 /**
  * @brief Core namespace for %UIRB system functionalities.
@@ -134,6 +165,30 @@
  *   charger states, and battery conditions.
  * - @ref uirbcore::eeprom : Sub-namespace providing tools for storing and retrieving configuration 
  *   and runtime data in EEPROM.
+ * - @ref uirbcore::WatchdogSupervisor : Reset cause tracking and optional watchdog supervision with 
+ *   hang post-mortem.
+ * - @ref uirbcore::WarmRestart : Optional `.noinit` RAM state allowing warm resets to skip EEPROM.
+ * - @ref uirbcore::Profiler : Optional Timer1-based execution time statistics of library hot paths.
+ * - @ref uirbcore::Trace : Optional event trace ring buffer surviving warm resets.
+ * - @ref uirbcore::MemoryPlan : Compile-time SRAM budget of the library buffers, declared in @ref UIRBcore_MemoryPlan.hpp.
+ * - @ref uirbcore::StackMonitor : Optional stack painting and high-water mark of the deepest stack use.
+ * - @ref uirbcore::SelfTest : Power-on self-test of the board hardware with a per-test timing budget.
+ * - @ref uirbcore::IRCodeStore : Optional IR code library on SPI NOR flash with wear leveling and indexed lookup.
+ * - @ref uirbcore::PinArbiter : Optional priority based ownership of the pins shared by the LED, IR receiver, UART and SPI.
+ * - @ref uirbcore::TimerManager : Optional allocation of Timer0/1/2 and their interrupt vectors with shared dispatch and
+ *   optional preemptible handler priority.
+ * - @ref uirbcore::TimerWheel : Optional hierarchical software timer wheel on one Timer1 compare channel, bounding sleep time.
+ * - @ref uirbcore::DeferredQueue : Optional queue running interrupt triggered work at safe points, with latency statistics.
+ * - @ref uirbcore::PinChangeDispatcher : Optional per-pin handlers sharing the three pin change interrupt vectors.
+ * - @ref uirbcore::IRTransmitGate : Optional scheduling of the ADC measurements into the gaps between IR frames.
+ * - @ref uirbcore::BatteryHealth : Optional battery internal resistance estimate from the IR LED load, equivalent full
+ *   cycles and learned capacity, kept in EEPROM.
+ * - @ref uirbcore::ChargeSessionLog : Optional EEPROM log of charging sessions with their start, duration, peak current and charge.
+ * - @ref uirbcore::DischargeProtection : Optional deep-discharge protection sleep with backed-off charger checks.
+ * - @ref uirbcore::PowerMonitor : Optional power information updates at a period adapting to state changes and reading deltas.
+ * - @ref uirbcore::AdcCalibration : Optional per reference ADC offset measured on the GND channel and two-point gain correction of the PROG reading.
+ * - @ref uirbcore::StatusLedPatternTask, @ref uirbcore::BandgapSampleTask : Resumable stackless tasks of the multi-step
+ *   library operations, which applications can run concurrently from `loop()`.
  *
  * @details
  * This namespace is designed to simplify hardware integration and provide modular, 
@@ -158,7 +213,8 @@ namespace uirbcore
         ERROR_INVALID_ARGUMENT, /**< An invalid argument was provided to the function. */
         ERROR_EEPROM_HW_VER_MISMATCH, /**< Hardware version stored in EEPROM does not match the version expected by this library. */
         ERROR_EEPROM_CHARGER_PROG_RESISTANCE_INVALID, /**< Charger Rprog resistor value stored in EEPROM is invalid. */
-        ERROR_EEPROM_SAVE_FAILED /**< Failed to save data to EEPROM. */
+        ERROR_EEPROM_SAVE_FAILED, /**< Failed to save data to EEPROM. */
+        ERROR_SELF_TEST_FAILED /**< The power-on self-test detected a hardware fault. See @ref SelfTest::getReport(). */
     };
 
     /**
@@ -320,6 +376,10 @@ namespace uirbcore
              * @retval #CoreResult::ERROR_EEPROM_HW_VER_MISMATCH Hardware version from eeprom does not match the hardware version of the board defined in this library.
              * @retval #CoreResult::ERROR_EEPROM_SAVE_FAILED Failed to save data to eeprom.
              * @retval #CoreResult::ERROR_EEPROM_CHARGER_PROG_RESISTANCE_INVALID Charger Rprog resistor resistance from eeprom is invalid.
+             * @retval #CoreResult::ERROR_SELF_TEST_FAILED The power-on self-test failed. Only returned when @ref UIRB_CORE_SELF_TEST is defined.
+             * 
+             * @note When @ref UIRB_CORE_SELF_TEST is defined, the first call after a successful initialization runs 
+             * @ref SelfTest::run() with @ref SelfTest::DEFAULT_TESTS. It must therefore be called after `init()`, e.g. from `setup()`.
              */
             CoreResult begin() const;
 
@@ -413,6 +473,93 @@ namespace uirbcore
              */
             void getDataStoredInRAM(eeprom::EEPROMData& data) const;
 
+            /**
+             * @brief Reads a setting from RAM by its identifier.
+             * 
+             * @param[in] id Setting to read.
+             * @param[out] value Decoded value, see @ref eeprom::SettingId for the unit and range of each setting.
+             * @return bool
+             * @retval true The value is valid.
+             * @retval false The stored value is out of range or @p id is invalid.
+             * 
+             * @see @ref eeprom::EEPROMDataManager::get_setting() for the underlying implementation.
+             */
+            bool getSetting(const eeprom::SettingId id, uint32_t& value) const;
+
+            /**
+             * @brief Validates and writes a setting by its identifier and optionally saves it to EEPROM.
+             * 
+             * Only settings with @ref eeprom::SETTING_FLAG_USER_WRITABLE can be written; factory calibration 
+             * and bookkeeping fields such as the serial number or the boot count are rejected.
+             * 
+             * @param[in] id Setting to write.
+             * @param[in] value Value to store, see @ref eeprom::SettingId for the unit and range of each setting.
+             * @param[in] saveToEEPROM Whether to save the configuration to EEPROM after the setting is written.
+             * @return bool
+             * @retval true The setting was written and saved to EEPROM.
+             * @retval false The setting is not writable, @p value is out of range, saving to EEPROM failed or 
+             *               @p saveToEEPROM was set to `false`.
+             */
+            bool setSetting(const eeprom::SettingId id, const uint32_t value, const bool saveToEEPROM);
+
+            /**
+             * @brief Validates and writes a setting by its identifier in RAM.
+             * 
+             * The typed setters such as @ref UIRB::setStatusLEDBrightness() are implemented on top of this function.
+             * 
+             * @param[in] id Setting to write.
+             * @param[in] value Value to store, see @ref eeprom::SettingId for the unit and range of each setting.
+             * @return bool
+             * @retval true The setting was written.
+             * @retval false The setting is not writable or @p value is out of range.
+             */
+            bool setSetting(const eeprom::SettingId id, const uint32_t value);
+
+            /**
+             * @brief Reads several settings from RAM in one call.
+             * 
+             * Every value is written, the result only tells if all of them are valid.
+             * 
+             * @param[in] ids Settings to read.
+             * @param[out] values Decoded values, in the order of @p ids.
+             * @param[in] count Number of entries of @p ids and @p values.
+             * @return bool `true` if all values are valid.
+             */
+            bool getSettings(const eeprom::SettingId* ids, uint32_t* values, const uint8_t count) const;
+
+            /**
+             * @brief Writes several settings in one call, all or none of them, and optionally saves them to EEPROM.
+             * 
+             * The settings are first applied to a copy of the configuration in RAM, which replaces it only 
+             * if every setting was accepted. The configuration is saved to EEPROM at most once.
+             * 
+             * @param[in] ids Settings to write.
+             * @param[in] values Values to store, in the order of @p ids.
+             * @param[in] count Number of entries of @p ids and @p values.
+             * @param[in] saveToEEPROM Whether to save the configuration to EEPROM after the settings are written.
+             * @return bool
+             * @retval true All settings were written and saved to EEPROM.
+             * @retval false A setting was rejected and nothing was changed, saving to EEPROM failed or 
+             *               @p saveToEEPROM was set to `false`.
+             * 
+             * @see @ref setSetting() for the settings which can be written.
+             */
+            bool setSettings(const eeprom::SettingId* ids, const uint32_t* values, const uint8_t count, const bool saveToEEPROM);
+
+            /**
+             * @brief Writes several settings in RAM in one call, all or none of them.
+             * 
+             * @param[in] ids Settings to write.
+             * @param[in] values Values to store, in the order of @p ids.
+             * @param[in] count Number of entries of @p ids and @p values.
+             * @return bool
+             * @retval true All settings were written.
+             * @retval false A setting was rejected and nothing was changed.
+             * 
+             * @see @ref setSetting() for the settings which can be written.
+             */
+            bool setSettings(const eeprom::SettingId* ids, const uint32_t* values, const uint8_t count);
+
             /**
              * @brief Updates power-related information and retrieves it as a reference.
              * 
@@ -457,6 +604,11 @@ namespace uirbcore
              * 
              * @note This function is typically called by @ref UIRB::getPowerInfo() when 
              *       a low-battery condition is detected.
+             * @note With @ref UIRB_CORE_PIN_ARBITER defined, @ref PIN_STAT_LED is claimed as 
+             *       @ref PinOwner::STATUS_LED first and the pattern is skipped if another owner holds the pin.
+             * @note Blocks for about 2 seconds while running @ref StatusLedPatternTask with 
+             *       @ref StatusLedPatternTask::LOW_BATTERY_PATTERN. Step that task from `loop()` instead to 
+             *       play the pattern without blocking.
              * 
              * @see @ref UIRB::getPowerInfo() for triggering this function during a power 
              *      information update.
@@ -551,6 +703,16 @@ namespace uirbcore
              * **Limitations:**
              * - Watchdog timer intervals range from 16 ms to 8 seconds per interval.
              * - Sleep durations exceeding the maximum watchdog timer interval are split into multiple intervals.
+             * - With @ref UIRB_CORE_TIMER_WHEEL defined, the sleep time is limited to the next @ref TimerWheel event and 
+             *   the function returns without sleeping if that event is closer than 16 ms.
+             * - The time slept is added to @ref UIRB::getUptimeMilliseconds(), which is also the clock of 
+             *   @ref TimerWheel::now(), except for the interval cut short by a wakeup interrupt.
+             * - With @ref UIRB_CORE_DEFERRED_WORK defined, @ref DeferredQueue::run() is called before sleeping and after 
+             *   waking up, and the wakeup callbacks are run from the queue.
+             * - With @ref UIRB_CORE_STATIC_WAKEUP_VECTORS defined, the wakeup interrupts are configured once in the 
+             *   constructor and only unmasked while sleeping, instead of attached and detached on every call.
+             * - With @ref UIRB_CORE_PCINT_DISPATCHER defined, the @ref PIN_USB_IO3 wakeup is attached to 
+             *   @ref PinChangeDispatcher while sleeping and skipped if the application already attached the pin.
              * 
              * @warning Configure pins, wakeup sources, and callbacks properly before calling this function to prevent unintended 
              *          behavior. Debugging can be aided using interrupt flags such as @ref UIRB::getButtonWakeupISRFlag() and 
@@ -564,6 +726,16 @@ namespace uirbcore
              */
             void powerDown(const uint32_t sleeptime_milliseconds = UIRB::SLEEP_FOREVER, const WakeupInterrupt wakeupSource = WakeupInterrupt::WAKE_BUTTON) __attribute__((optimize("-O1")));
 
+            /**
+             * @brief Returns the time since reset including the time spent in @ref UIRB::powerDown().
+             * 
+             * `millis()` stops in power-down, this clock is `millis()` advanced by every watchdog interval slept 
+             * through. The interval cut short by a wakeup interrupt is not counted, its slept part is unknown.
+             * 
+             * @return uint32_t Uptime in milliseconds, wrapping after about 49 days like `millis()`.
+             */
+            static uint32_t getUptimeMilliseconds();
+
             /**
              * @brief Sets the callback function for the button wakeup interrupt.
              * 
@@ -968,10 +1140,11 @@ namespace uirbcore
              * pin should be attached for wakeup functionality. It does not interact with the actual hardware or configure the pin.
              * 
              * @note Returns `false` if @ref AVR_DEBUG is defined, overriding the EEPROM setting to disable sleep-related functionality during debugging.
+             * @note Returns `false` if @ref UIRB_CORE_NO_PCINT_VECTORS is defined, as the library has no pin change vector then.
              * 
              * @return bool True if the EEPROM setting allows wakeup from the @ref PIN_USB_IO3 pin, false otherwise.
              * @retval true The stored configuration enables wakeup from the @ref PIN_USB_IO3 pin.
-             * @retval false The stored configuration disables wakeup, or @ref AVR_DEBUG is defined.
+             * @retval false The stored configuration disables wakeup, or @ref AVR_DEBUG or @ref UIRB_CORE_NO_PCINT_VECTORS is defined.
              * @see @ref UIRB::setWakeupFromIO3Allowed() to modify the stored configuration.
              */
             bool isWakeupFromIO3Allowed() const;
@@ -1116,7 +1289,10 @@ namespace uirbcore
              * 
              * - Verifying the hardware version stored in EEPROM against the library's expected version.
              * - Configuring default pin modes and states for the device.
+             * - Appending watchdog and brown-out resets to the EEPROM reset log when @ref UIRB_CORE_WDT_SUPERVISOR is defined.
              * - Incrementing the boot count during initialization.
+             * - Restoring the EEPROM image and power snapshot from `.noinit` RAM on warm resets when 
+             *   @ref UIRB_CORE_WARM_RESTART is defined. EEPROM is not accessed and the boot count is not incremented in that case.
              * - Setting the result of the initialization process, accessible via the @ref UIRB::begin() method.
              * 
              * **Operation Details:**
@@ -1164,6 +1340,8 @@ namespace uirbcore
              *                                   - @p result is `nullptr`.
              *                                   - @p samples is `0`.
              * 
+             * @note With @ref UIRB_CORE_IR_TX_GATE, @ref PIN_IR_LED is not driven low and every sample waits for a gap
+             * between IR frames, see @ref IRTransmitGate.
              * @warning Ensure that AVcc is stable and within the expected range for accurate measurements.
              */
             CoreResult get_raw_bandgap_adc_sample(uint16_t* result, const uint8_t samples = 1);
@@ -1197,6 +1375,8 @@ namespace uirbcore
              *                                   - @p samples is `0`.
              *                                   - @p adcReference is not `DEFAULT` or `INTERNAL1V1`.
              * 
+             * @note With @ref UIRB_CORE_IR_TX_GATE, @ref PIN_IR_LED is not driven low and every sample waits for a gap
+             * between IR frames, see @ref IRTransmitGate.
              * @warning The function assumes that the @ref PIN_PROG pin is properly connected to an appropriate voltage source for sampling.
              */
             CoreResult get_raw_prog_adc_sample(uint16_t* result, uint8_t& adcReference, const uint8_t samples = 1);
@@ -1215,6 +1395,40 @@ namespace uirbcore
              */
             friend class PowerInfoData;
 
+            /**
+             * @brief Grants @ref SelfTest access to the ADC limits and the EEPROM data of this class.
+             */
+            friend class SelfTest;
+
+            /**
+             * @brief Grants @ref BandgapSampleTask access to the ADC settling delays of this class.
+             */
+            friend class BandgapSampleTask;
+
+            /**
+             * @brief Grants @ref BatteryHealth access to the ADC limits and settling delays of this class.
+             */
+            friend class BatteryHealth;
+
+            /**
+             * @brief Grants @ref DischargeProtection the restore of the IO3 wakeup flag it borrows while sleeping.
+             */
+            friend class DischargeProtection;
+
+#if defined(UIRB_CORE_ADC_CALIBRATION)
+            /**
+             * @brief Grants @ref AdcCalibration the reference settling delay of this class.
+             */
+            friend class AdcCalibration;
+#endif  // defined(UIRB_CORE_ADC_CALIBRATION)
+
+#if defined(UIRB_CORE_STATIC_WAKEUP_VECTORS) && !defined(__DOXYGEN__)
+            /**
+             * @brief Grants the library owned `INT0_vect` a direct call of @ref button_wakeup_isr().
+             */
+            friend void ::INT0_vect(void);
+#endif  // defined(UIRB_CORE_STATIC_WAKEUP_VECTORS) && !defined(__DOXYGEN__)
+
             /**
              * @brief Private instance of the @ref PowerInfoData class for managing power-related information.
              * 
@@ -1247,6 +1461,36 @@ namespace uirbcore
              */
             void (*io3_wakeup_user_callback_)() = nullptr;
 
+#if defined(UIRB_CORE_DEFERRED_WORK) || defined(__DOXYGEN__)
+            /**
+             * @brief Deferred work handler calling @ref button_wakeup_user_callback_.
+             * 
+             * @param[in] work Work item, unused.
+             */
+            static void run_button_wakeup_callback(DeferredWork& work);
+
+            /**
+             * @brief Deferred work handler calling @ref io3_wakeup_user_callback_.
+             * 
+             * @param[in] work Work item, unused.
+             */
+            static void run_io3_wakeup_callback(DeferredWork& work);
+
+            /**
+             * @brief Work item scheduled by @ref button_wakeup_isr() when a button wakeup callback is set.
+             * 
+             * @note Only available when @ref UIRB_CORE_DEFERRED_WORK is defined.
+             */
+            DeferredWork button_wakeup_work_{UIRB::run_button_wakeup_callback};
+
+            /**
+             * @brief Work item scheduled by @ref powerDown() after a @ref PIN_USB_IO3 wakeup when a callback is set.
+             * 
+             * @note Only available when @ref UIRB_CORE_DEFERRED_WORK is defined.
+             */
+            DeferredWork io3_wakeup_work_{UIRB::run_io3_wakeup_callback};
+#endif  // defined(UIRB_CORE_DEFERRED_WORK) || defined(__DOXYGEN__)
+
             /**
              * @brief Interrupt Service Routine (ISR) executed when the wakeup button triggers an MCU wakeup.
              * 
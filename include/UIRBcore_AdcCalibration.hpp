@@ -0,0 +1,205 @@
+/**
+ * @file UIRBcore_AdcCalibration.hpp
+ * @brief ADC offset and gain correction of the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::AdcCalibration class, the @ref uirbcore::AdcReference enumeration and
+ * the @ref uirbcore::AdcCalibrationRecord structure. A raw 10-bit reading of @ref PIN_PROG is corrected in two
+ * steps, both in fixed point and both kept separately for each @ref uirbcore::AdcReference:
+ * - The offset is measured on the internal GND channel (`MUX[3:0] = 0b1111`), the channel
+ *   @ref setAnalogReference() already selects for its dummy conversion, against the reference of the reading. It is
+ *   measured at boot against AVcc and again before a reading once it is older than
+ *   @ref UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS, and subtracted from the reading.
+ * - A two-point calibration, made once per board and reference from two known input voltages and stored in EEPROM
+ *   at @ref UIRB_EEPROM_ADC_CALIBRATION_ADDR_START, scales the reading by a Q1.15 gain and adds the remaining offset.
+ *
+ * @details
+ * The correction is applied to the averaged raw reading of @ref uirbcore::UIRB::getProgVoltageMilivolts(), before it
+ * is converted to millivolts, with the record of the reference the reading was taken with. Averaging only removes
+ * noise, not these systematic errors, so a calibrated board reaches the same accuracy with fewer samples.
+ *
+ * The bandgap reading of @ref uirbcore::UIRB::getSupplyVoltageMilivolts() is not corrected. Its error is trimmed by
+ * the bandgap reference setting (@ref uirbcore::UIRB::setInternalBandgapReferenceVoltageMilivolts()), a gain measured
+ * on @ref PIN_PROG would correct it a second time.
+ *
+ * The GND channel can only show a positive offset, a negative one reads as `0`. The two-point calibration covers
+ * the negative part, as long as the offset does not drift far from its value during the calibration.
+ *
+ * @note Only compiled when @ref UIRB_CORE_ADC_CALIBRATION is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_AdcCalibration_hpp
+#define UIRBcore_AdcCalibration_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+
+namespace uirbcore
+{
+#if defined(UIRB_CORE_ADC_CALIBRATION) || defined(__DOXYGEN__)
+    /**
+     * @brief ADC reference of a reading, each has its own offset and two-point calibration.
+     */
+    enum class AdcReference : uint8_t
+    {
+        AVCC = 0, /**< AVcc reference, `DEFAULT`. */
+        BANDGAP_1V1, /**< Internal 1.1V reference, `INTERNAL1V1`. */
+        COUNT /**< Number of references. */
+    };
+
+    /**
+     * @brief Two-point ADC calibration as stored in EEPROM.
+     *
+     * @note This structure is packed and stored as-is in the EEPROM calibration log.
+     */
+    struct AdcCalibrationRecord
+    {
+        uint16_t gain; /**< @brief Gain in Q1.15, @ref AdcCalibration::UNITY_GAIN being `1.0`. */
+        int8_t offset; /**< @brief Offset added after the gain, in ADC steps. */
+    } __attribute__((packed, aligned(1)));
+
+    /**
+     * @brief Static ADC offset and gain correction.
+     *
+     * Example usage, calibrating @ref PIN_PROG against the internal 1.1V reference with 0.2V and 0.9V applied:
+     * @code
+     * analogReference(INTERNAL1V1);
+     * const uint16_t low = analogRead(PIN_PROG);  // 0.2V applied
+     * // ...
+     * const uint16_t high = analogRead(PIN_PROG); // 0.9V applied
+     * AdcCalibration::setTwoPoint(AdcReference::BANDGAP_1V1, low, 186, high, 838); // 0.2V and 0.9V as ADC steps of 1.1V
+     * @endcode
+     *
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class AdcCalibration
+    {
+        public:
+            /**
+             * @brief Gain of `1.0` in Q1.15.
+             */
+            static constexpr uint16_t UNITY_GAIN = 0x8000U;
+
+            /**
+             * @brief Lowest gain accepted from a two-point calibration, `0.875`.
+             */
+            static constexpr uint16_t GAIN_MIN = 0x7000U;
+
+            /**
+             * @brief Highest gain accepted from a two-point calibration, `1.125`.
+             */
+            static constexpr uint16_t GAIN_MAX = 0x9000U;
+
+            /**
+             * @brief Smallest distance between the two calibration points, in ADC steps.
+             */
+            static constexpr uint16_t MIN_POINT_SPAN = 256U;
+
+            /**
+             * @brief Number of GND conversions averaged by @ref measureOffset(), after one discarded conversion.
+             */
+            static constexpr uint8_t OFFSET_SAMPLES = 4;
+
+            /**
+             * @brief Loads the two-point calibrations from EEPROM and measures the offset against AVcc.
+             *
+             * Called by the @ref UIRB constructor.
+             */
+            static void begin();
+
+            /**
+             * @brief Measures the offset on the GND channel against a reference.
+             *
+             * `ADMUX` and `ADCSRA` are restored afterwards. If the reference differs from the one selected in
+             * `ADMUX`, the reference is given @ref UIRB::ADC_VREF_SETTLE_DELAY_MS to settle first.
+             *
+             * @param[in] reference Reference to measure against.
+             * @return uint8_t Offset in ADC steps, `0` if @p reference is invalid.
+             */
+            static uint8_t measureOffset(const AdcReference reference);
+
+            /**
+             * @brief Corrects a raw reading of @ref PIN_PROG.
+             *
+             * The offset of @p reference is measured again first if it is older than
+             * @ref UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS.
+             *
+             * @param[in] raw Raw 10-bit reading, possibly averaged.
+             * @param[in] reference Reference the reading was taken with.
+             * @return uint16_t Corrected reading, limited to `[0-1023]`. @p raw if @p reference is invalid.
+             */
+            static uint16_t correct(const uint16_t raw, const AdcReference reference);
+
+            /**
+             * @brief Computes the two-point calibration of a reference and stores it in EEPROM.
+             *
+             * @param[in] reference Reference both points were read with.
+             * @param[in] raw_low Raw reading of the lower point, without any correction.
+             * @param[in] expected_low Reading expected from the voltage of the lower point.
+             * @param[in] raw_high Raw reading of the upper point, without any correction.
+             * @param[in] expected_high Reading expected from the voltage of the upper point.
+             * @return bool
+             * @retval true The calibration is stored and used.
+             * @retval false @p reference is invalid, the points are less than @ref MIN_POINT_SPAN apart, out of
+             * order, the gain is outside of `[` @ref GAIN_MIN `-` @ref GAIN_MAX `]`, the offset does not fit or the
+             * EEPROM write failed.
+             */
+            static bool setTwoPoint(const AdcReference reference, const uint16_t raw_low, const uint16_t expected_low, const uint16_t raw_high, const uint16_t expected_high);
+
+            /**
+             * @brief Clears the two-point calibration of a reference from EEPROM, only the offset is corrected
+             * afterwards.
+             *
+             * @param[in] reference Reference to clear.
+             */
+            static void clearTwoPoint(const AdcReference reference);
+
+            /**
+             * @brief Returns the last offset measured on the GND channel against a reference.
+             *
+             * @param[in] reference Reference.
+             * @return uint8_t Offset in ADC steps, `0` if not measured yet or @p reference is invalid.
+             */
+            static uint8_t getOffset(const AdcReference reference);
+
+            /**
+             * @brief Returns the two-point calibration in use for a reference.
+             *
+             * @param[in] reference Reference.
+             * @return AdcCalibrationRecord Calibration, @ref UNITY_GAIN and no offset if none is stored or
+             * @p reference is invalid.
+             */
+            static AdcCalibrationRecord getTwoPoint(const AdcReference reference);
+    };
+#endif  // defined(UIRB_CORE_ADC_CALIBRATION) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_AdcCalibration_hpp
@@ -0,0 +1,283 @@
+/**
+ * @file UIRBcore_BatteryHealth.hpp
+ * @brief Battery internal resistance (ESR) estimation and charge cycle tracking of the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::BatteryHealth class and the @ref uirbcore::BatteryEsrRecord and
+ * @ref uirbcore::BatteryCycleRecord structures.
+ *
+ * The internal resistance of the battery is estimated from the drop of AVcc under a known load, the IR LED on
+ * @ref PIN_IR_LED drawing @ref UIRB_CORE_IR_LED_LOAD_MILLIAMPS:
+ * @f[ R_{ESR} = \frac{V_{open} - V_{loaded}}{I_{LED}} @f]
+ *
+ * @details
+ * - AVcc is measured through the bandgap path, as by @ref uirbcore::UIRB::getSupplyVoltageMilivolts(). Each of
+ *   @ref uirbcore::BatteryHealth::SAMPLE_PAIRS pairs converts once with the LED off and once with the LED on.
+ *   The LED is on for a single conversion, about 260 µs, so pulse ratings of the LED are respected.
+ * - Single estimates are noisy at the ADC resolution of about 14 mV at 4 V. They are smoothed by an exponential
+ *   moving average with a weight of 1/4.
+ * - The filtered estimate is kept in RAM. It is appended to a 4 record EEPROM ring log at
+ *   @ref UIRB_EEPROM_BATTERY_ESR_LOG_ADDR_START, so it survives resets and can be read back in the field, only when
+ *   it moved by @ref uirbcore::BatteryHealth::PERSIST_CHANGE_PERCENT or after
+ *   @ref uirbcore::BatteryHealth::PERSIST_INTERVAL_MEASUREMENTS measurements. Measuring around every IR burst
+ *   therefore does not wear the EEPROM out.
+ * - @ref uirbcore::BatteryHealth::predictSagMillivolts() turns the estimate into the expected supply drop of
+ *   another load, for example to lower the IR transmit power before the supply browns out.
+ *
+ * The wear of the battery is tracked from the charging current sampled by @ref uirbcore::PowerInfoData::update():
+ * - The charge is read from @ref uirbcore::PowerInfoData::getChargedMilliampSeconds(), which integrates the current
+ *   over the time between updates while charging, including the time spent in @ref uirbcore::UIRB::powerDown().
+ *   The total charge delivered, divided by @ref UIRB_CORE_BATTERY_CAPACITY_MAH, gives the equivalent full cycles.
+ * - A charge starting at `BatteryState::EMPTY` and ending at `BatteryState::FULLY_CHARGED` without interruption
+ *   measures the usable capacity. It is smoothed like the ESR and reported in percent of the rated capacity.
+ * - Both are appended to a 4 record EEPROM ring log at @ref UIRB_EEPROM_BATTERY_CYCLE_LOG_ADDR_START at the end of
+ *   each charge, so a battery wears the EEPROM far less than it wears itself.
+ *
+ * @note The ESR estimator is only compiled when @ref UIRB_CORE_BATTERY_ESR is defined, the cycle tracking only when
+ * @ref UIRB_CORE_BATTERY_CYCLES is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_BatteryHealth_hpp
+#define UIRBcore_BatteryHealth_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_PowerInfoData.hpp>
+
+namespace uirbcore
+{
+    class UIRB;
+
+#if defined(UIRB_CORE_BATTERY_ESR) || defined(__DOXYGEN__)
+    /**
+     * @brief Compact record of a battery ESR measurement.
+     *
+     * @note This structure is packed and stored as-is in the EEPROM ESR history.
+     */
+    struct BatteryEsrRecord
+    {
+        uint16_t esr_milliohms; /**< @brief Filtered internal resistance in milliohms. */
+        uint16_t open_circuit_millivolts; /**< @brief AVcc with the LED off, in millivolts. */
+        uint16_t sag_millivolts; /**< @brief Drop of AVcc with the LED on, in millivolts. */
+        uint16_t measurement_count; /**< @brief Number of measurements since the history was cleared, saturating. */
+    } __attribute__((packed, aligned(1)));
+#endif  // defined(UIRB_CORE_BATTERY_ESR) || defined(__DOXYGEN__)
+
+#if defined(UIRB_CORE_BATTERY_CYCLES) || defined(__DOXYGEN__)
+    /**
+     * @brief Compact record of the charge delivered to the battery and its learned capacity.
+     *
+     * @note This structure is packed and stored as-is in the EEPROM charge cycle log.
+     */
+    struct BatteryCycleRecord
+    {
+        uint32_t charged_milliamp_hours; /**< @brief Total charge delivered to the battery in milliamp hours. */
+        uint16_t capacity_milliamp_hours; /**< @brief Filtered learned capacity in milliamp hours, `0` if not learned. */
+        uint8_t capacity_samples; /**< @brief Number of full charges the capacity was learned from, saturating. */
+    } __attribute__((packed, aligned(1)));
+#endif  // defined(UIRB_CORE_BATTERY_CYCLES) || defined(__DOXYGEN__)
+
+#if defined(UIRB_CORE_BATTERY_ESR) || defined(UIRB_CORE_BATTERY_CYCLES) || defined(__DOXYGEN__)
+    /**
+     * @brief Static estimator of the internal resistance and the wear of the battery.
+     *
+     * Example usage, measuring the ESR once a day and reporting the battery health:
+     * @code
+     * if (BatteryHealth::measureEsr(uirb))
+     * {
+     *     BatteryHealth::dump(Serial);
+     * }
+     * BatteryHealth::dumpCycles(Serial);
+     * @endcode
+     *
+     * @note The ESR estimate is written to EEPROM only on a change of @ref PERSIST_CHANGE_PERCENT or every
+     * @ref PERSIST_INTERVAL_MEASUREMENTS measurements, so it can be measured around every IR burst. Measurements
+     * since the newest record are lost on reset.
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class BatteryHealth
+    {
+        public:
+#if defined(UIRB_CORE_BATTERY_ESR) || defined(__DOXYGEN__)
+            /**
+             * @brief Value returned by @ref getEsrMilliohms() before the first measurement.
+             */
+            static constexpr uint16_t INVALID_ESR_MILLIOHMS = UINT16_MAX;
+
+            /**
+             * @brief Number of unloaded and loaded conversion pairs of one measurement.
+             */
+            static constexpr uint8_t SAMPLE_PAIRS = 16;
+
+            /**
+             * @brief Number of records kept in the EEPROM history.
+             */
+            static constexpr uint8_t HISTORY_SLOTS = 4;
+
+            /**
+             * @brief Change of the filtered ESR since the newest EEPROM record which writes a new one, in percent.
+             */
+            static constexpr uint8_t PERSIST_CHANGE_PERCENT = 10;
+
+            /**
+             * @brief Number of measurements after which the estimate is written to EEPROM even if it barely changed.
+             */
+            static constexpr uint16_t PERSIST_INTERVAL_MEASUREMENTS = 64;
+
+            /**
+             * @brief Measures the battery ESR with the IR LED as load and updates the filtered estimate.
+             *
+             * Blocks for about 90 ms. The ADC registers and the analog reference are restored afterwards.
+             *
+             * @param[in] uirb Core instance, providing the calibrated bandgap voltage.
+             * @return bool
+             * @retval true The estimate was updated. It is also appended to the EEPROM history, unless
+             * @ref UIRB_EEPROM_BYPASS_DEBUG is defined, when it changed by @ref PERSIST_CHANGE_PERCENT or
+             * @ref PERSIST_INTERVAL_MEASUREMENTS measurements passed since the newest record.
+             * @retval false @ref PIN_IR_LED is not an output or is driven by Timer2, an IR frame is being sent
+             * (with @ref UIRB_CORE_IR_TX_GATE), or AVcc was out of the measurable range.
+             */
+            static bool measureEsr(const UIRB& uirb);
+
+            /**
+             * @brief Returns the filtered ESR estimate.
+             *
+             * After a reset, the estimate is restored from the newest EEPROM record.
+             *
+             * @return uint16_t ESR in milliohms, or @ref INVALID_ESR_MILLIOHMS if never measured.
+             */
+            static uint16_t getEsrMilliohms();
+
+            /**
+             * @brief Predicts the drop of the supply voltage under a load.
+             *
+             * @param[in] load_milliamps Load current in milliamps.
+             * @return uint16_t Expected drop in millivolts, `0` if the ESR was never measured.
+             */
+            static uint16_t predictSagMillivolts(const uint16_t load_milliamps);
+
+            /**
+             * @brief Reads a record of the EEPROM history by age.
+             *
+             * @param[in] age Age of the record, `0` being the newest one.
+             * @param[out] record Destination of the record.
+             * @return bool `true` if the record exists and is valid.
+             */
+            static bool getHistory(const uint8_t age, BatteryEsrRecord& record);
+
+            /**
+             * @brief Clears the EEPROM history and the filtered estimate, for example after a battery swap.
+             */
+            static void clearHistory();
+
+            /**
+             * @brief Prints the EEPROM history, newest first, as tab separated lines
+             * `esr_mohm\topen_mv\tsag_mv\tcount`.
+             *
+             * @param[in] output Destination, such as `Serial`.
+             */
+            static void dump(Print& output);
+#endif  // defined(UIRB_CORE_BATTERY_ESR) || defined(__DOXYGEN__)
+
+#if defined(UIRB_CORE_BATTERY_CYCLES) || defined(__DOXYGEN__)
+            /**
+             * @brief Number of records kept in the EEPROM charge cycle log.
+             */
+            static constexpr uint8_t CYCLE_LOG_SLOTS = 4;
+
+            /**
+             * @brief Returns the total charge delivered to the battery.
+             *
+             * After a reset, the total is restored from the newest EEPROM record. Charge of a charge in progress
+             * is included.
+             *
+             * @return uint32_t Charge in milliamp hours.
+             */
+            static uint32_t getChargedMilliampHours();
+
+            /**
+             * @brief Returns the number of equivalent full cycles, the total charge divided by
+             * @ref UIRB_CORE_BATTERY_CAPACITY_MAH.
+             *
+             * @return uint16_t Whole cycles, saturating.
+             */
+            static uint16_t getEquivalentFullCycles();
+
+            /**
+             * @brief Returns the learned capacity of the battery.
+             *
+             * @return uint16_t Capacity in milliamp hours, `0` if no full charge from empty was observed yet.
+             */
+            static uint16_t getCapacityMilliampHours();
+
+            /**
+             * @brief Returns the learned capacity in percent of @ref UIRB_CORE_BATTERY_CAPACITY_MAH.
+             *
+             * @return uint8_t Capacity in percent, saturating at `255`, `0` if not learned yet.
+             */
+            static uint8_t getCapacityPercent();
+
+            /**
+             * @brief Clears the charge cycle log, the total charge and the learned capacity, for example after a
+             * battery swap.
+             */
+            static void clearCycleLog();
+
+            /**
+             * @brief Prints the charge cycle statistics as tab separated lines `charged_mah`, `cycles`,
+             * `capacity_mah` and `capacity_pct`.
+             *
+             * @param[in] output Destination, such as `Serial`.
+             */
+            static void dumpCycles(Print& output);
+
+        private:
+            /**
+             * @brief Tracks the charge of the battery.
+             *
+             * The whole milliamp hours of @ref PowerInfoData::getChargedMilliampSeconds() since the previous call
+             * are added to the total. The capacity is learned when a charge which started empty reaches
+             * @ref BatteryState::FULLY_CHARGED, and the totals are written to EEPROM whenever a charge ends.
+             *
+             * @param[in] state Battery state estimated now.
+             */
+            static void track_charge(const BatteryState state);
+
+            /**
+             * @brief Grants @ref PowerInfoData the call of @ref track_charge() after every valid update.
+             */
+            friend class PowerInfoData;
+#endif  // defined(UIRB_CORE_BATTERY_CYCLES) || defined(__DOXYGEN__)
+    };
+#endif  // defined(UIRB_CORE_BATTERY_ESR) || defined(UIRB_CORE_BATTERY_CYCLES) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_BatteryHealth_hpp
@@ -0,0 +1,157 @@
+/**
+ * @file UIRBcore_ChargeLog.hpp
+ * @brief Charging session log of the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::ChargeSessionLog class and the @ref uirbcore::ChargeSession structure.
+ * A session is recorded from the charger state transitions observed by @ref uirbcore::PowerInfoData::update():
+ * - It starts when the charger enters `ChargerState::CHARGING_CC` or `ChargerState::CHARGING_CV`.
+ * - The time spent in constant current mode ends at the first `ChargerState::CHARGING_CV`.
+ * - It ends when the charger leaves both charging modes. The state it ends in tells why: `ChargerState::FLOATING`
+ *   for a completed charge, `ChargerState::TURNED_OFF` for a charger disabled through @ref PIN_PROG, and
+ *   `ChargerState::UNKNOWN` for an unplugged charger.
+ *
+ * @details
+ * Each update costs a constant amount of work: the charge is the difference of
+ * @ref uirbcore::PowerInfoData::getChargedMilliampSeconds() since the start, and the peak current is kept. Durations
+ * use @ref uirbcore::UIRB::getUptimeMilliseconds(), so time spent in @ref uirbcore::UIRB::powerDown() while charging
+ * is counted. Nothing is written while charging. The finished session is appended to
+ * an EEPROM ring log of @ref UIRB_CORE_CHARGE_LOG_SLOTS records at @ref UIRB_EEPROM_CHARGE_LOG_ADDR_START in a
+ * single write, so a board wears one slot per charge, spread over all slots.
+ *
+ * The board has no real-time clock. The start of a session is given by the boot count and the uptime, which can be
+ * matched with the boot time of the device in the support records.
+ *
+ * @note Only compiled when @ref UIRB_CORE_CHARGE_LOG is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_ChargeLog_hpp
+#define UIRBcore_ChargeLog_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_PowerInfoData.hpp>
+
+namespace uirbcore
+{
+#if defined(UIRB_CORE_CHARGE_LOG) || defined(__DOXYGEN__)
+    /**
+     * @brief Compact record of a charging session.
+     *
+     * @note This structure is packed and stored as-is in the EEPROM charging session log.
+     */
+    struct ChargeSession
+    {
+        uint32_t boot_count; /**< @brief Boot count of the board when the session started. */
+        uint32_t start_seconds; /**< @brief Uptime in seconds when the session started, including time in power-down. */
+        uint16_t duration_minutes; /**< @brief Length of the session in minutes, saturating. */
+        uint16_t cc_minutes; /**< @brief Time spent in constant current mode in minutes, saturating. */
+        uint16_t peak_current_miliamps; /**< @brief Highest charging current sampled. */
+        uint16_t charged_milliamp_hours; /**< @brief Charge delivered in milliamp hours, saturating. */
+        ChargerState end_state; /**< @brief Charger state which ended the session. */
+    } __attribute__((packed, aligned(1)));
+
+    /**
+     * @brief Static recorder of charging sessions.
+     *
+     * Example usage, printing the sessions for a support ticket:
+     * @code
+     * ChargeSessionLog::dump(Serial);
+     * @endcode
+     *
+     * @note A session in progress is kept in RAM and lost on reset.
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class ChargeSessionLog
+    {
+        public:
+            /**
+             * @brief Checks if a session is in progress.
+             *
+             * @return bool `true` if the last update saw the charger in a charging mode.
+             */
+            static bool isCharging();
+
+            /**
+             * @brief Returns the session in progress, as it would be logged if it ended now.
+             *
+             * @param[out] session Destination of the session.
+             * @return bool `true` if a session is in progress.
+             */
+            static bool getCurrentSession(ChargeSession& session);
+
+            /**
+             * @brief Returns the number of sessions stored in EEPROM.
+             *
+             * @return uint8_t Number of readable sessions `[0-` @ref UIRB_CORE_CHARGE_LOG_SLOTS `]`.
+             */
+            static uint8_t count();
+
+            /**
+             * @brief Reads a session from EEPROM by age.
+             *
+             * @param[in] age Age of the session, `0` being the newest one.
+             * @param[out] session Destination of the session.
+             * @return bool `true` if the session exists and is valid.
+             */
+            static bool read(const uint8_t age, ChargeSession& session);
+
+            /**
+             * @brief Clears the sessions stored in EEPROM. A session in progress is kept.
+             */
+            static void clear();
+
+            /**
+             * @brief Prints the stored sessions, newest first, as tab separated lines
+             * `boot\tstart_s\tduration_min\tcc_min\tpeak_ma\tmah\tend`, `end` being the @ref ChargerState value.
+             *
+             * @param[in] output Destination, such as `Serial`.
+             */
+            static void dump(Print& output);
+
+        private:
+            /**
+             * @brief Advances the session with a new sample.
+             *
+             * @param[in] charging_current_miliamps Charging current sampled now.
+             * @param[in] state Charger state estimated now.
+             */
+            static void track(const uint16_t charging_current_miliamps, const ChargerState state);
+
+            /**
+             * @brief Grants @ref PowerInfoData the call of @ref track() after every valid update.
+             */
+            friend class PowerInfoData;
+    };
+#endif  // defined(UIRB_CORE_CHARGE_LOG) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_ChargeLog_hpp
@@ -0,0 +1,232 @@
+/**
+ * @file UIRBcore_Coroutine.hpp
+ * @brief Stackless coroutines for the resumable tasks of the %UIRB system.
+ *
+ * This header defines the @ref uirbcore::CoroutineState structure and the `UIRB_TASK_*` macros, which turn a
+ * `step()` method into a function that returns at each wait and continues after it on the next call. A task keeps
+ * 4 bytes of coroutine state and no stack of its own, so many tasks can run concurrently from `loop()`.
+ *
+ * @details
+ * A task is a class with a @ref uirbcore::CoroutineState member and a `TaskStatus step()` method whose body
+ * is enclosed in @ref UIRB_TASK_BEGIN and @ref UIRB_TASK_END:
+ * - Local variables of `step()` are lost at every wait. Values needed after a wait are kept in members.
+ * - The macros expand to `case` labels of one `switch`, so `step()` must not wait inside a `switch` statement
+ *   of its own and must not use two `UIRB_TASK_*` macros on one source line.
+ * - Tasks are composed by awaiting a child task from the parent with @ref UIRB_TASK_AWAIT.
+ *
+ * Library tasks are declared in @ref UIRBcore_Tasks.hpp. The blocking library functions run the same tasks to
+ * completion with @ref uirbcore::runTask().
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_Coroutine_hpp
+#define UIRBcore_Coroutine_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+
+namespace uirbcore
+{
+    /**
+     * @brief Enum class returned by the `step()` method of a task, as `uint8_t`.
+     */
+    enum class TaskStatus : uint8_t
+    {
+        RUNNING = 0, /**< The task waits and has to be stepped again. */
+        DONE /**< The task has finished. Further steps do nothing. */
+    };
+
+    /**
+     * @brief Resume state of a stackless coroutine, used by the `UIRB_TASK_*` macros.
+     *
+     * Example usage, blinking the status LED three times while other tasks keep running:
+     * @code
+     * class BlinkTask
+     * {
+     *     public:
+     *         TaskStatus step()
+     *         {
+     *             UIRB_TASK_BEGIN(this->coroutine_);
+     *             for (this->count_ = 0; this->count_ < 3; this->count_++)
+     *             {
+     *                 digitalWrite(PIN_STAT_LED, HIGH);
+     *                 UIRB_TASK_DELAY(this->coroutine_, 100);
+     *                 digitalWrite(PIN_STAT_LED, LOW);
+     *                 UIRB_TASK_DELAY(this->coroutine_, 400);
+     *             }
+     *             UIRB_TASK_END(this->coroutine_);
+     *         }
+     *
+     *     private:
+     *         CoroutineState coroutine_ = {};
+     *         uint8_t count_ = 0;
+     * };
+     * @endcode
+     */
+    struct CoroutineState
+    {
+        /**
+         * @brief Value of @ref resume_point after @ref UIRB_TASK_END or @ref UIRB_TASK_EXIT.
+         */
+        static constexpr uint16_t DONE = UINT16_MAX;
+
+        uint16_t resume_point; /**< @brief Source line to continue at, `0` before the first step. */
+        uint16_t wait_start_milliseconds; /**< @brief Low 16 bits of `millis()` when @ref UIRB_TASK_DELAY started. */
+    };
+
+    /**
+     * @brief Checks if a coroutine has finished.
+     *
+     * @param[in] state Coroutine state.
+     * @return bool `true` after @ref UIRB_TASK_END or @ref UIRB_TASK_EXIT was reached.
+     */
+    inline bool isTaskDone(const CoroutineState& state)
+    {
+        return state.resume_point == CoroutineState::DONE;
+    }
+
+    /**
+     * @brief Steps a task until it is done, blocking like the `delay()` based code it replaces.
+     *
+     * `yield()` is called between steps, as in `delay()`.
+     *
+     * @tparam Task Class with a `TaskStatus step()` method.
+     * @param[in,out] task Task to run.
+     */
+    template <typename Task>
+    inline void runTask(Task& task)
+    {
+        while (task.step() != TaskStatus::DONE)
+        {
+            yield();
+        }
+    }
+}  // namespace uirbcore
+
+/**
+ * @def UIRB_TASK_FALLTHROUGH
+ * @brief Marks the intended fall through into the resume `case` labels for `-Wimplicit-fallthrough`.
+ */
+#if defined(__GNUC__) && (__GNUC__ >= 7)
+    #define UIRB_TASK_FALLTHROUGH __attribute__((fallthrough))
+#else  // defined(__GNUC__) && (__GNUC__ >= 7)
+    #define UIRB_TASK_FALLTHROUGH do {} while (0)
+#endif  // defined(__GNUC__) && (__GNUC__ >= 7)
+
+/**
+ * @def UIRB_TASK_BEGIN(state)
+ * @brief Starts the body of a `step()` method, continuing at the last wait.
+ *
+ * @param state @ref uirbcore::CoroutineState of the task.
+ */
+#define UIRB_TASK_BEGIN(state) switch ((state).resume_point) { case 0:
+
+/**
+ * @def UIRB_TASK_WAIT_UNTIL(state, condition)
+ * @brief Returns @ref uirbcore::TaskStatus::RUNNING until @p condition is `true`, evaluating it on every step.
+ *
+ * @param state @ref uirbcore::CoroutineState of the task.
+ * @param condition Expression checked on every step.
+ */
+#define UIRB_TASK_WAIT_UNTIL(state, condition) \
+    do \
+    { \
+        (state).resume_point = __LINE__; \
+        UIRB_TASK_FALLTHROUGH; \
+        case __LINE__: \
+        if (!(condition)) \
+        { \
+            return uirbcore::TaskStatus::RUNNING; \
+        } \
+    } while (0)
+
+/**
+ * @def UIRB_TASK_YIELD(state)
+ * @brief Returns @ref uirbcore::TaskStatus::RUNNING once and continues after the macro on the next step.
+ *
+ * @param state @ref uirbcore::CoroutineState of the task.
+ */
+#define UIRB_TASK_YIELD(state) \
+    do \
+    { \
+        (state).resume_point = __LINE__; \
+        return uirbcore::TaskStatus::RUNNING; \
+        case __LINE__:; \
+    } while (0)
+
+/**
+ * @def UIRB_TASK_DELAY(state, milliseconds)
+ * @brief Waits for @p milliseconds without blocking, like `delay()`.
+ *
+ * @param state @ref uirbcore::CoroutineState of the task.
+ * @param milliseconds Delay, at most `65535`.
+ */
+#define UIRB_TASK_DELAY(state, milliseconds) \
+    do \
+    { \
+        (state).wait_start_milliseconds = static_cast<uint16_t>(millis()); \
+        UIRB_TASK_WAIT_UNTIL(state, static_cast<uint16_t>(static_cast<uint16_t>(millis()) - \
+                                    (state).wait_start_milliseconds) >= static_cast<uint16_t>(milliseconds)); \
+    } while (0)
+
+/**
+ * @def UIRB_TASK_AWAIT(state, task)
+ * @brief Steps a child task once per step of the calling task until the child is done.
+ *
+ * @param state @ref uirbcore::CoroutineState of the calling task.
+ * @param task Child task object, kept as a member of the calling task.
+ */
+#define UIRB_TASK_AWAIT(state, task) UIRB_TASK_WAIT_UNTIL(state, (task).step() == uirbcore::TaskStatus::DONE)
+
+/**
+ * @def UIRB_TASK_EXIT(state)
+ * @brief Finishes the task early.
+ *
+ * @param state @ref uirbcore::CoroutineState of the task.
+ */
+#define UIRB_TASK_EXIT(state) \
+    do \
+    { \
+        (state).resume_point = uirbcore::CoroutineState::DONE; \
+        return uirbcore::TaskStatus::DONE; \
+    } while (0)
+
+/**
+ * @def UIRB_TASK_END(state)
+ * @brief Ends the body of a `step()` method started with @ref UIRB_TASK_BEGIN and finishes the task.
+ *
+ * @param state @ref uirbcore::CoroutineState of the task.
+ */
+#define UIRB_TASK_END(state) \
+    } \
+    UIRB_TASK_EXIT(state)
+
+#endif  // UIRBcore_Coroutine_hpp
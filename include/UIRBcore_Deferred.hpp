@@ -0,0 +1,219 @@
+/**
+ * @file UIRBcore_Deferred.hpp
+ * @brief Deferred work queue running interrupt triggered work outside of interrupts for the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::DeferredWork and @ref uirbcore::DeferredQueue classes. An interrupt
+ * only schedules a work item, which appends it to a queue, and the work itself runs later with interrupts enabled
+ * at a safe point:
+ * - From `loop()`, by calling @ref uirbcore::DeferredQueue::run().
+ * - In @ref uirbcore::UIRB::powerDown(), before going to sleep and right after waking up.
+ *
+ * @details
+ * - Items run in the order they were scheduled, so the latency of an item is bounded by the handlers queued
+ *   before it plus the time until the next safe point.
+ * - Scheduling an item which is already pending does nothing but count the coalesced event.
+ * - The latency from scheduling to the start of the handler is measured with `micros()` for every item.
+ * - With the queue enabled, the wakeup callbacks set by @ref uirbcore::UIRB::setButtonWakeupCallback() and
+ *   @ref uirbcore::UIRB::setIO3WakeupCallback() are run through it.
+ *
+ * @note Only compiled when @ref UIRB_CORE_DEFERRED_WORK is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_Deferred_hpp
+#define UIRBcore_Deferred_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+
+namespace uirbcore
+{
+#if defined(UIRB_CORE_DEFERRED_WORK) || defined(__DOXYGEN__)
+    /**
+     * @brief Work item run by @ref DeferredQueue. Items are owned by the caller and linked into the queue.
+     *
+     * Example usage, decoding in `loop()` what an interrupt captured:
+     * @code
+     * void decodeFrame(DeferredWork& work) { ... }
+     *
+     * DeferredWork decodeWork(decodeFrame);
+     *
+     * ISR(...) { ...; DeferredQueue::schedule(decodeWork); }
+     *
+     * void loop()
+     * {
+     *     DeferredQueue::run();
+     * }
+     * @endcode
+     *
+     * @warning A pending item must not be destroyed or moved.
+     */
+    class DeferredWork
+    {
+        public:
+            /**
+             * @brief Handler run by @ref DeferredQueue::run() with interrupts enabled.
+             */
+            typedef void (*Handler)(DeferredWork& work);
+
+            /**
+             * @brief Constructs an idle work item.
+             *
+             * @param[in] handler Handler to run.
+             * @param[in] context User pointer returned by @ref getContext(). Defaults to `nullptr`.
+             */
+            explicit DeferredWork(const Handler handler, void* context = nullptr)
+                : handler_(handler), context_(context)
+            {
+            }
+
+            /**
+             * @brief Checks if the item is scheduled and its handler has not started yet.
+             *
+             * @return bool `true` if pending.
+             */
+            bool isPending() const
+            {
+                return this->pending_;
+            }
+
+            /**
+             * @brief Returns the user pointer passed to the constructor.
+             *
+             * @return void* User pointer.
+             */
+            void* getContext() const
+            {
+                return this->context_;
+            }
+
+            /**
+             * @brief Returns the number of handler runs since construction or @ref resetStats(), saturating.
+             *
+             * @return uint16_t Number of runs.
+             */
+            uint16_t getRunCount() const
+            {
+                return this->run_count_;
+            }
+
+            /**
+             * @brief Returns the number of schedules ignored because the item was still pending, saturating.
+             *
+             * @return uint16_t Number of coalesced schedules.
+             */
+            uint16_t getCoalescedCount() const
+            {
+                return this->coalesced_count_;
+            }
+
+            /**
+             * @brief Returns the longest time from scheduling to the start of the handler.
+             *
+             * @return uint32_t Latency in microseconds. Time spent in power-down is not included, as `micros()`
+             * stops while sleeping.
+             */
+            uint32_t getMaxLatencyMicroseconds() const
+            {
+                return this->max_latency_microseconds_;
+            }
+
+            /**
+             * @brief Clears the run and coalesced counts and the maximum latency.
+             */
+            void resetStats();
+
+        private:
+            DeferredWork* next_ = nullptr; /**< Next item in the queue. */
+            volatile bool pending_ = false; /**< Item is queued. */
+            uint16_t run_count_ = 0; /**< Handler runs. */
+            uint16_t coalesced_count_ = 0; /**< Schedules while pending. */
+            uint32_t scheduled_microseconds_ = 0; /**< `micros()` when scheduled. */
+            uint32_t max_latency_microseconds_ = 0; /**< Longest latency. */
+            const Handler handler_; /**< Handler. */
+            void* const context_; /**< User pointer. */
+
+            /**
+             * @brief Grants @ref DeferredQueue access to the links and statistics.
+             */
+            friend class DeferredQueue;
+    };
+
+    /**
+     * @brief Static first in, first out queue of @ref DeferredWork items.
+     *
+     * @note Most of the scheduling time is spent reading `micros()` for the latency measurement.
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class DeferredQueue
+    {
+        public:
+            /**
+             * @brief Appends an item to the queue. Safe to call from interrupts and from the main loop.
+             *
+             * @param[in] work Item to schedule.
+             * @return bool `false` if the item was already pending. Its handler runs once for both schedules.
+             */
+            static bool schedule(DeferredWork& work);
+
+            /**
+             * @brief Runs the handlers of all items pending when called.
+             *
+             * Items scheduled while the handlers run, including by the handlers themselves, are left for the next
+             * call, which bounds the time spent here.
+             *
+             * @return uint8_t Number of handlers run, saturating at `255`.
+             */
+            static uint8_t run();
+
+            /**
+             * @brief Checks if any item is pending.
+             *
+             * @return bool `true` if the next @ref run() has work to do.
+             */
+            static bool isPending();
+
+            /**
+             * @brief Returns the longest latency of any item since the last @ref resetMaxLatency().
+             *
+             * @return uint32_t Latency in microseconds.
+             */
+            static uint32_t getMaxLatencyMicroseconds();
+
+            /**
+             * @brief Clears the value returned by @ref getMaxLatencyMicroseconds().
+             */
+            static void resetMaxLatency();
+    };
+#endif  // defined(UIRB_CORE_DEFERRED_WORK) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_Deferred_hpp
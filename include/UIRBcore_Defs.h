@@ -279,4 +279,1212 @@
 #endif  // defined(UIRB_EEPROM_RPROG_DEBUG)
 /** @} */ // End of EEPROM
 
+/**
+ * @name Diagnostics
+ * @{
+ */
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_WDT_SUPERVISOR
+     * @brief Macro enabling the watchdog supervisor with hang post-mortem and EEPROM reset log.
+     * 
+     * When this macro is defined, @ref uirbcore::WatchdogSupervisor can supervise the application with the 
+     * watchdog timer in interrupt-then-reset mode. A hang is recorded into `.noinit` RAM before the reset, 
+     * and watchdog and brown-out resets are appended to a rolling log in EEPROM by the @ref uirbcore::UIRB constructor.
+     * 
+     * @details
+     * - The library provides the `WDT_vect` interrupt handler in both cases. With this macro defined it is 
+     *   replaced by a naked entry stub capturing the interrupted program counter.
+     * - @ref uirbcore::UIRB::powerDown() pauses supervision while the watchdog is used as a sleep timer.
+     * - The reset log occupies `UIRB_CORE_WDT_RESET_LOG_SLOTS * 10` bytes of EEPROM starting at 
+     *   @ref UIRB_EEPROM_RESET_LOG_ADDR_START.
+     * 
+     * @warning The supervision timeout must be longer than the longest blocking library call, e.g. 
+     * @ref uirbcore::UIRB::notifyStatusLowBattery() takes about 1.7 seconds.
+     * 
+     * @see @ref UIRB_CORE_WDT_RESET_LOG_SLOTS
+     */
+    #define UIRB_CORE_WDT_SUPERVISOR
+    #undef UIRB_CORE_WDT_SUPERVISOR
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_WDT_RESET_LOG_SLOTS
+ * @brief Macro defining the number of records kept in the EEPROM reset log.
+ * 
+ * Each record takes 10 bytes of EEPROM. Once the log is full the oldest record is overwritten. 
+ * By default, 8 records are kept.
+ * 
+ * @note Only used when @ref UIRB_CORE_WDT_SUPERVISOR is defined.
+ */
+#if !defined(UIRB_CORE_WDT_RESET_LOG_SLOTS)
+    #define UIRB_CORE_WDT_RESET_LOG_SLOTS 8
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_WDT_RESET_LOG_SLOTS.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_WDT_RESET_LOG_SLOTS
+#endif  // !defined(UIRB_CORE_WDT_RESET_LOG_SLOTS)
+
+// Check if UIRB_CORE_WDT_RESET_LOG_SLOTS is a number
+#if (UIRB_CORE_WDT_RESET_LOG_SLOTS + 0) != UIRB_CORE_WDT_RESET_LOG_SLOTS
+    #error "UIRB_CORE_WDT_RESET_LOG_SLOTS must be a numeric constant."
+#endif  // (UIRB_CORE_WDT_RESET_LOG_SLOTS + 0) != UIRB_CORE_WDT_RESET_LOG_SLOTS
+
+#if UIRB_CORE_WDT_RESET_LOG_SLOTS < 1 || UIRB_CORE_WDT_RESET_LOG_SLOTS > 32
+    #error "Invalid value for `UIRB_CORE_WDT_RESET_LOG_SLOTS`. Valid values are between 1 and 32."
+#endif  // UIRB_CORE_WDT_RESET_LOG_SLOTS < 1 || UIRB_CORE_WDT_RESET_LOG_SLOTS > 32
+
+#if !defined(NO_WARN_UIRB_CORE_WDT_RESET_LOG_SLOTS)
+    #warning "UIRB_CORE_WDT_RESET_LOG_SLOTS is defined with value: " XSTR(UIRB_CORE_WDT_RESET_LOG_SLOTS)
+#else
+    #undef NO_WARN_UIRB_CORE_WDT_RESET_LOG_SLOTS
+#endif  // !defined(NO_WARN_UIRB_CORE_WDT_RESET_LOG_SLOTS)
+
+#if defined(UIRB_CORE_WDT_SUPERVISOR)
+    #warning "UIRB_CORE_WDT_SUPERVISOR is defined. Watchdog resets will be logged to EEPROM."
+#endif  // defined(UIRB_CORE_WDT_SUPERVISOR)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_PROFILER
+     * @brief Macro enabling the Timer1-based hot-path profiler.
+     * 
+     * When this macro is defined, library hot paths record their execution time into @ref uirbcore::Profiler. 
+     * Each probe takes 14 bytes of RAM. When it is not defined, @ref UIRB_PROFILE_SCOPE expands to nothing.
+     * 
+     * @warning @ref uirbcore::Profiler::begin() takes over Timer1. Do not enable the profiler together with code 
+     * that reconfigures Timer1 (e.g. `Servo` or IR libraries using Timer1 in CTC or PWM mode). Declaring such code 
+     * with @ref UIRB_CORE_RESERVE_TIMER1 turns the conflict into a build error.
+     * 
+     * @see @ref UIRB_CORE_PROFILER_PRESCALER
+     */
+    #define UIRB_CORE_PROFILER
+    #undef UIRB_CORE_PROFILER
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_PROFILER_PRESCALER
+ * @brief Macro defining the Timer1 prescaler used by @ref uirbcore::Profiler.
+ * 
+ * Valid values are `1`, `8`, `64`, `256` and `1024`. By default, a prescaler of 64 is used, giving a tick of 
+ * 8 µs and a measurable range of about 524 ms at 8 MHz.
+ * 
+ * @note Only used when @ref UIRB_CORE_PROFILER is defined.
+ */
+#if !defined(UIRB_CORE_PROFILER_PRESCALER)
+    #define UIRB_CORE_PROFILER_PRESCALER 64
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_PROFILER_PRESCALER.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_PROFILER_PRESCALER
+#endif  // !defined(UIRB_CORE_PROFILER_PRESCALER)
+
+// Check if UIRB_CORE_PROFILER_PRESCALER is a number
+#if (UIRB_CORE_PROFILER_PRESCALER + 0) != UIRB_CORE_PROFILER_PRESCALER
+    #error "UIRB_CORE_PROFILER_PRESCALER must be a numeric constant."
+#endif  // (UIRB_CORE_PROFILER_PRESCALER + 0) != UIRB_CORE_PROFILER_PRESCALER
+
+#if UIRB_CORE_PROFILER_PRESCALER != 1 && UIRB_CORE_PROFILER_PRESCALER != 8 && UIRB_CORE_PROFILER_PRESCALER != 64 && \
+    UIRB_CORE_PROFILER_PRESCALER != 256 && UIRB_CORE_PROFILER_PRESCALER != 1024
+    #error "Invalid value for `UIRB_CORE_PROFILER_PRESCALER`. Valid values are 1, 8, 64, 256 and 1024."
+#endif  // UIRB_CORE_PROFILER_PRESCALER is not a Timer1 prescaler
+
+#if !defined(NO_WARN_UIRB_CORE_PROFILER_PRESCALER)
+    #warning "UIRB_CORE_PROFILER_PRESCALER is defined with value: " XSTR(UIRB_CORE_PROFILER_PRESCALER)
+#else
+    #undef NO_WARN_UIRB_CORE_PROFILER_PRESCALER
+#endif  // !defined(NO_WARN_UIRB_CORE_PROFILER_PRESCALER)
+
+#if defined(UIRB_CORE_PROFILER)
+    #warning "UIRB_CORE_PROFILER is defined. Timer1 will be used as a free-running counter."
+#endif  // defined(UIRB_CORE_PROFILER)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_DEBUG_STROBE
+     * @brief Macro selecting the probes which drive the debug strobe on @ref PIN_PULLDOWN_RESISTOR.
+     * 
+     * The value is a bit mask with bit `n` set for each @ref uirbcore::ProfileProbe of value `n` to strobe, e.g. 
+     * `0x0003` for both ADC probes. While a selected probe runs, @ref PIN_PULLDOWN_RESISTOR (PD5) is high and `GPIOR0` 
+     * holds the probe value plus one, so a logic analyzer shows the real timing and a simulator trace tells the 
+     * probes apart. The markers are single `sbi`/`cbi` and `out` instructions inlined at the 
+     * @ref UIRB_PROFILE_SCOPE probe points and work with or without @ref UIRB_CORE_PROFILER. 
+     * Valid range is [`0x0001`-`0xFFFF`]. When it is not defined, no strobe code is generated.
+     * 
+     * @warning PD5 is driven as an output and `GPIOR0` is used by the library. The strobe is held low while asleep, 
+     * and @ref uirbcore::ProfileProbe::SLEEP only marks the wake edge with a short pulse. Keep the pulldown resistor's 
+     * current in mind when measuring the awake supply current.
+     * @see `scripts/simavr/uirb_strobe_vcd.c` and `scripts/strobe_summary.py`
+     */
+    #define UIRB_CORE_DEBUG_STROBE 0xFFFF
+    #undef UIRB_CORE_DEBUG_STROBE
+#endif  // defined(__DOXYGEN__)
+
+#if defined(UIRB_CORE_DEBUG_STROBE)
+    // Check if UIRB_CORE_DEBUG_STROBE is a number
+    #if (UIRB_CORE_DEBUG_STROBE + 0) != UIRB_CORE_DEBUG_STROBE
+        #error "UIRB_CORE_DEBUG_STROBE must be a numeric constant."
+    #endif  // (UIRB_CORE_DEBUG_STROBE + 0) != UIRB_CORE_DEBUG_STROBE
+
+    #if UIRB_CORE_DEBUG_STROBE < 0x0001 || UIRB_CORE_DEBUG_STROBE > 0xFFFF
+        #error "Invalid value for `UIRB_CORE_DEBUG_STROBE`. Valid range is [0x0001-0xFFFF]."
+    #endif  // UIRB_CORE_DEBUG_STROBE < 0x0001 || UIRB_CORE_DEBUG_STROBE > 0xFFFF
+
+    #warning "UIRB_CORE_DEBUG_STROBE is defined with value: " XSTR(UIRB_CORE_DEBUG_STROBE)
+#endif  // defined(UIRB_CORE_DEBUG_STROBE)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_STACK_MONITOR
+     * @brief Macro enabling stack painting and the stack high-water mark of @ref uirbcore::StackMonitor.
+     * 
+     * When this macro is defined, the free RAM between the heap and the stack is filled with a known pattern 
+     * during startup, before static constructors run. The deepest stack use since reset is found at runtime by 
+     * scanning for the first overwritten byte. The scan takes up to about 1 ms and no RAM is used.
+     * 
+     * @see `scripts/simavr/uirb_stack_depth.c` and `scripts/stack_report.py` for the per-function stack depth 
+     * measured in the simulator.
+     */
+    #define UIRB_CORE_STACK_MONITOR
+    #undef UIRB_CORE_STACK_MONITOR
+#endif  // defined(__DOXYGEN__)
+
+#if defined(UIRB_CORE_STACK_MONITOR)
+    #warning "UIRB_CORE_STACK_MONITOR is defined. Free RAM will be painted at startup."
+#endif  // defined(UIRB_CORE_STACK_MONITOR)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_TRACE
+     * @brief Macro enabling the post-mortem event trace ring buffer.
+     * 
+     * When this macro is defined, the library logs typed events into @ref uirbcore::Trace. The buffer lives in 
+     * `.noinit` RAM and survives watchdog and external resets. When it is not defined, @ref UIRB_TRACE expands to nothing.
+     * 
+     * @see @ref UIRB_CORE_TRACE_ENTRIES
+     */
+    #define UIRB_CORE_TRACE
+    #undef UIRB_CORE_TRACE
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_TRACE_ENTRIES
+ * @brief Macro defining the number of entries in the trace ring buffer.
+ * 
+ * Each entry takes 4 bytes of RAM. The value must be a power of two between 8 and 256. 
+ * By default, 64 entries (256 bytes) are kept.
+ * 
+ * @note Only used when @ref UIRB_CORE_TRACE is defined.
+ */
+#if !defined(UIRB_CORE_TRACE_ENTRIES)
+    #define UIRB_CORE_TRACE_ENTRIES 64
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_TRACE_ENTRIES.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_TRACE_ENTRIES
+#endif  // !defined(UIRB_CORE_TRACE_ENTRIES)
+
+// Check if UIRB_CORE_TRACE_ENTRIES is a number
+#if (UIRB_CORE_TRACE_ENTRIES + 0) != UIRB_CORE_TRACE_ENTRIES
+    #error "UIRB_CORE_TRACE_ENTRIES must be a numeric constant."
+#endif  // (UIRB_CORE_TRACE_ENTRIES + 0) != UIRB_CORE_TRACE_ENTRIES
+
+#if UIRB_CORE_TRACE_ENTRIES < 8 || UIRB_CORE_TRACE_ENTRIES > 256 || (UIRB_CORE_TRACE_ENTRIES & (UIRB_CORE_TRACE_ENTRIES - 1)) != 0
+    #error "Invalid value for `UIRB_CORE_TRACE_ENTRIES`. Valid values are powers of two between 8 and 256."
+#endif  // UIRB_CORE_TRACE_ENTRIES is not a power of two between 8 and 256
+
+#if !defined(NO_WARN_UIRB_CORE_TRACE_ENTRIES)
+    #warning "UIRB_CORE_TRACE_ENTRIES is defined with value: " XSTR(UIRB_CORE_TRACE_ENTRIES)
+#else
+    #undef NO_WARN_UIRB_CORE_TRACE_ENTRIES
+#endif  // !defined(NO_WARN_UIRB_CORE_TRACE_ENTRIES)
+
+#if defined(UIRB_CORE_TRACE)
+    #warning "UIRB_CORE_TRACE is defined. Library events will be logged to the trace buffer."
+#endif  // defined(UIRB_CORE_TRACE)
+/** @} */ // End of Diagnostics
+
+/**
+ * @name Startup
+ * @{
+ */
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_WARM_RESTART
+     * @brief Macro enabling the warm restart fast path.
+     * 
+     * When this macro is defined, the validated @ref uirbcore::eeprom::EEPROMData image and the last 
+     * @ref uirbcore::PowerInfoData snapshot are mirrored into `.noinit` RAM guarded by a magic value and a CRC-16. 
+     * After a watchdog or external reset the @ref uirbcore::UIRB constructor restores them instead of reading, 
+     * incrementing the boot count and writing back EEPROM.
+     * 
+     * @details
+     * - Power-on and brown-out resets always take the full cold path.
+     * - Warm resets are not counted by the boot counter.
+     * - The mirror is refreshed only with data known to match EEPROM, i.e. after a successful save or reload.
+     * 
+     * @see @ref uirbcore::WarmRestart
+     */
+    #define UIRB_CORE_WARM_RESTART
+    #undef UIRB_CORE_WARM_RESTART
+#endif  // defined(__DOXYGEN__)
+
+#if defined(UIRB_CORE_WARM_RESTART)
+    #warning "UIRB_CORE_WARM_RESTART is defined. Warm resets will skip EEPROM and boot counting."
+#endif  // defined(UIRB_CORE_WARM_RESTART)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_SELF_TEST
+     * @brief Macro enabling the power-on self-test in @ref uirbcore::UIRB::begin().
+     * 
+     * When this macro is defined, the first call to @ref uirbcore::UIRB::begin() runs @ref uirbcore::SelfTest::run() 
+     * with the default tests and returns `CoreResult::ERROR_SELF_TEST_FAILED` if any of them failed or was skipped.
+     * @ref uirbcore::SelfTest can be used without this macro.
+     * 
+     * @see @ref UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS
+     */
+    #define UIRB_CORE_SELF_TEST
+    #undef UIRB_CORE_SELF_TEST
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS
+ * @brief Macro defining the total time budget of a self-test run in microseconds.
+ * 
+ * Tests which would not fit into the remaining budget are skipped and reported as such. 
+ * The value must be between 1000 and 60000. By default, the budget is 30000us (30ms).
+ */
+#if !defined(UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS)
+    #define UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS 30000
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS
+#endif  // !defined(UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS)
+
+// Check if UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS is a number
+#if (UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS + 0) != UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS
+    #error "UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS must be a numeric constant."
+#endif  // (UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS + 0) != UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS
+
+#if UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS < 1000 || UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS > 60000
+    #error "Invalid value for `UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS`. Valid range is [1000-60000]."
+#endif  // UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS < 1000 || UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS > 60000
+
+#if !defined(NO_WARN_UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS)
+    #warning "UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS is defined with value: " XSTR(UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS)
+#else
+    #undef NO_WARN_UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS
+#endif  // !defined(NO_WARN_UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS)
+
+#if defined(UIRB_CORE_SELF_TEST)
+    #warning "UIRB_CORE_SELF_TEST is defined. UIRB::begin() will run the power-on self-test."
+#endif  // defined(UIRB_CORE_SELF_TEST)
+/** @} */ // End of Startup
+
+/**
+ * @name Peripherals
+ * @{
+ */
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_PIN_ARBITER
+     * @brief Macro enabling the ownership arbiter for shared pins.
+     * 
+     * When this macro is defined, @ref uirbcore::PinArbiter is compiled and the library claims the pins it shares 
+     * with other functions before using them: the status LED patterns of @ref uirbcore::UIRB and the 
+     * @ref uirbcore::JedecSPIFlash transactions. Hold time statistics take about 170 bytes of RAM.
+     */
+    #define UIRB_CORE_PIN_ARBITER
+    #undef UIRB_CORE_PIN_ARBITER
+#endif  // defined(__DOXYGEN__)
+
+#if defined(UIRB_CORE_PIN_ARBITER)
+    #warning "UIRB_CORE_PIN_ARBITER is defined. Shared pins will be arbitrated."
+#endif  // defined(UIRB_CORE_PIN_ARBITER)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_TIMER_MANAGER
+     * @brief Macro enabling the hardware timer allocation.
+     * 
+     * When this macro is defined, @ref uirbcore::TimerManager is compiled and library features acquire their timers 
+     * through it. The manager defines the compare, capture and overflow vectors of every timer not reserved with 
+     * @ref UIRB_CORE_RESERVE_TIMER0, @ref UIRB_CORE_RESERVE_TIMER1 or @ref UIRB_CORE_RESERVE_TIMER2.
+     * 
+     * @warning The Arduino core's `tone()` defines `TIMER2_COMPA_vect` as well, so a sketch calling `tone()` 
+     * fails to link unless @ref UIRB_CORE_RESERVE_TIMER2 is defined.
+     * 
+     * @see @ref UIRB_CORE_TIMER_HANDLER_SLOTS
+     */
+    #define UIRB_CORE_TIMER_MANAGER
+    #undef UIRB_CORE_TIMER_MANAGER
+
+    /**
+     * @def UIRB_CORE_RESERVE_TIMER0
+     * @brief Macro reserving the Timer0 compare vectors for code outside the library.
+     * 
+     * Timer0 itself always runs `millis()`. When this macro is defined, @ref uirbcore::TimerManager does not define 
+     * `TIMER0_COMPA_vect` and `TIMER0_COMPB_vect`.
+     */
+    #define UIRB_CORE_RESERVE_TIMER0
+    #undef UIRB_CORE_RESERVE_TIMER0
+
+    /**
+     * @def UIRB_CORE_RESERVE_TIMER1
+     * @brief Macro reserving Timer1 and its vectors for code outside the library, e.g. an IR or `Servo` library.
+     * 
+     * Library features needing Timer1, such as @ref UIRB_CORE_PROFILER, fail to build when this macro is defined.
+     */
+    #define UIRB_CORE_RESERVE_TIMER1
+    #undef UIRB_CORE_RESERVE_TIMER1
+
+    /**
+     * @def UIRB_CORE_RESERVE_TIMER2
+     * @brief Macro reserving Timer2 and its vectors for code outside the library, e.g. an IR library sending 
+     * through OC2B.
+     * 
+     * Required by sketches using the Arduino core's `tone()`, which defines `TIMER2_COMPA_vect` itself.
+     * 
+     * @note @ref uirbcore::SelfTest still borrows Timer2 for the IR tests, saving and restoring its registers.
+     */
+    #define UIRB_CORE_RESERVE_TIMER2
+    #undef UIRB_CORE_RESERVE_TIMER2
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_TIMER_HANDLER_SLOTS
+ * @brief Macro defining the number of handlers @ref uirbcore::TimerManager can attach to timer vectors in total.
+ * 
+ * Each slot takes 3 bytes of RAM. Valid range is from 1 to 8. By default, 4 slots are available.
+ * 
+ * @note Only used when @ref UIRB_CORE_TIMER_MANAGER is defined.
+ */
+#if !defined(UIRB_CORE_TIMER_HANDLER_SLOTS)
+    #define UIRB_CORE_TIMER_HANDLER_SLOTS 4
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_TIMER_HANDLER_SLOTS.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_TIMER_HANDLER_SLOTS
+#endif  // !defined(UIRB_CORE_TIMER_HANDLER_SLOTS)
+
+// Check if UIRB_CORE_TIMER_HANDLER_SLOTS is a number
+#if (UIRB_CORE_TIMER_HANDLER_SLOTS + 0) != UIRB_CORE_TIMER_HANDLER_SLOTS
+    #error "UIRB_CORE_TIMER_HANDLER_SLOTS must be a numeric constant."
+#endif  // (UIRB_CORE_TIMER_HANDLER_SLOTS + 0) != UIRB_CORE_TIMER_HANDLER_SLOTS
+
+#if UIRB_CORE_TIMER_HANDLER_SLOTS < 1 || UIRB_CORE_TIMER_HANDLER_SLOTS > 8
+    #error "Invalid value for `UIRB_CORE_TIMER_HANDLER_SLOTS`. Valid range is [1-8]."
+#endif  // UIRB_CORE_TIMER_HANDLER_SLOTS < 1 || UIRB_CORE_TIMER_HANDLER_SLOTS > 8
+
+#if !defined(NO_WARN_UIRB_CORE_TIMER_HANDLER_SLOTS)
+    #warning "UIRB_CORE_TIMER_HANDLER_SLOTS is defined with value: " XSTR(UIRB_CORE_TIMER_HANDLER_SLOTS)
+#else
+    #undef NO_WARN_UIRB_CORE_TIMER_HANDLER_SLOTS
+#endif  // !defined(NO_WARN_UIRB_CORE_TIMER_HANDLER_SLOTS)
+
+#if defined(UIRB_CORE_TIMER_MANAGER)
+    #warning "UIRB_CORE_TIMER_MANAGER is defined. Timer vectors of unreserved timers will be defined by the library."
+#endif  // defined(UIRB_CORE_TIMER_MANAGER)
+
+#if defined(UIRB_CORE_RESERVE_TIMER0)
+    #warning "UIRB_CORE_RESERVE_TIMER0 is defined. Timer0 compare vectors are left to code outside the library."
+#endif  // defined(UIRB_CORE_RESERVE_TIMER0)
+
+#if defined(UIRB_CORE_RESERVE_TIMER1)
+    #warning "UIRB_CORE_RESERVE_TIMER1 is defined. Timer1 is left to code outside the library."
+#endif  // defined(UIRB_CORE_RESERVE_TIMER1)
+
+#if defined(UIRB_CORE_RESERVE_TIMER2)
+    #warning "UIRB_CORE_RESERVE_TIMER2 is defined. Timer2 is left to code outside the library."
+#endif  // defined(UIRB_CORE_RESERVE_TIMER2)
+
+/**
+ * @def UIRB_CORE_TIMER1_SHARED_PRESCALER
+ * @brief Prescaler of the free-running Timer1 shared by library features, derived from their configuration.
+ * 
+ * Features counting on the free-running Timer1 must agree on its prescaler. Each of them checks this macro and 
+ * fails to build on a mismatch, instead of reconfiguring the counter under the others at run time.
+ */
+#if defined(UIRB_CORE_PROFILER)
+    #if defined(UIRB_CORE_RESERVE_TIMER1)
+        #error "UIRB_CORE_PROFILER needs Timer1, which is reserved by UIRB_CORE_RESERVE_TIMER1."
+    #endif  // defined(UIRB_CORE_RESERVE_TIMER1)
+    #define UIRB_CORE_TIMER1_SHARED_PRESCALER UIRB_CORE_PROFILER_PRESCALER
+#endif  // defined(UIRB_CORE_PROFILER)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_TIMER_WHEEL
+     * @brief Macro enabling the hierarchical software timer wheel.
+     * 
+     * When this macro is defined, @ref uirbcore::TimerWheel runs any number of @ref uirbcore::SoftTimer timeouts 
+     * from the Timer1 compare A channel and @ref uirbcore::UIRB::powerDown() sleeps at most until the next expiry. 
+     * Requires @ref UIRB_CORE_TIMER_MANAGER. Timer1 runs free with @ref UIRB_CORE_TIMER1_SHARED_PRESCALER, 
+     * which is 64 unless set by @ref UIRB_CORE_PROFILER_PRESCALER.
+     * 
+     * @see @ref UIRB_CORE_TIMER_WHEEL_LEVELS
+     */
+    #define UIRB_CORE_TIMER_WHEEL
+    #undef UIRB_CORE_TIMER_WHEEL
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_TIMER_WHEEL_LEVELS
+ * @brief Macro defining the number of 16 slot levels of @ref uirbcore::TimerWheel.
+ * 
+ * Level `n` covers delays up to `16^(n+1)` ms, longer timers are moved down the levels several times. Each level 
+ * takes 34 bytes of RAM. Valid range is from 2 to 6. By default, 4 levels cover delays up to 65 seconds.
+ * 
+ * @note Only used when @ref UIRB_CORE_TIMER_WHEEL is defined.
+ */
+#if !defined(UIRB_CORE_TIMER_WHEEL_LEVELS)
+    #define UIRB_CORE_TIMER_WHEEL_LEVELS 4
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_TIMER_WHEEL_LEVELS.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_TIMER_WHEEL_LEVELS
+#endif  // !defined(UIRB_CORE_TIMER_WHEEL_LEVELS)
+
+// Check if UIRB_CORE_TIMER_WHEEL_LEVELS is a number
+#if (UIRB_CORE_TIMER_WHEEL_LEVELS + 0) != UIRB_CORE_TIMER_WHEEL_LEVELS
+    #error "UIRB_CORE_TIMER_WHEEL_LEVELS must be a numeric constant."
+#endif  // (UIRB_CORE_TIMER_WHEEL_LEVELS + 0) != UIRB_CORE_TIMER_WHEEL_LEVELS
+
+#if UIRB_CORE_TIMER_WHEEL_LEVELS < 2 || UIRB_CORE_TIMER_WHEEL_LEVELS > 6
+    #error "Invalid value for `UIRB_CORE_TIMER_WHEEL_LEVELS`. Valid range is [2-6]."
+#endif  // UIRB_CORE_TIMER_WHEEL_LEVELS < 2 || UIRB_CORE_TIMER_WHEEL_LEVELS > 6
+
+#if !defined(NO_WARN_UIRB_CORE_TIMER_WHEEL_LEVELS)
+    #warning "UIRB_CORE_TIMER_WHEEL_LEVELS is defined with value: " XSTR(UIRB_CORE_TIMER_WHEEL_LEVELS)
+#else
+    #undef NO_WARN_UIRB_CORE_TIMER_WHEEL_LEVELS
+#endif  // !defined(NO_WARN_UIRB_CORE_TIMER_WHEEL_LEVELS)
+
+#if defined(UIRB_CORE_TIMER_WHEEL)
+    #if !defined(UIRB_CORE_TIMER_MANAGER)
+        #error "UIRB_CORE_TIMER_WHEEL requires UIRB_CORE_TIMER_MANAGER to be defined."
+    #endif  // !defined(UIRB_CORE_TIMER_MANAGER)
+    #if defined(UIRB_CORE_RESERVE_TIMER1)
+        #error "UIRB_CORE_TIMER_WHEEL needs Timer1, which is reserved by UIRB_CORE_RESERVE_TIMER1."
+    #endif  // defined(UIRB_CORE_RESERVE_TIMER1)
+    #if !defined(UIRB_CORE_TIMER1_SHARED_PRESCALER)
+        #define UIRB_CORE_TIMER1_SHARED_PRESCALER 64
+    #endif  // !defined(UIRB_CORE_TIMER1_SHARED_PRESCALER)
+    #warning "UIRB_CORE_TIMER_WHEEL is defined. Timer1 compare A will drive the software timers."
+#endif  // defined(UIRB_CORE_TIMER_WHEEL)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_DEFERRED_WORK
+     * @brief Macro enabling the deferred work queue.
+     * 
+     * When this macro is defined, interrupts can hand work to @ref uirbcore::DeferredQueue, which runs it from 
+     * `loop()` and around sleep in @ref uirbcore::UIRB::powerDown(), and the wakeup callbacks are run through the queue. 
+     * Latencies from scheduling to handling are measured per @ref uirbcore::DeferredWork item.
+     */
+    #define UIRB_CORE_DEFERRED_WORK
+    #undef UIRB_CORE_DEFERRED_WORK
+#endif  // defined(__DOXYGEN__)
+
+#if defined(UIRB_CORE_DEFERRED_WORK)
+    #warning "UIRB_CORE_DEFERRED_WORK is defined. Wakeup callbacks will run from the deferred work queue."
+#endif  // defined(UIRB_CORE_DEFERRED_WORK)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_IRQ_PRIORITY
+     * @brief Macro enabling the two level interrupt priority scheme which protects the IR timing.
+     * 
+     * When this macro is defined, timer handlers attached as @ref uirbcore::InterruptPriority::PREEMPTIBLE, the 
+     * @ref uirbcore::TimerWheel callbacks, the button, pin change and non-supervisor watchdog interrupts run with interrupts 
+     * enabled, and the Arduino Timer0 tick can be suspended with @ref uirbcore::TimerManager::suspendTimer0Tick(). 
+     * Requires @ref UIRB_CORE_TIMER_MANAGER.
+     */
+    #define UIRB_CORE_IRQ_PRIORITY
+    #undef UIRB_CORE_IRQ_PRIORITY
+#endif  // defined(__DOXYGEN__)
+
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+    #if !defined(UIRB_CORE_TIMER_MANAGER)
+        #error "UIRB_CORE_IRQ_PRIORITY requires UIRB_CORE_TIMER_MANAGER to be defined."
+    #endif  // !defined(UIRB_CORE_TIMER_MANAGER)
+    #warning "UIRB_CORE_IRQ_PRIORITY is defined. Housekeeping interrupts will run with interrupts enabled."
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_STATIC_WAKEUP_VECTORS
+     * @brief Macro making the library own the `INT0_vect` interrupt of the wakeup button.
+     * 
+     * When this macro is defined, the library defines `INT0_vect` calling the button handler directly, instead of 
+     * going through `attachInterrupt()` of the Arduino core, and the edge of `INT0` and the pin change mask of 
+     * @ref PIN_USB_IO3 are configured once in the constructor of @ref uirbcore::UIRB. 
+     * @ref uirbcore::UIRB::powerDown() then only unmasks the wakeup interrupts while sleeping. 
+     * Application code must not call `attachInterrupt()` at all, for any pin: the Arduino core defines `INT0_vect` and 
+     * `INT1_vect` in the same object (`WInterrupts.c`), so any use of it fails to link with a duplicate `INT0_vect`.
+     */
+    #define UIRB_CORE_STATIC_WAKEUP_VECTORS
+    #undef UIRB_CORE_STATIC_WAKEUP_VECTORS
+#endif  // defined(__DOXYGEN__)
+
+#if defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
+    #if defined(AVR_DEBUG)
+        #error "UIRB_CORE_STATIC_WAKEUP_VECTORS cannot be used with AVR_DEBUG, the debugger owns INT0."
+    #endif  // defined(AVR_DEBUG)
+    #warning "UIRB_CORE_STATIC_WAKEUP_VECTORS is defined. The library will define INT0_vect."
+#endif  // defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_PCINT_DISPATCHER
+     * @brief Macro enabling the shared pin change interrupt dispatcher.
+     * 
+     * When this macro is defined, the library defines the `PCINT0_vect`, `PCINT1_vect` and `PCINT2_vect` vectors 
+     * and calls the per-pin handlers registered with @ref uirbcore::PinChangeDispatcher. The wakeup from 
+     * @ref PIN_USB_IO3 is registered as one of them while sleeping.
+     */
+    #define UIRB_CORE_PCINT_DISPATCHER
+    #undef UIRB_CORE_PCINT_DISPATCHER
+
+    /**
+     * @def UIRB_CORE_NO_PCINT_VECTORS
+     * @brief Macro leaving all pin change interrupt vectors to code outside the library.
+     * 
+     * When this macro is defined, the library does not define `PCINT2_vect`, so libraries defining the pin change 
+     * vectors themselves, such as SoftwareSerial, can be linked. The wakeup from @ref PIN_USB_IO3 is not available 
+     * and @ref uirbcore::UIRB::isWakeupFromIO3Allowed() returns `false`.
+     */
+    #define UIRB_CORE_NO_PCINT_VECTORS
+    #undef UIRB_CORE_NO_PCINT_VECTORS
+#endif  // defined(__DOXYGEN__)
+
+#if defined(UIRB_CORE_PCINT_DISPATCHER)
+    #if defined(UIRB_CORE_NO_PCINT_VECTORS)
+        #error "UIRB_CORE_PCINT_DISPATCHER and UIRB_CORE_NO_PCINT_VECTORS cannot be defined together."
+    #endif  // defined(UIRB_CORE_NO_PCINT_VECTORS)
+    #warning "UIRB_CORE_PCINT_DISPATCHER is defined. The library will define and dispatch all pin change vectors."
+#endif  // defined(UIRB_CORE_PCINT_DISPATCHER)
+
+#if defined(UIRB_CORE_NO_PCINT_VECTORS)
+    #warning "UIRB_CORE_NO_PCINT_VECTORS is defined. Wakeup from USB IO3 will not be available."
+#endif  // defined(UIRB_CORE_NO_PCINT_VECTORS)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_IR_TX_GATE
+     * @brief Macro enabling the coordination of ADC measurements with IR transmission.
+     * 
+     * When this macro is defined, the library no longer forces @ref PIN_IR_LED low before measuring. The IR sender 
+     * brackets each frame with @ref uirbcore::IRTransmitGate::beginFrame() and 
+     * @ref uirbcore::IRTransmitGate::endFrame(), and the supply and @ref PIN_PROG conversions only start in the gaps 
+     * between frames, @ref UIRB_CORE_IR_TX_SETTLE_MICROSECONDS after the last frame ended. A conversion overlapped by 
+     * a new frame is discarded and taken again in the next gap, so a transmission never waits for the ADC.
+     * 
+     * @see @ref UIRB_CORE_IR_TX_SETTLE_MICROSECONDS
+     */
+    #define UIRB_CORE_IR_TX_GATE
+    #undef UIRB_CORE_IR_TX_GATE
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_IR_TX_SETTLE_MICROSECONDS
+ * @brief Macro defining the time after an IR frame before the supply is measured again, in microseconds.
+ * 
+ * The IR LED draws pulses of around 100 mA from the battery, and the supply recovers from the sag after the 
+ * last mark. Valid range is [0-65535]. By default, 2000 us.
+ * 
+ * @note Only used when @ref UIRB_CORE_IR_TX_GATE is defined.
+ */
+#if !defined(UIRB_CORE_IR_TX_SETTLE_MICROSECONDS)
+    #define UIRB_CORE_IR_TX_SETTLE_MICROSECONDS 2000
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_IR_TX_SETTLE_MICROSECONDS.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_IR_TX_SETTLE_MICROSECONDS
+#endif  // !defined(UIRB_CORE_IR_TX_SETTLE_MICROSECONDS)
+
+// Check if UIRB_CORE_IR_TX_SETTLE_MICROSECONDS is a number
+#if (UIRB_CORE_IR_TX_SETTLE_MICROSECONDS + 0) != UIRB_CORE_IR_TX_SETTLE_MICROSECONDS
+    #error "UIRB_CORE_IR_TX_SETTLE_MICROSECONDS must be a numeric constant."
+#endif  // (UIRB_CORE_IR_TX_SETTLE_MICROSECONDS + 0) != UIRB_CORE_IR_TX_SETTLE_MICROSECONDS
+
+#if UIRB_CORE_IR_TX_SETTLE_MICROSECONDS < 0 || UIRB_CORE_IR_TX_SETTLE_MICROSECONDS > 65535
+    #error "Invalid value for `UIRB_CORE_IR_TX_SETTLE_MICROSECONDS`. Valid range is [0-65535]."
+#endif  // UIRB_CORE_IR_TX_SETTLE_MICROSECONDS < 0 || UIRB_CORE_IR_TX_SETTLE_MICROSECONDS > 65535
+
+#if !defined(NO_WARN_UIRB_CORE_IR_TX_SETTLE_MICROSECONDS)
+    #warning "UIRB_CORE_IR_TX_SETTLE_MICROSECONDS is defined with value: " XSTR(UIRB_CORE_IR_TX_SETTLE_MICROSECONDS)
+#else
+    #undef NO_WARN_UIRB_CORE_IR_TX_SETTLE_MICROSECONDS
+#endif  // !defined(NO_WARN_UIRB_CORE_IR_TX_SETTLE_MICROSECONDS)
+
+#if defined(UIRB_CORE_IR_TX_GATE)
+    #warning "UIRB_CORE_IR_TX_GATE is defined. ADC measurements will wait for the gaps between IR frames."
+#endif  // defined(UIRB_CORE_IR_TX_GATE)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_ADC_CALIBRATION
+     * @brief Macro enabling the ADC offset and gain correction of @ref uirbcore::AdcCalibration.
+     * 
+     * When this macro is defined, the ADC offset is measured on the GND channel against the reference of the 
+     * reading and again every @ref UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS. Together with a two-point gain correction 
+     * stored in EEPROM for each reference, it is applied in fixed point to the raw reading of 
+     * @ref uirbcore::UIRB::getProgVoltageMilivolts(). The bandgap reading of 
+     * @ref uirbcore::UIRB::getSupplyVoltageMilivolts() is left to the stored bandgap reference voltage.
+     * 
+     * @see @ref UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS
+     */
+    #define UIRB_CORE_ADC_CALIBRATION
+    #undef UIRB_CORE_ADC_CALIBRATION
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS
+ * @brief Macro defining the age in seconds after which the ADC offset is measured again before a reading.
+ * 
+ * The age is counted with `millis()`, which stops in power-down. Valid range is [1-65535]. By default, 600 seconds.
+ * 
+ * @note Only used when @ref UIRB_CORE_ADC_CALIBRATION is defined.
+ */
+#if !defined(UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS)
+    #define UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS 600
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS
+#endif  // !defined(UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS)
+
+// Check if UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS is a number
+#if (UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS + 0) != UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS
+    #error "UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS must be a numeric constant."
+#endif  // (UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS + 0) != UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS
+
+#if UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS < 1 || UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS > 65535
+    #error "Invalid value for `UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS`. Valid range is [1-65535]."
+#endif  // UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS < 1 || UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS > 65535
+
+#if !defined(NO_WARN_UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS)
+    #warning "UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS is defined with value: " XSTR(UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS)
+#else
+    #undef NO_WARN_UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS
+#endif  // !defined(NO_WARN_UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS)
+
+#if defined(UIRB_CORE_ADC_CALIBRATION)
+    #warning "UIRB_CORE_ADC_CALIBRATION is defined. PROG readings will be corrected for ADC offset and gain."
+#endif  // defined(UIRB_CORE_ADC_CALIBRATION)
+/** @} */ // End of Peripherals
+
+/**
+ * @name Storage
+ * @{
+ */
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_SPI_FLASH
+     * @brief Macro enabling the SPI NOR flash backend for IR code libraries.
+     * 
+     * When this macro is defined, @ref uirbcore::JedecSPIFlash, @ref uirbcore::SimulatedSPIFlash and 
+     * @ref uirbcore::IRCodeStore are compiled. The JEDEC driver depends on the Arduino `SPI` library.
+     * 
+     * @see @ref UIRB_CORE_SPI_FLASH_CACHE_SIZE
+     * @see @ref UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES
+     */
+    #define UIRB_CORE_SPI_FLASH
+    #undef UIRB_CORE_SPI_FLASH
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_SPI_FLASH_CACHE_SIZE
+ * @brief Macro defining the size of the @ref uirbcore::IRCodeStore read cache line in bytes.
+ * 
+ * The cache holds one aligned line of flash used for index and header reads. Each store instance 
+ * takes this many bytes of RAM. The value must be a power of two between 8 and 256. By default, the line is 32 bytes.
+ * 
+ * @note Only used when @ref UIRB_CORE_SPI_FLASH is defined.
+ */
+#if !defined(UIRB_CORE_SPI_FLASH_CACHE_SIZE)
+    #define UIRB_CORE_SPI_FLASH_CACHE_SIZE 32
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_SPI_FLASH_CACHE_SIZE.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_SPI_FLASH_CACHE_SIZE
+#endif  // !defined(UIRB_CORE_SPI_FLASH_CACHE_SIZE)
+
+// Check if UIRB_CORE_SPI_FLASH_CACHE_SIZE is a number
+#if (UIRB_CORE_SPI_FLASH_CACHE_SIZE + 0) != UIRB_CORE_SPI_FLASH_CACHE_SIZE
+    #error "UIRB_CORE_SPI_FLASH_CACHE_SIZE must be a numeric constant."
+#endif  // (UIRB_CORE_SPI_FLASH_CACHE_SIZE + 0) != UIRB_CORE_SPI_FLASH_CACHE_SIZE
+
+#if UIRB_CORE_SPI_FLASH_CACHE_SIZE < 8 || UIRB_CORE_SPI_FLASH_CACHE_SIZE > 256 || (UIRB_CORE_SPI_FLASH_CACHE_SIZE & (UIRB_CORE_SPI_FLASH_CACHE_SIZE - 1)) != 0
+    #error "Invalid value for `UIRB_CORE_SPI_FLASH_CACHE_SIZE`. Valid values are powers of two between 8 and 256."
+#endif  // UIRB_CORE_SPI_FLASH_CACHE_SIZE is not a power of two between 8 and 256
+
+#if !defined(NO_WARN_UIRB_CORE_SPI_FLASH_CACHE_SIZE)
+    #warning "UIRB_CORE_SPI_FLASH_CACHE_SIZE is defined with value: " XSTR(UIRB_CORE_SPI_FLASH_CACHE_SIZE)
+#else
+    #undef NO_WARN_UIRB_CORE_SPI_FLASH_CACHE_SIZE
+#endif  // !defined(NO_WARN_UIRB_CORE_SPI_FLASH_CACHE_SIZE)
+
+/**
+ * @def UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES
+ * @brief Macro defining the number of journal entries per @ref uirbcore::IRCodeStore index copy.
+ * 
+ * Index updates are appended to the journal and merged into the sorted table once it is full. More entries 
+ * mean fewer index erases but a longer lookup, and the merge buffers all of them on the stack (8 bytes each). 
+ * The value must be between 4 and 32. By default, the journal has 8 entries.
+ * 
+ * @note Only used when @ref UIRB_CORE_SPI_FLASH is defined.
+ */
+#if !defined(UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES)
+    #define UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES 8
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES
+#endif  // !defined(UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES)
+
+// Check if UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES is a number
+#if (UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES + 0) != UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES
+    #error "UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES must be a numeric constant."
+#endif  // (UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES + 0) != UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES
+
+#if UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES < 4 || UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES > 32
+    #error "Invalid value for `UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES`. Valid range is [4-32]."
+#endif  // UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES < 4 || UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES > 32
+
+#if !defined(NO_WARN_UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES)
+    #warning "UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES is defined with value: " XSTR(UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES)
+#else
+    #undef NO_WARN_UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES
+#endif  // !defined(NO_WARN_UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES)
+
+#if defined(UIRB_CORE_SPI_FLASH)
+    #warning "UIRB_CORE_SPI_FLASH is defined. The SPI flash IR code store will be compiled."
+#endif  // defined(UIRB_CORE_SPI_FLASH)
+/** @} */ // End of Storage
+
+/**
+ * @name Battery health
+ * @{
+ */
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_BATTERY_ESR
+     * @brief Macro enabling the battery internal resistance (ESR) estimator of @ref uirbcore::BatteryHealth.
+     * 
+     * When this macro is defined, @ref uirbcore::BatteryHealth::measureEsr() measures AVcc through the bandgap 
+     * path with and without the IR LED load of @ref UIRB_CORE_IR_LED_LOAD_MILLIAMPS and derives the resistance from 
+     * the sag. The filtered estimate is kept in an EEPROM ring log after the watchdog reset log.
+     * 
+     * @warning Cannot be used with `AVR_DEBUG`, the debugger owns @ref PIN_IR_LED.
+     * @see @ref UIRB_CORE_IR_LED_LOAD_MILLIAMPS
+     */
+    #define UIRB_CORE_BATTERY_ESR
+    #undef UIRB_CORE_BATTERY_ESR
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_IR_LED_LOAD_MILLIAMPS
+ * @brief Macro defining the current drawn from the battery while @ref PIN_IR_LED is driven high, in milliamps.
+ * 
+ * This is the known load of the ESR estimate and depends on the LED driver of the board. Measure it once with 
+ * the LED held on for a short time. Valid range is [10-2000]. By default, 100 mA.
+ * 
+ * @note Only used when @ref UIRB_CORE_BATTERY_ESR is defined.
+ */
+#if !defined(UIRB_CORE_IR_LED_LOAD_MILLIAMPS)
+    #define UIRB_CORE_IR_LED_LOAD_MILLIAMPS 100
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_IR_LED_LOAD_MILLIAMPS.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_IR_LED_LOAD_MILLIAMPS
+#endif  // !defined(UIRB_CORE_IR_LED_LOAD_MILLIAMPS)
+
+// Check if UIRB_CORE_IR_LED_LOAD_MILLIAMPS is a number
+#if (UIRB_CORE_IR_LED_LOAD_MILLIAMPS + 0) != UIRB_CORE_IR_LED_LOAD_MILLIAMPS
+    #error "UIRB_CORE_IR_LED_LOAD_MILLIAMPS must be a numeric constant."
+#endif  // (UIRB_CORE_IR_LED_LOAD_MILLIAMPS + 0) != UIRB_CORE_IR_LED_LOAD_MILLIAMPS
+
+#if UIRB_CORE_IR_LED_LOAD_MILLIAMPS < 10 || UIRB_CORE_IR_LED_LOAD_MILLIAMPS > 2000
+    #error "Invalid value for `UIRB_CORE_IR_LED_LOAD_MILLIAMPS`. Valid range is [10-2000]."
+#endif  // UIRB_CORE_IR_LED_LOAD_MILLIAMPS < 10 || UIRB_CORE_IR_LED_LOAD_MILLIAMPS > 2000
+
+#if !defined(NO_WARN_UIRB_CORE_IR_LED_LOAD_MILLIAMPS)
+    #warning "UIRB_CORE_IR_LED_LOAD_MILLIAMPS is defined with value: " XSTR(UIRB_CORE_IR_LED_LOAD_MILLIAMPS)
+#else
+    #undef NO_WARN_UIRB_CORE_IR_LED_LOAD_MILLIAMPS
+#endif  // !defined(NO_WARN_UIRB_CORE_IR_LED_LOAD_MILLIAMPS)
+
+#if defined(UIRB_CORE_BATTERY_ESR)
+    #if defined(AVR_DEBUG)
+        #error "UIRB_CORE_BATTERY_ESR cannot be used with AVR_DEBUG, the debugger owns PIN_IR_LED."
+    #endif  // defined(AVR_DEBUG)
+
+    #warning "UIRB_CORE_BATTERY_ESR is defined. The battery ESR history will be kept in EEPROM."
+#endif  // defined(UIRB_CORE_BATTERY_ESR)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_BATTERY_CYCLES
+     * @brief Macro enabling the charge cycle counting and capacity learning of @ref uirbcore::BatteryHealth.
+     * 
+     * When this macro is defined, every valid @ref uirbcore::PowerInfoData::update() integrates the charging 
+     * current. The charge delivered over the life of the battery gives the equivalent full cycles, and the charge 
+     * delivered from `BatteryState::EMPTY` to `BatteryState::FULLY_CHARGED` gives the learned capacity. Both are 
+     * kept in an EEPROM ring log after the battery ESR history, written once per charge.
+     * 
+     * @see @ref UIRB_CORE_BATTERY_CAPACITY_MAH
+     */
+    #define UIRB_CORE_BATTERY_CYCLES
+    #undef UIRB_CORE_BATTERY_CYCLES
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_BATTERY_CAPACITY_MAH
+ * @brief Macro defining the rated capacity of the battery in milliamp hours.
+ * 
+ * One equivalent full cycle is this much charge delivered to the battery, and the learned capacity is reported 
+ * in percent of it. Valid range is [50-10000]. By default, 1000 mAh.
+ * 
+ * @note Only used when @ref UIRB_CORE_BATTERY_CYCLES is defined.
+ */
+#if !defined(UIRB_CORE_BATTERY_CAPACITY_MAH)
+    #define UIRB_CORE_BATTERY_CAPACITY_MAH 1000
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_BATTERY_CAPACITY_MAH.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_BATTERY_CAPACITY_MAH
+#endif  // !defined(UIRB_CORE_BATTERY_CAPACITY_MAH)
+
+// Check if UIRB_CORE_BATTERY_CAPACITY_MAH is a number
+#if (UIRB_CORE_BATTERY_CAPACITY_MAH + 0) != UIRB_CORE_BATTERY_CAPACITY_MAH
+    #error "UIRB_CORE_BATTERY_CAPACITY_MAH must be a numeric constant."
+#endif  // (UIRB_CORE_BATTERY_CAPACITY_MAH + 0) != UIRB_CORE_BATTERY_CAPACITY_MAH
+
+#if UIRB_CORE_BATTERY_CAPACITY_MAH < 50 || UIRB_CORE_BATTERY_CAPACITY_MAH > 10000
+    #error "Invalid value for `UIRB_CORE_BATTERY_CAPACITY_MAH`. Valid range is [50-10000]."
+#endif  // UIRB_CORE_BATTERY_CAPACITY_MAH < 50 || UIRB_CORE_BATTERY_CAPACITY_MAH > 10000
+
+#if !defined(NO_WARN_UIRB_CORE_BATTERY_CAPACITY_MAH)
+    #warning "UIRB_CORE_BATTERY_CAPACITY_MAH is defined with value: " XSTR(UIRB_CORE_BATTERY_CAPACITY_MAH)
+#else
+    #undef NO_WARN_UIRB_CORE_BATTERY_CAPACITY_MAH
+#endif  // !defined(NO_WARN_UIRB_CORE_BATTERY_CAPACITY_MAH)
+
+#if defined(UIRB_CORE_BATTERY_CYCLES)
+    #warning "UIRB_CORE_BATTERY_CYCLES is defined. Charge cycles and the learned capacity will be kept in EEPROM."
+#endif  // defined(UIRB_CORE_BATTERY_CYCLES)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_CHARGE_LOG
+     * @brief Macro enabling the charging session log of @ref uirbcore::ChargeSessionLog.
+     * 
+     * When this macro is defined, the charger state transitions observed by @ref uirbcore::PowerInfoData::update() 
+     * are recorded as sessions, each with its start, duration, peak current and charge, in an EEPROM ring log of 
+     * @ref UIRB_CORE_CHARGE_LOG_SLOTS records after the battery charge cycle log.
+     * 
+     * @see @ref UIRB_CORE_CHARGE_LOG_SLOTS
+     */
+    #define UIRB_CORE_CHARGE_LOG
+    #undef UIRB_CORE_CHARGE_LOG
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_CHARGE_LOG_SLOTS
+ * @brief Macro defining the number of charging sessions kept in EEPROM.
+ * 
+ * Each session takes 19 bytes of EEPROM. Valid range is [1-16]. By default, 8 sessions.
+ * 
+ * @note Only used when @ref UIRB_CORE_CHARGE_LOG is defined.
+ */
+#if !defined(UIRB_CORE_CHARGE_LOG_SLOTS)
+    #define UIRB_CORE_CHARGE_LOG_SLOTS 8
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_CHARGE_LOG_SLOTS.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_CHARGE_LOG_SLOTS
+#endif  // !defined(UIRB_CORE_CHARGE_LOG_SLOTS)
+
+// Check if UIRB_CORE_CHARGE_LOG_SLOTS is a number
+#if (UIRB_CORE_CHARGE_LOG_SLOTS + 0) != UIRB_CORE_CHARGE_LOG_SLOTS
+    #error "UIRB_CORE_CHARGE_LOG_SLOTS must be a numeric constant."
+#endif  // (UIRB_CORE_CHARGE_LOG_SLOTS + 0) != UIRB_CORE_CHARGE_LOG_SLOTS
+
+#if UIRB_CORE_CHARGE_LOG_SLOTS < 1 || UIRB_CORE_CHARGE_LOG_SLOTS > 16
+    #error "Invalid value for `UIRB_CORE_CHARGE_LOG_SLOTS`. Valid range is [1-16]."
+#endif  // UIRB_CORE_CHARGE_LOG_SLOTS < 1 || UIRB_CORE_CHARGE_LOG_SLOTS > 16
+
+#if !defined(NO_WARN_UIRB_CORE_CHARGE_LOG_SLOTS)
+    #warning "UIRB_CORE_CHARGE_LOG_SLOTS is defined with value: " XSTR(UIRB_CORE_CHARGE_LOG_SLOTS)
+#else
+    #undef NO_WARN_UIRB_CORE_CHARGE_LOG_SLOTS
+#endif  // !defined(NO_WARN_UIRB_CORE_CHARGE_LOG_SLOTS)
+
+#if defined(UIRB_CORE_CHARGE_LOG)
+    #warning "UIRB_CORE_CHARGE_LOG is defined. Charging sessions will be logged to EEPROM."
+#endif  // defined(UIRB_CORE_CHARGE_LOG)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_DISCHARGE_PROTECTION
+     * @brief Macro enabling the deep-discharge protection sleep of @ref uirbcore::DischargeProtection.
+     * 
+     * When this macro is defined, @ref uirbcore::DischargeProtection::sleepUntilCharging() keeps an empty battery 
+     * in power-down with the LEDs off, checking the charger once per interval. The interval doubles from 8 seconds 
+     * after every check up to @ref UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS.
+     * 
+     * @see @ref UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS
+     */
+    #define UIRB_CORE_DISCHARGE_PROTECTION
+    #undef UIRB_CORE_DISCHARGE_PROTECTION
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS
+ * @brief Macro defining the longest interval between two charger checks of the deep-discharge protection, in seconds.
+ * 
+ * This is also the longest time until the protection notices that the charger was plugged in, unless 
+ * @ref PIN_USB_IO3 wakes it up earlier. Valid range is [8-65535]. By default, 3600 seconds.
+ * 
+ * @note Only used when @ref UIRB_CORE_DISCHARGE_PROTECTION is defined.
+ */
+#if !defined(UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS)
+    #define UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS 3600
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS
+#endif  // !defined(UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS)
+
+// Check if UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS is a number
+#if (UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS + 0) != UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS
+    #error "UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS must be a numeric constant."
+#endif  // (UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS + 0) != UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS
+
+#if UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS < 8 || UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS > 65535
+    #error "Invalid value for `UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS`. Valid range is [8-65535]."
+#endif  // UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS < 8 || UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS > 65535
+
+#if !defined(NO_WARN_UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS)
+    #warning "UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS is defined with value: " XSTR(UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS)
+#else
+    #undef NO_WARN_UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS
+#endif  // !defined(NO_WARN_UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS)
+
+#if defined(UIRB_CORE_DISCHARGE_PROTECTION)
+    #warning "UIRB_CORE_DISCHARGE_PROTECTION is defined. An empty battery can be kept in protection sleep."
+#endif  // defined(UIRB_CORE_DISCHARGE_PROTECTION)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_POWER_MONITOR
+     * @brief Macro enabling the adaptive power monitor of @ref uirbcore::PowerMonitor.
+     * 
+     * When this macro is defined, @ref uirbcore::PowerMonitor updates the power information from a 
+     * @ref uirbcore::SoftTimer whose period shrinks to @ref UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS around charger 
+     * and battery state changes and grows up to @ref UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS while the readings 
+     * are flat. Requires @ref UIRB_CORE_TIMER_WHEEL.
+     * 
+     * @see @ref UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS
+     * @see @ref UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS
+     */
+    #define UIRB_CORE_POWER_MONITOR
+    #undef UIRB_CORE_POWER_MONITOR
+#endif  // defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS
+ * @brief Macro defining the shortest period between two updates of the adaptive power monitor, in milliseconds.
+ * 
+ * Used right after a charger or battery state change. Valid range is [100-60000]. By default, 1000 milliseconds.
+ * 
+ * @note Only used when @ref UIRB_CORE_POWER_MONITOR is defined.
+ */
+#if !defined(UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS)
+    #define UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS 1000
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS
+#endif  // !defined(UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS)
+
+// Check if UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS is a number
+#if (UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS + 0) != UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS
+    #error "UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS must be a numeric constant."
+#endif  // (UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS + 0) != UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS
+
+#if UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS < 100 || UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS > 60000
+    #error "Invalid value for `UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS`. Valid range is [100-60000]."
+#endif  // UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS < 100 || UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS > 60000
+
+#if !defined(NO_WARN_UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS)
+    #warning "UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS is defined with value: " XSTR(UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS)
+#else
+    #undef NO_WARN_UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS
+#endif  // !defined(NO_WARN_UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS)
+
+/**
+ * @def UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS
+ * @brief Macro defining the longest period between two updates of the adaptive power monitor, in seconds.
+ * 
+ * Reached after several updates without a significant change. It bounds the time until a charger connected 
+ * without any other wakeup is noticed. Must not be shorter than @ref UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS. 
+ * Valid range is [1-65535]. By default, 600 seconds.
+ * 
+ * @note Only used when @ref UIRB_CORE_POWER_MONITOR is defined.
+ */
+#if !defined(UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS)
+    #define UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS 600
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS
+#endif  // !defined(UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS)
+
+// Check if UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS is a number
+#if (UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS + 0) != UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS
+    #error "UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS must be a numeric constant."
+#endif  // (UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS + 0) != UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS
+
+#if UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS < 1 || UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS > 65535
+    #error "Invalid value for `UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS`. Valid range is [1-65535]."
+#endif  // UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS < 1 || UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS > 65535
+
+#if (UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS * 1000UL) < UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS
+    #error "UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS must not be shorter than UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS."
+#endif  // (UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS * 1000UL) < UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS
+
+#if !defined(NO_WARN_UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS)
+    #warning "UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS is defined with value: " XSTR(UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS)
+#else
+    #undef NO_WARN_UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS
+#endif  // !defined(NO_WARN_UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS)
+
+#if defined(UIRB_CORE_POWER_MONITOR)
+    #if !defined(UIRB_CORE_TIMER_WHEEL)
+        #error "UIRB_CORE_POWER_MONITOR requires UIRB_CORE_TIMER_WHEEL to be defined."
+    #endif  // !defined(UIRB_CORE_TIMER_WHEEL)
+    #warning "UIRB_CORE_POWER_MONITOR is defined. Power information will be updated at an adaptive rate."
+#endif  // defined(UIRB_CORE_POWER_MONITOR)
+/** @} */ // End of Battery health
+
+/**
+ * @name Memory budget
+ * @{
+ */
+
+/**
+ * @def UIRB_CORE_STACK_RESERVE
+ * @brief Macro defining the SRAM in bytes kept free for the stack by @ref uirbcore::MemoryPlan.
+ * 
+ * The library buffers plus this reserve and @ref UIRB_CORE_APPLICATION_SRAM must fit into the 2 KB of SRAM, 
+ * otherwise the build fails. Measure the real stack depth with @ref uirbcore::StackMonitor or 
+ * `scripts/stack_report.py` before lowering it. Valid range is [64-1536]. By default, 256 bytes are reserved.
+ */
+#if !defined(UIRB_CORE_STACK_RESERVE)
+    #define UIRB_CORE_STACK_RESERVE 256
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_STACK_RESERVE.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_STACK_RESERVE
+#endif  // !defined(UIRB_CORE_STACK_RESERVE)
+
+// Check if UIRB_CORE_STACK_RESERVE is a number
+#if (UIRB_CORE_STACK_RESERVE + 0) != UIRB_CORE_STACK_RESERVE
+    #error "UIRB_CORE_STACK_RESERVE must be a numeric constant."
+#endif  // (UIRB_CORE_STACK_RESERVE + 0) != UIRB_CORE_STACK_RESERVE
+
+#if UIRB_CORE_STACK_RESERVE < 64 || UIRB_CORE_STACK_RESERVE > 1536
+    #error "Invalid value for `UIRB_CORE_STACK_RESERVE`. Valid range is [64-1536]."
+#endif  // UIRB_CORE_STACK_RESERVE < 64 || UIRB_CORE_STACK_RESERVE > 1536
+
+#if !defined(NO_WARN_UIRB_CORE_STACK_RESERVE)
+    #warning "UIRB_CORE_STACK_RESERVE is defined with value: " XSTR(UIRB_CORE_STACK_RESERVE)
+#else
+    #undef NO_WARN_UIRB_CORE_STACK_RESERVE
+#endif  // !defined(NO_WARN_UIRB_CORE_STACK_RESERVE)
+
+/**
+ * @def UIRB_CORE_APPLICATION_SRAM
+ * @brief Macro defining the SRAM in bytes of the application's own global variables and heap.
+ * 
+ * Counted by @ref uirbcore::MemoryPlan on top of the library buffers and @ref UIRB_CORE_STACK_RESERVE, so a 
+ * product variant fails to build instead of running out of RAM. Valid range is [0-1536]. By default, 0.
+ */
+#if !defined(UIRB_CORE_APPLICATION_SRAM)
+    #define UIRB_CORE_APPLICATION_SRAM 0
+
+    /**
+     * @brief Used to suppress the warning message for @ref UIRB_CORE_APPLICATION_SRAM.
+     * 
+     */
+    #define NO_WARN_UIRB_CORE_APPLICATION_SRAM
+#endif  // !defined(UIRB_CORE_APPLICATION_SRAM)
+
+// Check if UIRB_CORE_APPLICATION_SRAM is a number
+#if (UIRB_CORE_APPLICATION_SRAM + 0) != UIRB_CORE_APPLICATION_SRAM
+    #error "UIRB_CORE_APPLICATION_SRAM must be a numeric constant."
+#endif  // (UIRB_CORE_APPLICATION_SRAM + 0) != UIRB_CORE_APPLICATION_SRAM
+
+#if UIRB_CORE_APPLICATION_SRAM < 0 || UIRB_CORE_APPLICATION_SRAM > 1536
+    #error "Invalid value for `UIRB_CORE_APPLICATION_SRAM`. Valid range is [0-1536]."
+#endif  // UIRB_CORE_APPLICATION_SRAM < 0 || UIRB_CORE_APPLICATION_SRAM > 1536
+
+#if !defined(NO_WARN_UIRB_CORE_APPLICATION_SRAM)
+    #warning "UIRB_CORE_APPLICATION_SRAM is defined with value: " XSTR(UIRB_CORE_APPLICATION_SRAM)
+#else
+    #undef NO_WARN_UIRB_CORE_APPLICATION_SRAM
+#endif  // !defined(NO_WARN_UIRB_CORE_APPLICATION_SRAM)
+
+#if defined(__DOXYGEN__)
+    /**
+     * @def UIRB_CORE_SRAM_REPORT
+     * @brief Macro printing the SRAM breakdown of @ref uirbcore::MemoryPlan while the library is compiled.
+     * 
+     * When this macro is defined, `MemoryPlan.cpp` emits one compiler warning per buffer with its size in bytes, 
+     * followed by the total, the reserves and the remaining SRAM. Nothing is added to the program.
+     */
+    #define UIRB_CORE_SRAM_REPORT
+    #undef UIRB_CORE_SRAM_REPORT
+#endif  // defined(__DOXYGEN__)
+/** @} */ // End of Memory budget
+
 #endif  // UIRBcore_Defs_h
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+ * @file UIRBcore_DischargeProtection.hpp
+ * @brief Deep-discharge protection sleep of the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::DischargeProtection class. Waking up every few seconds to signal and
+ * check an empty battery drains it below the point of damage. The protection sleep instead keeps the board in
+ * power-down until the charger is connected:
+ * - The IR LED is switched off, including the Timer2 carrier output on @ref PIN_IR_LED, and the status LED is
+ *   driven low if it is an output.
+ * - The board sleeps with @ref uirbcore::UIRB::powerDown(), chaining 8 second watchdog intervals. Only the end of
+ *   each check interval runs a single sample update of @ref uirbcore::PowerInfoData, without the low battery
+ *   pattern. A @ref uirbcore::UIRB::powerDown() ended early by a @ref uirbcore::TimerWheel timer is called again
+ *   for the rest of the interval, measured with @ref uirbcore::UIRB::getUptimeMilliseconds().
+ * - The check interval starts at 8 seconds and doubles after every check which followed a full interval, up to
+ *   @ref UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS.
+ * - A change on @ref PIN_USB_IO3, such as a USB host being connected, triggers a check right away and keeps the
+ *   interval.
+ * - The sleep ends once the charger state is `ChargerState::CHARGING_CC`, `ChargerState::CHARGING_CV` or
+ *   `ChargerState::FLOATING`. The LEDs and Timer2 are restored.
+ *
+ * @note Only compiled when @ref UIRB_CORE_DISCHARGE_PROTECTION is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_DischargeProtection_hpp
+#define UIRBcore_DischargeProtection_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+
+namespace uirbcore
+{
+    class UIRB;
+
+#if defined(UIRB_CORE_DISCHARGE_PROTECTION) || defined(__DOXYGEN__)
+    /**
+     * @brief Static deep-discharge protection sleep.
+     *
+     * Example usage, instead of blinking and re-checking an empty battery:
+     * @code
+     * if (uirb.getPowerInfo(5, false).isBatteryLow())
+     * {
+     *     flash.sleep(); // Other devices powered from the battery
+     *     DischargeProtection::sleepUntilCharging(uirb);
+     * }
+     * @endcode
+     *
+     * @note Put other devices powered from the battery into their lowest power mode before, the protection only
+     * knows the pins of the board.
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class DischargeProtection
+    {
+        public:
+            /**
+             * @brief First interval between two charger checks in milliseconds, the longest watchdog interval.
+             */
+            static constexpr uint32_t FIRST_CHECK_INTERVAL_MILLISECONDS = 8000UL;
+
+            /**
+             * @brief Sleeps until the charger state shows that power is back.
+             *
+             * @param[in,out] uirb Core instance, used to sleep and to sample the power information.
+             * @return bool
+             * @retval true The charger is connected.
+             * @retval false Sleeping is not allowed (@ref UIRB::isSleepingAllowed()), returned right away.
+             *
+             * @note The IO3 wakeup flag (@ref UIRB::getIO3WakeupISRFlag()) is used to tell a @ref PIN_USB_IO3 wakeup
+             *       from a software timer. It is set on return if it was set before or @ref PIN_USB_IO3 woke the board.
+             */
+            static bool sleepUntilCharging(UIRB& uirb);
+
+            /**
+             * @brief Returns the number of charger checks of the last protection sleep.
+             *
+             * @return uint16_t Number of checks, saturating.
+             */
+            static uint16_t getLastCheckCount();
+
+            /**
+             * @brief Returns the time spent in the last protection sleep.
+             *
+             * @return uint32_t Time in seconds, measured with @ref UIRB::getUptimeMilliseconds(). The part of an
+             *         interval cut short by @ref PIN_USB_IO3 is not counted, the watchdog cannot tell it.
+             */
+            static uint32_t getLastSleepSeconds();
+    };
+#endif  // defined(UIRB_CORE_DISCHARGE_PROTECTION) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_DischargeProtection_hpp
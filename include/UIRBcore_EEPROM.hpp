@@ -53,6 +53,7 @@
 
 #include <Arduino.h>
 #include <UIRBcore_Defs.h>
+#include <UIRBcore_Coroutine.hpp>
 
 #if defined(UIRB_EEPROM_DATA_ADDR_START)
     #error "UIRB_EEPROM_DATA_ADDR_START is fixed to 0x00"
@@ -70,6 +71,96 @@
  */
 #define UIRB_EEPROM_DATA_ADDR_START (0x00U)
 
+/**
+ * @brief Number of EEPROM bytes reserved for @ref uirbcore::eeprom::EEPROMData.
+ * 
+ * The core data block currently occupies fewer bytes than reserved. The remainder is kept free so the 
+ * structure can grow without relocating the auxiliary EEPROM regions placed after it.
+ * 
+ * @note A `static_assert` guards that `sizeof(EEPROMData)` never exceeds this reservation.
+ */
+#define UIRB_EEPROM_DATA_RESERVED_SIZE (0x40U)
+
+/**
+ * @brief The starting address in EEPROM of the watchdog reset log.
+ * 
+ * The reset log is a @ref uirbcore::eeprom::EEPROMRingLog holding 
+ * @ref UIRB_CORE_WDT_RESET_LOG_SLOTS entries of @ref uirbcore::ResetRecord. It is placed directly 
+ * after the region reserved for @ref uirbcore::eeprom::EEPROMData.
+ * 
+ * @see @ref uirbcore::WatchdogSupervisor for the producer of the log entries.
+ */
+#define UIRB_EEPROM_RESET_LOG_ADDR_START (UIRB_EEPROM_DATA_ADDR_START + UIRB_EEPROM_DATA_RESERVED_SIZE)
+
+/**
+ * @brief Number of EEPROM bytes of the watchdog reset log, 10 bytes per record.
+ * 
+ * The region is reserved whether or not @ref UIRB_CORE_WDT_SUPERVISOR is defined, so the regions after it 
+ * keep their addresses when the supervisor is toggled.
+ */
+#define UIRB_EEPROM_RESET_LOG_SIZE (UIRB_CORE_WDT_RESET_LOG_SLOTS * 10U)
+
+/**
+ * @brief The starting address in EEPROM of the battery ESR history.
+ * 
+ * The history is a @ref uirbcore::eeprom::EEPROMRingLog of @ref uirbcore::BatteryEsrRecord entries, placed 
+ * directly after the watchdog reset log.
+ * 
+ * @see @ref uirbcore::BatteryHealth for the producer of the entries.
+ */
+#define UIRB_EEPROM_BATTERY_ESR_LOG_ADDR_START (UIRB_EEPROM_RESET_LOG_ADDR_START + UIRB_EEPROM_RESET_LOG_SIZE)
+
+/**
+ * @brief Number of EEPROM bytes of the battery ESR history, 4 records of 10 bytes.
+ */
+#define UIRB_EEPROM_BATTERY_ESR_LOG_SIZE (4U * 10U)
+
+/**
+ * @brief The starting address in EEPROM of the battery charge cycle log.
+ * 
+ * The log is a @ref uirbcore::eeprom::EEPROMRingLog of @ref uirbcore::BatteryCycleRecord entries, placed 
+ * directly after the battery ESR history.
+ * 
+ * @see @ref uirbcore::BatteryHealth for the producer of the entries.
+ */
+#define UIRB_EEPROM_BATTERY_CYCLE_LOG_ADDR_START (UIRB_EEPROM_BATTERY_ESR_LOG_ADDR_START + UIRB_EEPROM_BATTERY_ESR_LOG_SIZE)
+
+/**
+ * @brief Number of EEPROM bytes of the battery charge cycle log, 4 records of 9 bytes.
+ */
+#define UIRB_EEPROM_BATTERY_CYCLE_LOG_SIZE (4U * 9U)
+
+/**
+ * @brief The starting address in EEPROM of the charging session log.
+ * 
+ * The log is a @ref uirbcore::eeprom::EEPROMRingLog of @ref UIRB_CORE_CHARGE_LOG_SLOTS 
+ * @ref uirbcore::ChargeSession entries, placed directly after the battery charge cycle log.
+ * 
+ * @see @ref uirbcore::ChargeSessionLog for the producer of the entries.
+ */
+#define UIRB_EEPROM_CHARGE_LOG_ADDR_START (UIRB_EEPROM_BATTERY_CYCLE_LOG_ADDR_START + UIRB_EEPROM_BATTERY_CYCLE_LOG_SIZE)
+
+/**
+ * @brief Number of EEPROM bytes of the charging session log, 19 bytes per record.
+ */
+#define UIRB_EEPROM_CHARGE_LOG_SIZE (UIRB_CORE_CHARGE_LOG_SLOTS * 19U)
+
+/**
+ * @brief The starting address in EEPROM of the ADC two-point calibration.
+ * 
+ * Each ADC reference has its own @ref uirbcore::eeprom::EEPROMRingLog of two @ref uirbcore::AdcCalibrationRecord 
+ * entries, AVcc first, placed directly after the charging session log. The newest valid entry is used, so an interrupted update keeps 
+ * the previous calibration.
+ * 
+ * @see @ref uirbcore::AdcCalibration for the producer of the entries.
+ */
+#define UIRB_EEPROM_ADC_CALIBRATION_ADDR_START (UIRB_EEPROM_CHARGE_LOG_ADDR_START + UIRB_EEPROM_CHARGE_LOG_SIZE)
+
+/**
+ * @brief Number of EEPROM bytes of the ADC two-point calibration, 2 references with 2 records of 5 bytes.
+ */
+#define UIRB_EEPROM_ADC_CALIBRATION_SIZE (2U * 2U * 5U)
+
 namespace uirbcore 
 {
     /**
@@ -367,6 +458,8 @@ namespace uirbcore
             char factory_cp2104_usb_serial_number[DATA_FACTORY_CP2104_SERIAL_NUM_LEN]; /**< @brief CP2104 USB serial number (8 ASCII characters, not null-terminated). */
         } __attribute__((packed, aligned(1)));
 
+        static_assert(sizeof(EEPROMData) <= UIRB_EEPROM_DATA_RESERVED_SIZE, "EEPROMData exceeds UIRB_EEPROM_DATA_RESERVED_SIZE");
+
         /**
          * @brief Compares two @ref EEPROMData structures for equality.
          * 
@@ -418,6 +511,71 @@ namespace uirbcore
          */
         bool operator!=(const EEPROMData& lhs, const EEPROMData& rhs);
 
+        /**
+         * @brief Identifies a field of @ref EEPROMData in the settings registry.
+         * 
+         * Each identifier indexes a @ref SettingDescriptor, which @ref EEPROMDataManager::get_setting() and 
+         * @ref EEPROMDataManager::set_setting() use to read and write the field with one generic, validated path. 
+         * The values are stable, so they can be used on the wire by host tools.
+         * 
+         * @note The factory CP2104 USB serial number is a string and has no identifier; it is accessed through 
+         *       @ref EEPROMDataManager::get_factory_cp2104_usb_serial_number_cstr().
+         */
+        enum class SettingId : uint8_t
+        {
+            HARDWARE_VERSION = 0,           /**< @ref HardwareVersion::version_byte, read-only. */
+            BANDGAP_REFERENCE_MILIVOLTS,    /**< Bandgap reference voltage in millivolts, `[972 - 1227]`. */
+            STAT_LED_BRIGHTNESS,            /**< Status LED brightness, `[0 - 255]`. */
+            CHARGER_PROG_RESISTOR_OHMS,     /**< `Rprog` resistance in ohms, `[3333 - 65535]`. */
+            AVR_SERIAL_DEBUGGER,            /**< @ref SoftwareConfig::avr_serial_debugger_enabled, `[0 - 1]`. */
+            SLEEP_MODE_ALLOWED,             /**< @ref SoftwareConfig::sleep_mode_allowed, `[0 - 1]`. */
+            SLEEP_MODE_IO3_WAKEUP,          /**< @ref SoftwareConfig::sleep_mode_io3_wakeup_enabled, `[0 - 1]`. */
+            BOOT_COUNT_INCREMENT,           /**< @ref SoftwareConfig::boot_count_increment_enabled, `[0 - 1]`. */
+            MANUFACTURE_YEAR,               /**< Manufacture year, `[2020 - 2035]`. */
+            MANUFACTURE_MONTH,              /**< Manufacture %month, `[1 - 12]`. */
+            BOOT_COUNT,                     /**< Boot count, `[0 - UINT32_MAX]`. */
+            UIRB_SERIAL_NUMBER,             /**< %UIRB board serial number, `[1 - 9999]`. */
+            COUNT                           /**< Number of settings, not a valid setting. */
+        };
+
+        /**
+         * @brief The field is a two's complement number and is sign-extended when read.
+         */
+        constexpr uint8_t SETTING_FLAG_SIGNED = _BV(0);
+
+        /**
+         * @brief The field can be written by the application through @ref UIRB::setSetting().
+         * 
+         * Fields without this flag are factory calibration or bookkeeping and can only be written 
+         * through @ref EEPROMDataManager::set_setting().
+         */
+        constexpr uint8_t SETTING_FLAG_USER_WRITABLE = _BV(1);
+
+        /**
+         * @brief The field cannot be written at all, not even by @ref EEPROMDataManager::set_setting().
+         */
+        constexpr uint8_t SETTING_FLAG_READ_ONLY = _BV(2);
+
+        /**
+         * @brief Describes how a setting is stored in @ref EEPROMData and which values it accepts.
+         * 
+         * The stored bits are read as `(field >> bit_shift) & mask(bit_count)`, sign-extended if 
+         * @ref SETTING_FLAG_SIGNED is set, and @ref bias is added to get the value seen by the caller.
+         * 
+         * @note The descriptors are stored in flash and read with `memcpy_P()`.
+         */
+        struct SettingDescriptor
+        {
+            uint8_t offset;         /**< @brief Offset of the field in @ref EEPROMData, in bytes. */
+            uint8_t size;           /**< @brief Size of the field, `[1 - 4]` bytes. */
+            uint8_t bit_shift;      /**< @brief Position of the lowest bit of the setting in the field. */
+            uint8_t bit_count;      /**< @brief Number of bits of the setting, `[1 - 32]`. */
+            int16_t bias;           /**< @brief Added to the stored bits to get the value. */
+            uint32_t min;           /**< @brief Lowest valid value, after the bias. */
+            uint32_t max;           /**< @brief Highest valid value, after the bias. */
+            uint8_t flags;          /**< @brief `SETTING_FLAG_*` bits. */
+        };
+
         /**
          * @brief A utility class for managing configuration data stored in EEPROM.
          * 
@@ -446,6 +604,9 @@ namespace uirbcore
          * - Verifies hardware version compatibility during initialization.
          * - Supports efficient in-memory manipulation of EEPROM data.
          * - Provides field-specific accessors and mutators for individual configuration settings.
+         * - Reads and writes any setting by @ref SettingId through one table-driven path. The field-specific
+         *   setters are inline wrappers of it, the getters read their field directly as some run on every
+         *   measurement.
          * - Implements safeguards against invalid data, ensuring robust operation.
          * 
          * @note This class is tightly coupled with the @ref EEPROMData structure, which encapsulates 
@@ -520,6 +681,47 @@ namespace uirbcore
                  */
                 bool hardware_version_matches() const;
 
+                /**
+                 * @brief Reads a setting from RAM through the settings registry.
+                 * 
+                 * Looks up the @ref SettingDescriptor of @p id, extracts the setting from its field of the 
+                 * @ref EEPROMData structure stored in RAM and applies the sign extension and the bias.
+                 * 
+                 * @param[in] id Setting to read.
+                 * @param[out] value Decoded value. Written even if it is out of range, `0` if @p id is invalid.
+                 * @return bool Indicates whether the value is valid.
+                 * @retval true The value is within the range of the descriptor.
+                 * @retval false The value is out of range or @p id is invalid.
+                 * 
+                 * @note The per-field getters such as @ref get_stat_led_brightness() read their field directly and 
+                 *       return the same values, without the copy of the descriptor from flash.
+                 */
+                bool get_setting(const SettingId id, uint32_t& value) const;
+
+                /**
+                 * @brief Validates and writes a setting in RAM through the settings registry.
+                 * 
+                 * Only the bits of the setting are changed, the rest of the field is kept.
+                 * 
+                 * @param[in] id Setting to write.
+                 * @param[in] value Value to store, before the bias is removed.
+                 * @return bool Indicates whether the setting was written.
+                 * @retval true The setting was written.
+                 * @retval false @p id is invalid, the setting has @ref SETTING_FLAG_READ_ONLY or @p value is out of range.
+                 * 
+                 * @note Changes are not saved to EEPROM until @ref save_to_eeprom() is called.
+                 */
+                bool set_setting(const SettingId id, const uint32_t value);
+
+                /**
+                 * @brief Copies the @ref SettingDescriptor of a setting from flash.
+                 * 
+                 * @param[in] id Setting to describe.
+                 * @param[out] descriptor Descriptor of the setting.
+                 * @return bool `false` if @p id is invalid and @p descriptor was not written.
+                 */
+                static bool get_setting_descriptor(const SettingId id, SettingDescriptor& descriptor);
+
                 /**
                  * @brief Retrieves the @ref HardwareVersion stored in RAM.
                  * 
@@ -566,7 +768,10 @@ namespace uirbcore
                  * @warning Setting an out-of-range voltage will result in a `false` return value and no 
                  *          updates to the stored offset.
                  */
-                bool set_bandgap_reference_milivolts(const uint16_t milivolts);
+                bool set_bandgap_reference_milivolts(const uint16_t milivolts)
+                {
+                    return this->set_setting(SettingId::BANDGAP_REFERENCE_MILIVOLTS, milivolts);
+                }
 
                 /**
                  * @brief Retrieves the brightness level of the status LED stored in RAM.
@@ -592,7 +797,10 @@ namespace uirbcore
                  * @note The brightness value corresponds to the intensity of the LED, where `0` represents 
                  *       the minimum brightness (LED off) and `255` represents the maximum brightness.
                  */
-                void set_stat_led_brightness(const uint8_t brightness);
+                void set_stat_led_brightness(const uint8_t brightness)
+                {
+                    this->set_setting(SettingId::STAT_LED_BRIGHTNESS, brightness);
+                }
 
                 /**
                  * @brief Retrieves the resistance of the `Rprog` resistor stored in RAM, in ohms.
@@ -621,7 +829,10 @@ namespace uirbcore
                  * @note The minimum valid resistance value is defined by @ref CHARGER_PROG_RESISTANCE_MIN. 
                  *       Values below this threshold are considered invalid and will not be accepted.
                  */
-                bool set_charger_prog_resistor_ohms(const uint16_t ohms);
+                bool set_charger_prog_resistor_ohms(const uint16_t ohms)
+                {
+                    return this->set_setting(SettingId::CHARGER_PROG_RESISTOR_OHMS, ohms);
+                }
 
                 /**
                  * @brief Checks if the AVR serial debugger (`avr8-stub`) is present in the firmware.
@@ -645,7 +856,10 @@ namespace uirbcore
                  * @arg @c true AVR serial debugger is present in the firmware.
                  * @arg @c false AVR serial debugger is not present in the firmware.
                  */
-                void set_avr_serial_debugger(const bool enabled);
+                void set_avr_serial_debugger(const bool enabled)
+                {
+                    this->set_setting(SettingId::AVR_SERIAL_DEBUGGER, enabled);
+                }
 
                 /**
                  * @brief Checks if sleep mode is allowed.
@@ -669,7 +883,10 @@ namespace uirbcore
                  * @arg @p true Allows the system to enter sleep mode.
                  * @arg @p false Prevents the system from entering sleep mode.
                  */
-                void allow_sleep_mode(const bool allowed);
+                void allow_sleep_mode(const bool allowed)
+                {
+                    this->set_setting(SettingId::SLEEP_MODE_ALLOWED, allowed);
+                }
 
                 /**
                  * @brief Checks if the MCU can be woken up by the IO3 pin.
@@ -693,7 +910,10 @@ namespace uirbcore
                  * @arg @p true Allows the MCU to be woken up by the IO3 pin.
                  * @arg @p false Prevents the MCU from being woken up by the IO3 pin.
                  */
-                void allow_sleep_mode_io3_wakeup(const bool allowed);
+                void allow_sleep_mode_io3_wakeup(const bool allowed)
+                {
+                    this->set_setting(SettingId::SLEEP_MODE_IO3_WAKEUP, allowed);
+                }
 
                 /**
                  * @brief Checks if boot count incrementing is allowed.
@@ -717,7 +937,10 @@ namespace uirbcore
                  * @arg @p true Allows boot count incrementing.
                  * @arg @p false Prevents boot count incrementing.
                  */
-                void allow_boot_count_increment(const bool allowed);
+                void allow_boot_count_increment(const bool allowed)
+                {
+                    this->set_setting(SettingId::BOOT_COUNT_INCREMENT, allowed);
+                }
 
                 /**
                  * @brief Retrieves the board's manufacture year stored in RAM.
@@ -751,7 +974,10 @@ namespace uirbcore
                  * 
                  * @see @ref HardwareManufactureDate for the `union` representing the manufacturing date.
                  */
-                bool set_board_manufacture_year(const uint16_t year);
+                bool set_board_manufacture_year(const uint16_t year)
+                {
+                    return this->set_setting(SettingId::MANUFACTURE_YEAR, year);
+                }
 
                 /**
                  * @brief Retrieves the board's manufacture %month stored in RAM.
@@ -760,7 +986,8 @@ namespace uirbcore
                  * as stored in the @ref EEPROMData structure.
                  * 
                  * @return `uint8_t` The %month of manufacture in the range `[1-12]`.
-                 * @retval #INVALID_MANUFACTURE_MONTH If the stored %month is outside the valid range.
+                 * @retval #INVALID_MANUFACTURE_MONTH If the stored %month is `0` or above `12`. The constant is `0`, 
+                 *         so an unprogrammed `0` is returned as it is stored.
                  * 
                  * @note Months are represented as integers `[1-12]`, where `1` corresponds to January and `12` to December.
                  */
@@ -781,7 +1008,10 @@ namespace uirbcore
                  * 
                  * @warning Ensure that the input @p month is within the valid range to avoid errors.
                  */
-                bool set_board_manufacture_month(const uint8_t month);
+                bool set_board_manufacture_month(const uint8_t month)
+                {
+                    return this->set_setting(SettingId::MANUFACTURE_MONTH, month);
+                }
 
                 /**
                  * @brief Retrieves the boot count stored in RAM.
@@ -807,7 +1037,10 @@ namespace uirbcore
                  * @note Ensure the provided @p boot_count value is meaningful and does not exceed 
                  *       the maximum allowable range for a `uint32_t`.
                  */
-                void set_boot_count(const uint32_t boot_count);
+                void set_boot_count(const uint32_t boot_count)
+                {
+                    this->set_setting(SettingId::BOOT_COUNT, boot_count);
+                }
 
                 /**
                  * @brief Increments the boot count stored in RAM by 1.
@@ -874,7 +1107,10 @@ namespace uirbcore
                  * 
                  * @see @ref get_uirb_board_serial_number() for retrieving the stored serial %number.
                  */
-                bool set_uirb_board_serial_number(const uint16_t serial_number);
+                bool set_uirb_board_serial_number(const uint16_t serial_number)
+                {
+                    return this->set_setting(SettingId::UIRB_SERIAL_NUMBER, serial_number);
+                }
 
                 /**
                  * @brief Updates the factory CP2104 USB serial number in the @ref EEPROMData struct stored in RAM.
@@ -1058,7 +1294,7 @@ namespace uirbcore
                  * - The value is set to `1` ohm, which is considered invalid for normal operation.
                  * - This constant ensures consistent error handling and validation in the firmware.
                  * 
-                 * @note Ensure that the actual Rprog resistor value is greater than @ref CHARGER_PROG_RESISTANCE_MIN 
+                 * @note Ensure that the actual Rprog resistor value is at least @ref CHARGER_PROG_RESISTANCE_MIN 
                  *       to maintain proper operation.
                  */
                 static constexpr uint8_t INVALID_CHARGER_PROG_RESISTANCE = 1U;
@@ -1230,6 +1466,13 @@ namespace uirbcore
                  */
                 static constexpr uint16_t CHARGER_PROG_RESISTANCE_MIN = 3333U;
 
+                /**
+                 * @brief Descriptors of the settings registry stored in flash, indexed by @ref SettingId.
+                 * 
+                 * @see @ref get_setting_descriptor() for reading a descriptor.
+                 */
+                static const SettingDescriptor SETTING_DESCRIPTORS[];
+
                 /**
                  * @brief Grants access to all private and protected members of this class to @ref UIRB.
                  * 
@@ -1239,6 +1482,69 @@ namespace uirbcore
                  * @see UIRB for details about the UIRB core class.
                  */
                 friend class uirbcore::UIRB;
+
+                /**
+                 * @brief Grants @ref EEPROMCommitTask access to @ref CORE_DATA_ADDR_START.
+                 */
+                friend class EEPROMCommitTask;
+        };
+
+        /**
+         * @brief Task writing an @ref EEPROMData structure to EEPROM, one byte per step.
+         * 
+         * Each byte differing from the EEPROM content is written once the previous write has finished, so a
+         * step never waits for the EEPROM. The data is read back and compared after the last byte, like
+         * @ref EEPROMDataManager::store_to_eeprom(), which runs this task to completion.
+         * 
+         * Example usage, saving without stopping `loop()`:
+         * @code
+         * eeprom::EEPROMData data = uirb.getDataStoredInRAM();
+         * eeprom::EEPROMCommitTask commit(data);
+         * ...
+         * if (commit.step() == TaskStatus::DONE && !commit.isVerified()) { ... }
+         * @endcode
+         * 
+         * @note Unlike @ref UIRB::saveToEEPROM(), the task does not update the warm restart copy of the data
+         *       (@ref UIRB_CORE_WARM_RESTART).
+         * @note With @ref UIRB_EEPROM_BYPASS_DEBUG defined, the data is copied to @ref EEPROM_DATA in the first step.
+         * 
+         * @warning The data must neither change nor go out of scope before the task is done.
+         */
+        class EEPROMCommitTask
+        {
+            public:
+                /**
+                 * @brief Constructs a task for the given data.
+                 * 
+                 * @param[in] data Data to write, referenced until the task is done.
+                 */
+                explicit EEPROMCommitTask(const EEPROMData& data)
+                    : data_(data)
+                {
+                }
+
+                /**
+                 * @brief Runs the task until its next wait.
+                 * 
+                 * @return TaskStatus @ref TaskStatus::DONE once the data is written and verified.
+                 */
+                TaskStatus step();
+
+                /**
+                 * @brief Checks if the data read back after writing matched.
+                 * 
+                 * @return bool `true` if the task is done and the EEPROM holds the data.
+                 */
+                bool isVerified() const
+                {
+                    return this->verified_;
+                }
+
+            private:
+                CoroutineState coroutine_ = {}; /**< Coroutine state. */
+                const EEPROMData& data_; /**< Data to write. */
+                uint8_t index_ = 0; /**< Byte being written. */
+                bool verified_ = false; /**< Result of the read back. */
         };
 
     #if defined(UIRB_EEPROM_BYPASS_DEBUG) || defined(__DOXYGEN__)
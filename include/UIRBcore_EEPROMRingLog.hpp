@@ -0,0 +1,215 @@
+/**
+ * @file UIRBcore_EEPROMRingLog.hpp
+ * @brief Wear-aware circular record log stored in EEPROM for the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::eeprom::EEPROMRingLog class, a small fixed-size circular
+ * log of equally sized records used by diagnostic features that need to persist history across resets
+ * without rewriting the same EEPROM cells on every update.
+ *
+ * @details
+ * - Each slot holds a sequence byte, the record payload and a CRC-8 of both.
+ * - Appending always writes the slot following the newest one, spreading writes evenly over the region.
+ * - The newest slot is found by scanning for the break in the sequence numbers, so no separate
+ *   head pointer has to be stored (and worn out) in EEPROM.
+ * - A slot is invalidated before its payload is written and its sequence byte is committed last,
+ *   so an interrupted write never corrupts older entries.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_EEPROMRingLog_hpp
+#define UIRBcore_EEPROMRingLog_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+
+namespace uirbcore::eeprom
+{
+    /**
+     * @brief Fixed-size circular log of equally sized records stored in EEPROM.
+     *
+     * The @ref EEPROMRingLog class manages a contiguous EEPROM region split into @ref slots() slots of
+     * `payload_size + ` @ref SLOT_OVERHEAD bytes. The class keeps no state in RAM apart from its geometry,
+     * so instances can be `constexpr` and placed in flash.
+     *
+     * @details
+     * **Slot layout:**
+     * | Offset             | Size           | Content                                          |
+     * |--------------------|----------------|--------------------------------------------------|
+     * | `0`                | 1              | Sequence number `[0-254]`, `0xFF` marks an empty slot |
+     * | `1`                | `payload_size` | Record payload                                   |
+     * | `1 + payload_size` | 1              | CRC-8 (CCITT) over sequence number and payload   |
+     *
+     * @note When @ref UIRB_EEPROM_BYPASS_DEBUG is defined, the log is disabled: @ref append() returns `false`
+     * and @ref count() returns `0`, keeping the physical EEPROM untouched.
+     *
+     * @warning The number of slots must be lower than `128` to keep sequence numbers unambiguous.
+     */
+    class EEPROMRingLog
+    {
+        public:
+            /**
+             * @brief Constructs a ring log descriptor for an EEPROM region.
+             *
+             * @param[in] address First EEPROM address of the region.
+             * @param[in] slots Number of record slots `[1-127]`.
+             * @param[in] payload_size Size of a single record payload in bytes.
+             */
+            constexpr EEPROMRingLog(const uint16_t address, const uint8_t slots, const uint8_t payload_size) :
+                address_(address), slots_(slots), payload_size_(payload_size) {}
+
+            /**
+             * @brief Appends a record after the newest one, overwriting the oldest record when the log is full.
+             *
+             * @param[in] payload Pointer to @ref payloadSize() bytes to store.
+             * @return bool
+             * @retval true The record was written and verified.
+             * @retval false @p payload is `nullptr`, the write could not be verified, or EEPROM access is bypassed.
+             */
+            bool append(const void* payload) const;
+
+            /**
+             * @brief Reads a record by age.
+             *
+             * @param[in] age Age of the record, `0` being the newest one.
+             * @param[out] payload Destination buffer of at least @ref payloadSize() bytes.
+             * @return bool
+             * @retval true The record exists and its CRC is valid.
+             * @retval false No such record is stored.
+             */
+            bool read(const uint8_t age, void* payload) const;
+
+            /**
+             * @brief Returns the number of consecutive valid records, starting from the newest one.
+             *
+             * @return uint8_t Number of readable records `[0-` @ref slots() `]`.
+             */
+            uint8_t count() const;
+
+            /**
+             * @brief Marks every slot as empty.
+             *
+             * Only the sequence byte of each slot is rewritten, and only when it is not already empty.
+             */
+            void clear() const;
+
+            /**
+             * @brief Returns the number of slots in the log.
+             *
+             * @return uint8_t Number of slots.
+             */
+            constexpr uint8_t slots() const { return this->slots_; }
+
+            /**
+             * @brief Returns the payload size of a single record.
+             *
+             * @return uint8_t Payload size in bytes.
+             */
+            constexpr uint8_t payloadSize() const { return this->payload_size_; }
+
+            /**
+             * @brief Returns the total number of EEPROM bytes occupied by the log.
+             *
+             * @return uint16_t Size of the log region in bytes.
+             */
+            constexpr uint16_t size() const { return regionSize(this->slots_, this->payload_size_); }
+
+            /**
+             * @brief Computes the EEPROM footprint of a log with the given geometry.
+             *
+             * Useful for laying out consecutive EEPROM regions at compile time.
+             *
+             * @param[in] slots Number of record slots.
+             * @param[in] payload_size Size of a single record payload in bytes.
+             * @return uint16_t Size of the log region in bytes.
+             */
+            static constexpr uint16_t regionSize(const uint8_t slots, const uint8_t payload_size)
+            {
+                return static_cast<uint16_t>(slots) * (static_cast<uint16_t>(payload_size) + SLOT_OVERHEAD);
+            }
+
+            /**
+             * @brief Number of bookkeeping bytes (sequence number and CRC) stored in each slot.
+             */
+            static constexpr uint8_t SLOT_OVERHEAD = 2U;
+
+            /**
+             * @brief Sequence value marking an empty slot (erased EEPROM state).
+             */
+            static constexpr uint8_t EMPTY_SEQUENCE = 0xFFU;
+
+            /**
+             * @brief Value returned by internal slot lookups when no valid slot exists.
+             */
+            static constexpr uint8_t INVALID_SLOT = 0xFFU;
+
+        private:
+            /**
+             * @brief Returns the EEPROM address of the first byte of a slot.
+             *
+             * @param[in] slot Slot index `[0-` @ref slots() `)`.
+             * @return uint16_t EEPROM address of the slot.
+             */
+            uint16_t slot_address(const uint8_t slot) const;
+
+            /**
+             * @brief Reads the sequence number of a slot and validates its CRC.
+             *
+             * @param[in] slot Slot index.
+             * @param[out] sequence Sequence number stored in the slot.
+             * @return bool
+             * @retval true The slot is occupied and its CRC is valid.
+             * @retval false The slot is empty or corrupted.
+             */
+            bool slot_valid(const uint8_t slot, uint8_t& sequence) const;
+
+            /**
+             * @brief Finds the slot holding the newest record.
+             *
+             * @param[out] sequence Sequence number of the newest record.
+             * @return uint8_t Index of the newest slot, or @ref INVALID_SLOT if the log is empty.
+             */
+            uint8_t newest_slot(uint8_t& sequence) const;
+
+            /**
+             * @brief Returns the sequence number following @p sequence, skipping @ref EMPTY_SEQUENCE.
+             *
+             * @param[in] sequence Current sequence number.
+             * @return uint8_t Next sequence number.
+             */
+            static uint8_t next_sequence(const uint8_t sequence);
+
+            uint16_t address_; /**< @brief First EEPROM address of the log region. */
+            uint8_t slots_; /**< @brief Number of record slots. */
+            uint8_t payload_size_; /**< @brief Size of a single record payload in bytes. */
+    };
+}  // namespace uirbcore::eeprom
+
+#endif  // UIRBcore_EEPROMRingLog_hpp
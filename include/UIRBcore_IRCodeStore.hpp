@@ -0,0 +1,438 @@
+/**
+ * @file UIRBcore_IRCodeStore.hpp
+ * @brief IR code library stored on SPI NOR flash for the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::IRCodeStore class, which keeps IR codes of up to one erase sector
+ * each on a @ref uirbcore::SPIFlashDevice and finds them by a 16-bit ID.
+ *
+ * @details
+ * **Flash layout:**
+ * - The first `2 * index_sectors` sectors hold two copies (A/B) of the index. Each copy starts with a
+ *   16-byte header, followed by a table of index entries sorted by ID and a journal of
+ *   @ref UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES entries at its end.
+ * - The remaining sectors form a circular log of data sectors. Each starts with a 16-byte header holding
+ *   its erase count and allocation sequence, followed by records (8-byte header and payload).
+ *
+ * **Lookup:** The journal is searched newest first, then the sorted table is binary searched, giving
+ * O(log n) reads for n codes plus at most one cache line per four journal entries.
+ *
+ * **Updates:** A record is appended to the head data sector, then an index entry is appended to the journal.
+ * When the journal is full it is merged with the table into the inactive copy, whose header is programmed
+ * last with a higher sequence. An interrupted merge leaves the previous copy valid.
+ *
+ * **Wear leveling:** Data sectors are allocated and reclaimed in ring order, so every data sector is erased
+ * equally often regardless of how long codes live. Reclaiming the oldest sector relocates its live records
+ * to the head. One data sector is always kept free as relocation space. Erase counts are stored in the
+ * sector headers and reported by @ref uirbcore::IRCodeStore::getStats().
+ *
+ * **Caching:** Index and header reads go through one aligned line of @ref UIRB_CORE_SPI_FLASH_CACHE_SIZE
+ * bytes, which is invalidated by overlapping program and erase operations.
+ *
+ * @note Only compiled when @ref UIRB_CORE_SPI_FLASH is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_IRCodeStore_hpp
+#define UIRBcore_IRCodeStore_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_SPIFlash.hpp>
+
+namespace uirbcore
+{
+#if defined(UIRB_CORE_SPI_FLASH) || defined(__DOXYGEN__)
+    /**
+     * @brief Result codes of @ref IRCodeStore operations.
+     */
+    enum class StoreResult : uint8_t
+    {
+        SUCCESS = 0, /**< Operation completed successfully. */
+        ERROR_NOT_MOUNTED, /**< @ref IRCodeStore::begin() or @ref IRCodeStore::format() did not succeed. */
+        ERROR_INVALID_ARGUMENT, /**< Invalid ID, length or device geometry. */
+        ERROR_NOT_FOUND, /**< No code with the given ID is stored. */
+        ERROR_BUFFER_TOO_SMALL, /**< The destination buffer is smaller than the stored code. */
+        ERROR_FULL, /**< The index or all data sectors are full of live codes. */
+        ERROR_CORRUPTED, /**< No valid index was found or a record failed its CRC check. */
+        ERROR_DEVICE /**< The flash device reported an error. */
+    };
+
+    /**
+     * @brief Usage and wear statistics returned by @ref IRCodeStore::getStats().
+     */
+    struct StoreStats
+    {
+        uint16_t codes = 0; /**< Number of stored codes. */
+        uint16_t max_codes = 0; /**< Capacity of the index table. */
+        uint32_t live_bytes = 0; /**< Bytes taken by stored codes including their record headers. */
+        uint32_t max_live_bytes = 0; /**< Data sector space available for codes, excluding the reserve sector. */
+        uint16_t journal_entries = 0; /**< Used journal entries of the active index copy. */
+        uint16_t data_sectors = 0; /**< Number of data sectors. */
+        uint16_t free_sectors = 0; /**< Data sectors not holding any records, including the reserve sector. */
+        uint32_t min_erase_count = 0; /**< Lowest erase count of the data sectors. */
+        uint32_t max_erase_count = 0; /**< Highest erase count of the data sectors. */
+        uint32_t index_sequence = 0; /**< Sequence of the active index copy, incremented by every merge. */
+    };
+
+    /**
+     * @brief IR code library on SPI NOR flash with O(log n) lookup by ID.
+     *
+     * Example usage:
+     * @code
+     * JedecSPIFlash flash;
+     * IRCodeStore store(flash);
+     *
+     * if (flash.begin() && store.begin() != StoreResult::SUCCESS)
+     * {
+     *     store.format();
+     * }
+     * store.store(42, code, sizeof(code));
+     * uint16_t length;
+     * store.load(42, buffer, sizeof(buffer), length);
+     * @endcode
+     *
+     * @note The store keeps no reference to the caller's buffers and is not reentrant. Do not use it from interrupts.
+     */
+    class IRCodeStore
+    {
+        public:
+            /**
+             * @brief Constructs a store on a flash device. The device is not accessed until @ref begin().
+             *
+             * @param[in] device Flash device holding the store.
+             * @param[in] index_sectors Number of sectors per index copy, limiting the number of codes.
+             */
+            explicit IRCodeStore(SPIFlashDevice& device, const uint8_t index_sectors = 1)
+                : device_(device), index_sectors_(index_sectors) {}
+
+            /**
+             * @brief Mounts an existing store.
+             *
+             * Selects the valid index copy with the highest sequence, counts its journal entries and locates
+             * the head and tail data sectors. Data sectors with a missing header, for example after a power
+             * loss during reclaim, are erased.
+             *
+             * @return StoreResult
+             * @retval StoreResult::SUCCESS The store is ready.
+             * @retval StoreResult::ERROR_INVALID_ARGUMENT The device geometry is not supported.
+             * @retval StoreResult::ERROR_CORRUPTED No valid index was found, call @ref format().
+             * @retval StoreResult::ERROR_DEVICE The flash device reported an error.
+             */
+            StoreResult begin();
+
+            /**
+             * @brief Erases the device and creates an empty store. Erase counts of data sectors are preserved.
+             *
+             * @return StoreResult
+             * @retval StoreResult::SUCCESS The store is ready.
+             * @retval StoreResult::ERROR_INVALID_ARGUMENT The device geometry is not supported.
+             * @retval StoreResult::ERROR_DEVICE The flash device reported an error.
+             */
+            StoreResult format();
+
+            /**
+             * @brief Stores a code, replacing any code with the same ID.
+             *
+             * @param[in] id Code ID, any value except @ref INVALID_ID.
+             * @param[in] data Code data.
+             * @param[in] length Code length in bytes, between 1 and @ref getMaxCodeLength().
+             * @return StoreResult
+             * @retval StoreResult::SUCCESS The code was stored.
+             * @retval StoreResult::ERROR_FULL The index or data space is full, the previous code with this ID is kept.
+             */
+            StoreResult store(const uint16_t id, const void* data, const uint16_t length);
+
+            /**
+             * @brief Loads a code and verifies its CRC.
+             *
+             * @param[in] id Code ID.
+             * @param[out] buffer Destination buffer.
+             * @param[in] capacity Size of @p buffer in bytes.
+             * @param[out] length Length of the stored code, also set for @ref StoreResult::ERROR_BUFFER_TOO_SMALL.
+             * @return StoreResult
+             * @retval StoreResult::SUCCESS The code was copied into @p buffer.
+             * @retval StoreResult::ERROR_NOT_FOUND No code with this ID is stored.
+             * @retval StoreResult::ERROR_BUFFER_TOO_SMALL @p buffer cannot hold the code.
+             * @retval StoreResult::ERROR_CORRUPTED The code failed its CRC check.
+             */
+            StoreResult load(const uint16_t id, void* buffer, const uint16_t capacity, uint16_t& length);
+
+            /**
+             * @brief Checks if a code is stored.
+             *
+             * @param[in] id Code ID.
+             * @return bool `true` if a code with this ID is stored.
+             */
+            bool contains(const uint16_t id);
+
+            /**
+             * @brief Removes a code. Its space is reclaimed when its data sector is reclaimed.
+             *
+             * @param[in] id Code ID.
+             * @return StoreResult
+             * @retval StoreResult::SUCCESS The code was removed.
+             * @retval StoreResult::ERROR_NOT_FOUND No code with this ID is stored.
+             */
+            StoreResult remove(const uint16_t id);
+
+            /**
+             * @brief Reads usage and wear statistics, scanning all data sector headers.
+             *
+             * @param[out] stats Statistics.
+             * @return StoreResult @ref StoreResult::SUCCESS or @ref StoreResult::ERROR_NOT_MOUNTED.
+             */
+            StoreResult getStats(StoreStats& stats);
+
+            /**
+             * @brief Returns the maximum length of a single code, limited by the sector size.
+             *
+             * @return uint16_t Maximum code length in bytes.
+             */
+            uint16_t getMaxCodeLength() const;
+
+            /**
+             * @brief Returns the data sector space available for codes, excluding the reserve sector.
+             *
+             * Codes do not span sectors, so the space left at the end of sectors is not usable for long codes.
+             *
+             * @return uint32_t Usable space in bytes, record headers included.
+             */
+            uint32_t getMaxLiveBytes() const;
+
+            /**
+             * @brief Checks if the store is mounted.
+             *
+             * @return bool `true` after a successful @ref begin() or @ref format().
+             */
+            bool isMounted() const { return this->mounted_; }
+
+            /**
+             * @brief Reserved ID marking free journal entries.
+             */
+            static constexpr uint16_t INVALID_ID = 0xFFFFU;
+
+        private:
+            /**
+             * @brief Location of a code as kept in the index table and journal.
+             *
+             * `location` holds the 24-bit record address and a CRC-8 of the entry in its top byte.
+             * Address `0` marks a removed code, as it always lies within the index.
+             */
+            struct IndexEntry
+            {
+                uint16_t id;
+                uint16_t length;
+                uint32_t location;
+            };
+
+            /**
+             * @brief Reads through the cache.
+             *
+             * @param[in] address Start address.
+             * @param[out] data Destination buffer.
+             * @param[in] length Number of bytes.
+             * @return bool `true` on success.
+             */
+            bool cached_read(uint32_t address, void* data, uint16_t length);
+
+            /**
+             * @brief Programs an arbitrary range, split at page boundaries, invalidating the cache if needed.
+             *
+             * @param[in] address Start address.
+             * @param[in] data Source buffer.
+             * @param[in] length Number of bytes.
+             * @return bool `true` on success.
+             */
+            bool write(uint32_t address, const void* data, uint16_t length);
+
+            /**
+             * @brief Erases a sector, invalidating the cache if needed.
+             *
+             * @param[in] address Sector start address.
+             * @return bool `true` on success.
+             */
+            bool erase(const uint32_t address);
+
+            /**
+             * @brief Finds the newest index entry for an ID.
+             *
+             * @param[in] id Code ID.
+             * @param[out] entry Index entry, a removed code has a zero address.
+             * @return bool `true` if an entry was found in the journal or table.
+             */
+            bool find(const uint16_t id, IndexEntry& entry);
+
+            /**
+             * @brief Binary searches the table of the active index copy.
+             *
+             * @param[in] id Code ID.
+             * @param[out] entry Table entry.
+             * @return bool `true` if the table contains the ID.
+             */
+            bool find_in_table(const uint16_t id, IndexEntry& entry);
+
+            /**
+             * @brief Appends an index entry to the journal, merging first if the journal is full.
+             *
+             * @param[in] id Code ID.
+             * @param[in] length Code length.
+             * @param[in] address Record address, `0` to remove the code.
+             * @return StoreResult Result of the merge or program operation.
+             */
+            StoreResult append_index(const uint16_t id, const uint16_t length, const uint32_t address);
+
+            /**
+             * @brief Merges the journal into the table of the inactive index copy and activates it.
+             *
+             * @return StoreResult Result of the merge.
+             */
+            StoreResult merge_index();
+
+            /**
+             * @brief Writes an empty index copy with the given sequence.
+             *
+             * @param[in] copy Index copy, `0` or `1`.
+             * @param[in] sequence Index sequence.
+             * @return bool `true` on success.
+             */
+            bool write_empty_index(const uint8_t copy, const uint32_t sequence);
+
+            /**
+             * @brief Validates the header and table CRC of an index copy.
+             *
+             * @param[in] copy Index copy, `0` or `1`.
+             * @param[out] sequence Index sequence.
+             * @param[out] count Number of table entries.
+             * @return bool `true` if the copy is valid.
+             */
+            bool check_index(const uint8_t copy, uint32_t& sequence, uint16_t& count);
+
+            /**
+             * @brief Appends a record to the head data sector, advancing and reclaiming sectors as needed.
+             *
+             * @param[in] id Code ID.
+             * @param[in] length Payload length.
+             * @param[in] crc Payload CRC-16.
+             * @param[out] address Address of the record header.
+             * @param[in] relocating `true` when called while reclaiming, allowing use of the reserve sector.
+             * @return StoreResult Result of the allocation.
+             */
+            StoreResult allocate(const uint16_t id, const uint16_t length, const uint16_t crc, uint32_t& address, const bool relocating);
+
+            /**
+             * @brief Relocates the live records of the tail data sector and erases it.
+             *
+             * @return StoreResult Result of the reclaim.
+             */
+            StoreResult reclaim_tail();
+
+            /**
+             * @brief Copies a record payload to a new address.
+             *
+             * @param[in] from Source payload address.
+             * @param[in] to Destination payload address.
+             * @param[in] length Payload length.
+             * @return bool `true` on success.
+             */
+            bool copy_payload(uint32_t from, uint32_t to, uint16_t length);
+
+            /**
+             * @brief Erases a data sector and writes a free sector header with the given erase count.
+             *
+             * @param[in] sector Data sector index.
+             * @param[in] erase_count Erase count to store.
+             * @return bool `true` on success.
+             */
+            bool reset_sector(const uint16_t sector, const uint32_t erase_count);
+
+            /**
+             * @brief Assigns the next allocation sequence to a free data sector and makes it the head.
+             *
+             * @param[in] sector Data sector index.
+             * @return bool `true` on success.
+             */
+            bool open_sector(const uint16_t sector);
+
+            /**
+             * @brief Returns the start address of a data sector.
+             *
+             * @param[in] sector Data sector index.
+             * @return uint32_t Sector start address.
+             */
+            uint32_t sector_address(const uint16_t sector) const;
+
+            /**
+             * @brief Returns the start address of an index copy.
+             *
+             * @param[in] copy Index copy, `0` or `1`.
+             * @return uint32_t Copy start address.
+             */
+            uint32_t index_address(const uint8_t copy) const;
+
+            /**
+             * @brief Returns the address of a journal entry of the active index copy.
+             *
+             * @param[in] slot Journal slot.
+             * @return uint32_t Journal entry address.
+             */
+            uint32_t journal_address(const uint16_t slot) const;
+
+            /**
+             * @brief Validates the device geometry and computes the layout.
+             *
+             * @return bool `true` if the geometry is supported.
+             */
+            bool configure();
+
+            SPIFlashDevice& device_; /**< @brief Flash device. */
+            uint8_t index_sectors_; /**< @brief Sectors per index copy. */
+            bool mounted_ = false; /**< @brief Set by a successful @ref begin() or @ref format(). */
+            uint8_t active_index_ = 0; /**< @brief Active index copy. */
+            uint16_t sector_size_ = 0; /**< @brief Device sector size. */
+            uint16_t data_sectors_ = 0; /**< @brief Number of data sectors. */
+            uint16_t table_capacity_ = 0; /**< @brief Maximum number of table entries per index copy. */
+            uint16_t table_count_ = 0; /**< @brief Entries in the table of the active copy. */
+            uint16_t journal_count_ = 0; /**< @brief Used journal slots of the active copy. */
+            uint16_t code_count_ = 0; /**< @brief Number of stored codes. */
+            uint32_t live_bytes_ = 0; /**< @brief Bytes taken by stored codes including their record headers. */
+            uint32_t index_sequence_ = 0; /**< @brief Sequence of the active copy. */
+            uint16_t head_sector_ = 0; /**< @brief Data sector receiving new records. */
+            uint16_t head_offset_ = 0; /**< @brief Offset of the next record within the head sector. */
+            uint16_t tail_sector_ = 0; /**< @brief Oldest data sector holding records. */
+            uint16_t used_sectors_ = 0; /**< @brief Data sectors holding records, including the head. */
+            uint32_t data_sequence_ = 0; /**< @brief Allocation sequence of the head sector. */
+            uint32_t cache_address_ = UINT32_MAX; /**< @brief Address of the cached line, `UINT32_MAX` if empty. */
+            uint8_t cache_[UIRB_CORE_SPI_FLASH_CACHE_SIZE]; /**< @brief Read cache line. */
+    };
+#endif  // defined(UIRB_CORE_SPI_FLASH) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_IRCodeStore_hpp
@@ -0,0 +1,138 @@
+/**
+ * @file UIRBcore_IRGate.hpp
+ * @brief Coordination of ADC measurements with IR transmission for the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::IRTransmitGate class. The IR sender of the application marks the start
+ * and end of every frame, and the ADC measurements of the library start their conversions only in the gaps between
+ * frames, once the supply has settled.
+ *
+ * @details
+ * - A transmission never waits for the ADC. A conversion is checked after it completes and is discarded if a frame
+ *   started meanwhile, then taken again in the next gap.
+ * - @ref uirbcore::BandgapSampleTask waits for a gap without blocking. The blocking measurements of
+ *   @ref uirbcore::UIRB wait for a gap and call `yield()` meanwhile.
+ * - The conversion of a single sample takes about 208 us at the ADC clock of 62.5 kHz, shorter than the gaps
+ *   between the frames and repeats of common IR protocols.
+ *
+ * @note Only compiled when @ref UIRB_CORE_IR_TX_GATE is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_IRGate_hpp
+#define UIRBcore_IRGate_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+
+namespace uirbcore
+{
+#if defined(UIRB_CORE_IR_TX_GATE) || defined(__DOXYGEN__)
+    /**
+     * @brief Static gate between the IR sender and the ADC measurements.
+     *
+     * Example usage, with an IR sender driving the carrier from its own code:
+     * @code
+     * IRTransmitGate::beginFrame();
+     * irSender.sendNEC(address, command);
+     * IRTransmitGate::endFrame();
+     * @endcode
+     *
+     * @note The frame marks are safe to call from interrupts, for senders running from a timer interrupt.
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class IRTransmitGate
+    {
+        public:
+            /**
+             * @brief Marks the start of an IR frame, before its first mark is sent.
+             *
+             * A conversion in progress is discarded once it completes.
+             */
+            static void beginFrame();
+
+            /**
+             * @brief Marks the end of an IR frame, after its last mark is sent.
+             *
+             * Conversions start again @ref UIRB_CORE_IR_TX_SETTLE_MICROSECONDS later.
+             */
+            static void endFrame();
+
+            /**
+             * @brief Checks if an IR frame is being sent.
+             *
+             * @return bool `true` between @ref beginFrame() and @ref endFrame().
+             */
+            static bool isTransmitting();
+
+            /**
+             * @brief Checks if a conversion can start now.
+             *
+             * @return bool `true` if no frame is being sent and the supply has settled after the last one.
+             */
+            static bool isQuiet();
+
+            /**
+             * @brief Starts a gated conversion if the gate is quiet.
+             *
+             * @param[out] frame_mark Frame counter, passed to @ref endSample() after the conversion.
+             * @return bool `true` if the conversion may start now.
+             */
+            static bool beginSample(uint8_t& frame_mark);
+
+            /**
+             * @brief Checks if a conversion started with @ref beginSample() was overlapped by a frame.
+             *
+             * @param[in] frame_mark Frame counter returned by @ref beginSample().
+             * @return bool `true` if the result is valid, `false` if it has to be discarded and taken again.
+             */
+            static bool endSample(const uint8_t frame_mark);
+
+            /**
+             * @brief Reads an analog pin in the next gap between frames, waiting for it if needed.
+             *
+             * `yield()` is called while waiting, as in `delay()`.
+             *
+             * @param[in] pin Analog pin, as for `analogRead()`.
+             * @return uint16_t Raw 10-bit ADC value of a conversion no frame overlapped.
+             */
+            static uint16_t analogReadInGap(const uint8_t pin);
+
+            /**
+             * @brief Returns the number of conversions discarded because a frame overlapped them, saturating.
+             *
+             * @return uint16_t Number of discarded conversions.
+             */
+            static uint16_t getDiscardedSamples();
+    };
+#endif  // defined(UIRB_CORE_IR_TX_GATE) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_IRGate_hpp
@@ -0,0 +1,201 @@
+/**
+ * @file UIRBcore_MemoryPlan.hpp
+ * @brief Static SRAM budget of the %UIRB system.
+ *
+ * This header defines @ref uirbcore::MemoryPlan, the size in bytes of every library buffer for the enabled
+ * features and configured buffer lengths, and checks at compile time that they fit into the SRAM of the
+ * ATmega328P together with @ref UIRB_CORE_STACK_RESERVE and @ref UIRB_CORE_APPLICATION_SRAM.
+ *
+ * @details
+ * - Every module owning a buffer checks with a `static_assert` that the buffer matches its size here, so the
+ *   plan cannot silently drift from the code.
+ * - The core object and the @ref uirbcore::IRCodeStore object are counted once each, as they are usually
+ *   global. The `Serial` object with its receive and transmit queues is counted if the core has one.
+ * - Counters and flags of a few bytes each are not listed and are covered by the stack reserve.
+ * - Define @ref UIRB_CORE_SRAM_REPORT to print the breakdown while compiling, so product variants can trade
+ *   buffers against each other.
+ *
+ * The buffer lengths themselves are configured in @ref UIRBcore_Defs.h.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_MemoryPlan_hpp
+#define UIRBcore_MemoryPlan_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore.hpp>
+
+namespace uirbcore
+{
+    /**
+     * @brief SRAM taken by each library buffer, in bytes, `0` for disabled features.
+     *
+     * Example usage, printing the remaining headroom at startup:
+     * @code
+     * Serial.println(MemoryPlan::UNPLANNED_BYTES);
+     * @endcode
+     *
+     * @note All members are static constants; the structure only groups them.
+     */
+    struct MemoryPlan
+    {
+        /**
+         * @brief SRAM of the ATmega328P.
+         */
+        static constexpr uint16_t SRAM_BYTES = RAMEND - RAMSTART + 1U;
+
+        /**
+         * @brief The @ref UIRB object, including the EEPROM image and the power information.
+         */
+        static constexpr uint16_t CORE_OBJECT_BYTES = sizeof(UIRB);
+
+        /**
+         * @brief `Serial` with its receive and transmit queues of the Arduino core.
+         */
+#if defined(HAVE_HWSERIAL0)
+        static constexpr uint16_t SERIAL_BYTES = sizeof(HardwareSerial);
+#else  // defined(HAVE_HWSERIAL0)
+        static constexpr uint16_t SERIAL_BYTES = 0;
+#endif  // defined(HAVE_HWSERIAL0)
+
+        /**
+         * @brief @ref Trace ring buffer with its header, in `.noinit`.
+         */
+#if defined(UIRB_CORE_TRACE)
+        static constexpr uint16_t TRACE_BYTES = 3U * sizeof(uint16_t) + UIRB_CORE_TRACE_ENTRIES * sizeof(TraceEntry);
+#else  // defined(UIRB_CORE_TRACE)
+        static constexpr uint16_t TRACE_BYTES = 0;
+#endif  // defined(UIRB_CORE_TRACE)
+
+        /**
+         * @brief @ref Profiler statistics of every probe.
+         */
+#if defined(UIRB_CORE_PROFILER)
+        static constexpr uint16_t PROFILER_BYTES = static_cast<uint8_t>(ProfileProbe::COUNT) * sizeof(ProfileStats);
+#else  // defined(UIRB_CORE_PROFILER)
+        static constexpr uint16_t PROFILER_BYTES = 0;
+#endif  // defined(UIRB_CORE_PROFILER)
+
+        /**
+         * @brief Post-mortem record of the @ref WatchdogSupervisor, in `.noinit`.
+         */
+#if defined(UIRB_CORE_WDT_SUPERVISOR)
+        static constexpr uint16_t POST_MORTEM_BYTES = 2U * sizeof(uint16_t) + sizeof(ResetRecord);
+#else  // defined(UIRB_CORE_WDT_SUPERVISOR)
+        static constexpr uint16_t POST_MORTEM_BYTES = 0;
+#endif  // defined(UIRB_CORE_WDT_SUPERVISOR)
+
+        /**
+         * @brief @ref WarmRestart copy of the EEPROM image and the power information, in `.noinit`.
+         */
+#if defined(UIRB_CORE_WARM_RESTART)
+        static constexpr uint16_t WARM_RESTART_BYTES = 2U * sizeof(uint16_t) + sizeof(eeprom::EEPROMData) + sizeof(PowerInfoData);
+#else  // defined(UIRB_CORE_WARM_RESTART)
+        static constexpr uint16_t WARM_RESTART_BYTES = 0;
+#endif  // defined(UIRB_CORE_WARM_RESTART)
+
+        /**
+         * @brief @ref PinArbiter holders and hold statistics of every shared pin.
+         */
+#if defined(UIRB_CORE_PIN_ARBITER)
+        static constexpr uint16_t PIN_ARBITER_BYTES = static_cast<uint8_t>(SharedPin::COUNT) *
+            (2U * (sizeof(PinOwner) + 2U * sizeof(uint8_t) + sizeof(uint32_t)) +
+             (static_cast<uint8_t>(PinOwner::COUNT) - 1U) * sizeof(PinHoldStats));
+#else  // defined(UIRB_CORE_PIN_ARBITER)
+        static constexpr uint16_t PIN_ARBITER_BYTES = 0;
+#endif  // defined(UIRB_CORE_PIN_ARBITER)
+
+        /**
+         * @brief @ref TimerManager handler slots.
+         */
+#if defined(UIRB_CORE_TIMER_MANAGER)
+        static constexpr uint16_t TIMER_SLOT_BYTES = UIRB_CORE_TIMER_HANDLER_SLOTS * (sizeof(TimerHandler) + sizeof(TimerClient));
+#else  // defined(UIRB_CORE_TIMER_MANAGER)
+        static constexpr uint16_t TIMER_SLOT_BYTES = 0;
+#endif  // defined(UIRB_CORE_TIMER_MANAGER)
+
+        /**
+         * @brief @ref TimerWheel slot lists of every level.
+         */
+#if defined(UIRB_CORE_TIMER_WHEEL)
+        static constexpr uint16_t TIMER_WHEEL_BYTES = UIRB_CORE_TIMER_WHEEL_LEVELS * TimerWheel::SLOTS_PER_LEVEL * sizeof(SoftTimer*);
+#else  // defined(UIRB_CORE_TIMER_WHEEL)
+        static constexpr uint16_t TIMER_WHEEL_BYTES = 0;
+#endif  // defined(UIRB_CORE_TIMER_WHEEL)
+
+        /**
+         * @brief @ref PinChangeDispatcher handler table and port snapshots of the three groups.
+         */
+#if defined(UIRB_CORE_PCINT_DISPATCHER)
+        static constexpr uint16_t PIN_CHANGE_BYTES = 3U * (8U * sizeof(PinChangeHandler) + 2U * sizeof(uint8_t));
+#else  // defined(UIRB_CORE_PCINT_DISPATCHER)
+        static constexpr uint16_t PIN_CHANGE_BYTES = 0;
+#endif  // defined(UIRB_CORE_PCINT_DISPATCHER)
+
+        /**
+         * @brief One @ref IRCodeStore object, including its read cache of @ref UIRB_CORE_SPI_FLASH_CACHE_SIZE bytes.
+         */
+#if defined(UIRB_CORE_SPI_FLASH)
+        static constexpr uint16_t IR_CODE_STORE_BYTES = sizeof(IRCodeStore);
+#else  // defined(UIRB_CORE_SPI_FLASH)
+        static constexpr uint16_t IR_CODE_STORE_BYTES = 0;
+#endif  // defined(UIRB_CORE_SPI_FLASH)
+
+        /**
+         * @brief Sum of all buffers above.
+         */
+        static constexpr uint16_t STATIC_BYTES = CORE_OBJECT_BYTES + SERIAL_BYTES + TRACE_BYTES + PROFILER_BYTES +
+            POST_MORTEM_BYTES + WARM_RESTART_BYTES + PIN_ARBITER_BYTES + TIMER_SLOT_BYTES + TIMER_WHEEL_BYTES +
+            PIN_CHANGE_BYTES + IR_CODE_STORE_BYTES;
+
+        /**
+         * @brief Bytes kept for the stack, @ref UIRB_CORE_STACK_RESERVE.
+         */
+        static constexpr uint16_t STACK_RESERVE_BYTES = UIRB_CORE_STACK_RESERVE;
+
+        /**
+         * @brief Bytes of the application, @ref UIRB_CORE_APPLICATION_SRAM.
+         */
+        static constexpr uint16_t APPLICATION_BYTES = UIRB_CORE_APPLICATION_SRAM;
+
+        static_assert(static_cast<uint32_t>(STATIC_BYTES) + STACK_RESERVE_BYTES + APPLICATION_BYTES <= SRAM_BYTES,
+                      "Library buffers, UIRB_CORE_STACK_RESERVE and UIRB_CORE_APPLICATION_SRAM do not fit into SRAM. "
+                      "Define UIRB_CORE_SRAM_REPORT for the breakdown and shrink or disable a buffer.");
+
+        /**
+         * @brief SRAM left after the buffers and both reserves, available to either the stack or the application.
+         */
+        static constexpr uint16_t UNPLANNED_BYTES = SRAM_BYTES - STATIC_BYTES - STACK_RESERVE_BYTES - APPLICATION_BYTES;
+    };
+}  // namespace uirbcore
+
+#endif  // UIRBcore_MemoryPlan_hpp
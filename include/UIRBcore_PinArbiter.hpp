@@ -0,0 +1,236 @@
+/**
+ * @file UIRBcore_PinArbiter.hpp
+ * @brief Ownership arbiter for the shared pins of the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::PinArbiter class, which coordinates the pins shared between the
+ * status LED, the IR receiver, the UART and the SPI bus on the %UIRB board V0.2:
+ * - @ref PIN_STAT_LED is @ref PIN_SPI_SCK.
+ * - @ref PIN_IR_RECEIVE defaults to @ref PIN_SPI_MISO.
+ * - @ref PIN_TX can be used as the SPI slave select.
+ *
+ * @details
+ * Owners claim a set of pins with a priority. A claim of a pin held with a lower priority preempts the holder:
+ * its pin state is saved and restored as soon as the preempting owner releases the pin, so the preempted
+ * owner continues without reconfiguring anything. Switching only saves and restores port bits and peripheral
+ * enable bits, with two exceptions:
+ * - Taking @ref PIN_SPI_SCK from the SPI bus clears `SPE`, as the SPI peripheral drives SCK while enabled.
+ * - Taking @ref PIN_TX from the UART masks the transmit buffer interrupt, waits for the frame being shifted out
+ *   and disables the transmitter. The wait of up to two frame times runs before the critical section of the
+ *   claim, with interrupts as the caller left them, and the claim fails if `Serial` refilled the data register
+ *   meanwhile. Buffered `Serial` data is sent after the pin is given back, not lost.
+ *   `Serial` must not be written while another owner holds the pin, as bytes written to the data register
+ *   with the transmitter disabled are dropped.
+ *
+ * @note Only compiled when @ref UIRB_CORE_PIN_ARBITER is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_PinArbiter_hpp
+#define UIRBcore_PinArbiter_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_Pins.h>
+
+namespace uirbcore
+{
+    /**
+     * @brief Enum class identifying the shared pins, as `uint8_t`.
+     */
+    enum class SharedPin : uint8_t
+    {
+        STAT_LED_SCK = 0, /**< @ref PIN_STAT_LED / @ref PIN_SPI_SCK (PB5). */
+        IR_RECEIVE_MISO, /**< @ref PIN_IR_RECEIVE / @ref PIN_SPI_MISO (PB4). */
+        TX_SLAVE_SELECT, /**< @ref PIN_TX / SPI slave select (PD1). */
+        COUNT /**< Number of shared pins. */
+    };
+
+    /**
+     * @brief Enum class identifying the owners of shared pins, as `uint8_t`.
+     */
+    enum class PinOwner : uint8_t
+    {
+        NONE = 0, /**< The pin is not claimed. */
+        STATUS_LED, /**< Status LED patterns, e.g. @ref UIRB::notifyStatusLowBattery(). */
+        IR_RECEIVER, /**< IR receiver decoding a frame. */
+        UART, /**< UART transmitter (`Serial`). */
+        SPI, /**< SPI bus, e.g. @ref JedecSPIFlash. */
+        APPLICATION, /**< Application code. */
+        COUNT /**< Number of owners including @ref NONE. */
+    };
+
+    /**
+     * @brief Returns the bit of a shared pin in a pin set.
+     *
+     * @param[in] pin Shared pin.
+     * @return uint8_t Pin set containing only @p pin.
+     */
+    constexpr uint8_t sharedPinMask(const SharedPin pin)
+    {
+        return 1U << static_cast<uint8_t>(pin);
+    }
+
+    /**
+     * @brief Hold time statistics of one owner on one shared pin.
+     */
+    struct PinHoldStats
+    {
+        uint32_t total_microseconds; /**< Total time the pin was held, including time spent preempted. */
+        uint32_t max_microseconds; /**< Longest single hold. */
+        uint16_t claims; /**< Number of granted claims. */
+        uint8_t preemptions; /**< Number of times the owner was preempted, saturating at 255. */
+    };
+
+#if defined(UIRB_CORE_PIN_ARBITER) || defined(__DOXYGEN__)
+    /**
+     * @brief Static arbiter granting shared pins to owners by priority.
+     *
+     * Example usage:
+     * @code
+     * if (PinArbiter::claim(PinOwner::STATUS_LED, sharedPinMask(SharedPin::STAT_LED_SCK)))
+     * {
+     *     digitalWrite(PIN_STAT_LED, HIGH);
+     *     delay(50);
+     *     PinArbiter::release(PinOwner::STATUS_LED, sharedPinMask(SharedPin::STAT_LED_SCK));
+     * }
+     * @endcode
+     *
+     * @note Claims and releases are atomic and can be used from interrupts.
+     * @note Only one level of preemption is supported per pin. A claim fails if the pin is already preempted.
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class PinArbiter
+    {
+        public:
+            /**
+             * @brief Claims all pins of a set, or none of them.
+             *
+             * Pins already held by @p owner are kept and their priority is updated.
+             *
+             * @param[in] owner Claiming owner, not @ref PinOwner::NONE.
+             * @param[in] pins Pin set built with @ref sharedPinMask().
+             * @param[in] priority Claim priority, higher values preempt lower ones.
+             * @return bool
+             * @retval true All pins are held by @p owner.
+             * @retval false A pin is held with an equal or higher priority or is already preempted, or `Serial` wrote
+             *         to the data register while @ref PIN_TX was being drained.
+             */
+            static bool claim(const PinOwner owner, const uint8_t pins, const uint8_t priority);
+
+            /**
+             * @brief Claims pins with the default priority of the owner.
+             *
+             * @param[in] owner Claiming owner.
+             * @param[in] pins Pin set built with @ref sharedPinMask().
+             * @return bool `true` if all pins are held by @p owner.
+             *
+             * @see @ref getDefaultPriority()
+             */
+            static bool claim(const PinOwner owner, const uint8_t pins)
+            {
+                return PinArbiter::claim(owner, pins, PinArbiter::getDefaultPriority(owner));
+            }
+
+            /**
+             * @brief Releases pins held or preempted from an owner, restoring their previous state.
+             *
+             * Pins of the set not claimed by @p owner are ignored.
+             *
+             * @param[in] owner Releasing owner.
+             * @param[in] pins Pin set built with @ref sharedPinMask().
+             */
+            static void release(const PinOwner owner, const uint8_t pins);
+
+            /**
+             * @brief Returns the owner currently driving a pin.
+             *
+             * @param[in] pin Shared pin.
+             * @return PinOwner Active owner, @ref PinOwner::NONE if the pin is free.
+             */
+            static PinOwner getOwner(const SharedPin pin);
+
+            /**
+             * @brief Checks if an owner currently drives all pins of a set.
+             *
+             * @param[in] owner Owner.
+             * @param[in] pins Pin set built with @ref sharedPinMask().
+             * @return bool `true` if @p owner is the active owner of every pin in @p pins.
+             */
+            static bool isOwner(const PinOwner owner, const uint8_t pins);
+
+            /**
+             * @brief Checks and clears the preemption flag of an owner.
+             *
+             * The flag is set whenever another owner takes a pin from @p owner. An IR receiver should discard
+             * the current frame if it was set.
+             *
+             * @param[in] owner Owner.
+             * @return bool `true` if @p owner was preempted since the last call.
+             */
+            static bool consumePreempted(const PinOwner owner);
+
+            /**
+             * @brief Returns the default claim priority of an owner.
+             *
+             * @ref PinOwner::IR_RECEIVER is highest as a frame cannot be repeated, followed by
+             * @ref PinOwner::SPI, @ref PinOwner::APPLICATION, @ref PinOwner::UART and @ref PinOwner::STATUS_LED.
+             *
+             * @param[in] owner Owner.
+             * @return uint8_t Default priority.
+             */
+            static uint8_t getDefaultPriority(const PinOwner owner);
+
+            /**
+             * @brief Reads the hold time statistics of an owner on a pin. Holds in progress are not included.
+             *
+             * @param[in] pin Shared pin.
+             * @param[in] owner Owner, not @ref PinOwner::NONE.
+             * @param[out] stats Statistics.
+             * @return bool `false` if @p pin or @p owner is invalid.
+             */
+            static bool getStats(const SharedPin pin, const PinOwner owner, PinHoldStats& stats);
+
+            /**
+             * @brief Clears all hold time statistics.
+             */
+            static void resetStats();
+
+            /**
+             * @brief Prints the current owners and the hold time statistics as a table.
+             *
+             * @param[in] output Output stream, e.g. `Serial`.
+             */
+            static void dump(Print& output);
+    };
+#endif  // defined(UIRB_CORE_PIN_ARBITER) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_PinArbiter_hpp
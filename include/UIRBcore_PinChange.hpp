@@ -0,0 +1,119 @@
+/**
+ * @file UIRBcore_PinChange.hpp
+ * @brief Shared pin change interrupt dispatcher of the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::PinChangeDispatcher class. The ATmega328P has a single interrupt vector
+ * per pin change group, and a vector can only be defined once in a program, so the library owns the `PCINT0_vect`,
+ * `PCINT1_vect` and `PCINT2_vect` vectors and calls handlers registered per pin. The @ref uirbcore::UIRB wakeup on
+ * @ref PIN_USB_IO3 is one of these handlers, and application code and other libraries register their own.
+ *
+ * @details
+ * Each group interrupt reads its input port once and finds the changed pins with one XOR against the port value
+ * of the previous interrupt, masked with the registered pins. Only the handlers of changed pins are called, in
+ * order of their bit in the port.
+ *
+ * Without the dispatcher, the library defines `PCINT2_vect` for the wakeup alone. Libraries defining the pin
+ * change vectors themselves, such as SoftwareSerial, link together with the library if
+ * @ref UIRB_CORE_NO_PCINT_VECTORS is defined instead.
+ *
+ * @note Only compiled when @ref UIRB_CORE_PCINT_DISPATCHER is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_PinChange_hpp
+#define UIRBcore_PinChange_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+
+namespace uirbcore
+{
+    /**
+     * @brief Pin change handler, called from the group interrupt with interrupts disabled.
+     *
+     * @param[in] pin Arduino pin number which changed.
+     * @param[in] level `true` if the pin reads high.
+     */
+    typedef void (*PinChangeHandler)(const uint8_t pin, const bool level);
+
+#if defined(UIRB_CORE_PCINT_DISPATCHER) || defined(__DOXYGEN__)
+    /**
+     * @brief Static dispatcher of the three pin change interrupt groups to per-pin handlers.
+     *
+     * Example usage, counting the edges of a signal on pin 7:
+     * @code
+     * volatile uint16_t edges = 0;
+     * void countEdge(const uint8_t pin, const bool level) { edges++; }
+     *
+     * PinChangeDispatcher::attach(7, countEdge);
+     * @endcode
+     *
+     * @note A pulse shorter than the interrupt latency reads the same level as the snapshot and is not reported.
+     * With @ref UIRB_CORE_IRQ_PRIORITY, the handlers run with interrupts enabled and their own group masked.
+     * @note The handler table takes 48 bytes of RAM.
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class PinChangeDispatcher
+    {
+        public:
+            /**
+             * @brief Registers the handler of a pin and enables its pin change interrupt.
+             *
+             * The current level of the pin becomes the reference of the next interrupt. The pin mode is not changed.
+             *
+             * @param[in] pin Arduino pin number, `0` to `21`.
+             * @param[in] handler Handler called on every change of @p pin.
+             * @return bool
+             * @retval true The handler is registered.
+             * @retval false @p pin has no pin change interrupt, @p handler is `nullptr`, or the pin already has a
+             * handler.
+             */
+            static bool attach(const uint8_t pin, const PinChangeHandler handler);
+
+            /**
+             * @brief Removes the handler of a pin. The group interrupt is disabled with the last pin of the group.
+             *
+             * @param[in] pin Arduino pin number.
+             */
+            static void detach(const uint8_t pin);
+
+            /**
+             * @brief Checks if a pin has a handler.
+             *
+             * @param[in] pin Arduino pin number.
+             * @return bool `true` if attached.
+             */
+            static bool isAttached(const uint8_t pin);
+    };
+#endif  // defined(UIRB_CORE_PCINT_DISPATCHER) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_PinChange_hpp
@@ -196,6 +196,13 @@ namespace uirbcore
              * 
              * @note The sampled data includes supply voltage, @ref PIN_PROG pin voltage, and estimated charging current.
              *       If data is valid, the estimated charger and battery states are also updated.
+             * @note With @ref UIRB_CORE_BATTERY_CYCLES or @ref UIRB_CORE_CHARGE_LOG, every valid update also integrates
+             *       the charging current into @ref PowerInfoData::getChargedMilliampSeconds(), so update regularly
+             *       while charging.
+             * @note With @ref UIRB_CORE_BATTERY_CYCLES, every valid update also advances the charge cycle tracking of
+             *       @ref BatteryHealth.
+             * @note With @ref UIRB_CORE_CHARGE_LOG, every valid update also advances the charging session of
+             *       @ref ChargeSessionLog.
              * 
              * @see @ref PowerInfoData::isValid() For checking if the sampled data is valid after calling @ref PowerInfoData::update().
              * @see @ref UIRB::getSupplyVoltageMilivolts() For retrieving supply voltage values used in sampling.
@@ -357,12 +364,36 @@ namespace uirbcore
              */
             ChargerState getChargerState() const;
 
+#if defined(UIRB_CORE_BATTERY_CYCLES) || defined(UIRB_CORE_CHARGE_LOG) || defined(__DOXYGEN__)
+            /**
+             * @brief Returns the charge delivered to the battery since reset.
+             * 
+             * Every valid @ref PowerInfoData::update() of any instance integrates the charging current of the 
+             * previous valid update over the time between both, measured with @ref UIRB::getUptimeMilliseconds() 
+             * so the time spent in @ref UIRB::powerDown() is counted. Only the time after an update which saw 
+             * the battery charging (@ref PowerInfoData::isBatteryCharging()) is integrated.
+             * 
+             * @return uint32_t Charge in milliamp seconds, wrapping. Use the difference of two calls.
+             * 
+             * @note Only available with @ref UIRB_CORE_BATTERY_CYCLES or @ref UIRB_CORE_CHARGE_LOG defined, which 
+             *       both read this total.
+             */
+            static uint32_t getChargedMilliampSeconds();
+#endif  // defined(UIRB_CORE_BATTERY_CYCLES) || defined(UIRB_CORE_CHARGE_LOG) || defined(__DOXYGEN__)
+
         private:
             /**
              * @brief Friend class providing access to internal data and methods of this class.
              */
             friend class UIRB;
 
+#if defined(UIRB_CORE_POWER_MONITOR)
+            /**
+             * @brief Grants @ref PowerMonitor the read of the integer measurements to compare two updates.
+             */
+            friend class PowerMonitor;
+#endif  // defined(UIRB_CORE_POWER_MONITOR)
+
             /**
              * @brief Supply voltage in millivolts measured on the `AVcc` MCU pin.
              * 
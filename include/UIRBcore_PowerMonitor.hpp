@@ -0,0 +1,162 @@
+/**
+ * @file UIRBcore_PowerMonitor.hpp
+ * @brief Adaptive rate power monitor of the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::PowerMonitor class. It updates the power information of
+ * @ref uirbcore::UIRB::getPowerInfo() at a period which follows the readings instead of a fixed polling rate:
+ * - A charger or battery state change, an invalid update and the first update set the period to
+ *   @ref UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS.
+ * - A supply voltage change of at least @ref uirbcore::PowerMonitor::VOLTAGE_DELTA_MILIVOLTS or a charging current
+ *   change of at least @ref uirbcore::PowerMonitor::CURRENT_DELTA_MILIAMPS since the previous update halves it.
+ * - Any other update doubles it, up to @ref UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS.
+ *
+ * @details
+ * The period runs on a @ref uirbcore::SoftTimer, so @ref uirbcore::UIRB::powerDown() wakes up for the next update
+ * by itself and the time spent asleep counts. The timer only marks the update as due; the ADC is used from
+ * @ref uirbcore::PowerMonitor::poll(), called from `loop()`. With the default bounds, an idle board on battery
+ * settles at one update per 10 minutes after about 10 flat updates, instead of one per second.
+ *
+ * A charger plugged in while the board is idle is seen at the next update at the latest. Events known to the
+ * application, such as a @ref PIN_USB_IO3 wakeup, can ask for an update right away with
+ * @ref uirbcore::PowerMonitor::requestUpdate().
+ *
+ * @note Only compiled when @ref UIRB_CORE_POWER_MONITOR is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_PowerMonitor_hpp
+#define UIRBcore_PowerMonitor_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_PowerInfoData.hpp>
+
+namespace uirbcore
+{
+    class UIRB;
+
+#if defined(UIRB_CORE_POWER_MONITOR) || defined(__DOXYGEN__)
+    /**
+     * @brief Static power information updater with a period adapting to the readings.
+     *
+     * Example usage:
+     * @code
+     * void setup()
+     * {
+     *     TimerWheel::begin();
+     *     PowerMonitor::begin();
+     *     uirb.setIO3WakeupCallback([]() { PowerMonitor::requestUpdate(); });
+     * }
+     *
+     * void loop()
+     * {
+     *     const PowerInfoData* power = PowerMonitor::poll(uirb);
+     *     if (power != nullptr && power->isBatteryLow()) { ... }
+     *     uirb.powerDown(UIRB::SLEEP_FOREVER, WakeupInterrupt::WAKE_BUTTON_AND_USB_IO3);
+     * }
+     * @endcode
+     *
+     * @note Updates made outside of the monitor, through @ref UIRB::getPowerInfo(), are not seen by it.
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class PowerMonitor
+    {
+        public:
+            /**
+             * @brief Number of ADC samples averaged by each update.
+             */
+            static constexpr uint8_t SAMPLES = 5;
+
+            /**
+             * @brief Supply voltage change between two updates which halves the period, about two ADC steps at 4V.
+             */
+            static constexpr uint16_t VOLTAGE_DELTA_MILIVOLTS = 30;
+
+            /**
+             * @brief Charging current change between two updates which halves the period.
+             */
+            static constexpr uint16_t CURRENT_DELTA_MILIAMPS = 10;
+
+            /**
+             * @brief Shortest period, from @ref UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS.
+             */
+            static constexpr uint32_t MIN_PERIOD_MILLISECONDS = UIRB_CORE_POWER_MONITOR_MIN_PERIOD_MS;
+
+            /**
+             * @brief Longest period, from @ref UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS.
+             */
+            static constexpr uint32_t MAX_PERIOD_MILLISECONDS = UIRB_CORE_POWER_MONITOR_MAX_PERIOD_SECONDS * 1000UL;
+
+            /**
+             * @brief Starts the monitor with an update due right away and the shortest period.
+             *
+             * @note @ref TimerWheel::begin() must have succeeded before.
+             */
+            static void begin();
+
+            /**
+             * @brief Stops the monitor. @ref poll() does nothing until the next @ref begin().
+             */
+            static void end();
+
+            /**
+             * @brief Updates the power information if an update is due and schedules the next one.
+             *
+             * @param[in,out] uirb Core instance, used to sample the power information.
+             * @return const PowerInfoData* Power information of the update, `nullptr` if no update was due.
+             */
+            static const PowerInfoData* poll(UIRB& uirb);
+
+            /**
+             * @brief Makes the next @ref poll() update, regardless of the period.
+             *
+             * @note Safe to call from an interrupt.
+             */
+            static void requestUpdate();
+
+            /**
+             * @brief Returns the period until the update after the last one.
+             *
+             * @return uint32_t Period in milliseconds.
+             */
+            static uint32_t getPeriodMilliseconds();
+
+            /**
+             * @brief Returns the number of updates since @ref begin().
+             *
+             * @return uint32_t Number of updates. Multiplied by the time of one update, it gives the ADC on time.
+             */
+            static uint32_t getUpdateCount();
+    };
+#endif  // defined(UIRB_CORE_POWER_MONITOR) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_PowerMonitor_hpp
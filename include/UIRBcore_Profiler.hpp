@@ -0,0 +1,305 @@
+/**
+ * @file UIRBcore_Profiler.hpp
+ * @brief Low-overhead hot-path profiler for the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::Profiler class and the @ref UIRB_PROFILE_SCOPE macro. Library hot
+ * paths (ADC sampling, power information updates, EEPROM commits, interrupt handlers and sleep entry) are
+ * instrumented with probes which read the free-running Timer1 counter on entry and exit.
+ *
+ * @details
+ * For every probe the profiler accumulates:
+ * - **count**: Number of recorded executions (saturating at `65535`).
+ * - **min / max**: Shortest and longest execution time in Timer1 ticks.
+ * - **histogram**: 8 saturating `uint8_t` buckets with base-4 (log4) bounds `<4, <16, <64, <256, <1K, <4K, <16K, >=16K` ticks.
+ *
+ * With @ref UIRB_CORE_DEBUG_STROBE, the same probes also drive @ref PIN_PULLDOWN_RESISTOR through
+ * @ref uirbcore::StrobeScope, for timing measurements with a logic analyzer or simavr.
+ *
+ * @note The profiler is only compiled when @ref UIRB_CORE_PROFILER is defined. Otherwise
+ * @ref UIRB_PROFILE_SCOPE expands to nothing and no RAM or flash is used.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_Profiler_hpp
+#define UIRBcore_Profiler_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_Pins.h>
+#include <UIRBcore_Timers.hpp>
+#include <util/atomic.h>
+
+namespace uirbcore
+{
+    /**
+     * @brief Enum class identifying the instrumented library hot paths, as `uint8_t`.
+     */
+    enum class ProfileProbe : uint8_t
+    {
+        ADC_BANDGAP = 0, /**< Sampling of the internal bandgap reference against AVcc. */
+        ADC_PROG, /**< Sampling of the charger `PROG` pin voltage. */
+        POWER_INFO_UPDATE, /**< @ref PowerInfoData::update() */
+        EEPROM_COMMIT, /**< Writing and verifying @ref eeprom::EEPROMData in EEPROM. */
+        POWER_DOWN, /**< @ref UIRB::powerDown() excluding the time spent asleep, as Timer1 is stopped in power-down. */
+        ISR_BUTTON_WAKEUP, /**< Wakeup button interrupt handler. */
+        ISR_PCINT2, /**< Pin change interrupt handler of the `PCINT2` group. */
+        ISR_WDT, /**< Watchdog interrupt handler. */
+        SLEEP, /**< Wake edge, marked right after the MCU leaves sleep mode. Counts the wakeups; the time asleep is not measured, as Timer1 is stopped in power-down. */
+        COUNT /**< Number of probes, not a valid probe. */
+    };
+
+#if defined(UIRB_CORE_PROFILER) || defined(__DOXYGEN__)
+    /**
+     * @brief Statistics accumulated for a single @ref ProfileProbe.
+     */
+    struct ProfileStats
+    {
+        uint16_t count; /**< @brief Number of recorded executions, saturating. */
+        uint16_t min_ticks; /**< @brief Shortest execution time in Timer1 ticks. */
+        uint16_t max_ticks; /**< @brief Longest execution time in Timer1 ticks. */
+        uint8_t histogram[8]; /**< @brief Saturating base-4 histogram, bucket `i` counts durations below `4^(i+1)` ticks. */
+    };
+
+    /**
+     * @brief Timer1-based profiler accumulating per-probe execution time statistics.
+     *
+     * @details
+     * - @ref begin() starts Timer1 in normal (free-running) mode with the prescaler selected by 
+     *   @ref UIRB_CORE_PROFILER_PRESCALER. The counter can be shared with code using Timer1 in normal mode 
+     *   with the same prescaler (e.g. input capture on @ref PIN_IR_CAPTURE), but not with code reconfiguring it.
+     * - Durations are measured modulo `65536` ticks. Longer executions wrap around, choose a larger 
+     *   prescaler if a probe may exceed this limit.
+     * - Recording takes about 40 cycles with interrupts disabled, nested probes (e.g. an ISR interrupting 
+     *   an ADC probe) are supported but the outer probe includes the time spent in the inner one.
+     *
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class Profiler
+    {
+        public:
+            /**
+             * @brief Starts Timer1 as a free-running counter and clears all statistics.
+             *
+             * With @ref UIRB_CORE_TIMER_MANAGER defined, Timer1 is acquired as @ref TimerClient::PROFILER in
+             * @ref TimerMode::FREE_RUNNING, so other clients can share the counter and its vectors.
+             *
+             * @return bool `false` if Timer1 is held by another client in another mode or with another prescaler.
+             */
+            static bool begin();
+
+            /**
+             * @brief Clears all statistics.
+             */
+            static void reset();
+
+            /**
+             * @brief Returns the current Timer1 counter value.
+             *
+             * The 16-bit register is read with interrupts disabled, as an interrupt reading Timer1 between 
+             * the low and high byte accesses would corrupt the shared `TEMP` register.
+             *
+             * @return uint16_t Current Timer1 counter value.
+             */
+            static uint16_t now()
+            {
+                uint16_t ticks;
+                ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+                {
+                    ticks = TCNT1;
+                }
+                return ticks;
+            }
+
+            /**
+             * @brief Records one execution of a probe.
+             *
+             * @param[in] probe Probe that finished.
+             * @param[in] ticks Execution time in Timer1 ticks.
+             */
+            static void record(const ProfileProbe probe, const uint16_t ticks);
+
+            /**
+             * @brief Copies the statistics of a probe.
+             *
+             * @param[in] probe Probe to read.
+             * @param[out] stats Destination for the statistics.
+             * @return bool
+             * @retval true The statistics were copied.
+             * @retval false @p probe is not a valid probe.
+             */
+            static bool getStats(const ProfileProbe probe, ProfileStats& stats);
+
+            /**
+             * @brief Prints a table of all probes to @p output.
+             *
+             * The first line holds the Timer1 tick period in nanoseconds, followed by one line per probe with 
+             * its name, count, min, max and histogram buckets separated by tabs.
+             *
+             * @param[in] output Destination, e.g. `Serial`.
+             */
+            static void dump(Print& output);
+
+            /**
+             * @brief Duration of one Timer1 tick in nanoseconds.
+             */
+            static constexpr uint32_t TICK_NANOSECONDS = (UIRB_CORE_PROFILER_PRESCALER * 1000000000ULL) / F_CPU;
+    };
+
+    /**
+     * @brief Scope guard recording the lifetime of a block as one execution of a probe.
+     *
+     * @note Use @ref UIRB_PROFILE_SCOPE instead of instantiating this class directly.
+     */
+    class ProfileScope
+    {
+        public:
+            /**
+             * @brief Captures the start time of the probe.
+             *
+             * @param[in] probe Probe to record when the scope ends.
+             */
+            explicit ProfileScope(const ProfileProbe probe) : probe_(probe), start_ticks_(Profiler::now()) {}
+
+            /**
+             * @brief Records the elapsed time since construction.
+             */
+            ~ProfileScope()
+            {
+                Profiler::record(this->probe_, Profiler::now() - this->start_ticks_);
+            }
+
+            ProfileScope(const ProfileScope&) = delete;
+            void operator=(const ProfileScope&) = delete;
+
+        private:
+            const ProfileProbe probe_; /**< @brief Probe recorded by this scope. */
+            const uint16_t start_ticks_; /**< @brief Timer1 counter value at construction. */
+    };
+#endif  // defined(UIRB_CORE_PROFILER) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#if defined(UIRB_CORE_DEBUG_STROBE) || defined(__DOXYGEN__)
+namespace uirbcore
+{
+    /**
+     * @brief Scope driving @ref PIN_PULLDOWN_RESISTOR high while a probe selected by @ref UIRB_CORE_DEBUG_STROBE runs.
+     *
+     * `GPIOR0` holds the value of the innermost running probe plus one, `0` outside of all probes. A nested
+     * scope restores the value of the enclosing one and keeps the pin high.
+     *
+     * @tparam probe Probe of the scope. Scopes of probes not selected compile to nothing.
+     */
+    template <ProfileProbe probe>
+    class StrobeScope
+    {
+        public:
+            /**
+             * @brief `true` if @ref UIRB_CORE_DEBUG_STROBE selects @p probe.
+             */
+            static constexpr bool ENABLED = (UIRB_CORE_DEBUG_STROBE >> static_cast<uint8_t>(probe)) & 1U;
+
+            /**
+             * @brief Marks the start of the probe.
+             */
+            StrobeScope()
+            {
+                if (ENABLED)
+                {
+                    this->previous_ = GPIOR0;
+                    GPIOR0 = static_cast<uint8_t>(probe) + 1U;
+                    PORTD |= _BV(PORTD5);
+                }
+            }
+
+            /**
+             * @brief Marks the end of the probe.
+             */
+            ~StrobeScope()
+            {
+                if (ENABLED)
+                {
+                    GPIOR0 = this->previous_;
+                    if (this->previous_ == 0)
+                    {
+                        PORTD &= ~_BV(PORTD5);
+                    }
+                }
+            }
+
+            StrobeScope(const StrobeScope&) = delete;
+            void operator=(const StrobeScope&) = delete;
+
+        private:
+            uint8_t previous_ = 0; /**< @brief `GPIOR0` of the enclosing probe. */
+    };
+
+    static_assert(PIN_PULLDOWN_RESISTOR == 5, "The debug strobe is driven with PORTD5.");
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_DEBUG_STROBE) || defined(__DOXYGEN__)
+
+/**
+ * @def UIRB_PROFILE_CONCAT(a, b)
+ * @brief Concatenates two tokens after macro expansion. Helper for @ref UIRB_PROFILE_SCOPE.
+ */
+#define UIRB_PROFILE_CONCAT_IMPL(a, b) a##b
+#define UIRB_PROFILE_CONCAT(a, b) UIRB_PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * @def UIRB_PROFILE_TIMER_SCOPE(probe)
+ * @brief Profiler part of @ref UIRB_PROFILE_SCOPE.
+ */
+#if defined(UIRB_CORE_PROFILER)
+    #define UIRB_PROFILE_TIMER_SCOPE(probe) const uirbcore::ProfileScope UIRB_PROFILE_CONCAT(uirb_profile_scope_, __LINE__)(uirbcore::ProfileProbe::probe)
+#else  // defined(UIRB_CORE_PROFILER)
+    #define UIRB_PROFILE_TIMER_SCOPE(probe) do {} while (0)
+#endif  // defined(UIRB_CORE_PROFILER)
+
+/**
+ * @def UIRB_PROFILE_STROBE_SCOPE(probe)
+ * @brief Debug strobe part of @ref UIRB_PROFILE_SCOPE.
+ */
+#if defined(UIRB_CORE_DEBUG_STROBE)
+    #define UIRB_PROFILE_STROBE_SCOPE(probe) const uirbcore::StrobeScope<uirbcore::ProfileProbe::probe> UIRB_PROFILE_CONCAT(uirb_strobe_scope_, __LINE__)
+#else  // defined(UIRB_CORE_DEBUG_STROBE)
+    #define UIRB_PROFILE_STROBE_SCOPE(probe) do {} while (0)
+#endif  // defined(UIRB_CORE_DEBUG_STROBE)
+
+/**
+ * @def UIRB_PROFILE_SCOPE(probe)
+ * @brief Records the execution time of the enclosing block as one execution of @p probe.
+ *
+ * @param probe Name of a @ref uirbcore::ProfileProbe enumerator, e.g. `ADC_BANDGAP`.
+ *
+ * @note Expands to nothing when neither @ref UIRB_CORE_PROFILER nor @ref UIRB_CORE_DEBUG_STROBE is defined.
+ */
+#define UIRB_PROFILE_SCOPE(probe) UIRB_PROFILE_TIMER_SCOPE(probe); UIRB_PROFILE_STROBE_SCOPE(probe)
+
+#endif  // UIRBcore_Profiler_hpp
@@ -0,0 +1,335 @@
+/**
+ * @file UIRBcore_SPIFlash.hpp
+ * @brief SPI NOR flash device abstraction, JEDEC driver and simulated device for the %UIRB system.
+ *
+ * This header declares:
+ * - @ref uirbcore::SPIFlashDevice : Minimal NOR flash interface (read, page program, sector erase) used by
+ *   @ref uirbcore::IRCodeStore.
+ * - @ref uirbcore::JedecSPIFlash : Driver for JEDEC compatible SPI NOR flash chips (W25Qxx, GD25Qxx, ...) on the
+ *   hardware SPI pins of the %UIRB board, with @ref PIN_TX as the default slave select.
+ * - @ref uirbcore::SimulatedSPIFlash : RAM backed device with NOR semantics and power loss injection, used to
+ *   exercise the storage code in simavr without hardware.
+ *
+ * @note Only compiled when @ref UIRB_CORE_SPI_FLASH is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_SPIFlash_hpp
+#define UIRBcore_SPIFlash_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_Pins.h>
+#include <UIRBcore_PinArbiter.hpp>
+
+namespace uirbcore
+{
+#if defined(UIRB_CORE_SPI_FLASH) || defined(__DOXYGEN__)
+    /**
+     * @brief Minimal SPI NOR flash interface.
+     *
+     * @details
+     * Implementations must follow NOR flash semantics:
+     * - Erasing a sector sets all its bytes to `0xFF`.
+     * - Programming can only clear bits, i.e. the stored value becomes `old & new`.
+     * - A single @ref program() call must not cross a page boundary.
+     */
+    class SPIFlashDevice
+    {
+        public:
+            /**
+             * @brief Reads bytes from the device.
+             *
+             * @param[in] address Start address.
+             * @param[out] data Destination buffer.
+             * @param[in] length Number of bytes to read.
+             * @return bool `true` on success, `false` if the range is invalid or the device did not respond.
+             */
+            virtual bool read(const uint32_t address, void* data, const uint16_t length) = 0;
+
+            /**
+             * @brief Programs bytes within a single page.
+             *
+             * @param[in] address Start address.
+             * @param[in] data Source buffer.
+             * @param[in] length Number of bytes, the range must not cross a page boundary.
+             * @return bool `true` on success, `false` if the range is invalid or the operation timed out.
+             */
+            virtual bool program(const uint32_t address, const void* data, const uint16_t length) = 0;
+
+            /**
+             * @brief Erases the sector containing @p address.
+             *
+             * @param[in] address Any address within the sector.
+             * @return bool `true` on success, `false` if the address is invalid or the operation timed out.
+             */
+            virtual bool eraseSector(const uint32_t address) = 0;
+
+            /**
+             * @brief Returns the device capacity in bytes, `0` if unknown.
+             *
+             * @return uint32_t Capacity in bytes.
+             */
+            virtual uint32_t capacity() const = 0;
+
+            /**
+             * @brief Returns the size of an erase sector in bytes.
+             *
+             * @return uint16_t Sector size in bytes.
+             */
+            virtual uint16_t sectorSize() const = 0;
+
+            /**
+             * @brief Returns the size of a program page in bytes.
+             *
+             * @return uint16_t Page size in bytes.
+             */
+            virtual uint16_t pageSize() const = 0;
+    };
+
+    /**
+     * @brief Driver for JEDEC compatible SPI NOR flash chips with 4KB sectors and 256 byte pages.
+     *
+     * @details
+     * - The capacity is detected from the JEDEC ID (`0x9F`) in @ref begin().
+     * - Only 3-byte addressing is supported, limiting the usable capacity to 16MB.
+     * - SPI transactions use mode 0 at up to @ref SPI_CLOCK_HZ.
+     *
+     * @warning The default slave select @ref PIN_TX is shared with the UART. `Serial` must not transmit while the
+     * flash is accessed. @ref PIN_PROG can be used instead only while the charger is not powered.
+     * @warning @ref PIN_SPI_SCK drives the status LED, which flickers during transfers.
+     *
+     * @note With @ref UIRB_CORE_PIN_ARBITER defined, every transaction claims @ref PIN_SPI_SCK, @ref PIN_SPI_MISO
+     * and, if used as slave select, @ref PIN_TX as @ref PinOwner::SPI. Buffered `Serial` output is paused for the
+     * transaction and operations fail instead of disturbing a higher priority owner such as the IR receiver.
+     */
+    class JedecSPIFlash : public SPIFlashDevice
+    {
+        public:
+            /**
+             * @brief Constructs a driver instance.
+             *
+             * @param[in] chipSelectPin Slave select pin, @ref PIN_TX by default.
+             */
+            explicit JedecSPIFlash(const uint8_t chipSelectPin = PIN_TX) : chip_select_pin_(chipSelectPin) {}
+
+            /**
+             * @brief Initializes the SPI bus, wakes the chip from deep power-down and detects its capacity.
+             *
+             * @return bool
+             * @retval true A JEDEC compatible chip with a supported capacity was detected.
+             * @retval false No chip responded or the capacity is not supported.
+             */
+            bool begin();
+
+            /**
+             * @brief Returns the 24-bit JEDEC ID read in @ref begin() (manufacturer, memory type, capacity).
+             *
+             * @return uint32_t JEDEC ID, `0` if no chip was detected.
+             */
+            uint32_t getJedecId() const { return this->jedec_id_; }
+
+            /**
+             * @brief Puts the chip into deep power-down (`0xB9`). Call before @ref UIRB::powerDown().
+             *
+             * @return bool `false` if the bus could not be claimed.
+             */
+            bool sleep();
+
+            /**
+             * @brief Releases the chip from deep power-down (`0xAB`).
+             *
+             * @return bool `false` if the bus could not be claimed.
+             */
+            bool wakeup();
+
+            bool read(const uint32_t address, void* data, const uint16_t length) override;
+            bool program(const uint32_t address, const void* data, const uint16_t length) override;
+            bool eraseSector(const uint32_t address) override;
+            uint32_t capacity() const override { return this->capacity_; }
+            uint16_t sectorSize() const override { return JedecSPIFlash::SECTOR_SIZE; }
+            uint16_t pageSize() const override { return JedecSPIFlash::PAGE_SIZE; }
+
+            /**
+             * @brief Maximum SPI clock frequency used by the driver.
+             */
+            static constexpr uint32_t SPI_CLOCK_HZ = 4000000UL;
+
+            /**
+             * @brief Erase sector size of JEDEC chips (`0x20` command).
+             */
+            static constexpr uint16_t SECTOR_SIZE = 4096U;
+
+            /**
+             * @brief Program page size of JEDEC chips.
+             */
+            static constexpr uint16_t PAGE_SIZE = 256U;
+
+        private:
+            /**
+             * @brief Waits until the busy flag of the status register clears.
+             *
+             * @param[in] timeout_milliseconds Maximum time to wait.
+             * @return bool `true` if the chip became ready in time.
+             */
+            bool wait_ready(const uint16_t timeout_milliseconds);
+
+            /**
+             * @brief Sends a single byte command in its own transaction.
+             *
+             * @param[in] command Command byte.
+             * @return bool `false` if the bus could not be claimed.
+             */
+            bool command(const uint8_t command);
+
+            /**
+             * @brief Starts a transaction and sends a command followed by a 24-bit address.
+             *
+             * @param[in] command Command byte.
+             * @param[in] address Address, sent MSB first.
+             * @return bool `false` if the bus could not be claimed.
+             */
+            bool begin_command(const uint8_t command, const uint32_t address);
+
+            /**
+             * @brief Ends the transaction started by @ref begin_command().
+             */
+            void end_command();
+
+            /**
+             * @brief Claims the shared pins if needed, starts an SPI transaction and selects the chip.
+             *
+             * @return bool `false` if the shared pins are held by a higher priority owner.
+             */
+            bool select();
+
+            /**
+             * @brief Deselects the chip, ends the SPI transaction and releases the shared pins.
+             */
+            void deselect();
+
+#if defined(UIRB_CORE_PIN_ARBITER) || defined(__DOXYGEN__)
+            /**
+             * @brief Returns the shared pins used by this driver.
+             *
+             * @return uint8_t Pin set for @ref PinArbiter.
+             */
+            uint8_t shared_pins() const;
+#endif  // defined(UIRB_CORE_PIN_ARBITER) || defined(__DOXYGEN__)
+
+            uint8_t chip_select_pin_; /**< @brief Slave select pin. */
+            uint32_t jedec_id_ = 0; /**< @brief JEDEC ID read in @ref begin(). */
+            uint32_t capacity_ = 0; /**< @brief Detected capacity in bytes. */
+    };
+
+    /**
+     * @brief RAM backed flash device with NOR semantics for simulators.
+     *
+     * @details
+     * - Programming ANDs data into the buffer, and programs crossing a page boundary are rejected, as on real chips.
+     * - @ref failAfter() simulates a power loss: after the given number of program and erase operations
+     *   every further operation fails, leaving the buffer in the state a real chip would be in.
+     * - Operation counters allow checking wear leveling and write amplification.
+     * - The `IRCodeStorePowerLoss` example injects a power loss at every operation of a workload and checks
+     *   the recovery of @ref IRCodeStore::begin().
+     *
+     * Example usage on the ATmega328P in simavr (5 sectors of 128 bytes):
+     * @code
+     * uint8_t flashMemory[640];
+     * SimulatedSPIFlash flash(flashMemory, sizeof(flashMemory), 128, 32);
+     * @endcode
+     */
+    class SimulatedSPIFlash : public SPIFlashDevice
+    {
+        public:
+            /**
+             * @brief Constructs a simulated device over a caller provided buffer, which is erased.
+             *
+             * @param[in] memory Backing buffer of @p capacity bytes.
+             * @param[in] capacity Device capacity, a multiple of @p sector_size.
+             * @param[in] sector_size Erase sector size, a multiple of @p page_size.
+             * @param[in] page_size Program page size.
+             */
+            SimulatedSPIFlash(uint8_t* memory, const uint32_t capacity, const uint16_t sector_size, const uint16_t page_size);
+
+            /**
+             * @brief Makes every operation after the next @p operations program or erase operations fail.
+             *
+             * @param[in] operations Number of operations to allow, @ref NEVER_FAIL to disable the injection.
+             */
+            void failAfter(const uint16_t operations) { this->operations_left_ = operations; }
+
+            /**
+             * @brief Returns the number of successful program operations.
+             *
+             * @return uint32_t Program operation count.
+             */
+            uint32_t getProgramCount() const { return this->program_count_; }
+
+            /**
+             * @brief Returns the number of successful sector erase operations.
+             *
+             * @return uint32_t Erase operation count.
+             */
+            uint32_t getEraseCount() const { return this->erase_count_; }
+
+            bool read(const uint32_t address, void* data, const uint16_t length) override;
+            bool program(const uint32_t address, const void* data, const uint16_t length) override;
+            bool eraseSector(const uint32_t address) override;
+            uint32_t capacity() const override { return this->capacity_; }
+            uint16_t sectorSize() const override { return this->sector_size_; }
+            uint16_t pageSize() const override { return this->page_size_; }
+
+            /**
+             * @brief Value for @ref failAfter() disabling the power loss injection.
+             */
+            static constexpr uint16_t NEVER_FAIL = UINT16_MAX;
+
+        private:
+            /**
+             * @brief Consumes one operation from the power loss budget.
+             *
+             * @return bool `false` if the simulated power is already lost.
+             */
+            bool consume_operation();
+
+            uint8_t* memory_; /**< @brief Backing buffer. */
+            uint32_t capacity_; /**< @brief Capacity in bytes. */
+            uint16_t sector_size_; /**< @brief Erase sector size. */
+            uint16_t page_size_; /**< @brief Program page size. */
+            uint16_t operations_left_ = NEVER_FAIL; /**< @brief Remaining operations before the simulated power loss. */
+            uint32_t program_count_ = 0; /**< @brief Successful program operations. */
+            uint32_t erase_count_ = 0; /**< @brief Successful erase operations. */
+    };
+#endif  // defined(UIRB_CORE_SPI_FLASH) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_SPIFlash_hpp
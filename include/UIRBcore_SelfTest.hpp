@@ -0,0 +1,271 @@
+/**
+ * @file UIRBcore_SelfTest.hpp
+ * @brief Power-on self-test (POST) of the %UIRB hardware with a per-test timing budget.
+ *
+ * This header declares the @ref uirbcore::SelfTest class which checks the board for hardware faults that
+ * the regular initialization does not detect:
+ * - **ADC references**: Ground and bandgap channels are converted against both AVcc and the internal 1.1V reference.
+ * - **Bandgap plausibility**: The calibrated bandgap voltage and the resulting AVcc must be within datasheet limits.
+ * - **Input pins**: Button, USB IO3, IR receiver and pulldown inputs are checked for stuck-at faults.
+ * - **EEPROM data**: The core data block must read back consistently and hold safe calibration values.
+ * - **IR LED**: A short carrier burst must toggle @ref PIN_IR_LED without collapsing AVcc.
+ * - **IR loopback**: The demodulating receiver must detect the carrier burst.
+ *
+ * @details
+ * Each test is timed with `micros()` and reported in a @ref uirbcore::SelfTestReport. Tests are skipped once
+ * the total budget @ref UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS would be exceeded, so the POST never adds more
+ * than that to boot time. When @ref UIRB_CORE_SELF_TEST is defined, @ref uirbcore::UIRB::begin() runs
+ * @ref uirbcore::SelfTest::DEFAULT_TESTS once and reports `CoreResult::ERROR_SELF_TEST_FAILED` on failure.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_SelfTest_hpp
+#define UIRBcore_SelfTest_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+
+namespace uirbcore
+{
+    /**
+     * @brief Enum class representing the individual self-tests, as `uint8_t`.
+     *
+     * The value is the bit position of the test in the masks of @ref SelfTestReport and @ref SelfTest::run().
+     */
+    enum class SelfTestItem : uint8_t
+    {
+        ADC_REFERENCES = 0, /**< Ground and bandgap conversions against AVcc and the internal 1.1V reference. */
+        BANDGAP, /**< Calibrated bandgap voltage within `[1000-1200]mV` and AVcc within operating limits. */
+        INPUT_PINS, /**< Stuck-at faults on the input pins, see @ref SelfTestReport::stuck_pins. */
+        EEPROM_DATA, /**< Stable EEPROM reads and safe calibration values of the core data block. */
+        IR_LED, /**< @ref PIN_IR_LED toggles during a carrier burst and AVcc does not droop excessively. */
+        IR_LOOPBACK, /**< @ref PIN_IR_RECEIVE detects the carrier burst. Requires an optical path from LED to receiver. */
+        COUNT /**< Number of tests, not a valid test. */
+    };
+
+    /**
+     * @brief Returns the mask bit of a self-test.
+     *
+     * @param[in] item Test.
+     * @return uint8_t Mask with only the bit of @p item set.
+     */
+    constexpr uint8_t selfTestMask(const SelfTestItem item)
+    {
+        return static_cast<uint8_t>(1U << static_cast<uint8_t>(item));
+    }
+
+    /**
+     * @brief Result of a @ref SelfTest::run() call.
+     *
+     * @details
+     * Bit `n` of every mask corresponds to the @ref SelfTestItem with value `n`.
+     *
+     * **Stuck pin mask bits:**
+     * | Bit | Pin                          | Fault detected                                         |
+     * |-----|------------------------------|--------------------------------------------------------|
+     * | `0` | @ref PIN_BUTTON_WAKEUP       | Stuck low (pressed) or stuck high                      |
+     * | `1` | @ref PIN_BUTTON_OPTION_1     | Stuck low (pressed) or stuck high                      |
+     * | `2` | @ref PIN_BUTTON_OPTION_2     | Stuck low (pressed) or stuck high                      |
+     * | `3` | @ref PIN_BUTTON_OPTION_3     | Stuck low (pressed) or stuck high                      |
+     * | `4` | @ref PIN_USB_IO3             | Stuck high (low is a valid host driven state)          |
+     * | `5` | @ref PIN_IR_RECEIVE          | Stuck low (receiver output never idle)                 |
+     * | `6` | @ref PIN_PULLDOWN_RESISTOR   | Stuck high                                             |
+     */
+    struct SelfTestReport
+    {
+        uint8_t requested; /**< @brief Tests requested by the caller. */
+        uint8_t executed; /**< @brief Tests executed within the budget. */
+        uint8_t failed; /**< @brief Executed tests which detected a fault. */
+        uint8_t over_budget; /**< @brief Executed tests which took longer than their individual budget. */
+        uint8_t stuck_pins; /**< @brief Input pins with a stuck-at fault, see the table above. */
+        uint16_t supply_milivolts; /**< @brief AVcc measured by @ref SelfTestItem::BANDGAP, `0` if not measured. */
+        uint16_t ir_droop_milivolts; /**< @brief AVcc droop during the IR burst measured by @ref SelfTestItem::IR_LED. */
+        uint16_t duration_microseconds[static_cast<uint8_t>(SelfTestItem::COUNT)]; /**< @brief Duration of each executed test. */
+        uint16_t total_microseconds; /**< @brief Duration of the whole run. */
+
+        /**
+         * @brief Checks if every requested test was executed and passed.
+         *
+         * @return bool
+         * @retval true All requested tests passed.
+         * @retval false A test failed or was skipped because the budget was exhausted.
+         */
+        bool passed() const
+        {
+            return this->failed == 0 && this->executed == this->requested;
+        }
+    };
+
+    /**
+     * @brief Power-on self-test of the %UIRB hardware.
+     *
+     * @details
+     * - Tests only use direct register access and short polling loops with timeouts; nothing blocks on
+     *   `delay()`. ADC reference switching is detected by polling instead of waiting a fixed settle time.
+     * - Pin modes, ADC and Timer2 registers touched by the tests are restored afterwards.
+     * - With @ref UIRB_CORE_TIMER_MANAGER defined, the IR tests acquire Timer2 as @ref TimerClient::SELF_TEST
+     *   and fail if another client holds it.
+     * - Tests are executed in @ref SelfTestItem order. Before a test starts, its individual budget is
+     *   checked against the remaining total budget; if it does not fit, it and all following tests are skipped.
+     * - @ref SelfTestItem::IR_LED and @ref SelfTestItem::IR_LOOPBACK are never executed when @ref AVR_DEBUG
+     *   is defined, as the debugger owns the INT1 pin (@ref PIN_IR_LED).
+     *
+     * @note `micros()` must be running, so the self-test cannot be executed from a global constructor.
+     * @note All methods are static; the class only groups the functionality.
+     *
+     * Example usage:
+     * @code
+     * const SelfTestReport& report = SelfTest::run(SelfTest::ALL_TESTS);
+     * SelfTest::print(report, Serial);
+     * if (!report.passed()) {
+     *     // Refuse to run on faulty hardware
+     * }
+     * @endcode
+     */
+    class SelfTest
+    {
+        public:
+            /**
+             * @brief Runs the requested self-tests.
+             *
+             * @param[in] tests Mask of tests to run, see @ref selfTestMask(). Default is @ref DEFAULT_TESTS.
+             * @return const SelfTestReport& Report of this run, also available through @ref getReport().
+             */
+            static const SelfTestReport& run(const uint8_t tests = DEFAULT_TESTS);
+
+            /**
+             * @brief Returns the report of the last @ref run().
+             *
+             * @return const SelfTestReport& Last report, all zero if the self-test has not been run yet.
+             */
+            static const SelfTestReport& getReport();
+
+            /**
+             * @brief Checks if @ref run() has been called since reset.
+             *
+             * @return bool
+             * @retval true A report is available.
+             * @retval false The self-test has not been run yet.
+             */
+            static bool hasRun();
+
+            /**
+             * @brief Prints a report as one line per test followed by a summary line.
+             *
+             * Lines have the form `POST <test> <PASS|FAIL|SKIP> <duration>us`.
+             *
+             * @param[in] report Report to print.
+             * @param[in] output Destination, e.g. `Serial`.
+             */
+            static void print(const SelfTestReport& report, Print& output);
+
+            /**
+             * @brief Mask of all tests.
+             */
+            static constexpr uint8_t ALL_TESTS = static_cast<uint8_t>((1U << static_cast<uint8_t>(SelfTestItem::COUNT)) - 1U);
+
+            /**
+             * @brief Mask of tests run by default. @ref SelfTestItem::IR_LOOPBACK is excluded as it depends on the enclosure.
+             */
+            static constexpr uint8_t DEFAULT_TESTS = ALL_TESTS & ~selfTestMask(SelfTestItem::IR_LOOPBACK);
+
+            /**
+             * @brief Total time budget of a run in microseconds, see @ref UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS.
+             */
+            static constexpr uint16_t BUDGET_MICROSECONDS = UIRB_CORE_SELF_TEST_BUDGET_MICROSECONDS;
+
+            /**
+             * @brief Maximum allowed AVcc droop during the IR carrier burst in millivolts.
+             *
+             * A shorted LED or driver pulls much more current than the pulsed high-power mode is designed for.
+             */
+            static constexpr uint16_t IR_DROOP_MAX_MV = 400U;
+
+        private:
+            /**
+             * @brief Individual budget of each test in microseconds, in @ref SelfTestItem order.
+             */
+            static const uint16_t TEST_BUDGET_MICROSECONDS[static_cast<uint8_t>(SelfTestItem::COUNT)];
+
+            /**
+             * @brief Implements @ref SelfTestItem::ADC_REFERENCES.
+             *
+             * @param[in,out] report Report receiving measured values.
+             * @return bool `true` if the test passed.
+             */
+            static bool test_adc_references(SelfTestReport& report);
+
+            /**
+             * @brief Implements @ref SelfTestItem::BANDGAP. Stores AVcc in @ref SelfTestReport::supply_milivolts.
+             *
+             * @param[in,out] report Report receiving measured values.
+             * @return bool `true` if the test passed.
+             */
+            static bool test_bandgap(SelfTestReport& report);
+
+            /**
+             * @brief Implements @ref SelfTestItem::INPUT_PINS. Stores faults in @ref SelfTestReport::stuck_pins.
+             *
+             * @param[in,out] report Report receiving measured values.
+             * @return bool `true` if the test passed.
+             */
+            static bool test_input_pins(SelfTestReport& report);
+
+            /**
+             * @brief Implements @ref SelfTestItem::EEPROM_DATA.
+             *
+             * @param[in,out] report Report receiving measured values.
+             * @return bool `true` if the test passed.
+             */
+            static bool test_eeprom_data(SelfTestReport& report);
+
+            /**
+             * @brief Implements @ref SelfTestItem::IR_LED. Stores the droop in @ref SelfTestReport::ir_droop_milivolts.
+             *
+             * @param[in,out] report Report receiving measured values.
+             * @return bool `true` if the test passed.
+             */
+            static bool test_ir_led(SelfTestReport& report);
+
+            /**
+             * @brief Implements @ref SelfTestItem::IR_LOOPBACK.
+             *
+             * @param[in,out] report Report receiving measured values.
+             * @return bool `true` if the test passed.
+             */
+            static bool test_ir_loopback(SelfTestReport& report);
+
+            static SelfTestReport report_; /**< @brief Report of the last run. */
+            static bool has_run_; /**< @brief Set after the first run. */
+    };
+}  // namespace uirbcore
+
+#endif  // UIRBcore_SelfTest_hpp
@@ -0,0 +1,118 @@
+/**
+ * @file UIRBcore_Stack.hpp
+ * @brief Stack painting and high-water mark measurement for the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::StackMonitor class. During startup, the free RAM between the end of the
+ * static data and the stack is filled with @ref uirbcore::StackMonitor::CANARY. The stack grows down into this
+ * area, so the lowest overwritten byte marks the deepest stack use since reset, including interrupts.
+ *
+ * @details
+ * - The painting runs from `.init3`, right after the stack pointer is set and before `.data`, `.bss` and static
+ *   constructors, so no stack use of the application is missed.
+ * - The high-water mark is found by scanning up from the top of the heap, which takes up to about 1 ms.
+ * - The depth of each library function and interrupt is measured in the simulator with
+ *   `scripts/simavr/uirb_stack_depth.c` and `scripts/stack_report.py`.
+ *
+ * @note Only compiled when @ref UIRB_CORE_STACK_MONITOR is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_Stack_hpp
+#define UIRBcore_Stack_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+
+namespace uirbcore
+{
+#if defined(UIRB_CORE_STACK_MONITOR) || defined(__DOXYGEN__)
+    /**
+     * @brief Static access to the stack high-water mark.
+     *
+     * Example usage, checking the stack margin after exercising the application:
+     * @code
+     * StackMonitor::dump(Serial);
+     * if (StackMonitor::getUnusedBytes() < 128) { ... }
+     * @endcode
+     *
+     * @note A stack byte which happens to be written with @ref CANARY is taken as unused, so the peak may be
+     * reported a few bytes low.
+     * @note Heap memory released back below its previous top is not painted again until @ref resetPeak(), and
+     * is reported as stack use until then.
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class StackMonitor
+    {
+        public:
+            /**
+             * @brief Value painted into the free RAM.
+             */
+            static constexpr uint8_t CANARY = 0xC5;
+
+            /**
+             * @brief Returns the deepest stack use since reset or the last @ref resetPeak().
+             *
+             * @return uint16_t Bytes between `RAMEND` and the lowest overwritten address.
+             */
+            static uint16_t getPeakStackBytes();
+
+            /**
+             * @brief Returns the painted bytes between the heap and the deepest stack use which were never written.
+             *
+             * @return uint16_t Remaining stack margin in bytes.
+             */
+            static uint16_t getUnusedBytes();
+
+            /**
+             * @brief Returns the bytes between the top of the heap and the current stack pointer.
+             *
+             * @return uint16_t Free RAM in bytes.
+             */
+            static uint16_t getFreeBytes();
+
+            /**
+             * @brief Paints the free RAM again, so the high-water mark restarts from the current stack depth.
+             *
+             * Interrupts are disabled while painting, for about 1 ms.
+             */
+            static void resetPeak();
+
+            /**
+             * @brief Prints the peak, unused and free byte counts, one `name<TAB>value` pair per line.
+             *
+             * @param[in] output Output stream, e.g. `Serial`.
+             */
+            static void dump(Print& output);
+    };
+#endif  // defined(UIRB_CORE_STACK_MONITOR) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_Stack_hpp
@@ -0,0 +1,186 @@
+/**
+ * @file UIRBcore_Tasks.hpp
+ * @brief Resumable library tasks of the %UIRB system.
+ *
+ * This header declares the multi-step library operations as stackless tasks (see @ref UIRBcore_Coroutine.hpp):
+ * - @ref uirbcore::StatusLedPatternTask plays an on/off pattern on the status LED.
+ * - @ref uirbcore::BandgapSampleTask oversamples the internal bandgap reference against AVcc.
+ * - @ref uirbcore::eeprom::EEPROMCommitTask, declared in @ref UIRBcore_EEPROM.hpp, writes the core data to EEPROM.
+ *
+ * The blocking functions @ref uirbcore::UIRB::notifyStatusLowBattery(), @ref uirbcore::UIRB::getSupplyVoltageMilivolts()
+ * and @ref uirbcore::UIRB::saveToEEPROM() run these tasks to completion. Applications can instead step them from
+ * `loop()` alongside other work, for example:
+ * @code
+ * StatusLedPatternTask pattern(StatusLedPatternTask::LOW_BATTERY_PATTERN, StatusLedPatternTask::LOW_BATTERY_PATTERN_LENGTH);
+ * BandgapSampleTask sample(64);
+ *
+ * void loop()
+ * {
+ *     pattern.step();
+ *     if (sample.step() == TaskStatus::DONE) { ... sample.getResult() ... }
+ *     // Other work
+ * }
+ * @endcode
+ *
+ * @warning A task holds its resources, such as the ADC or the status LED, from its first to its last step. Code
+ * running between the steps must not use them.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_Tasks_hpp
+#define UIRBcore_Tasks_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_Coroutine.hpp>
+
+namespace uirbcore
+{
+    /**
+     * @brief Task playing an on/off pattern on @ref PIN_STAT_LED.
+     *
+     * The pin mode and state are saved on the first step and restored on the last. With
+     * @ref UIRB_CORE_PIN_ARBITER, the LED pin is claimed as @ref PinOwner::STATUS_LED for the whole pattern and the
+     * task finishes without playing it if the claim fails.
+     */
+    class StatusLedPatternTask
+    {
+        public:
+            /**
+             * @brief Pattern of @ref UIRB::notifyStatusLowBattery(), Morse code "L" (dot-dash-dot-dot) between pauses.
+             */
+            static const uint16_t LOW_BATTERY_PATTERN[];
+
+            /**
+             * @brief Number of entries of @ref LOW_BATTERY_PATTERN.
+             */
+            static constexpr uint8_t LOW_BATTERY_PATTERN_LENGTH = 9;
+
+            /**
+             * @brief Constructs a task for a pattern.
+             *
+             * @param[in] pattern Durations in milliseconds stored in `PROGMEM`. Even entries keep the LED off, odd
+             * entries keep it on.
+             * @param[in] length Number of entries.
+             */
+            StatusLedPatternTask(const uint16_t* pattern, const uint8_t length)
+                : pattern_(pattern), length_(length)
+            {
+            }
+
+            /**
+             * @brief Runs the task until its next wait.
+             *
+             * @return TaskStatus @ref TaskStatus::DONE once the pattern has been played.
+             */
+            TaskStatus step();
+
+        private:
+            CoroutineState coroutine_ = {}; /**< Coroutine state. */
+            const uint16_t* const pattern_; /**< Pattern in `PROGMEM`. */
+            const uint8_t length_; /**< Number of pattern entries. */
+            uint8_t index_ = 0; /**< Entry being played. */
+            uint8_t old_mode_ = 0; /**< Pin mode before the pattern. */
+            uint8_t old_state_ = LOW; /**< Pin state before the pattern. */
+    };
+
+    /**
+     * @brief Task averaging ADC samples of the internal 1.1V bandgap reference measured against AVcc.
+     *
+     * The ADC prescaler, reference and input are set on the first step, followed by a conversion and
+     * @ref UIRB::ADC_VREF_SETTLE_DELAY_MS for the reference to settle. Samples are taken
+     * @ref UIRB::ADC_SAMPLE_DELAY_MS apart. `ADCSRA` and the previous analog reference are restored on the last step.
+     * The input is selected again right before every conversion: if another ADC user, such as `analogRead()`, switched
+     * it while the task waited, the reference settles again before the next sample, and a conversion during which the
+     * input was switched is repeated.
+     * @ref PIN_IR_LED is driven low to keep the supply quiet. With @ref UIRB_CORE_IR_TX_GATE, the LED is left to the
+     * IR sender instead and each sample is taken in a gap between IR frames, see @ref IRTransmitGate.
+     */
+    class BandgapSampleTask
+    {
+        public:
+            /**
+             * @brief `ADMUX` value selecting the bandgap as input, measured against AVcc. `MUX[3:0] = 0b1110`.
+             */
+            static constexpr uint8_t ADMUX_BANDGAP = _BV(REFS0) | _BV(MUX3) | _BV(MUX2) | _BV(MUX1);
+
+            /**
+             * @brief Selects the bandgap against AVcc as ADC input, with a prescaler of 128.
+             *
+             * @return bool
+             * @retval true The ADC had another input or reference selected. A conversion must be discarded and
+             * @ref UIRB::ADC_VREF_SETTLE_DELAY_MS waited for before sampling.
+             * @retval false The bandgap was already selected.
+             */
+            static bool selectBandgapInput();
+
+            /**
+             * @brief Constructs a task.
+             *
+             * @param[in] samples Number of samples to average, at least `1`.
+             */
+            explicit BandgapSampleTask(const uint8_t samples)
+                : samples_(samples)
+            {
+            }
+
+            /**
+             * @brief Runs the task until its next wait.
+             *
+             * @return TaskStatus @ref TaskStatus::DONE once the average is available.
+             */
+            TaskStatus step();
+
+            /**
+             * @brief Returns the rounded average of the samples.
+             *
+             * @return uint16_t Raw 10-bit ADC value, `0` before the task is done or if constructed with `0` samples.
+             */
+            uint16_t getResult() const
+            {
+                return this->result_;
+            }
+
+        private:
+            CoroutineState coroutine_ = {}; /**< Coroutine state. */
+            uint32_t sample_sum_ = 0; /**< Sum of the samples taken so far, at most 18 bits. */
+            uint16_t result_ = 0; /**< Rounded average. */
+            const uint8_t samples_; /**< Number of samples to average. */
+            uint8_t sample_index_ = 0; /**< Samples taken so far. */
+            uint8_t old_adc_reference_ = 0; /**< Analog reference before the task. */
+            uint8_t old_adcsra_ = 0; /**< `ADCSRA` before the task. */
+#if defined(UIRB_CORE_IR_TX_GATE)
+            uint8_t frame_mark_ = 0; /**< IR frame counter when the current conversion started. */
+#endif  // defined(UIRB_CORE_IR_TX_GATE)
+    };
+}  // namespace uirbcore
+
+#endif  // UIRBcore_Tasks_hpp
@@ -0,0 +1,256 @@
+/**
+ * @file UIRBcore_TimerWheel.hpp
+ * @brief Hierarchical software timer wheel for the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::SoftTimer and @ref uirbcore::TimerWheel classes. Any number of
+ * millisecond timeouts share the Timer1 compare A channel, which is reprogrammed to the next point in time the
+ * wheel has work to do. No interrupt occurs while no timer is running.
+ *
+ * @details
+ * The wheel has @ref UIRB_CORE_TIMER_WHEEL_LEVELS levels of 16 slots. Level `n` slots span `16^n` ms, so a timer
+ * due in `d` ms is linked into the level where `16^n <= d < 16^(n+1)`. Timers of higher levels are moved down
+ * when the wheel reaches their slot and run from level 0 at their exact expiry. Timers further away than the top
+ * level are parked in it and moved again when reached.
+ * - Starting and cancelling a timer only links or unlinks it, independent of the number of running timers.
+ * - The next event is found from the per-level slot occupancy masks after each wheel advance.
+ * - @ref UIRB::powerDown() sleeps at most until the next expiry and advances the wheel clock by the time spent
+ *   asleep, as `millis()` and Timer1 stop in power-down.
+ *
+ * @note Only compiled when @ref UIRB_CORE_TIMER_WHEEL is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_TimerWheel_hpp
+#define UIRBcore_TimerWheel_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_Timers.hpp>
+
+namespace uirbcore
+{
+#if defined(UIRB_CORE_TIMER_WHEEL) || defined(__DOXYGEN__)
+    class UIRB;
+
+    /**
+     * @brief Timeout managed by @ref TimerWheel. Timers are owned by the caller and linked into the wheel.
+     *
+     * Example usage:
+     * @code
+     * void ledStep(SoftTimer& timer)
+     * {
+     *     digitalWrite(PIN_STAT_LED, !digitalRead(PIN_STAT_LED));
+     * }
+     *
+     * SoftTimer ledTimer(ledStep);
+     *
+     * TimerWheel::begin();
+     * TimerWheel::start(ledTimer, 250, 250); // Toggle every 250ms
+     * @endcode
+     *
+     * @warning A running timer must not be destroyed or moved. Cancel it first.
+     */
+    class SoftTimer
+    {
+        public:
+            /**
+             * @brief Callback run when the timer expires, from the Timer1 compare interrupt.
+             */
+            typedef void (*Callback)(SoftTimer& timer);
+
+            /**
+             * @brief Constructs a stopped timer.
+             *
+             * @param[in] callback Callback run on expiry.
+             * @param[in] context User pointer returned by @ref getContext(). Defaults to `nullptr`.
+             */
+            explicit SoftTimer(const Callback callback, void* context = nullptr)
+                : callback_(callback), context_(context)
+            {
+            }
+
+            /**
+             * @brief Checks if the timer is waiting in the wheel.
+             *
+             * @return bool `true` if started and neither expired nor cancelled. A periodic timer stays active.
+             */
+            bool isActive() const
+            {
+                return this->pprev_ != nullptr;
+            }
+
+            /**
+             * @brief Returns the user pointer passed to the constructor.
+             *
+             * @return void* User pointer.
+             */
+            void* getContext() const
+            {
+                return this->context_;
+            }
+
+        private:
+            SoftTimer* next_ = nullptr; /**< Next timer in the slot. */
+            SoftTimer** pprev_ = nullptr; /**< Link pointing to this timer, `nullptr` when not in the wheel. */
+            uint32_t expiry_milliseconds_ = 0; /**< Wheel time of expiry. */
+            uint32_t period_milliseconds_ = 0; /**< Restart period, `0` for one-shot timers. */
+            const Callback callback_; /**< Expiry callback. */
+            void* const context_; /**< User pointer. */
+
+            /**
+             * @brief Grants @ref TimerWheel access to the links.
+             */
+            friend class TimerWheel;
+    };
+
+    /**
+     * @brief Static hierarchical timer wheel on the Timer1 compare A channel.
+     *
+     * Timer1 is acquired through @ref TimerManager as @ref TimerMode::FREE_RUNNING with
+     * @ref UIRB_CORE_TIMER1_SHARED_PRESCALER, so it runs together with @ref Profiler, and
+     * @ref TimerVector::TIMER1_COMPA is attached exclusively.
+     *
+     * @note Callbacks run from the compare interrupt with interrupts disabled and must be short. They may start
+     * and cancel timers, including their own. With @ref UIRB_CORE_IRQ_PRIORITY, callbacks run with interrupts
+     * enabled and can be preempted by the IR timing interrupts.
+     * @note Resolution is 1ms. Expiries are late by up to the `millis()` granularity of 2ms at 8 MHz.
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class TimerWheel
+    {
+        public:
+            /**
+             * @brief Value of @ref getMillisecondsToNextExpiry() when no timer is running.
+             */
+            static constexpr uint32_t NO_EXPIRY = UINT32_MAX;
+
+            /**
+             * @brief Number of slots per level.
+             */
+            static constexpr uint8_t SLOTS_PER_LEVEL = 16;
+
+            /**
+             * @brief Acquires Timer1 and its compare A vector.
+             *
+             * @return bool `false` if Timer1 or its compare A vector is held by another @ref TimerManager client.
+             */
+            static bool begin();
+
+            /**
+             * @brief Starts or restarts a timer.
+             *
+             * @param[in] timer Timer to start. A running timer is moved to the new expiry.
+             * @param[in] delay_milliseconds Delay from now, at most `2^31 - 1`.
+             * @param[in] period_milliseconds Restart period after each expiry, `0` for a one-shot timer. Periods
+             * missed while the callback could not run are skipped. Defaults to `0`.
+             */
+            static void start(SoftTimer& timer, const uint32_t delay_milliseconds, const uint32_t period_milliseconds = 0);
+
+            /**
+             * @brief Stops a timer. Stopping a timer which is not running does nothing.
+             *
+             * @param[in] timer Timer to stop.
+             */
+            static void cancel(SoftTimer& timer);
+
+            /**
+             * @brief Returns the wheel clock, @ref UIRB::getUptimeMilliseconds().
+             *
+             * @return uint32_t Wheel clock in milliseconds, `millis()` advanced by the time spent in @ref UIRB::powerDown().
+             */
+            static uint32_t now();
+
+            /**
+             * @brief Returns the time until the wheel has to run next.
+             *
+             * The time may be shorter than the earliest expiry, when a timer has to be moved to a lower level first.
+             *
+             * @return uint32_t Milliseconds until the next wheel event, `0` if overdue, @ref NO_EXPIRY if idle.
+             */
+            static uint32_t getMillisecondsToNextExpiry();
+
+        private:
+            /**
+             * @brief Links a timer into the slot matching its expiry, relative to the current wheel time.
+             *
+             * @param[in] timer Timer not linked into the wheel.
+             * @return uint32_t Wheel time at which the slot is processed.
+             */
+            static uint32_t link(SoftTimer& timer);
+
+            /**
+             * @brief Unlinks a timer from its slot or from a detached slot list.
+             *
+             * @param[in] timer Linked timer.
+             */
+            static void unlink(SoftTimer& timer);
+
+            /**
+             * @brief Processes all slots due at a wheel event: moves higher level timers down and runs expired ones.
+             *
+             * @param[in] event Wheel time of the event.
+             */
+            static void run_event(const uint32_t event);
+
+            /**
+             * @brief Finds the next wheel event from the slot occupancy masks.
+             */
+            static void update_next_event();
+
+            /**
+             * @brief Programs the compare channel for the next wheel event, or disables it if the wheel is idle.
+             */
+            static void program_compare();
+
+            /**
+             * @brief Advances the wheel to the current time, runs due timers and reprograms the compare channel.
+             *
+             * @note Must be called with interrupts disabled.
+             */
+            static void service();
+
+            /**
+             * @brief Runs the timers which expired while sleeping.
+             *
+             * Called by @ref UIRB::powerDown() after waking up, once the time slept was added to
+             * @ref UIRB::getUptimeMilliseconds().
+             */
+            static void resume_after_sleep();
+
+            /**
+             * @brief Grants @ref UIRB access to the sleep coordination functions.
+             */
+            friend class UIRB;
+    };
+#endif  // defined(UIRB_CORE_TIMER_WHEEL) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_TimerWheel_hpp
@@ -0,0 +1,308 @@
+/**
+ * @file UIRBcore_Timers.hpp
+ * @brief Hardware timer and timer interrupt allocation for the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::TimerManager class, which hands out Timer0, Timer1 and Timer2 and their
+ * interrupt vectors to library features and application code. On the %UIRB board V0.2:
+ * - Timer0 runs `millis()`, its mode and prescaler belong to the Arduino core.
+ * - Timer1 captures IR frames on @ref PIN_IR_CAPTURE (ICP1) and serves as @ref uirbcore::Profiler counter.
+ * - Timer2 generates the IR carrier on @ref PIN_IR_LED (OC2B).
+ *
+ * @details
+ * Conflicts are detected in two stages:
+ * - **Build time**: Timers used by code outside the library are declared with @ref UIRB_CORE_RESERVE_TIMER0,
+ *   @ref UIRB_CORE_RESERVE_TIMER1 and @ref UIRB_CORE_RESERVE_TIMER2. Library features needing a reserved timer
+ *   fail with `#error`, and the manager does not define interrupt vectors of reserved timers, so the vectors
+ *   remain available to the other code.
+ * - **Boot time**: Clients acquire a timer either as @ref uirbcore::TimerMode::FREE_RUNNING, shared by all
+ *   clients agreeing on the prescaler, or as @ref uirbcore::TimerMode::EXCLUSIVE. Handlers are attached to
+ *   vectors of acquired timers only.
+ *
+ * A vector can be shared by several handlers, all of them called from the one interrupt, as long as none of
+ * them changes the compare register. A client needing its own compare value attaches exclusively.
+ *
+ * With @ref UIRB_CORE_IRQ_PRIORITY, interrupts are split into two priorities to keep the IR timing exact:
+ * - **Critical**: IR capture, carrier and other handlers attached as @ref uirbcore::InterruptPriority::CRITICAL
+ *   run with interrupts disabled, as usual.
+ * - **Preemptible**: Vectors whose handlers are all attached as @ref uirbcore::InterruptPriority::PREEMPTIBLE,
+ *   the @ref uirbcore::TimerWheel callbacks, the button, pin change and non-supervisor watchdog interrupts re-enable
+ *   interrupts right after entry, so a critical interrupt waits at most for their prologue.
+ * - The Arduino Timer0 overflow interrupt cannot be made preemptible, but it can be suspended around a timing
+ *   critical section with @ref uirbcore::TimerManager::suspendTimer0Tick(). `millis()` and `micros()` are
+ *   compensated from Timer1 on resume.
+ *
+ * Worst-case delay a housekeeping interrupt adds to a critical one at 8 MHz. The values are estimated from
+ * instruction counts and have not been measured; `scripts/simavr/uirb_irq_latency.c` measures them for a given
+ * firmware, reporting the worst latency of the critical vector per interrupt in service:
+ * | Interrupt                    | Default                    | With @ref UIRB_CORE_IRQ_PRIORITY |
+ * |------------------------------|----------------------------|----------------------------------|
+ * | Arduino Timer0 overflow      | ~10µs                      | ~10µs, none while suspended      |
+ * | Manager dispatch             | ~3µs plus all handlers     | ~3µs for preemptible vectors     |
+ * | Timer wheel compare          | ~3µs plus wheel and callbacks | ~3µs plus wheel bookkeeping   |
+ * | Button (INT0)                | ~3µs plus handler          | ~3µs                             |
+ * | Pin change, watchdog         | ~2µs                       | under 1µs                        |
+ *
+ * @note Only compiled when @ref UIRB_CORE_TIMER_MANAGER is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_Timers_hpp
+#define UIRBcore_Timers_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_Pins.h>
+
+namespace uirbcore
+{
+    /**
+     * @brief Enum class identifying the hardware timers, as `uint8_t`.
+     */
+    enum class HardwareTimer : uint8_t
+    {
+        TIMER0 = 0, /**< 8-bit Timer0, running `millis()`. */
+        TIMER1, /**< 16-bit Timer1 with input capture. */
+        TIMER2, /**< 8-bit Timer2, IR carrier. */
+        COUNT /**< Number of timers. */
+    };
+
+    /**
+     * @brief Enum class identifying the timer interrupt vectors handed out by @ref TimerManager, as `uint8_t`.
+     *
+     * `TIMER0_OVF` is not included as it is used by the Arduino core.
+     */
+    enum class TimerVector : uint8_t
+    {
+        TIMER0_COMPA = 0, /**< Timer0 compare match A. */
+        TIMER0_COMPB, /**< Timer0 compare match B. */
+        TIMER1_COMPA, /**< Timer1 compare match A. */
+        TIMER1_COMPB, /**< Timer1 compare match B. */
+        TIMER1_CAPT, /**< Timer1 input capture on @ref PIN_IR_CAPTURE. */
+        TIMER1_OVF, /**< Timer1 overflow. */
+        TIMER2_COMPA, /**< Timer2 compare match A. */
+        TIMER2_COMPB, /**< Timer2 compare match B. */
+        TIMER2_OVF, /**< Timer2 overflow. */
+        COUNT /**< Number of vectors. */
+    };
+
+    /**
+     * @brief Enum class identifying timer clients, as `uint8_t`.
+     */
+    enum class TimerClient : uint8_t
+    {
+        NONE = 0, /**< No client. */
+        PROFILER, /**< @ref Profiler counter. */
+        SELF_TEST, /**< @ref SelfTest IR carrier. */
+        IR_CARRIER, /**< IR transmitter carrier. */
+        IR_CAPTURE, /**< IR receiver input capture. */
+        SCHEDULER, /**< Software timers and scheduling. */
+        DEBOUNCE, /**< Button debouncing. */
+        LED_PWM, /**< LED dimming. */
+        APPLICATION, /**< Application code. */
+        COUNT /**< Number of clients including @ref NONE. */
+    };
+
+    /**
+     * @brief Enum class defining how a timer is acquired, as `uint8_t`.
+     */
+    enum class TimerMode : uint8_t
+    {
+        FREE_RUNNING = 0, /**< Counter runs freely from 0 to its maximum. Shared by clients using the same prescaler. */
+        EXCLUSIVE /**< One client configures the timer registers as it needs. */
+    };
+
+    /**
+     * @brief Enum class defining whether a timer handler may be interrupted, as `uint8_t`.
+     */
+    enum class InterruptPriority : uint8_t
+    {
+        CRITICAL = 0, /**< Runs with interrupts disabled. */
+        PREEMPTIBLE /**< Runs with interrupts enabled when @ref UIRB_CORE_IRQ_PRIORITY is defined. */
+    };
+
+    /**
+     * @brief Timer interrupt handler, called with interrupts disabled unless attached as
+     * @ref InterruptPriority::PREEMPTIBLE.
+     */
+    typedef void (*TimerHandler)();
+
+#if defined(UIRB_CORE_TIMER_MANAGER) || defined(__DOXYGEN__)
+    /**
+     * @brief Static allocator of hardware timers and timer interrupt vectors.
+     *
+     * Example usage, a 2ms debounce tick on the Timer0 compare A vector shared with other clients:
+     * @code
+     * void debounceTick() { ... }
+     *
+     * TimerManager::acquire(HardwareTimer::TIMER0, TimerClient::DEBOUNCE, TimerMode::FREE_RUNNING, 64);
+     * TimerManager::attach(TimerVector::TIMER0_COMPA, TimerClient::DEBOUNCE, debounceTick);
+     * @endcode
+     *
+     * @note Timer0 can only be acquired as @ref TimerMode::FREE_RUNNING with prescaler `64`, as configured by the
+     * Arduino core. Its compare vectors fire once per counter period of 256 ticks.
+     * @note The manager stops a @ref TimerMode::FREE_RUNNING timer once its last client releases it. An
+     * @ref TimerMode::EXCLUSIVE client leaves the timer in the state it wants on release.
+     * @note Dispatching through handler pointers makes the compiler save all call-clobbered registers in the
+     * interrupt, about 3µs at 8 MHz. Hot vectors with a single user are better served by a dedicated `ISR()` in a
+     * reserved timer.
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class TimerManager
+    {
+        public:
+            /**
+             * @brief Acquires a timer for a client.
+             *
+             * A @ref TimerMode::FREE_RUNNING timer not yet in use is configured in normal mode with the given
+             * prescaler, output compare pins disconnected.
+             *
+             * @param[in] timer Timer to acquire.
+             * @param[in] client Client, not @ref TimerClient::NONE.
+             * @param[in] mode Acquisition mode.
+             * @param[in] prescaler Clock prescaler for @ref TimerMode::FREE_RUNNING: `1`, `8`, `64`, `256` or `1024`,
+             * and additionally `32` or `128` for Timer2. Ignored for @ref TimerMode::EXCLUSIVE.
+             * @return bool
+             * @retval true The client holds the timer. Acquiring a timer already held in the same mode succeeds.
+             * @retval false The timer is reserved at build time, used in another mode or with another prescaler,
+             * or an argument is invalid.
+             */
+            static bool acquire(const HardwareTimer timer, const TimerClient client, const TimerMode mode,
+                                const uint16_t prescaler = 0);
+
+            /**
+             * @brief Releases a timer and detaches all handlers of the client from its vectors.
+             *
+             * @param[in] timer Timer to release.
+             * @param[in] client Client.
+             */
+            static void release(const HardwareTimer timer, const TimerClient client);
+
+            /**
+             * @brief Attaches a handler to a timer vector and enables the interrupt.
+             *
+             * @param[in] vector Timer vector.
+             * @param[in] client Client holding the timer of @p vector.
+             * @param[in] handler Handler called from the interrupt.
+             * @param[in] exclusive If `true`, no other handler may share the vector and the client owns the compare
+             * register of a compare vector. Defaults to `false`.
+             * @param[in] priority Priority of the handler. A vector runs its handlers with interrupts enabled only if
+             * all of them are @ref InterruptPriority::PREEMPTIBLE and @ref UIRB_CORE_IRQ_PRIORITY is defined. A
+             * preemptible vector raised again while its handlers run is not nested, the handlers run once more
+             * instead. Defaults to @ref InterruptPriority::CRITICAL.
+             * @return bool
+             * @retval true The handler is attached.
+             * @retval false The client does not hold the timer, the vector is reserved, exclusively attached, the
+             * client is already attached to it, an exclusive attach finds other handlers, or all
+             * @ref UIRB_CORE_TIMER_HANDLER_SLOTS are used.
+             */
+            static bool attach(const TimerVector vector, const TimerClient client, const TimerHandler handler,
+                               const bool exclusive = false,
+                               const InterruptPriority priority = InterruptPriority::CRITICAL);
+
+            /**
+             * @brief Detaches the handler of a client from a vector. The interrupt is disabled with the last handler.
+             *
+             * @param[in] vector Timer vector.
+             * @param[in] client Client.
+             */
+            static void detach(const TimerVector vector, const TimerClient client);
+
+            /**
+             * @brief Returns the clients holding a timer.
+             *
+             * @param[in] timer Timer.
+             * @return uint16_t Bit mask with bit `n` set for each holding client of value `n`.
+             */
+            static uint16_t getClients(const HardwareTimer timer);
+
+            /**
+             * @brief Returns the prescaler of a free-running timer.
+             *
+             * @param[in] timer Timer.
+             * @return uint16_t Prescaler, `0` if the timer is free or used exclusively.
+             */
+            static uint16_t getPrescaler(const HardwareTimer timer);
+
+            /**
+             * @brief Checks if a timer is reserved for code outside the library at build time.
+             *
+             * @param[in] timer Timer.
+             * @return bool `true` if the matching `UIRB_CORE_RESERVE_TIMERn` macro is defined.
+             */
+            static bool isReserved(const HardwareTimer timer);
+
+            /**
+             * @brief Prints the timer and vector allocation as a table.
+             *
+             * @param[in] output Output stream, e.g. `Serial`.
+             */
+            static void dump(Print& output);
+
+#if defined(UIRB_CORE_IRQ_PRIORITY) || defined(__DOXYGEN__)
+            /**
+             * @brief Disables the Arduino Timer0 overflow interrupt, which would otherwise delay critical interrupts.
+             *
+             * Timer0 keeps counting. `millis()` and `micros()` stand still until @ref resumeTimer0Tick(), which
+             * advances them by the suspended time measured with Timer1.
+             *
+             * @return bool
+             * @retval true The tick is suspended.
+             * @retval false The tick is already suspended, Timer0 or Timer1 is reserved, or Timer1 is not acquired
+             * as @ref TimerMode::FREE_RUNNING.
+             *
+             * @warning The suspension must be shorter than one Timer1 period, 65536 times the Timer1 prescaler
+             * clock cycles (524ms with prescaler `64` at 8 MHz). Longer suspensions lose whole periods. Timer1 must
+             * stay free-running until @ref resumeTimer0Tick().
+             * @note Only available if @ref UIRB_CORE_IRQ_PRIORITY is defined.
+             */
+            static bool suspendTimer0Tick();
+
+            /**
+             * @brief Re-enables the Timer0 overflow interrupt and adds the suspended time to `millis()` and
+             * `micros()`. Does nothing if the tick is not suspended.
+             *
+             * @note Only available if @ref UIRB_CORE_IRQ_PRIORITY is defined.
+             */
+            static void resumeTimer0Tick();
+
+            /**
+             * @brief Checks if the Timer0 tick is suspended.
+             *
+             * @return bool `true` between @ref suspendTimer0Tick() and @ref resumeTimer0Tick().
+             * @note Only available if @ref UIRB_CORE_IRQ_PRIORITY is defined.
+             */
+            static bool isTimer0TickSuspended();
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY) || defined(__DOXYGEN__)
+    };
+#endif  // defined(UIRB_CORE_TIMER_MANAGER) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+#endif  // UIRBcore_Timers_hpp
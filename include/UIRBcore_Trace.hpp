@@ -0,0 +1,175 @@
+/**
+ * @file UIRBcore_Trace.hpp
+ * @brief Post-mortem event trace ring buffer for the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::Trace class and the @ref UIRB_TRACE macro. The library logs typed
+ * events with a millisecond timestamp into a compact ring buffer kept in `.noinit` RAM, so the history
+ * leading up to a watchdog or external reset can be dumped after the restart.
+ *
+ * @details
+ * - Each entry takes 4 bytes: a 16-bit timestamp (@ref uirbcore::UIRB::getUptimeMilliseconds() truncated), an event
+ *   type and an argument. The clock restarts with every reset, so the timestamps restart at each `BOOT` entry.
+ * - The buffer holds @ref UIRB_CORE_TRACE_ENTRIES entries and overwrites the oldest entry when full.
+ * - Power-on and brown-out resets clear the buffer, other resets append to it.
+ * - @ref uirbcore::Trace::dump() prints the buffer as text which `scripts/trace_decode.py` turns into a timeline.
+ *
+ * @note The trace is only compiled when @ref UIRB_CORE_TRACE is defined. Otherwise @ref UIRB_TRACE expands
+ * to nothing.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_Trace_hpp
+#define UIRBcore_Trace_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+
+namespace uirbcore
+{
+    /**
+     * @brief Enum class representing the event types stored in the trace, as `uint8_t`.
+     *
+     * @note Values are part of the dump format understood by `scripts/trace_decode.py`. Append new values
+     * only, and update the decoder accordingly.
+     */
+    enum class TraceEvent : uint8_t
+    {
+        NONE = 0, /**< Unused entry. */
+        BOOT, /**< Library startup. Argument: `MCUSR` reset flags. */
+        INIT_PHASE, /**< @ref UIRB constructor phase reached. Argument: @ref TracePhase. */
+        INIT_RESULT, /**< @ref UIRB constructor finished. Argument: @ref CoreResult. */
+        EEPROM_COMMIT, /**< Core data written to EEPROM. Argument: `1` if verified, `0` otherwise. */
+        EEPROM_RELOAD, /**< Core data reloaded from EEPROM. Argument: `1` if valid, `0` otherwise. */
+        ADC_REFERENCE, /**< ADC reference switched by the library. Argument: new reference (`DEFAULT`, `INTERNAL1V1`, ...). */
+        SLEEP, /**< Entering power-down. Argument: @ref WakeupInterrupt. */
+        WAKE, /**< Woken up from power-down. Argument: bit 0 button, bit 1 USB IO3, `0` timer. */
+        CHARGER_STATE, /**< Estimated charger state changed. Argument: @ref ChargerState. */
+        BATTERY_STATE, /**< Estimated battery state changed. Argument: @ref BatteryState. */
+        ERROR, /**< Library error. Argument: @ref CoreResult. */
+        BATTERY_CAPACITY, /**< Battery capacity learned from a full charge. Argument: capacity in percent of the rated capacity, saturating. */
+        USER = 0x80 /**< First value available for application defined events. */
+    };
+
+    /**
+     * @brief Enum class representing the phases of the @ref UIRB constructor logged with @ref TraceEvent::INIT_PHASE.
+     */
+    enum class TracePhase : uint8_t
+    {
+        HW_VERSION_CHECKED = 0, /**< The hardware version stored in EEPROM matches. */
+        PINS_CONFIGURED, /**< Default pin modes were applied. */
+        EEPROM_RESTORED, /**< Core data was restored from `.noinit` RAM on a warm start. */
+        EEPROM_SAVED /**< Boot count was incremented and core data saved to EEPROM. */
+    };
+
+#if defined(UIRB_CORE_TRACE) || defined(__DOXYGEN__)
+    /**
+     * @brief Single trace entry.
+     */
+    struct TraceEntry
+    {
+        uint16_t timestamp; /**< @brief Lower 16 bits of @ref UIRB::getUptimeMilliseconds() when the event was logged. */
+        TraceEvent type; /**< @brief Event type. */
+        uint8_t argument; /**< @brief Event specific argument. */
+    } __attribute__((packed, aligned(1)));
+
+    /**
+     * @brief Event trace ring buffer surviving warm resets.
+     *
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class Trace
+    {
+        public:
+            /**
+             * @brief Logs an event. Safe to call from interrupt handlers.
+             *
+             * @param[in] type Event type.
+             * @param[in] argument Event specific argument.
+             */
+            static void log(const TraceEvent type, const uint8_t argument = 0);
+
+            /**
+             * @brief Returns the number of entries stored in the buffer.
+             *
+             * @return uint16_t Number of entries `[0-` @ref UIRB_CORE_TRACE_ENTRIES `]`.
+             */
+            static uint16_t count();
+
+            /**
+             * @brief Reads an entry by age.
+             *
+             * @param[in] age Age of the entry, `0` being the newest one.
+             * @param[out] entry Destination for the entry.
+             * @return bool
+             * @retval true The entry was read.
+             * @retval false No entry of the requested age is stored.
+             */
+            static bool read(const uint16_t age, TraceEntry& entry);
+
+            /**
+             * @brief Removes all entries from the buffer.
+             */
+            static void clear();
+
+            /**
+             * @brief Prints all entries, oldest first, in the text format read by `scripts/trace_decode.py`.
+             *
+             * The output starts with `#UIRB-TRACE <version> <count>`, followed by one `<timestamp> <type> <argument>` 
+             * line per entry in hexadecimal, and ends with `#UIRB-TRACE-END`.
+             *
+             * @param[in] output Destination, e.g. `Serial`.
+             */
+            static void dump(Print& output);
+
+            /**
+             * @brief Version of the dump format.
+             */
+            static constexpr uint8_t DUMP_FORMAT_VERSION = 1U;
+    };
+#endif  // defined(UIRB_CORE_TRACE) || defined(__DOXYGEN__)
+}  // namespace uirbcore
+
+/**
+ * @def UIRB_TRACE(type, argument)
+ * @brief Logs a @ref uirbcore::TraceEvent into the trace buffer.
+ *
+ * @param type Name of a @ref uirbcore::TraceEvent enumerator, e.g. `EEPROM_COMMIT`.
+ * @param argument Event specific argument, converted to `uint8_t`.
+ *
+ * @note Expands to nothing when @ref UIRB_CORE_TRACE is not defined; @p argument is not evaluated in that case.
+ */
+#if defined(UIRB_CORE_TRACE)
+    #define UIRB_TRACE(type, argument) uirbcore::Trace::log(uirbcore::TraceEvent::type, static_cast<uint8_t>(argument))
+#else  // defined(UIRB_CORE_TRACE)
+    #define UIRB_TRACE(type, argument) do {} while (0)
+#endif  // defined(UIRB_CORE_TRACE)
+
+#endif  // UIRBcore_Trace_hpp
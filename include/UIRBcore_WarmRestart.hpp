@@ -0,0 +1,131 @@
+/**
+ * @file UIRBcore_WarmRestart.hpp
+ * @brief Warm restart fast path for the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::WarmRestart class, which keeps a copy of the validated
+ * @ref uirbcore::eeprom::EEPROMData image (including the bandgap and `Rprog` calibration) and the last
+ * @ref uirbcore::PowerInfoData snapshot in `.noinit` RAM. After a watchdog or external reset the
+ * @ref uirbcore::UIRB constructor restores this state instead of reading, updating and writing back EEPROM.
+ *
+ * @note The fast path is only compiled when @ref UIRB_CORE_WARM_RESTART is defined.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_WarmRestart_hpp
+#define UIRBcore_WarmRestart_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_EEPROM.hpp>
+#include <UIRBcore_PowerInfoData.hpp>
+
+namespace uirbcore
+{
+    class UIRB;
+
+    /**
+     * @brief Warm restart state kept in `.noinit` RAM across resets.
+     *
+     * The state block holds a magic value, the last validated @ref eeprom::EEPROMData image, the last
+     * @ref PowerInfoData snapshot and a CRC-16 over all of them. It is considered valid only if:
+     * - The reset was not caused by power-on or brown-out (RAM content is not retained reliably).
+     * - The reset cause is known (see @ref WatchdogSupervisor::getResetFlags()).
+     * - The magic value and the CRC match.
+     *
+     * @details
+     * - A cold start takes the full path: EEPROM is read and validated, the boot count is incremented and 
+     *   saved, and the state block is written afterwards.
+     * - A warm start restores the state block. EEPROM is not accessed and the boot count is not incremented.
+     * - The state block is refreshed on every successful @ref UIRB::saveToEEPROM(), @ref UIRB::reloadFromEEPROM() 
+     *   and @ref UIRB::getPowerInfo() call, so it always mirrors what is stored in EEPROM.
+     *
+     * @note All methods are static; the class only groups the functionality.
+     */
+    class WarmRestart
+    {
+        public:
+        #if defined(UIRB_CORE_WARM_RESTART) || defined(__DOXYGEN__)
+            /**
+             * @brief Checks if the current boot restored the warm restart state.
+             *
+             * The result is evaluated once, on the first call, and cached for the rest of the run.
+             *
+             * @return bool
+             * @retval true A valid state block was found after a warm reset.
+             * @retval false This is a cold start, or the state block was invalid.
+             */
+            static bool isWarmStart();
+
+            /**
+             * @brief Invalidates the state block, forcing the next reset to take the full cold path.
+             */
+            static void invalidate();
+        #endif  // defined(UIRB_CORE_WARM_RESTART) || defined(__DOXYGEN__)
+
+        private:
+        #if defined(UIRB_CORE_WARM_RESTART) || defined(__DOXYGEN__)
+            /**
+             * @brief Returns the @ref eeprom::EEPROMData image stored in the state block.
+             *
+             * @return const eeprom::EEPROMData& Stored data; only meaningful if @ref isWarmStart() returns `true`.
+             */
+            static const eeprom::EEPROMData& eeprom_data();
+
+            /**
+             * @brief Returns the @ref PowerInfoData snapshot stored in the state block.
+             *
+             * @return PowerInfoData Stored snapshot; only meaningful if @ref isWarmStart() returns `true`.
+             */
+            static PowerInfoData power_info();
+
+            /**
+             * @brief Stores a validated @ref eeprom::EEPROMData image and updates the CRC.
+             *
+             * @param[in] data Data known to match the EEPROM content.
+             */
+            static void store_eeprom_data(const eeprom::EEPROMData& data);
+
+            /**
+             * @brief Stores a @ref PowerInfoData snapshot and updates the CRC.
+             *
+             * @param[in] power_info Snapshot to store.
+             */
+            static void store_power_info(const PowerInfoData& power_info);
+        #endif  // defined(UIRB_CORE_WARM_RESTART) || defined(__DOXYGEN__)
+
+            /**
+             * @brief Grants @ref UIRB access to the state block.
+             */
+            friend class UIRB;
+    };
+}  // namespace uirbcore
+
+#endif  // UIRBcore_WarmRestart_hpp
@@ -0,0 +1,294 @@
+/**
+ * @file UIRBcore_Watchdog.hpp
+ * @brief Watchdog supervisor, reset cause tracking and hang post-mortem for the %UIRB system.
+ *
+ * This header declares the @ref uirbcore::WatchdogSupervisor class and supporting types used to:
+ * - **Capture the reset cause**: The `MCUSR` register is mirrored into RAM before `main()` runs.
+ * - **Supervise the application**: The watchdog runs in interrupt-then-reset mode while the application
+ *   executes, and must be fed periodically.
+ * - **Record hangs**: On a watchdog timeout the interrupted program counter, uptime and the last library
+ *   event are written into a `.noinit` record that survives the following reset.
+ * - **Persist history**: Abnormal resets are appended to a compact rolling log in EEPROM.
+ *
+ * @note The supervisor is only compiled when @ref UIRB_CORE_WDT_SUPERVISOR is defined. Reset cause
+ * capture is always available.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef UIRBcore_Watchdog_hpp
+#define UIRBcore_Watchdog_hpp
+
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <avr/wdt.h>
+
+namespace uirbcore
+{
+    class UIRB;
+
+    /**
+     * @brief Enum class representing the last library operation entered, as `uint8_t`.
+     *
+     * The library marks entry into potentially long-running or hardware-touching operations with one of
+     * these values. When the watchdog supervisor detects a hang, the last marked event is stored in the
+     * post-mortem @ref ResetRecord to narrow down where the firmware stopped responding.
+     */
+    enum class CoreEvent : uint8_t
+    {
+        NONE = 0, /**< No library event was recorded. */
+        BOOT, /**< The @ref UIRB constructor is running. */
+        HW_VERSION_MISMATCH, /**< The @ref UIRB constructor detected a hardware version mismatch and is waiting for reset. */
+        EEPROM_SAVE, /**< Data is being written to EEPROM. */
+        EEPROM_LOAD, /**< Data is being loaded from EEPROM. */
+        ADC_BANDGAP, /**< The internal bandgap reference is being sampled against AVcc. */
+        ADC_PROG, /**< The charger `PROG` pin voltage is being sampled. */
+        POWER_INFO_UPDATE, /**< Power information is being updated. */
+        LOW_BATTERY_NOTIFY, /**< The low battery pattern is being shown on the status LED. */
+        POWER_DOWN, /**< The MCU is entering or leaving power-down sleep. */
+        USER = 0x80 /**< First value available for application defined events. */
+    };
+
+    /**
+     * @brief Compact record describing the circumstances of a reset.
+     *
+     * @details
+     * - @ref reset_flags holds the `MCUSR` bits (`PORF`, `EXTRF`, `BORF`, `WDRF`) observed at startup.
+     * - @ref fault_address holds the byte address of the instruction interrupted by the watchdog. It can be
+     *   resolved with `avr-addr2line -e firmware.elf 0x<address>`. It is `0` when no hang was captured.
+     * - @ref uptime_milliseconds holds the value of `millis()` at the time the hang was captured.
+     * - @ref last_event holds the last @ref CoreEvent marked before the hang.
+     *
+     * @note This structure is packed and stored as-is in the EEPROM reset log.
+     */
+    struct ResetRecord
+    {
+        uint8_t reset_flags; /**< @brief `MCUSR` reset flags observed at startup. */
+        CoreEvent last_event; /**< @brief Last library event marked before the reset. */
+        uint16_t fault_address; /**< @brief Byte address of the instruction interrupted by the watchdog. */
+        uint32_t uptime_milliseconds; /**< @brief Uptime in milliseconds when the hang was captured. */
+    } __attribute__((packed, aligned(1)));
+
+    /**
+     * @brief Watchdog timer supervisor with reset cause tracking and hang post-mortem.
+     *
+     * The @ref WatchdogSupervisor class manages the watchdog timer in interrupt-then-reset mode. On a timeout
+     * the watchdog interrupt captures the return address at the top of the stack, the current uptime and
+     * the last library event into a `.noinit` @ref ResetRecord, then lets the watchdog reset the MCU.
+     * During the next construction of @ref UIRB the record is validated and, for watchdog and brown-out
+     * resets, appended to a rolling EEPROM log.
+     *
+     * @details
+     * - The watchdog is shared with @ref UIRB::powerDown(), which uses it as a sleep timer. The supervisor
+     *   is paused for the duration of the sleep and restored with its original timeout afterwards.
+     * - The deliberate reset issued by the @ref UIRB constructor on hardware version mismatch does not enable
+     *   the watchdog interrupt, so it is reported as a plain watchdog reset without a fault address.
+     * - All methods are static; the class only groups the functionality.
+     *
+     * @note Methods that control the watchdog are only available when @ref UIRB_CORE_WDT_SUPERVISOR is defined.
+     * @note The supervisor cannot be combined with @ref AVR_DEBUG, which reserves the watchdog for the debugger.
+     *
+     * Example usage:
+     * @code
+     * UIRB& uirb = UIRB::getInstance();
+     *
+     * void setup() {
+     *     WatchdogSupervisor::begin(WDTO_2S);
+     * }
+     *
+     * void loop() {
+     *     WatchdogSupervisor::feed();
+     *     // ...
+     * }
+     * @endcode
+     */
+    class WatchdogSupervisor
+    {
+        public:
+            /**
+             * @brief Returns the `MCUSR` reset flags captured before `main()` ran.
+             *
+             * @return uint8_t Combination of `_BV(PORF)`, `_BV(EXTRF)`, `_BV(BORF)` and `_BV(WDRF)`.
+             */
+            static uint8_t getResetFlags();
+
+            /**
+             * @brief Checks if the last reset was caused by the watchdog timer.
+             *
+             * @return bool
+             * @retval true The `WDRF` flag was set at startup.
+             * @retval false The reset had another cause.
+             */
+            static bool wasWatchdogReset();
+
+            /**
+             * @brief Checks if the last reset was caused by the brown-out detector.
+             *
+             * @return bool
+             * @retval true The `BORF` flag was set at startup.
+             * @retval false The reset had another cause.
+             */
+            static bool wasBrownOutReset();
+
+        #if defined(UIRB_CORE_WDT_SUPERVISOR) || defined(__DOXYGEN__)
+            /**
+             * @brief Starts supervising the application with the watchdog timer.
+             *
+             * The watchdog is configured in interrupt-then-reset mode. If @ref feed() is not called within
+             * @p timeout, the watchdog interrupt stores a post-mortem @ref ResetRecord and the MCU is reset.
+             *
+             * @param[in] timeout Watchdog timeout, one of `WDTO_15MS` to `WDTO_8S`. Default is `WDTO_2S`.
+             */
+            static void begin(const uint8_t timeout = WDTO_2S);
+
+            /**
+             * @brief Restarts the watchdog timeout. Must be called periodically while supervision is active.
+             */
+            static void feed()
+            {
+                wdt_reset();
+            }
+
+            /**
+             * @brief Stops supervising the application and disables the watchdog timer.
+             */
+            static void end();
+
+            /**
+             * @brief Checks if supervision is active.
+             *
+             * @return bool
+             * @retval true The watchdog supervises the application.
+             * @retval false The watchdog is disabled or used as a sleep timer.
+             */
+            static bool isActive();
+
+            /**
+             * @brief Retrieves the post-mortem record captured before the last reset.
+             *
+             * @param[out] record Destination for the captured record.
+             * @return bool
+             * @retval true A valid hang record was captured before the last reset.
+             * @retval false No hang was captured; @p record holds only the reset flags.
+             */
+            static bool getPostMortem(ResetRecord& record);
+
+            /**
+             * @brief Returns the number of records stored in the EEPROM reset log.
+             *
+             * @return uint8_t Number of records `[0-` @ref UIRB_CORE_WDT_RESET_LOG_SLOTS `]`.
+             */
+            static uint8_t getResetLogCount();
+
+            /**
+             * @brief Reads a record from the EEPROM reset log.
+             *
+             * @param[in] age Age of the record, `0` being the newest one.
+             * @param[out] record Destination for the stored record.
+             * @return bool
+             * @retval true The record was read successfully.
+             * @retval false No record of the requested age is stored.
+             */
+            static bool readResetLog(const uint8_t age, ResetRecord& record);
+
+            /**
+             * @brief Erases all records in the EEPROM reset log.
+             */
+            static void clearResetLog();
+        #endif  // defined(UIRB_CORE_WDT_SUPERVISOR) || defined(__DOXYGEN__)
+
+            /**
+             * @brief Marks the library or application event currently being executed.
+             *
+             * The value is stored in the post-mortem @ref ResetRecord when a hang is detected.
+             * When @ref UIRB_CORE_WDT_SUPERVISOR is not defined this function compiles to nothing.
+             *
+             * @param[in] event Event being entered.
+             */
+            static void markEvent(const CoreEvent event)
+            {
+            #if defined(UIRB_CORE_WDT_SUPERVISOR)
+                last_event_ = event;
+            #else  // defined(UIRB_CORE_WDT_SUPERVISOR)
+                (void)event;
+            #endif  // defined(UIRB_CORE_WDT_SUPERVISOR)
+            }
+
+        #if defined(UIRB_CORE_WDT_SUPERVISOR) || defined(__DOXYGEN__)
+            /**
+             * @brief Returns the last event marked with @ref markEvent().
+             *
+             * @return CoreEvent Last marked event.
+             */
+            static CoreEvent getLastEvent()
+            {
+                return last_event_;
+            }
+        #endif  // defined(UIRB_CORE_WDT_SUPERVISOR) || defined(__DOXYGEN__)
+
+        private:
+        #if defined(UIRB_CORE_WDT_SUPERVISOR) || defined(__DOXYGEN__)
+            /**
+             * @brief Pauses supervision and switches the watchdog to sleep timer mode.
+             *
+             * Called by @ref UIRB::powerDown() before it takes over the watchdog.
+             *
+             * @return bool `true` if supervision was active and must be resumed after sleep.
+             */
+            static bool suspend_for_sleep();
+
+            /**
+             * @brief Restores supervision after @ref UIRB::powerDown() released the watchdog.
+             *
+             * @param[in] resume Value returned by @ref suspend_for_sleep().
+             */
+            static void resume_after_sleep(const bool resume);
+
+            /**
+             * @brief Appends the current reset to the EEPROM reset log if it was abnormal.
+             *
+             * Watchdog and brown-out resets are logged. Called once by the @ref UIRB constructor.
+             */
+            static void log_reset();
+
+            /**
+             * @brief Last event marked with @ref markEvent().
+             */
+            static volatile CoreEvent last_event_;
+        #endif  // defined(UIRB_CORE_WDT_SUPERVISOR) || defined(__DOXYGEN__)
+
+            /**
+             * @brief Grants @ref UIRB access to the sleep coordination and logging functions.
+             */
+            friend class UIRB;
+    };
+}  // namespace uirbcore
+
+#endif  // UIRBcore_Watchdog_hpp
@@ -0,0 +1,283 @@
+/*
+ * simavr harness measuring the worst-case latency of a critical interrupt of a UIRBcorelib firmware.
+ *
+ * Runs the firmware on a simulated ATmega328P at 8 MHz one instruction at a time while driving its inputs:
+ * - PB0 (PIN_IR_CAPTURE, ICP1) toggles at random intervals, raising TIMER1_CAPT when input capture is enabled.
+ * - PD2 (PIN_BUTTON_WAKEUP, INT0) and PD4 (PIN_USB_IO3, PCINT20) toggle at their own random intervals, so the
+ *   button and pin change interrupts run next to Timer0, the watchdog and the timer wheel.
+ * The latency of the critical vector is the number of cycles from raising its flag to entering its vector.
+ * Each sample is charged to what held the CPU when the flag was raised: the innermost interrupt in service, the
+ * main program with interrupts disabled, or nothing.
+ *
+ * Output is CSV with one line per holder, followed by the worst case of the whole run:
+ *   holder,samples,max_cycles,max_us
+ *   isr <vector number>,<samples>,<cycles>,<microseconds>
+ *   cli,<samples>,<cycles>,<microseconds>
+ *   none,<samples>,<cycles>,<microseconds>
+ *   worst,<samples>,<cycles>,<microseconds>
+ * The cycles end when the CPU reaches the vector table, the jump and the handler prologue come on top.
+ *
+ * Build:   cc -O2 -o uirb_irq_latency uirb_irq_latency.c -lsimavr -lelf
+ * Run:     ./uirb_irq_latency firmware.elf latency.csv [milliseconds] [vector]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_io.h>
+#include <simavr/sim_irq.h>
+#include <simavr/sim_interrupts.h>
+#include <simavr/sim_cycle_timers.h>
+#include <simavr/avr_ioport.h>
+
+#define UIRB_FREQUENCY 8000000UL
+#define UIRB_DEFAULT_MILLISECONDS 10000UL
+#define UIRB_DEFAULT_VECTOR 10U /* TIMER1_CAPT */
+#define UIRB_VECTOR_COUNT 26U
+#define UIRB_VECTOR_SIZE 4U /* Bytes per vector table entry, one jmp */
+#define UIRB_SPL_ADDRESS 0x5D
+#define UIRB_SPH_ADDRESS 0x5E
+#define UIRB_MAX_FRAMES 16U
+#define UIRB_HOLDER_CLI UIRB_VECTOR_COUNT
+#define UIRB_HOLDER_NONE (UIRB_VECTOR_COUNT + 1U)
+#define UIRB_HOLDER_COUNT (UIRB_VECTOR_COUNT + 2U)
+
+/*
+ * Input toggled at random intervals.
+ */
+typedef struct
+{
+    char port;
+    uint8_t pin;
+    uint32_t min_us; /* Shortest interval between edges */
+    uint32_t max_us; /* Longest interval between edges */
+    avr_irq_t* irq;
+    uint8_t level;
+} stimulus_t;
+
+/*
+ * Open interrupt frame, closed when the stack pointer rises back above its return address.
+ */
+typedef struct
+{
+    uint16_t entry_sp;
+    uint8_t vector;
+} frame_t;
+
+/*
+ * Latency statistics of one holder.
+ */
+typedef struct
+{
+    uint32_t samples;
+    avr_cycle_count_t max_cycles;
+} latency_t;
+
+static stimulus_t stimuli[] = {
+    { 'B', 0, 200, 3000, NULL, 1 }, /* IR capture, NEC marks and spaces */
+    { 'D', 2, 700, 9000, NULL, 1 }, /* Button */
+    { 'D', 4, 500, 7000, NULL, 1 }, /* USB IO3 */
+};
+
+static frame_t frames[UIRB_MAX_FRAMES];
+static unsigned frame_count = 0;
+static latency_t latencies[UIRB_HOLDER_COUNT];
+static avr_cycle_count_t pending_cycle = 0;
+static uint8_t pending = 0;
+static uint8_t cleared = 0; /* The flag was cleared during the last instruction, by software or by entering the vector */
+static uint8_t pending_holder = UIRB_HOLDER_NONE;
+static uint32_t random_state = 0x2545F491UL;
+
+static uint16_t read_sp(const avr_t* avr)
+{
+    return (uint16_t)(avr->data[UIRB_SPL_ADDRESS] | (avr->data[UIRB_SPH_ADDRESS] << 8));
+}
+
+/*
+ * Returns a pseudo random number, the same sequence on every run.
+ */
+static uint32_t next_random(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+/*
+ * Toggles an input and returns the cycle of its next edge.
+ */
+static avr_cycle_count_t toggle_stimulus(struct avr_t* avr, avr_cycle_count_t when, void* param)
+{
+    stimulus_t* stimulus = (stimulus_t*)param;
+    stimulus->level ^= 1U;
+    avr_raise_irq(stimulus->irq, stimulus->level);
+    const uint32_t interval_us = stimulus->min_us + next_random() % (stimulus->max_us - stimulus->min_us + 1U);
+    (void)avr;
+    return when + (avr_cycle_count_t)interval_us * (UIRB_FREQUENCY / 1000000UL);
+}
+
+/*
+ * Records when the flag of the critical vector is raised and what holds the CPU at that moment.
+ */
+static void critical_pending(struct avr_irq_t* irq, uint32_t value, void* param)
+{
+    avr_t* avr = (avr_t*)param;
+    (void)irq;
+    if (value == 0)
+    {
+        cleared = pending;
+        pending = 0;
+        return;
+    }
+    if (pending)
+    {
+        return;
+    }
+    pending = 1;
+    pending_cycle = avr->cycle;
+    if (frame_count > 0)
+    {
+        pending_holder = frames[frame_count - 1].vector;
+    }
+    else
+    {
+        pending_holder = avr->sreg[S_I] ? UIRB_HOLDER_NONE : UIRB_HOLDER_CLI;
+    }
+}
+
+static void record_latency(const uint8_t holder, const avr_cycle_count_t cycles)
+{
+    latencies[holder].samples++;
+    if (cycles > latencies[holder].max_cycles)
+    {
+        latencies[holder].max_cycles = cycles;
+    }
+}
+
+static void print_latency(FILE* output, const char* holder, const unsigned vector, const latency_t* latency)
+{
+    if (vector < UIRB_VECTOR_COUNT)
+    {
+        fprintf(output, "%s %u,", holder, vector);
+    }
+    else
+    {
+        fprintf(output, "%s,", holder);
+    }
+    fprintf(output, "%lu,%lu,%.2f\n", (unsigned long)latency->samples, (unsigned long)latency->max_cycles,
+            (double)latency->max_cycles * 1000000.0 / UIRB_FREQUENCY);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: %s firmware.elf latency.csv [milliseconds] [vector]\n", argv[0]);
+        return 1;
+    }
+    const unsigned long milliseconds = (argc > 3) ? strtoul(argv[3], NULL, 0) : UIRB_DEFAULT_MILLISECONDS;
+    const unsigned critical_vector = (argc > 4) ? (unsigned)strtoul(argv[4], NULL, 0) : UIRB_DEFAULT_VECTOR;
+    if (critical_vector == 0 || critical_vector >= UIRB_VECTOR_COUNT)
+    {
+        fprintf(stderr, "Vector must be between 1 and %u\n", UIRB_VECTOR_COUNT - 1U);
+        return 1;
+    }
+
+    elf_firmware_t firmware = { { 0 } };
+    if (elf_read_firmware(argv[1], &firmware) != 0)
+    {
+        fprintf(stderr, "Cannot read firmware '%s'\n", argv[1]);
+        return 1;
+    }
+
+    avr_t* avr = avr_make_mcu_by_name("atmega328p");
+    if (avr == NULL)
+    {
+        fprintf(stderr, "simavr has no atmega328p core\n");
+        return 1;
+    }
+    avr_init(avr);
+    firmware.frequency = UIRB_FREQUENCY;
+    avr_load_firmware(avr, &firmware);
+
+    avr_irq_register_notify(avr_get_interrupt_irq(avr, (uint8_t)critical_vector) + AVR_INT_IRQ_PENDING,
+                            critical_pending, avr);
+    for (unsigned i = 0; i < sizeof(stimuli) / sizeof(stimuli[0]); i++)
+    {
+        stimuli[i].irq = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ(stimuli[i].port), stimuli[i].pin);
+        avr_raise_irq(stimuli[i].irq, stimuli[i].level);
+        avr_cycle_timer_register_usec(avr, stimuli[i].max_us, toggle_stimulus, &stimuli[i]);
+    }
+
+    const avr_cycle_count_t end = (avr_cycle_count_t)milliseconds * (UIRB_FREQUENCY / 1000UL);
+    int state = cpu_Running;
+    while (avr->cycle < end && state != cpu_Done && state != cpu_Crashed)
+    {
+        const avr_flashaddr_t old_pc = avr->pc;
+        cleared = 0;
+        state = avr_run(avr); /* One instruction, followed by the entry of a pending interrupt */
+        const avr_flashaddr_t pc = avr->pc;
+        const uint16_t sp = read_sp(avr);
+
+        while (frame_count > 0 && sp >= frames[frame_count - 1].entry_sp)
+        {
+            frame_count--;
+        }
+
+        const avr_flashaddr_t vectors_end = UIRB_VECTOR_COUNT * UIRB_VECTOR_SIZE;
+        if (pc < vectors_end && pc != 0 && old_pc >= vectors_end)
+        {
+            const uint8_t vector = (uint8_t)(pc / UIRB_VECTOR_SIZE);
+            if (vector == critical_vector && (pending || cleared))
+            {
+                record_latency(pending_holder, avr->cycle - pending_cycle);
+                pending = 0;
+            }
+            if (frame_count == UIRB_MAX_FRAMES)
+            {
+                fprintf(stderr, "Interrupt nesting deeper than %u frames\n", UIRB_MAX_FRAMES);
+                return 1;
+            }
+            frames[frame_count].entry_sp = (uint16_t)(sp + 2U);
+            frames[frame_count].vector = vector;
+            frame_count++;
+        }
+    }
+
+    FILE* output = fopen(argv[2], "w");
+    if (output == NULL)
+    {
+        fprintf(stderr, "Cannot create '%s'\n", argv[2]);
+        return 1;
+    }
+    latency_t worst = { 0, 0 };
+    fprintf(output, "holder,samples,max_cycles,max_us\n");
+    for (unsigned holder = 0; holder < UIRB_HOLDER_COUNT; holder++)
+    {
+        if (latencies[holder].samples == 0)
+        {
+            continue;
+        }
+        worst.samples += latencies[holder].samples;
+        if (latencies[holder].max_cycles > worst.max_cycles)
+        {
+            worst.max_cycles = latencies[holder].max_cycles;
+        }
+        if (holder < UIRB_VECTOR_COUNT)
+        {
+            print_latency(output, "isr", holder, &latencies[holder]);
+        }
+        else
+        {
+            print_latency(output, (holder == UIRB_HOLDER_CLI) ? "cli" : "none", UIRB_VECTOR_COUNT, &latencies[holder]);
+        }
+    }
+    print_latency(output, "worst", UIRB_VECTOR_COUNT, &worst);
+    fclose(output);
+
+    printf("Simulated %lu ms, vector %u entered %lu times, %s\n", (unsigned long)(avr->cycle / (UIRB_FREQUENCY / 1000UL)),
+           critical_vector, (unsigned long)worst.samples,
+           (state == cpu_Crashed) ? "crashed" : ((state == cpu_Done) ? "stopped" : "time limit reached"));
+    return (state == cpu_Crashed) ? 1 : 0;
+}
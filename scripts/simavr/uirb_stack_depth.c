@@ -0,0 +1,212 @@
+/*
+ * simavr harness measuring the stack depth of every function call and interrupt of a UIRBcorelib firmware.
+ *
+ * Runs the firmware on a simulated ATmega328P at 8 MHz one instruction at a time and follows the stack pointer:
+ * - A call is a step which pushes the address of the next instruction and jumps elsewhere.
+ * - An interrupt is a step which pushes a return address and jumps into the vector table.
+ * - A frame ends when the stack pointer rises back to its value before the push.
+ * The depth of a frame is the stack it used including its return address and its callees, but without the
+ * interrupts which preempted it. Interrupts are reported on their own.
+ *
+ * Output is CSV with one line per call target and vector, followed by the deepest stack use of the whole run:
+ *   kind,address,calls,max_bytes
+ *   call,0x<byte address>,<calls>,<bytes>
+ *   isr,<vector number>,<entries>,<bytes>
+ *   peak,,,<bytes>
+ *
+ * Build:   cc -O2 -o uirb_stack_depth uirb_stack_depth.c -lsimavr -lelf
+ * Run:     ./uirb_stack_depth firmware.elf stack.csv [milliseconds]
+ * Analyse: python scripts/stack_report.py firmware.elf stack.csv
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+
+#define UIRB_FREQUENCY 8000000UL
+#define UIRB_DEFAULT_MILLISECONDS 10000UL
+#define UIRB_FLASH_WORDS 16384U /* 32 KB of program memory */
+#define UIRB_VECTOR_COUNT 26U
+#define UIRB_VECTOR_SIZE 4U /* Bytes per vector table entry, one jmp */
+#define UIRB_SPL_ADDRESS 0x5D
+#define UIRB_SPH_ADDRESS 0x5E
+#define UIRB_RAMEND 0x8FFU
+#define UIRB_MAX_FRAMES 256U
+
+/*
+ * Open call or interrupt frame.
+ */
+typedef struct
+{
+    uint16_t entry_sp; /* Stack pointer before the return address was pushed */
+    uint16_t min_sp; /* Lowest stack pointer of the frame and its callees */
+    uint16_t target; /* Byte address of the callee, or vector number */
+    uint8_t isr; /* Frame is an interrupt */
+} frame_t;
+
+/*
+ * Statistics of one call target or vector.
+ */
+typedef struct
+{
+    uint32_t calls;
+    uint16_t max_bytes;
+} depth_t;
+
+static depth_t call_depths[UIRB_FLASH_WORDS];
+static depth_t isr_depths[UIRB_VECTOR_COUNT];
+static frame_t frames[UIRB_MAX_FRAMES];
+static unsigned frame_count = 0;
+
+static uint16_t read_sp(const avr_t* avr)
+{
+    return (uint16_t)(avr->data[UIRB_SPL_ADDRESS] | (avr->data[UIRB_SPH_ADDRESS] << 8));
+}
+
+/*
+ * Returns the word address pushed by the last call or interrupt, stored high byte first just above the stack pointer.
+ */
+static uint16_t pushed_return_word(const avr_t* avr, const uint16_t sp)
+{
+    return (uint16_t)((avr->data[sp + 1] << 8) | avr->data[sp + 2]);
+}
+
+/*
+ * Closes a frame, records its depth and passes its lowest stack pointer to the caller unless it is an interrupt.
+ */
+static void close_frame(void)
+{
+    const frame_t* frame = &frames[--frame_count];
+    const uint16_t bytes = (uint16_t)(frame->entry_sp - frame->min_sp);
+    depth_t* depth = frame->isr ? &isr_depths[frame->target] : &call_depths[frame->target / 2U];
+    if (bytes > depth->max_bytes)
+    {
+        depth->max_bytes = bytes;
+    }
+    if (!frame->isr && frame_count > 0 && frame->min_sp < frames[frame_count - 1].min_sp)
+    {
+        frames[frame_count - 1].min_sp = frame->min_sp;
+    }
+}
+
+static void open_frame(const uint16_t sp, const uint16_t target, const uint8_t isr)
+{
+    if (frame_count == UIRB_MAX_FRAMES)
+    {
+        fprintf(stderr, "Call nesting deeper than %u frames, stack overflow?\n", UIRB_MAX_FRAMES);
+        exit(1);
+    }
+    frame_t* frame = &frames[frame_count++];
+    frame->entry_sp = (uint16_t)(sp + 2U);
+    frame->min_sp = sp;
+    frame->target = target;
+    frame->isr = isr;
+    if (isr)
+    {
+        isr_depths[target].calls++;
+    }
+    else
+    {
+        call_depths[target / 2U].calls++;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: %s firmware.elf stack.csv [milliseconds]\n", argv[0]);
+        return 1;
+    }
+    const unsigned long milliseconds = (argc > 3) ? strtoul(argv[3], NULL, 0) : UIRB_DEFAULT_MILLISECONDS;
+
+    elf_firmware_t firmware = { { 0 } };
+    if (elf_read_firmware(argv[1], &firmware) != 0)
+    {
+        fprintf(stderr, "Cannot read firmware '%s'\n", argv[1]);
+        return 1;
+    }
+
+    avr_t* avr = avr_make_mcu_by_name("atmega328p");
+    if (avr == NULL)
+    {
+        fprintf(stderr, "simavr has no atmega328p core\n");
+        return 1;
+    }
+    avr_init(avr);
+    firmware.frequency = UIRB_FREQUENCY;
+    avr_load_firmware(avr, &firmware);
+
+    const avr_cycle_count_t end = (avr_cycle_count_t)milliseconds * (UIRB_FREQUENCY / 1000UL);
+    uint16_t peak_sp = UIRB_RAMEND;
+    int state = cpu_Running;
+    while (avr->cycle < end && state != cpu_Done && state != cpu_Crashed)
+    {
+        const avr_flashaddr_t old_pc = avr->pc;
+        const uint16_t old_sp = read_sp(avr);
+        state = avr_run(avr); /* One instruction, followed by the entry of a pending interrupt */
+        const avr_flashaddr_t pc = avr->pc;
+        const uint16_t sp = read_sp(avr);
+
+        const avr_flashaddr_t vectors_end = UIRB_VECTOR_COUNT * UIRB_VECTOR_SIZE;
+        if (pc < vectors_end && pc != 0 && old_pc >= vectors_end)
+        {
+            open_frame(sp, (uint16_t)(pc / UIRB_VECTOR_SIZE), 1);
+        }
+        else if (sp == (uint16_t)(old_sp - 2U) && pc != old_pc + 2U && pc != old_pc + 4U)
+        {
+            const uint16_t return_word = pushed_return_word(avr, sp);
+            if (return_word == old_pc / 2U + 1U || return_word == old_pc / 2U + 2U)
+            {
+                open_frame(sp, (uint16_t)pc, 0);
+            }
+        }
+
+        while (frame_count > 0 && sp >= frames[frame_count - 1].entry_sp)
+        {
+            close_frame();
+        }
+        if (frame_count > 0 && sp < frames[frame_count - 1].min_sp)
+        {
+            frames[frame_count - 1].min_sp = sp;
+        }
+        if (sp < peak_sp)
+        {
+            peak_sp = sp;
+        }
+    }
+    while (frame_count > 0)
+    {
+        close_frame();
+    }
+
+    FILE* output = fopen(argv[2], "w");
+    if (output == NULL)
+    {
+        fprintf(stderr, "Cannot create '%s'\n", argv[2]);
+        return 1;
+    }
+    fprintf(output, "kind,address,calls,max_bytes\n");
+    for (unsigned word = 0; word < UIRB_FLASH_WORDS; word++)
+    {
+        if (call_depths[word].calls != 0)
+        {
+            fprintf(output, "call,0x%x,%lu,%u\n", word * 2U, (unsigned long)call_depths[word].calls,
+                    call_depths[word].max_bytes);
+        }
+    }
+    for (unsigned vector = 0; vector < UIRB_VECTOR_COUNT; vector++)
+    {
+        if (isr_depths[vector].calls != 0)
+        {
+            fprintf(output, "isr,%u,%lu,%u\n", vector, (unsigned long)isr_depths[vector].calls,
+                    isr_depths[vector].max_bytes);
+        }
+    }
+    fprintf(output, "peak,,,%u\n", (unsigned)(UIRB_RAMEND - peak_sp));
+    fclose(output);
+
+    printf("Simulated %lu ms, %s\n", (unsigned long)(avr->cycle / (UIRB_FREQUENCY / 1000UL)),
+           (state == cpu_Crashed) ? "crashed" : ((state == cpu_Done) ? "stopped" : "time limit reached"));
+    return (state == cpu_Crashed) ? 1 : 0;
+}
@@ -0,0 +1,88 @@
+/*
+ * simavr harness recording the UIRBcorelib debug strobe into a VCD file.
+ *
+ * Runs a firmware built with UIRB_CORE_DEBUG_STROBE on a simulated ATmega328P at 8 MHz and traces:
+ * - PD5 (PIN_PULLDOWN_RESISTOR), high while a selected probe runs.
+ * - GPIOR0, the running probe value plus one, which scripts/strobe_summary.py uses to tell the probes apart.
+ *
+ * Build:   cc -O2 -o uirb_strobe_vcd uirb_strobe_vcd.c -lsimavr -lelf
+ * Run:     ./uirb_strobe_vcd firmware.elf trace.vcd [milliseconds]
+ * Analyse: python scripts/strobe_summary.py trace.vcd
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_io.h>
+#include <simavr/sim_irq.h>
+#include <simavr/sim_vcd_file.h>
+#include <simavr/avr_ioport.h>
+
+#define UIRB_FREQUENCY 8000000UL
+#define UIRB_STROBE_PIN 5
+#define UIRB_GPIOR0_ADDRESS 0x3E /* Data space address of GPIOR0 (I/O 0x1E) */
+#define UIRB_DEFAULT_MILLISECONDS 10000UL
+
+static const char* probe_irq_names[] = { "8>GPIOR0" };
+
+/*
+ * Stores a write to GPIOR0 and raises it on the traced IRQ, simavr has no IRQ for general purpose registers.
+ */
+static void gpior0_write(struct avr_t* avr, avr_io_addr_t address, uint8_t value, void* param)
+{
+    avr->data[address] = value;
+    avr_raise_irq((avr_irq_t*)param, value);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: %s firmware.elf trace.vcd [milliseconds]\n", argv[0]);
+        return 1;
+    }
+    const unsigned long milliseconds = (argc > 3) ? strtoul(argv[3], NULL, 0) : UIRB_DEFAULT_MILLISECONDS;
+
+    elf_firmware_t firmware = { { 0 } };
+    if (elf_read_firmware(argv[1], &firmware) != 0)
+    {
+        fprintf(stderr, "Cannot read firmware '%s'\n", argv[1]);
+        return 1;
+    }
+
+    avr_t* avr = avr_make_mcu_by_name("atmega328p");
+    if (avr == NULL)
+    {
+        fprintf(stderr, "simavr has no atmega328p core\n");
+        return 1;
+    }
+    avr_init(avr);
+    firmware.frequency = UIRB_FREQUENCY;
+    avr_load_firmware(avr, &firmware);
+
+    avr_irq_t* probe_irq = avr_alloc_irq(&avr->irq_pool, 0, 1, probe_irq_names);
+    avr_register_io_write(avr, UIRB_GPIOR0_ADDRESS, gpior0_write, probe_irq);
+
+    avr_vcd_t vcd;
+    if (avr_vcd_init(avr, argv[2], &vcd, 1000 /* flush period in microseconds */) != 0)
+    {
+        fprintf(stderr, "Cannot create '%s'\n", argv[2]);
+        return 1;
+    }
+    avr_vcd_add_signal(&vcd, avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ('D'), UIRB_STROBE_PIN), 1, "PD5");
+    avr_vcd_add_signal(&vcd, probe_irq, 8, "GPIOR0");
+    avr_vcd_start(&vcd);
+
+    const avr_cycle_count_t end = (avr_cycle_count_t)milliseconds * (UIRB_FREQUENCY / 1000UL);
+    int state = cpu_Running;
+    while (avr->cycle < end && state != cpu_Done && state != cpu_Crashed)
+    {
+        state = avr_run(avr);
+    }
+
+    avr_vcd_stop(&vcd);
+    avr_vcd_close(&vcd);
+    printf("Simulated %lu ms, %s\n", (unsigned long)(avr->cycle / (UIRB_FREQUENCY / 1000UL)),
+           (state == cpu_Crashed) ? "crashed" : ((state == cpu_Done) ? "stopped" : "time limit reached"));
+    return (state == cpu_Crashed) ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+import csv
+import subprocess
+import sys
+
+# Symbols reported by default, the public API of the library
+REPORTED_PREFIXES = (
+    "uirbcore::UIRB::",
+    "uirbcore::PowerInfoData::",
+    "uirbcore::eeprom::EEPROMDataManager::",
+)
+
+# Interrupt vectors of the ATmega328P, by vector number
+VECTOR_NAMES = [
+    "RESET", "INT0", "INT1", "PCINT0", "PCINT1", "PCINT2", "WDT", "TIMER2_COMPA", "TIMER2_COMPB", "TIMER2_OVF",
+    "TIMER1_CAPT", "TIMER1_COMPA", "TIMER1_COMPB", "TIMER1_OVF", "TIMER0_COMPA", "TIMER0_COMPB", "TIMER0_OVF",
+    "SPI_STC", "USART_RX", "USART_UDRE", "USART_TX", "ADC", "EE_READY", "ANALOG_COMP", "TWI", "SPM_READY",
+]
+
+def log_message(message):
+    """
+    Logs a message with the [UIRBcorelib] prefix to stderr.
+    """
+    print(f"[UIRBcorelib]: {message}", file=sys.stderr)
+
+def read_symbols(firmware):
+    """
+    Returns the demangled names of the functions in the firmware by their byte address, using avr-nm.
+    """
+    output = subprocess.run(["avr-nm", "-C", "--defined-only", firmware], check=True, capture_output=True,
+                            text=True).stdout
+    symbols = {}
+    for line in output.splitlines():
+        fields = line.split(" ", 2)
+        if len(fields) == 3 and fields[1] in "TtWw":
+            symbols.setdefault(int(fields[0], 16), fields[2])
+    return symbols
+
+def read_depths(lines, symbols, show_all):
+    """
+    Parses the CSV written by uirb_stack_depth.c.
+
+    Returns ([(name, calls, max bytes)] of the reported functions and vectors, peak bytes of the whole run).
+    """
+    rows = []
+    peak = None
+    for row in csv.DictReader(lines):
+        if row["kind"] == "peak":
+            peak = int(row["max_bytes"])
+        elif row["kind"] == "isr":
+            vector = int(row["address"])
+            name = VECTOR_NAMES[vector] if vector < len(VECTOR_NAMES) else f"VECTOR_{vector}"
+            rows.append((f"ISR {name}", int(row["calls"]), int(row["max_bytes"])))
+        elif row["kind"] == "call":
+            address = int(row["address"], 16)
+            name = symbols.get(address, f"0x{address:04x}")
+            if show_all or name.startswith(REPORTED_PREFIXES):
+                rows.append((name, int(row["calls"]), int(row["max_bytes"])))
+    if peak is None:
+        raise ValueError("No peak line found, the depth file is incomplete.")
+    return rows, peak
+
+def print_report(rows, peak):
+    """
+    Prints the maximum stack depth of every reported function and vector, deepest first.
+    """
+    peak_label = "peak (all code and interrupts)"
+    width = max([len(name) for name, _, _ in rows] + [len(peak_label)])
+    print(f"{'function':<{width}} {'calls':>9} {'max bytes':>10}")
+    for name, calls, max_bytes in sorted(rows, key=lambda row: (-row[2], row[0])):
+        print(f"{name:<{width}} {calls:>9} {max_bytes:>10}")
+    print(f"{peak_label:<{width}} {'':>9} {peak:>10}")
+
+def main():
+    try:
+        arguments = [argument for argument in sys.argv[1:] if argument != "--all"]
+        if len(arguments) != 2:
+            raise ValueError("Usage: stack_report.py [--all] firmware.elf stack.csv")
+
+        symbols = read_symbols(arguments[0])
+        with open(arguments[1], "r", newline="") as file:
+            rows, peak = read_depths(file.readlines(), symbols, "--all" in sys.argv[1:])
+        print_report(rows, peak)
+
+    except Exception as e:
+        log_message(f"Error: {e}")
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,150 @@
+import sys
+
+STROBE_SIGNAL = "PD5"
+PROBE_SIGNAL = "GPIOR0"
+
+# Mirrors uirbcore::ProfileProbe, GPIOR0 holds the probe value plus one
+PROBE_NAMES = [
+    "ADC_BANDGAP",
+    "ADC_PROG",
+    "POWER_INFO_UPDATE",
+    "EEPROM_COMMIT",
+    "POWER_DOWN",
+    "ISR_BUTTON_WAKEUP",
+    "ISR_PCINT2",
+    "ISR_WDT",
+    "SLEEP",
+]
+
+TIMESCALE_UNITS = {"s": 1e12, "ms": 1e9, "us": 1e6, "ns": 1e3, "ps": 1}
+
+def log_message(message):
+    """
+    Logs a message with the [UIRBcorelib] prefix to stderr.
+    """
+    print(f"[UIRBcorelib]: {message}", file=sys.stderr)
+
+def probe_name(value):
+    """
+    Returns the name of the probe stored in GPIOR0 as value.
+    """
+    index = value - 1
+    return PROBE_NAMES[index] if 0 <= index < len(PROBE_NAMES) else f"PROBE_{index}"
+
+def parse_timescale(text):
+    """
+    Returns the length of one VCD time unit in picoseconds.
+    """
+    text = text.replace(" ", "")
+    digits = "".join(character for character in text if character.isdigit())
+    unit = text[len(digits):]
+    if unit not in TIMESCALE_UNITS:
+        raise ValueError(f"Unsupported timescale '{text}'.")
+    return int(digits or "1") * TIMESCALE_UNITS[unit]
+
+def parse_vcd(lines):
+    """
+    Parses a VCD file into the timescale and the value changes of the strobe and probe signals.
+
+    Returns (picoseconds per unit, [(time, signal name, value)]), ordered by time.
+    """
+    tokens = " ".join(lines).split()
+    timescale = 1e6
+    identifiers = {}
+    changes = []
+    time = 0
+    index = 0
+    while index < len(tokens):
+        token = tokens[index]
+        if token == "$timescale":
+            end = tokens.index("$end", index)
+            timescale = parse_timescale("".join(tokens[index + 1:end]))
+            index = end
+        elif token == "$var":
+            # $var <type> <width> <identifier> <name> [range] $end
+            end = tokens.index("$end", index)
+            name = tokens[index + 4]
+            if name in (STROBE_SIGNAL, PROBE_SIGNAL):
+                identifiers[tokens[index + 3]] = name
+            index = end
+        elif token.startswith("$"):
+            if token not in ("$dumpvars", "$end"):
+                index = tokens.index("$end", index)
+        elif token.startswith("#"):
+            time = int(token[1:])
+        elif token[0] in "bBrR":
+            identifier = tokens[index + 1]
+            if identifier in identifiers:
+                bits = token[1:].lower()
+                value = int(bits, 2) if all(bit in "01" for bit in bits) else 0
+                changes.append((time, identifiers[identifier], value))
+            index += 1
+        elif token[0] in "01xXzZ":
+            identifier = token[1:]
+            if identifier in identifiers:
+                changes.append((time, identifiers[identifier], 1 if token[0] == "1" else 0))
+        index += 1
+
+    if STROBE_SIGNAL not in identifiers.values() and PROBE_SIGNAL not in identifiers.values():
+        raise ValueError(f"Neither {STROBE_SIGNAL} nor {PROBE_SIGNAL} found in the trace.")
+    return timescale, changes
+
+def collect_durations(changes):
+    """
+    Collects the duration of every probe execution, in VCD time units.
+
+    With the probe signal, nested probes are told apart by the value GPIOR0 returns to: going back to the value
+    of an enclosing probe, or to 0, ends the probes above it, any other value starts a new one. Without it, each high pulse
+    of the strobe counts as one execution of the probe "STROBE".
+    """
+    durations = {}
+    has_probe = any(name == PROBE_SIGNAL for _, name, _ in changes)
+    stack = []
+    strobe_start = None
+    for time, name, value in changes:
+        if has_probe and name == PROBE_SIGNAL:
+            if value == 0 or any(probe == value for probe, _ in stack[:-1]):
+                while stack and stack[-1][0] != value:
+                    probe, start = stack.pop()
+                    durations.setdefault(probe_name(probe), []).append(time - start)
+            elif not stack or stack[-1][0] != value:
+                stack.append((value, time))
+        elif not has_probe and name == STROBE_SIGNAL:
+            if value and strobe_start is None:
+                strobe_start = time
+            elif not value and strobe_start is not None:
+                durations.setdefault("STROBE", []).append(time - strobe_start)
+                strobe_start = None
+    return durations
+
+def print_summary(timescale, durations):
+    """
+    Prints count, minimum, average, maximum and total duration of every probe in microseconds.
+    """
+    to_us = timescale / 1e6
+    print(f"{'probe':<18} {'count':>7} {'min us':>10} {'avg us':>10} {'max us':>10} {'total us':>12}")
+    for name in sorted(durations, key=lambda probe: -sum(durations[probe])):
+        values = durations[name]
+        print(f"{name:<18} {len(values):>7} {min(values) * to_us:>10.1f} {sum(values) / len(values) * to_us:>10.1f} "
+              f"{max(values) * to_us:>10.1f} {sum(values) * to_us:>12.1f}")
+
+def main():
+    try:
+        if len(sys.argv) > 1:
+            with open(sys.argv[1], "r", errors="replace") as file:
+                lines = file.readlines()
+        else:
+            lines = sys.stdin.readlines()
+
+        timescale, changes = parse_vcd(lines)
+        durations = collect_durations(changes)
+        if not durations:
+            raise ValueError("No probe execution found in the trace.")
+        print_summary(timescale, durations)
+
+    except Exception as e:
+        log_message(f"Error: {e}")
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,219 @@
+import sys
+
+TRACE_BEGIN = "#UIRB-TRACE"
+TRACE_END = "#UIRB-TRACE-END"
+SUPPORTED_FORMAT_VERSION = 1
+
+# Mirrors uirbcore::TraceEvent
+EVENT_NAMES = {
+    0x00: "NONE",
+    0x01: "BOOT",
+    0x02: "INIT_PHASE",
+    0x03: "INIT_RESULT",
+    0x04: "EEPROM_COMMIT",
+    0x05: "EEPROM_RELOAD",
+    0x06: "ADC_REFERENCE",
+    0x07: "SLEEP",
+    0x08: "WAKE",
+    0x09: "CHARGER_STATE",
+    0x0A: "BATTERY_STATE",
+    0x0B: "ERROR",
+    0x0C: "BATTERY_CAPACITY",
+}
+EVENT_USER = 0x80
+
+# Mirrors uirbcore::TracePhase
+PHASE_NAMES = ["HW_VERSION_CHECKED", "PINS_CONFIGURED", "EEPROM_RESTORED", "EEPROM_SAVED"]
+
+# Mirrors uirbcore::CoreResult
+CORE_RESULT_NAMES = [
+    "SUCCESS",
+    "ERROR_NOT_INITIALIZED",
+    "ERROR_INVALID_ARGUMENT",
+    "ERROR_EEPROM_HW_VER_MISMATCH",
+    "ERROR_EEPROM_CHARGER_PROG_RESISTANCE_INVALID",
+    "ERROR_EEPROM_SAVE_FAILED",
+    "ERROR_SELF_TEST_FAILED",
+]
+
+# Mirrors uirbcore::ChargerState, uirbcore::BatteryState and uirbcore::WakeupInterrupt
+CHARGER_STATE_NAMES = ["ERROR", "UNKNOWN", "CHARGING_CC", "CHARGING_CV", "FLOATING", "TURNED_OFF"]
+BATTERY_STATE_NAMES = ["ERROR", "UNKNOWN", "EMPTY", "NOT_CHARGING", "CHARGING", "FULLY_CHARGED"]
+WAKEUP_INTERRUPT_NAMES = ["NONE", "WAKE_BUTTON", "USB_IO3", "WAKE_BUTTON_AND_USB_IO3"]
+
+# Arduino AVR core analogReference() values
+ADC_REFERENCE_NAMES = {0: "EXTERNAL", 1: "DEFAULT", 3: "INTERNAL1V1"}
+
+# ATmega328P MCUSR bits
+RESET_FLAG_NAMES = [(0, "PORF"), (1, "EXTRF"), (2, "BORF"), (3, "WDRF")]
+
+def log_message(message):
+    """
+    Logs a message with the [UIRBcorelib] prefix to stderr.
+    """
+    print(f"[UIRBcorelib]: {message}", file=sys.stderr)
+
+def lookup(names, value):
+    """
+    Returns the name of an enumeration value, or the raw value if it is unknown.
+    """
+    if isinstance(names, dict):
+        return names.get(value, f"0x{value:02X}")
+    return names[value] if value < len(names) else f"0x{value:02X}"
+
+def describe_reset_flags(flags):
+    """
+    Converts MCUSR reset flags into a readable list.
+    """
+    names = [name for bit, name in RESET_FLAG_NAMES if flags & (1 << bit)]
+    return "|".join(names) if names else "none"
+
+def describe_wake(argument):
+    """
+    Converts the WAKE event argument into a readable wakeup source.
+    """
+    sources = []
+    if argument & 0x01:
+        sources.append("button")
+    if argument & 0x02:
+        sources.append("usb_io3")
+    return "|".join(sources) if sources else "timer"
+
+def describe_event(event_type, argument):
+    """
+    Returns the event name and a readable description of its argument.
+    """
+    if event_type >= EVENT_USER:
+        return f"USER+{event_type - EVENT_USER}", f"0x{argument:02X}"
+
+    name = EVENT_NAMES.get(event_type, f"UNKNOWN(0x{event_type:02X})")
+    if name == "BOOT":
+        detail = describe_reset_flags(argument)
+    elif name == "INIT_PHASE":
+        detail = lookup(PHASE_NAMES, argument)
+    elif name in ("INIT_RESULT", "ERROR"):
+        detail = lookup(CORE_RESULT_NAMES, argument)
+    elif name in ("EEPROM_COMMIT", "EEPROM_RELOAD"):
+        detail = "ok" if argument else "failed"
+    elif name == "ADC_REFERENCE":
+        detail = lookup(ADC_REFERENCE_NAMES, argument)
+    elif name == "SLEEP":
+        detail = lookup(WAKEUP_INTERRUPT_NAMES, argument)
+    elif name == "WAKE":
+        detail = describe_wake(argument)
+    elif name == "CHARGER_STATE":
+        detail = lookup(CHARGER_STATE_NAMES, argument)
+    elif name == "BATTERY_STATE":
+        detail = lookup(BATTERY_STATE_NAMES, argument)
+    elif name == "BATTERY_CAPACITY":
+        detail = f"{argument}%"
+    else:
+        detail = f"0x{argument:02X}"
+    return name, detail
+
+def parse_dumps(lines):
+    """
+    Extracts every trace dump from the given lines.
+
+    Returns a list of dumps, each a list of (timestamp, type, argument) tuples, oldest first.
+    Lines outside of a dump, such as regular serial output, are ignored.
+    """
+    dumps = []
+    entries = None
+    for line_number, line in enumerate(lines, 1):
+        line = line.strip()
+        if line.startswith(TRACE_END):
+            if entries is not None:
+                dumps.append(entries)
+            entries = None
+        elif line.startswith(TRACE_BEGIN):
+            fields = line.split()
+            version = int(fields[1]) if len(fields) > 1 else 0
+            if version != SUPPORTED_FORMAT_VERSION:
+                raise ValueError(f"Line {line_number}: unsupported trace format version {version}")
+            entries = []
+        elif entries is not None and line:
+            fields = line.split()
+            if len(fields) != 3:
+                raise ValueError(f"Line {line_number}: malformed trace entry '{line}'")
+            entries.append(tuple(int(field, 16) for field in fields))
+    if entries is not None:
+        log_message("Warning: last trace dump is truncated.")
+        dumps.append(entries)
+    return dumps
+
+def split_boots(entries):
+    """
+    Splits a trace dump into segments that each start at a BOOT entry.
+
+    The timestamp clock restarts with every reset, so timestamps are only comparable within one segment.
+    Entries before the first BOOT entry, left from a boot that was overwritten in the ring, form their own segment.
+    """
+    segments = []
+    for entry in entries:
+        if not segments or EVENT_NAMES.get(entry[1]) == "BOOT":
+            segments.append([])
+        segments[-1].append(entry)
+    return segments
+
+def unwrap_timestamps(entries):
+    """
+    Converts the 16-bit millisecond timestamps of one boot segment into a monotonic time.
+
+    The time is counted from the reset when the segment starts with a BOOT entry, otherwise from its first entry.
+    A wrap is assumed whenever a timestamp is lower than the previous one. Firmware stamps entries with
+    UIRB::getUptimeMilliseconds(), so time slept in powerDown() is included, but any two consecutive events
+    more than 65.536 seconds apart, such as across a long sleep, are shown that many wraps too close together.
+    """
+    absolute = []
+    offset = 0
+    previous = None
+    for timestamp, _, _ in entries:
+        if previous is not None and timestamp < previous:
+            offset += 0x10000
+        absolute.append(offset + timestamp)
+        previous = timestamp
+    starts_at_boot = bool(entries) and EVENT_NAMES.get(entries[0][1]) == "BOOT"
+    base = absolute[0] if absolute and not starts_at_boot else 0
+    return [value - base for value in absolute]
+
+def print_timeline(entries):
+    """
+    Prints a trace dump as one timeline per boot with absolute and delta times in milliseconds.
+    """
+    segments = split_boots(entries)
+    for index, segment in enumerate(segments):
+        if len(segments) > 1:
+            origin = "reset" if EVENT_NAMES.get(segment[0][1]) == "BOOT" else "first entry, boot not in buffer"
+            print(f"--- segment {index + 1} of {len(segments)} (time since {origin}) ---")
+        print(f"{'time [ms]':>10} {'delta':>8}  {'event':<14} detail")
+        times = unwrap_timestamps(segment)
+        previous = times[0]
+        for time, (_, event_type, argument) in zip(times, segment):
+            name, detail = describe_event(event_type, argument)
+            print(f"{time:>10} {'+' + str(time - previous):>8}  {name:<14} {detail}")
+            previous = time
+
+def main():
+    try:
+        if len(sys.argv) > 1:
+            with open(sys.argv[1], "r", errors="replace") as file:
+                lines = file.readlines()
+        else:
+            lines = sys.stdin.readlines()
+
+        dumps = parse_dumps(lines)
+        if not dumps:
+            raise ValueError("No trace dump found in input.")
+
+        for index, entries in enumerate(dumps):
+            if len(dumps) > 1:
+                print(f"--- dump {index + 1} of {len(dumps)} ({len(entries)} entries) ---")
+            print_timeline(entries)
+
+    except Exception as e:
+        log_message(f"Error: {e}")
+        sys.exit(1)
+
+if __name__ == "__main__":
+    main()
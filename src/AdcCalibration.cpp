@@ -0,0 +1,260 @@
+/**
+ * @file AdcCalibration.cpp
+ * @brief Implementation of the ADC offset and gain correction of the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::AdcCalibration class.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+#include <UIRBcore_AdcCalibration.hpp>
+#include <UIRBcore_EEPROM.hpp>
+#include <UIRBcore_EEPROMRingLog.hpp>
+
+#if defined(UIRB_CORE_ADC_CALIBRATION)
+namespace
+{
+    /**
+     * @brief Number of references with their own calibration.
+     */
+    constexpr uint8_t REFERENCE_COUNT = static_cast<uint8_t>(uirbcore::AdcReference::COUNT);
+
+    /**
+     * @brief EEPROM footprint of the two-point calibration of one reference.
+     */
+    constexpr uint16_t LOG_SIZE = uirbcore::eeprom::EEPROMRingLog::regionSize(2, sizeof(uirbcore::AdcCalibrationRecord));
+
+    /**
+     * @brief Two-point calibrations stored in EEPROM right after the charging session log, one log per reference.
+     */
+    constexpr uirbcore::eeprom::EEPROMRingLog CALIBRATION_LOGS[REFERENCE_COUNT] = {
+        uirbcore::eeprom::EEPROMRingLog(UIRB_EEPROM_ADC_CALIBRATION_ADDR_START, 2, sizeof(uirbcore::AdcCalibrationRecord)),
+        uirbcore::eeprom::EEPROMRingLog(UIRB_EEPROM_ADC_CALIBRATION_ADDR_START + LOG_SIZE, 2, sizeof(uirbcore::AdcCalibrationRecord))
+    };
+
+    static_assert(UIRB_EEPROM_ADC_CALIBRATION_ADDR_START + REFERENCE_COUNT * LOG_SIZE <= (E2END + 1U), "ADC calibration does not fit into EEPROM");
+    static_assert(REFERENCE_COUNT * LOG_SIZE == UIRB_EEPROM_ADC_CALIBRATION_SIZE, "ADC calibration does not match UIRB_EEPROM_ADC_CALIBRATION_SIZE");
+
+    /**
+     * @brief Highest raw reading of the 10-bit ADC.
+     */
+    constexpr int32_t ADC_MAX = 1023;
+
+    /**
+     * @brief Age of the offset after which it is measured again, in milliseconds.
+     */
+    constexpr uint32_t OFFSET_REFRESH_MILLISECONDS = UIRB_CORE_ADC_OFFSET_REFRESH_SECONDS * 1000UL;
+
+    /**
+     * @brief `REFS[1:0]` bits of `ADMUX` of each reference.
+     */
+    constexpr uint8_t REFERENCE_BITS[REFERENCE_COUNT] = { _BV(REFS0), _BV(REFS1) | _BV(REFS0) };
+
+    /**
+     * @brief Offset and two-point calibration of one reference.
+     */
+    struct ReferenceCalibration
+    {
+        uirbcore::AdcCalibrationRecord two_point; /**< Calibration in use. */
+        uint8_t offset; /**< Last offset measured on the GND channel. */
+        bool offset_measured; /**< @ref offset was measured at least once. */
+        uint32_t offset_milliseconds; /**< `millis()` when @ref offset was measured. */
+    };
+
+    ReferenceCalibration calibrations[REFERENCE_COUNT] = {
+        { {uirbcore::AdcCalibration::UNITY_GAIN, 0}, 0, false, 0 },
+        { {uirbcore::AdcCalibration::UNITY_GAIN, 0}, 0, false, 0 }
+    };
+
+    /**
+     * @brief Checks if a reference has a calibration.
+     */
+    bool valid_reference(const uirbcore::AdcReference reference)
+    {
+        return static_cast<uint8_t>(reference) < REFERENCE_COUNT;
+    }
+
+    /**
+     * @brief Scales a reading with offset removed by the gain in Q1.15 and adds the two-point offset.
+     *
+     * @param[in] two_point Calibration of the reference of the reading.
+     * @param[in] value Reading with the GND offset removed.
+     * @return int32_t Corrected reading, not limited.
+     */
+    int32_t apply_two_point(const uirbcore::AdcCalibrationRecord& two_point, const int32_t value)
+    {
+        return ((value * two_point.gain + (1L << 14)) >> 15) + two_point.offset;
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    void AdcCalibration::begin()
+    {
+        for (uint8_t i = 0; i < REFERENCE_COUNT; i++)
+        {
+            AdcCalibrationRecord stored;
+            if (CALIBRATION_LOGS[i].read(0, &stored) && stored.gain >= AdcCalibration::GAIN_MIN && stored.gain <= AdcCalibration::GAIN_MAX)
+            {
+                calibrations[i].two_point = stored;
+            }
+        }
+        // The internal reference is measured before its first reading, when it is selected anyway
+        AdcCalibration::measureOffset(AdcReference::AVCC);
+    }
+
+    uint8_t AdcCalibration::measureOffset(const AdcReference reference)
+    {
+        if (!valid_reference(reference))
+        {
+            return 0;
+        }
+        ReferenceCalibration& calibration = calibrations[static_cast<uint8_t>(reference)];
+        const uint8_t reference_bits = REFERENCE_BITS[static_cast<uint8_t>(reference)];
+
+        const uint8_t old_admux = ADMUX;
+        const uint8_t old_adcsra = ADCSRA;
+
+        ADCSRA = _BV(ADEN) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0); // Prescaler of 128
+        ADMUX = reference_bits | 0b1111; // GND input
+        if ((old_admux & (_BV(REFS1) | _BV(REFS0))) != reference_bits)
+        {
+            // The capacitor on AREF follows the new reference, busy wait as the constructor may run before init()
+            delayMicroseconds(UIRB::ADC_VREF_SETTLE_DELAY_MS * 1000U);
+        }
+
+        uint16_t sum = 0;
+        for (uint8_t i = 0; i <= AdcCalibration::OFFSET_SAMPLES; i++)
+        {
+            ADCSRA |= _BV(ADSC); // Convert
+            while (bit_is_set(ADCSRA, ADSC)) { } // Wait for conversion to complete
+            // The first conversion after switching the input is discarded
+            if (i > 0)
+            {
+                sum += ADC;
+            }
+        }
+
+        ADMUX = old_admux;
+        ADCSRA = old_adcsra & ~_BV(ADSC);
+
+        const uint16_t average = (sum + (AdcCalibration::OFFSET_SAMPLES / 2U)) / AdcCalibration::OFFSET_SAMPLES;
+        calibration.offset = (average > UINT8_MAX) ? UINT8_MAX : static_cast<uint8_t>(average);
+        calibration.offset_measured = true;
+        calibration.offset_milliseconds = millis();
+        return calibration.offset;
+    }
+
+    uint16_t AdcCalibration::correct(const uint16_t raw, const AdcReference reference)
+    {
+        if (!valid_reference(reference))
+        {
+            return raw;
+        }
+        const ReferenceCalibration& calibration = calibrations[static_cast<uint8_t>(reference)];
+        if (!calibration.offset_measured || (millis() - calibration.offset_milliseconds) >= OFFSET_REFRESH_MILLISECONDS)
+        {
+            AdcCalibration::measureOffset(reference);
+        }
+
+        int32_t value = static_cast<int32_t>(raw) - calibration.offset;
+        if (value < 0)
+        {
+            value = 0;
+        }
+        value = apply_two_point(calibration.two_point, value);
+
+        if (value < 0)
+        {
+            return 0;
+        }
+        return (value > ADC_MAX) ? static_cast<uint16_t>(ADC_MAX) : static_cast<uint16_t>(value);
+    }
+
+    bool AdcCalibration::setTwoPoint(const AdcReference reference, const uint16_t raw_low, const uint16_t expected_low, const uint16_t raw_high, const uint16_t expected_high)
+    {
+        if (!valid_reference(reference) || raw_high > ADC_MAX || expected_high > ADC_MAX ||
+            raw_high < raw_low + AdcCalibration::MIN_POINT_SPAN || expected_high <= expected_low)
+        {
+            return false;
+        }
+
+        // The points are taken relative to the offset measured now, as correct() will remove it
+        const uint8_t offset = AdcCalibration::measureOffset(reference);
+        const uint16_t span = raw_high - raw_low;
+        const uint32_t gain = ((static_cast<uint32_t>(expected_high - expected_low) << 15) + (span / 2U)) / span;
+        if (gain < AdcCalibration::GAIN_MIN || gain > AdcCalibration::GAIN_MAX)
+        {
+            return false;
+        }
+
+        const int32_t low = (raw_low > offset) ? static_cast<int32_t>(raw_low - offset) : 0;
+        const int32_t point_offset = static_cast<int32_t>(expected_low) - ((low * static_cast<int32_t>(gain) + (1L << 14)) >> 15);
+        if (point_offset < INT8_MIN || point_offset > INT8_MAX)
+        {
+            return false;
+        }
+
+        const AdcCalibrationRecord record = {static_cast<uint16_t>(gain), static_cast<int8_t>(point_offset)};
+        if (!CALIBRATION_LOGS[static_cast<uint8_t>(reference)].append(&record))
+        {
+            return false;
+        }
+        calibrations[static_cast<uint8_t>(reference)].two_point = record;
+        return true;
+    }
+
+    void AdcCalibration::clearTwoPoint(const AdcReference reference)
+    {
+        if (!valid_reference(reference))
+        {
+            return;
+        }
+        CALIBRATION_LOGS[static_cast<uint8_t>(reference)].clear();
+        calibrations[static_cast<uint8_t>(reference)].two_point = {AdcCalibration::UNITY_GAIN, 0};
+    }
+
+    uint8_t AdcCalibration::getOffset(const AdcReference reference)
+    {
+        return valid_reference(reference) ? calibrations[static_cast<uint8_t>(reference)].offset : 0;
+    }
+
+    AdcCalibrationRecord AdcCalibration::getTwoPoint(const AdcReference reference)
+    {
+        if (!valid_reference(reference))
+        {
+            return {AdcCalibration::UNITY_GAIN, 0};
+        }
+        return calibrations[static_cast<uint8_t>(reference)].two_point;
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_ADC_CALIBRATION)
@@ -0,0 +1,424 @@
+/**
+ * @file BatteryHealth.cpp
+ * @brief Implementation of the battery internal resistance (ESR) estimation and charge cycle tracking of the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::BatteryHealth class.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+#include <UIRBcore_BatteryHealth.hpp>
+#include <UIRBcore_EEPROMRingLog.hpp>
+#include <UIRBcore_IRGate.hpp>
+#include <UIRBcore_Trace.hpp>
+#include <Utility.hpp>
+
+#if defined(UIRB_CORE_BATTERY_ESR)
+namespace
+{
+    /**
+     * @brief ESR history stored in EEPROM right after the watchdog reset log.
+     */
+    constexpr uirbcore::eeprom::EEPROMRingLog ESR_LOG(UIRB_EEPROM_BATTERY_ESR_LOG_ADDR_START, uirbcore::BatteryHealth::HISTORY_SLOTS, sizeof(uirbcore::BatteryEsrRecord));
+
+    static_assert(UIRB_EEPROM_BATTERY_ESR_LOG_ADDR_START + ESR_LOG.size() <= (E2END + 1U), "Battery ESR history does not fit into EEPROM");
+    static_assert(ESR_LOG.size() == UIRB_EEPROM_BATTERY_ESR_LOG_SIZE, "Battery ESR history does not match UIRB_EEPROM_BATTERY_ESR_LOG_SIZE");
+
+    /**
+     * @brief Settling time after switching the LED on, before the conversion samples AVcc.
+     */
+    constexpr uint8_t LOAD_SETTLE_MICROSECONDS = 20;
+
+    uirbcore::BatteryEsrRecord last_record = { uirbcore::BatteryHealth::INVALID_ESR_MILLIOHMS, 0, 0, 0 }; /**< Filtered estimate, kept in RAM. */
+    uirbcore::BatteryEsrRecord stored_record = { uirbcore::BatteryHealth::INVALID_ESR_MILLIOHMS, 0, 0, 0 }; /**< Newest record in EEPROM. */
+    bool history_loaded = false; /**< @ref last_record was restored from EEPROM. */
+
+    /**
+     * @brief Restores @ref last_record from the newest EEPROM record once after reset.
+     */
+    void load_history()
+    {
+        if (history_loaded)
+        {
+            return;
+        }
+        history_loaded = true;
+        if (!ESR_LOG.read(0, &last_record))
+        {
+            last_record = { uirbcore::BatteryHealth::INVALID_ESR_MILLIOHMS, 0, 0, 0 };
+        }
+        stored_record = last_record;
+    }
+
+    /**
+     * @brief Checks if @ref last_record differs enough from @ref stored_record to be written to EEPROM.
+     *
+     * @return bool `true` for the first estimate, a change of at least
+     * @ref uirbcore::BatteryHealth::PERSIST_CHANGE_PERCENT or
+     * @ref uirbcore::BatteryHealth::PERSIST_INTERVAL_MEASUREMENTS measurements since the newest record.
+     */
+    bool should_persist()
+    {
+        if (stored_record.esr_milliohms == uirbcore::BatteryHealth::INVALID_ESR_MILLIOHMS)
+        {
+            return true;
+        }
+        const uint16_t change = (last_record.esr_milliohms > stored_record.esr_milliohms)
+            ? (last_record.esr_milliohms - stored_record.esr_milliohms)
+            : (stored_record.esr_milliohms - last_record.esr_milliohms);
+        return static_cast<uint32_t>(change) * 100U >= static_cast<uint32_t>(stored_record.esr_milliohms) * uirbcore::BatteryHealth::PERSIST_CHANGE_PERCENT ||
+               static_cast<uint16_t>(last_record.measurement_count - stored_record.measurement_count) >= uirbcore::BatteryHealth::PERSIST_INTERVAL_MEASUREMENTS;
+    }
+
+    /**
+     * @brief Runs one conversion of the already selected ADC input.
+     *
+     * @return uint16_t Raw 10-bit ADC value.
+     */
+    uint16_t convert()
+    {
+        ADCSRA |= _BV(ADSC); // Convert
+        while (bit_is_set(ADCSRA, ADSC)) // Wait for conversion to complete
+        {
+        }
+        return ADC;
+    }
+
+    /**
+     * @brief Converts a sum of bandgap samples to AVcc.
+     *
+     * @param[in] sum Sum of @ref uirbcore::BatteryHealth::SAMPLE_PAIRS raw samples.
+     * @param[in] bandgap_milivolts Calibrated bandgap voltage.
+     * @return uint16_t AVcc in millivolts.
+     */
+    uint16_t avcc_milivolts(const uint16_t sum, const uint16_t bandgap_milivolts)
+    {
+        uint32_t milivolts = static_cast<uint32_t>(1024U) * bandgap_milivolts * uirbcore::BatteryHealth::SAMPLE_PAIRS;
+        milivolts += (sum / 2U);
+        milivolts /= sum;
+        return static_cast<uint16_t>(milivolts);
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    bool BatteryHealth::measureEsr(const UIRB& uirb)
+    {
+        // The LED is switched through PORTD directly to keep the loaded window short
+        static_assert(PIN_IR_LED == 3, "BatteryHealth drives PIN_IR_LED as PD3");
+
+        if (getPinMode(PIN_IR_LED) != OUTPUT || (TCCR2A & (_BV(COM2B1) | _BV(COM2B0))))
+        {
+            return false;
+        }
+#if defined(UIRB_CORE_IR_TX_GATE)
+        if (!IRTransmitGate::isQuiet())
+        {
+            return false;
+        }
+        // The load pulses count as a frame, so gated samples overlapping them are discarded
+        IRTransmitGate::beginFrame();
+#endif  // defined(UIRB_CORE_IR_TX_GATE)
+
+        const uint8_t old_adc_reference = getAnalogReference();
+        const uint8_t old_adcsra = ADCSRA;
+        const uint8_t old_led_state = bitRead(PORTD, PORTD3);
+
+        bitClear(PORTD, PORTD3);
+        BandgapSampleTask::selectBandgapInput();
+        convert();
+        delay(UIRB::ADC_VREF_SETTLE_DELAY_MS); // Wait for Vref to settle
+
+        uint16_t open_sum = 0;
+        uint16_t loaded_sum = 0;
+        for (uint8_t pair = 0; pair < BatteryHealth::SAMPLE_PAIRS; pair++)
+        {
+            open_sum += convert();
+
+            bitSet(PORTD, PORTD3);
+            delayMicroseconds(LOAD_SETTLE_MICROSECONDS);
+            loaded_sum += convert();
+            bitClear(PORTD, PORTD3);
+
+            // Let the battery recover before the next unloaded sample
+            delay(UIRB::ADC_SAMPLE_DELAY_MS);
+        }
+
+        bitWrite(PORTD, PORTD3, old_led_state);
+        ADCSRA = old_adcsra;
+        if (old_adc_reference != INVALID_ANALOG_REF && old_adc_reference != DEFAULT) // default was already used here
+        {
+            setAnalogReference(old_adc_reference);
+        }
+#if defined(UIRB_CORE_IR_TX_GATE)
+        IRTransmitGate::endFrame();
+#endif  // defined(UIRB_CORE_IR_TX_GATE)
+
+        // Same valid range as UIRB::getSupplyVoltageMilivolts(), for the averages of both sums
+        constexpr uint16_t SUM_MIN = UIRB::ADC_BANDGAP_AVCC_SAMPLE_MIN * BatteryHealth::SAMPLE_PAIRS;
+        constexpr uint16_t SUM_MAX = (UIRB::ADC_RESOLUTION_DEC - 1U) * BatteryHealth::SAMPLE_PAIRS;
+        if (open_sum <= SUM_MIN || loaded_sum <= SUM_MIN || open_sum > SUM_MAX || loaded_sum > SUM_MAX)
+        {
+            return false;
+        }
+
+        const uint16_t bandgap_milivolts = uirb.getInternalBandgapReferenceVoltageMilivolts();
+        const uint16_t open_milivolts = avcc_milivolts(open_sum, bandgap_milivolts);
+        const uint16_t loaded_milivolts = avcc_milivolts(loaded_sum, bandgap_milivolts);
+        const uint16_t sag_milivolts = (open_milivolts > loaded_milivolts) ? (open_milivolts - loaded_milivolts) : 0U;
+
+        uint32_t esr = static_cast<uint32_t>(sag_milivolts) * 1000U;
+        esr += (UIRB_CORE_IR_LED_LOAD_MILLIAMPS / 2U);
+        esr /= UIRB_CORE_IR_LED_LOAD_MILLIAMPS;
+        if (esr >= BatteryHealth::INVALID_ESR_MILLIOHMS)
+        {
+            esr = BatteryHealth::INVALID_ESR_MILLIOHMS - 1U;
+        }
+
+        load_history();
+        if (last_record.esr_milliohms != BatteryHealth::INVALID_ESR_MILLIOHMS)
+        {
+            // Exponential moving average, new = old + (sample - old) / 4, rounded
+            esr = (3U * static_cast<uint32_t>(last_record.esr_milliohms) + esr + 2U) / 4U;
+        }
+
+        last_record.esr_milliohms = static_cast<uint16_t>(esr);
+        last_record.open_circuit_millivolts = open_milivolts;
+        last_record.sag_millivolts = sag_milivolts;
+        if (last_record.measurement_count < UINT16_MAX)
+        {
+            last_record.measurement_count++;
+        }
+        if (should_persist() && ESR_LOG.append(&last_record))
+        {
+            stored_record = last_record;
+        }
+        return true;
+    }
+
+    uint16_t BatteryHealth::getEsrMilliohms()
+    {
+        load_history();
+        return last_record.esr_milliohms;
+    }
+
+    uint16_t BatteryHealth::predictSagMillivolts(const uint16_t load_milliamps)
+    {
+        const uint16_t esr = BatteryHealth::getEsrMilliohms();
+        if (esr == BatteryHealth::INVALID_ESR_MILLIOHMS)
+        {
+            return 0;
+        }
+        uint32_t sag = static_cast<uint32_t>(esr) * load_milliamps;
+        sag += 500U;
+        sag /= 1000U;
+        return (sag > UINT16_MAX) ? UINT16_MAX : static_cast<uint16_t>(sag);
+    }
+
+    bool BatteryHealth::getHistory(const uint8_t age, BatteryEsrRecord& record)
+    {
+        return ESR_LOG.read(age, &record);
+    }
+
+    void BatteryHealth::clearHistory()
+    {
+        ESR_LOG.clear();
+        last_record = { BatteryHealth::INVALID_ESR_MILLIOHMS, 0, 0, 0 };
+        stored_record = last_record;
+        history_loaded = true;
+    }
+
+    void BatteryHealth::dump(Print& output)
+    {
+        BatteryEsrRecord record;
+        for (uint8_t age = 0; BatteryHealth::getHistory(age, record); age++)
+        {
+            output.print(record.esr_milliohms);
+            output.print('\t');
+            output.print(record.open_circuit_millivolts);
+            output.print('\t');
+            output.print(record.sag_millivolts);
+            output.print('\t');
+            output.println(record.measurement_count);
+        }
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_BATTERY_ESR)
+
+#if defined(UIRB_CORE_BATTERY_CYCLES)
+namespace
+{
+    /**
+     * @brief Charge cycle log stored in EEPROM right after the battery ESR history.
+     */
+    constexpr uirbcore::eeprom::EEPROMRingLog CYCLE_LOG(UIRB_EEPROM_BATTERY_CYCLE_LOG_ADDR_START, uirbcore::BatteryHealth::CYCLE_LOG_SLOTS, sizeof(uirbcore::BatteryCycleRecord));
+
+    static_assert(UIRB_EEPROM_BATTERY_CYCLE_LOG_ADDR_START + CYCLE_LOG.size() <= (E2END + 1U), "Battery charge cycle log does not fit into EEPROM");
+    static_assert(CYCLE_LOG.size() == UIRB_EEPROM_BATTERY_CYCLE_LOG_SIZE, "Battery charge cycle log does not match UIRB_EEPROM_BATTERY_CYCLE_LOG_SIZE");
+
+    /**
+     * @brief Charge of one milliamp hour in milliamp seconds.
+     */
+    constexpr uint32_t MILLIAMP_SECONDS_PER_MILLIAMP_HOUR = 3600UL;
+
+    /**
+     * @brief Smallest charge from empty to full accepted as a capacity, rejecting charges of a battery which
+     * only looked empty under load.
+     */
+    constexpr uint16_t MIN_LEARNED_CAPACITY_MAH = UIRB_CORE_BATTERY_CAPACITY_MAH / 4U;
+
+    uirbcore::BatteryCycleRecord cycles = { 0, 0, 0 }; /**< Totals, including the charge in progress. */
+    bool cycles_loaded = false; /**< @ref cycles was restored from EEPROM. */
+    uint32_t persisted_milliamp_hours = 0; /**< Total charge of the newest EEPROM record. */
+    uint32_t counted_milliamp_seconds = 0; /**< Part of @ref uirbcore::PowerInfoData::getChargedMilliampSeconds() already added to @ref cycles. */
+    uint32_t empty_milliamp_seconds = 0; /**< @ref uirbcore::PowerInfoData::getChargedMilliampSeconds() when the battery was last empty. */
+    bool charging_from_empty = false; /**< The charge in progress started at `BatteryState::EMPTY`. */
+    uirbcore::BatteryState last_state = uirbcore::BatteryState::UNKNOWN; /**< Battery state of the previous update. */
+
+    /**
+     * @brief Restores @ref cycles from the newest EEPROM record once after reset.
+     */
+    void load_cycles()
+    {
+        if (cycles_loaded)
+        {
+            return;
+        }
+        cycles_loaded = true;
+        if (!CYCLE_LOG.read(0, &cycles))
+        {
+            cycles = { 0, 0, 0 };
+        }
+        persisted_milliamp_hours = cycles.charged_milliamp_hours;
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    void BatteryHealth::track_charge(const BatteryState state)
+    {
+        load_cycles();
+
+        // The total is integrated by PowerInfoData, the part below one milliamp hour stays for the next update
+        const uint32_t charged = PowerInfoData::getChargedMilliampSeconds();
+        const uint32_t whole = (charged - counted_milliamp_seconds) / MILLIAMP_SECONDS_PER_MILLIAMP_HOUR;
+        counted_milliamp_seconds += whole * MILLIAMP_SECONDS_PER_MILLIAMP_HOUR;
+        cycles.charged_milliamp_hours += whole;
+
+        if (last_state == BatteryState::CHARGING && state != BatteryState::CHARGING)
+        {
+            const uint32_t session_milliamp_hours = (charged - empty_milliamp_seconds) / MILLIAMP_SECONDS_PER_MILLIAMP_HOUR;
+            if (state == BatteryState::FULLY_CHARGED && charging_from_empty && session_milliamp_hours >= MIN_LEARNED_CAPACITY_MAH)
+            {
+                uint32_t capacity = (session_milliamp_hours > UINT16_MAX) ? UINT16_MAX : session_milliamp_hours;
+                if (cycles.capacity_milliamp_hours != 0)
+                {
+                    // Exponential moving average, new = old + (sample - old) / 4, rounded
+                    capacity = (3U * static_cast<uint32_t>(cycles.capacity_milliamp_hours) + capacity + 2U) / 4U;
+                }
+                cycles.capacity_milliamp_hours = static_cast<uint16_t>(capacity);
+                if (cycles.capacity_samples < UINT8_MAX)
+                {
+                    cycles.capacity_samples++;
+                }
+                UIRB_TRACE(BATTERY_CAPACITY, BatteryHealth::getCapacityPercent());
+                persisted_milliamp_hours = UINT32_MAX; // Force the write
+            }
+
+            // Once per charge, only if something changed
+            if (cycles.charged_milliamp_hours != persisted_milliamp_hours && CYCLE_LOG.append(&cycles))
+            {
+                persisted_milliamp_hours = cycles.charged_milliamp_hours;
+            }
+        }
+
+        if (state == BatteryState::EMPTY)
+        {
+            charging_from_empty = true;
+            empty_milliamp_seconds = charged;
+        }
+        else if (state != BatteryState::CHARGING)
+        {
+            charging_from_empty = false;
+        }
+        last_state = state;
+    }
+
+    uint32_t BatteryHealth::getChargedMilliampHours()
+    {
+        load_cycles();
+        return cycles.charged_milliamp_hours;
+    }
+
+    uint16_t BatteryHealth::getEquivalentFullCycles()
+    {
+        const uint32_t equivalent_cycles = BatteryHealth::getChargedMilliampHours() / UIRB_CORE_BATTERY_CAPACITY_MAH;
+        return (equivalent_cycles > UINT16_MAX) ? UINT16_MAX : static_cast<uint16_t>(equivalent_cycles);
+    }
+
+    uint16_t BatteryHealth::getCapacityMilliampHours()
+    {
+        load_cycles();
+        return cycles.capacity_milliamp_hours;
+    }
+
+    uint8_t BatteryHealth::getCapacityPercent()
+    {
+        uint32_t percent = static_cast<uint32_t>(BatteryHealth::getCapacityMilliampHours()) * 100U;
+        percent += (UIRB_CORE_BATTERY_CAPACITY_MAH / 2U);
+        percent /= UIRB_CORE_BATTERY_CAPACITY_MAH;
+        return (percent > UINT8_MAX) ? UINT8_MAX : static_cast<uint8_t>(percent);
+    }
+
+    void BatteryHealth::clearCycleLog()
+    {
+        CYCLE_LOG.clear();
+        cycles = { 0, 0, 0 };
+        cycles_loaded = true;
+        persisted_milliamp_hours = 0;
+        counted_milliamp_seconds = PowerInfoData::getChargedMilliampSeconds();
+        charging_from_empty = false;
+    }
+
+    void BatteryHealth::dumpCycles(Print& output)
+    {
+        output.print(F("charged_mah\t"));
+        output.println(BatteryHealth::getChargedMilliampHours());
+        output.print(F("cycles\t"));
+        output.println(BatteryHealth::getEquivalentFullCycles());
+        output.print(F("capacity_mah\t"));
+        output.println(BatteryHealth::getCapacityMilliampHours());
+        output.print(F("capacity_pct\t"));
+        output.println(BatteryHealth::getCapacityPercent());
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_BATTERY_CYCLES)
@@ -0,0 +1,190 @@
+/**
+ * @file ChargeLog.cpp
+ * @brief Implementation of the charging session log of the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::ChargeSessionLog class.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+#include <UIRBcore_ChargeLog.hpp>
+#include <UIRBcore_EEPROMRingLog.hpp>
+
+#if defined(UIRB_CORE_CHARGE_LOG)
+namespace
+{
+    /**
+     * @brief Charging session log stored in EEPROM right after the battery charge cycle log.
+     */
+    constexpr uirbcore::eeprom::EEPROMRingLog SESSION_LOG(UIRB_EEPROM_CHARGE_LOG_ADDR_START, UIRB_CORE_CHARGE_LOG_SLOTS, sizeof(uirbcore::ChargeSession));
+
+    static_assert(UIRB_EEPROM_CHARGE_LOG_ADDR_START + SESSION_LOG.size() <= (E2END + 1U), "Charging session log does not fit into EEPROM");
+    static_assert(SESSION_LOG.size() == UIRB_EEPROM_CHARGE_LOG_SIZE, "Charging session log does not match UIRB_EEPROM_CHARGE_LOG_SIZE");
+
+    /**
+     * @brief Charge of one milliamp hour in milliamp seconds.
+     */
+    constexpr uint32_t MILLIAMP_SECONDS_PER_MILLIAMP_HOUR = 3600UL;
+
+    uirbcore::ChargeSession session = {}; /**< Session in progress, completed when it ends. */
+    bool charging = false; /**< A session is in progress. */
+    bool cc_done = false; /**< The session left constant current mode. */
+    uint32_t start_milliseconds = 0; /**< @ref uirbcore::UIRB::getUptimeMilliseconds() at the start of the session. */
+    uint32_t start_milliamp_seconds = 0; /**< @ref uirbcore::PowerInfoData::getChargedMilliampSeconds() at the start of the session. */
+
+    /**
+     * @brief Returns the minutes between two @ref uirbcore::UIRB::getUptimeMilliseconds() values, saturating.
+     *
+     * @param[in] from Earlier value.
+     * @param[in] to Later value.
+     * @return uint16_t Whole minutes.
+     */
+    uint16_t minutes_between(const uint32_t from, const uint32_t to)
+    {
+        const uint32_t minutes = (to - from) / 60000UL;
+        return (minutes > UINT16_MAX) ? UINT16_MAX : static_cast<uint16_t>(minutes);
+    }
+
+    /**
+     * @brief Fills in the durations and the charge of the session up to a point in time.
+     *
+     * @param[in] now @ref uirbcore::UIRB::getUptimeMilliseconds() value to close the session at.
+     */
+    void complete_session(const uint32_t now)
+    {
+        const uint32_t charge_milliamp_seconds = uirbcore::PowerInfoData::getChargedMilliampSeconds() - start_milliamp_seconds;
+        session.duration_minutes = minutes_between(start_milliseconds, now);
+        if (!cc_done)
+        {
+            session.cc_minutes = session.duration_minutes;
+        }
+        const uint32_t milliamp_hours = (charge_milliamp_seconds + (MILLIAMP_SECONDS_PER_MILLIAMP_HOUR / 2U)) / MILLIAMP_SECONDS_PER_MILLIAMP_HOUR;
+        session.charged_milliamp_hours = (milliamp_hours > UINT16_MAX) ? UINT16_MAX : static_cast<uint16_t>(milliamp_hours);
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    void ChargeSessionLog::track(const uint16_t charging_current_miliamps, const ChargerState state)
+    {
+        // Counts the time spent in powerDown(), the charge is integrated by PowerInfoData on the same clock
+        const uint32_t now = UIRB::getUptimeMilliseconds();
+        const bool charging_now = (state == ChargerState::CHARGING_CC || state == ChargerState::CHARGING_CV);
+
+        if (charging)
+        {
+            if (!cc_done && state != ChargerState::CHARGING_CC)
+            {
+                session.cc_minutes = minutes_between(start_milliseconds, now);
+                cc_done = true;
+            }
+
+            session.end_state = state;
+            if (!charging_now)
+            {
+                complete_session(now);
+                SESSION_LOG.append(&session);
+                charging = false;
+            }
+        }
+        else if (charging_now)
+        {
+            session = {};
+            session.boot_count = UIRB::getInstance().getBootCount();
+            session.start_seconds = now / 1000U;
+            session.end_state = state;
+            charging = true;
+            cc_done = (state == ChargerState::CHARGING_CV);
+            start_milliseconds = now;
+            start_milliamp_seconds = PowerInfoData::getChargedMilliampSeconds();
+        }
+
+        if (charging && charging_current_miliamps > session.peak_current_miliamps)
+        {
+            session.peak_current_miliamps = charging_current_miliamps;
+        }
+    }
+
+    bool ChargeSessionLog::isCharging()
+    {
+        return charging;
+    }
+
+    bool ChargeSessionLog::getCurrentSession(ChargeSession& current)
+    {
+        if (!charging)
+        {
+            current = {};
+            return false;
+        }
+        complete_session(UIRB::getUptimeMilliseconds());
+        current = session;
+        return true;
+    }
+
+    uint8_t ChargeSessionLog::count()
+    {
+        return SESSION_LOG.count();
+    }
+
+    bool ChargeSessionLog::read(const uint8_t age, ChargeSession& stored)
+    {
+        return SESSION_LOG.read(age, &stored);
+    }
+
+    void ChargeSessionLog::clear()
+    {
+        SESSION_LOG.clear();
+    }
+
+    void ChargeSessionLog::dump(Print& output)
+    {
+        ChargeSession stored;
+        for (uint8_t age = 0; ChargeSessionLog::read(age, stored); age++)
+        {
+            output.print(stored.boot_count);
+            output.print('\t');
+            output.print(stored.start_seconds);
+            output.print('\t');
+            output.print(stored.duration_minutes);
+            output.print('\t');
+            output.print(stored.cc_minutes);
+            output.print('\t');
+            output.print(stored.peak_current_miliamps);
+            output.print('\t');
+            output.print(stored.charged_milliamp_hours);
+            output.print('\t');
+            output.println(static_cast<uint8_t>(stored.end_state));
+        }
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_CHARGE_LOG)
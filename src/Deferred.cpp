@@ -0,0 +1,156 @@
+/**
+ * @file Deferred.cpp
+ * @brief Implementation of the deferred work queue for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::DeferredWork and @ref uirbcore::DeferredQueue classes.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore_Deferred.hpp>
+
+#if defined(UIRB_CORE_DEFERRED_WORK)
+
+namespace
+{
+    uirbcore::DeferredWork* volatile queue_head = nullptr; /**< Oldest pending item, polled outside of interrupts. */
+    uirbcore::DeferredWork* queue_tail = nullptr; /**< Newest pending item. */
+    uint32_t max_latency_microseconds = 0; /**< Longest latency of any item. */
+}  // namespace
+
+namespace uirbcore
+{
+    void DeferredWork::resetStats()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        this->run_count_ = 0;
+        this->coalesced_count_ = 0;
+        this->max_latency_microseconds_ = 0;
+        SREG = oldSREG;
+    }
+
+    bool DeferredQueue::schedule(DeferredWork& work)
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        if (work.pending_)
+        {
+            if (work.coalesced_count_ < UINT16_MAX)
+            {
+                work.coalesced_count_++;
+            }
+            SREG = oldSREG;
+            return false;
+        }
+
+        work.pending_ = true;
+        work.next_ = nullptr;
+        work.scheduled_microseconds_ = micros();
+        if (queue_tail != nullptr)
+        {
+            queue_tail->next_ = &work;
+        }
+        else
+        {
+            queue_head = &work;
+        }
+        queue_tail = &work;
+        SREG = oldSREG;
+        return true;
+    }
+
+    uint8_t DeferredQueue::run()
+    {
+        // Detach the pending items, new schedules start a fresh queue
+        uint8_t oldSREG = SREG;
+        cli();
+        DeferredWork* work = queue_head;
+        queue_head = nullptr;
+        queue_tail = nullptr;
+        SREG = oldSREG;
+
+        uint8_t count = 0;
+        while (work != nullptr)
+        {
+            // Interrupts may schedule the item again as soon as it is no longer pending
+            oldSREG = SREG;
+            cli();
+            DeferredWork* next = work->next_;
+            work->next_ = nullptr;
+            work->pending_ = false;
+            const uint32_t scheduled = work->scheduled_microseconds_;
+            SREG = oldSREG;
+
+            const uint32_t latency = micros() - scheduled;
+            if (latency > work->max_latency_microseconds_)
+            {
+                work->max_latency_microseconds_ = latency;
+            }
+            if (latency > max_latency_microseconds)
+            {
+                max_latency_microseconds = latency;
+            }
+            if (work->run_count_ < UINT16_MAX)
+            {
+                work->run_count_++;
+            }
+            if (count < UINT8_MAX)
+            {
+                count++;
+            }
+
+            work->handler_(*work);
+            work = next;
+        }
+        return count;
+    }
+
+    bool DeferredQueue::isPending()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        const bool pending = queue_head != nullptr;
+        SREG = oldSREG;
+        return pending;
+    }
+
+    uint32_t DeferredQueue::getMaxLatencyMicroseconds()
+    {
+        return max_latency_microseconds;
+    }
+
+    void DeferredQueue::resetMaxLatency()
+    {
+        max_latency_microseconds = 0;
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_DEFERRED_WORK)
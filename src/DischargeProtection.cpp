@@ -0,0 +1,148 @@
+/**
+ * @file DischargeProtection.cpp
+ * @brief Implementation of the deep-discharge protection sleep of the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::DischargeProtection class.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+#include <UIRBcore_DischargeProtection.hpp>
+#include <Utility.hpp>
+
+#if defined(UIRB_CORE_DISCHARGE_PROTECTION)
+namespace
+{
+    /**
+     * @brief Longest interval between two charger checks in milliseconds.
+     */
+    constexpr uint32_t MAX_CHECK_INTERVAL_MILLISECONDS = UIRB_CORE_DISCHARGE_MAX_SLEEP_SECONDS * 1000UL;
+
+    uint16_t last_check_count = 0; /**< Charger checks of the last protection sleep. */
+    uint32_t last_sleep_milliseconds = 0; /**< Time spent in the last protection sleep. */
+
+    /**
+     * @brief Checks if the charger state shows that power is back.
+     *
+     * @param[in] state Charger state.
+     * @return bool `true` if the battery is charging or held at the float voltage.
+     */
+    bool is_powered(const uirbcore::ChargerState state)
+    {
+        return state == uirbcore::ChargerState::CHARGING_CC ||
+               state == uirbcore::ChargerState::CHARGING_CV ||
+               state == uirbcore::ChargerState::FLOATING;
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    bool DischargeProtection::sleepUntilCharging(UIRB& uirb)
+    {
+        // powerDown() would return right away, checking in a loop drains the battery faster than not sleeping at all
+        if (!uirb.isSleepingAllowed())
+        {
+            return false;
+        }
+
+        // The pin write alone does not stop the carrier if Timer2 drives OC2B
+        const uint8_t old_tccr2a = TCCR2A;
+        TCCR2A &= ~(_BV(COM2B1) | _BV(COM2B0));
+        digitalWrite(PIN_IR_LED, LOW);
+
+        const uint8_t old_stat_mode = getPinMode(PIN_STAT_LED);
+        const uint8_t old_stat_state = digitalRead(PIN_STAT_LED);
+        if (old_stat_mode == OUTPUT)
+        {
+            digitalWrite(PIN_STAT_LED, LOW);
+        }
+
+        // Tells a USB wakeup from a software timer, the application flag is restored on return
+        const bool old_io3_flag = uirb.getAndClearIO3WakeupISRFlag();
+        bool io3_woken = false;
+
+        last_check_count = 0;
+        last_sleep_milliseconds = 0;
+        uint32_t interval = DischargeProtection::FIRST_CHECK_INTERVAL_MILLISECONDS;
+        for (;;)
+        {
+            // A software timer ends powerDown() early, sleep again for the rest of the interval
+            const uint32_t start = UIRB::getUptimeMilliseconds();
+            uint32_t slept = 0;
+            do
+            {
+                uirb.powerDown(interval - slept, WakeupInterrupt::USB_IO3);
+                slept = UIRB::getUptimeMilliseconds() - start;
+            } while (slept < interval && !uirb.getIO3WakeupISRFlag());
+            last_sleep_milliseconds += slept;
+
+            const bool woken_early = uirb.getAndClearIO3WakeupISRFlag();
+            io3_woken |= woken_early;
+            if (last_check_count < UINT16_MAX)
+            {
+                last_check_count++;
+            }
+
+            // Single sample of AVcc and PIN_PROG, without the low battery pattern
+            const PowerInfoData& power = uirb.getPowerInfo(1, false);
+            if (power.isValid() && is_powered(power.getChargerState()))
+            {
+                break;
+            }
+
+            if (!woken_early)
+            {
+                interval = (interval >= MAX_CHECK_INTERVAL_MILLISECONDS / 2U) ? MAX_CHECK_INTERVAL_MILLISECONDS : (interval * 2U);
+            }
+        }
+
+        uirb.isr_wakeup_io3_flag_ = old_io3_flag || io3_woken;
+
+        if (old_stat_mode == OUTPUT)
+        {
+            digitalWrite(PIN_STAT_LED, old_stat_state);
+        }
+        TCCR2A = old_tccr2a;
+        return true;
+    }
+
+    uint16_t DischargeProtection::getLastCheckCount()
+    {
+        return last_check_count;
+    }
+
+    uint32_t DischargeProtection::getLastSleepSeconds()
+    {
+        return last_sleep_milliseconds / 1000U;
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_DISCHARGE_PROTECTION)
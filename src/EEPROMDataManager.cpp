@@ -47,6 +47,7 @@
 #include <Arduino.h>
 #include <UIRBcore_Defs.h>
 #include <UIRBcore_EEPROM.hpp>
+#include <UIRBcore_Profiler.hpp>
 
 #if !defined(UIRB_EEPROM_BYPASS_DEBUG)
     #include <EEPROM.h>
@@ -88,6 +89,23 @@ namespace uirbcore::eeprom
     static EEPROMData EEPROM_DATA = DEBUG_EEPROM_DATA;
 #endif // defined(UIRB_EEPROM_BYPASS_DEBUG) || defined(__DOXYGEN__)
 
+    // Bitfields are allocated from the least significant bit by avr-gcc, the first member of each union is at bit 0
+    const SettingDescriptor EEPROMDataManager::SETTING_DESCRIPTORS[] PROGMEM = {
+        // offset, size, bit_shift, bit_count, bias, min, max, flags
+        { offsetof(EEPROMData, hardware_version), 1, 0, 8, 0, 0U, UINT8_MAX, SETTING_FLAG_READ_ONLY },
+        { offsetof(EEPROMData, bandgap_1v1_reference_offset), 1, 0, 8, 1100, 1100U + INT8_MIN, 1100U + INT8_MAX, SETTING_FLAG_SIGNED | SETTING_FLAG_USER_WRITABLE },
+        { offsetof(EEPROMData, stat_led_brightness), 1, 0, 8, 0, 0U, UINT8_MAX, SETTING_FLAG_USER_WRITABLE },
+        { offsetof(EEPROMData, charger_prog_resistor_ohms), 2, 0, 16, 0, EEPROMDataManager::CHARGER_PROG_RESISTANCE_MIN, UINT16_MAX, 0 },
+        { offsetof(EEPROMData, software_config), 1, 0, 1, 0, 0U, 1U, 0 },
+        { offsetof(EEPROMData, software_config), 1, 1, 1, 0, 0U, 1U, SETTING_FLAG_USER_WRITABLE },
+        { offsetof(EEPROMData, software_config), 1, 2, 1, 0, 0U, 1U, SETTING_FLAG_USER_WRITABLE },
+        { offsetof(EEPROMData, software_config), 1, 3, 1, 0, 0U, 1U, 0 },
+        { offsetof(EEPROMData, hardware_manufacture_date), 1, 0, 4, 2020, 2020U, 2035U, 0 },
+        { offsetof(EEPROMData, hardware_manufacture_date), 1, 4, 4, 0, 1U, 12U, 0 },
+        { offsetof(EEPROMData, boot_count), 4, 0, 32, 0, 0U, UINT32_MAX, 0 },
+        { offsetof(EEPROMData, uirb_serial_number), 2, 0, 14, 0, 1U, EEPROMDataManager::UIRB_SERIAL_NUMBER_MAX, 0 },
+    };
+
     // Compare two EEPROMData structures for equality
     bool operator==(const EEPROMData& lhs, const EEPROMData& rhs)
     {
@@ -180,135 +198,116 @@ namespace uirbcore::eeprom
         return this->eeprom_core_data_.hardware_version.version_byte == UIRB_HW_VER.version_byte; 
     }
 
+    // The getters read their field directly, get_bandgap_reference_milivolts() runs on every voltage measurement
     uint16_t EEPROMDataManager::get_bandgap_reference_milivolts() const
     {
         return static_cast<uint16_t>(1100 + this->eeprom_core_data_.bandgap_1v1_reference_offset);
     }
 
-    bool EEPROMDataManager::set_bandgap_reference_milivolts(const uint16_t milivolts)
-    {
-        if (milivolts < 1100U + INT8_MIN || milivolts > 1100U + INT8_MAX) {
-            return false;
-        }
-
-        this->eeprom_core_data_.bandgap_1v1_reference_offset = static_cast<int8_t>(milivolts - 1100);
-
-        return true;
-    }
-
     uint8_t EEPROMDataManager::get_stat_led_brightness() const
     {
         return this->eeprom_core_data_.stat_led_brightness;
     }
 
-    void EEPROMDataManager::set_stat_led_brightness(const uint8_t brightness)
-    {
-        this->eeprom_core_data_.stat_led_brightness = brightness;
-    }
-
     uint16_t EEPROMDataManager::get_charger_prog_resistor_ohms() const
     {
-        return this->eeprom_core_data_.charger_prog_resistor_ohms <= EEPROMDataManager::CHARGER_PROG_RESISTANCE_MIN
+        return this->eeprom_core_data_.charger_prog_resistor_ohms < EEPROMDataManager::CHARGER_PROG_RESISTANCE_MIN
             ? EEPROMDataManager::INVALID_CHARGER_PROG_RESISTANCE
             : this->eeprom_core_data_.charger_prog_resistor_ohms;
     }
 
-    bool EEPROMDataManager::set_charger_prog_resistor_ohms(const uint16_t ohms)
-    {
-        if (ohms < EEPROMDataManager::CHARGER_PROG_RESISTANCE_MIN)
-        {
-            return false;
-        }
-
-        this->eeprom_core_data_.charger_prog_resistor_ohms = ohms;
-
-        return true;
-    }
-
     bool EEPROMDataManager::is_avr_serial_debugger_enabled() const
     {
         return this->eeprom_core_data_.software_config.avr_serial_debugger_enabled;
     }
 
-    void EEPROMDataManager::set_avr_serial_debugger(const bool enabled)
-    {
-        this->eeprom_core_data_.software_config.avr_serial_debugger_enabled = enabled;
-    }
-
     bool EEPROMDataManager::is_sleep_mode_allowed() const
     {
         return this->eeprom_core_data_.software_config.sleep_mode_allowed;
     }
 
-    void EEPROMDataManager::allow_sleep_mode(const bool allowed)
-    {
-        this->eeprom_core_data_.software_config.sleep_mode_allowed = allowed;
-    }
-
     bool EEPROMDataManager::is_sleep_mode_io3_wakeup_allowed() const
     {
         return this->eeprom_core_data_.software_config.sleep_mode_io3_wakeup_enabled;
     }
 
-    void EEPROMDataManager::allow_sleep_mode_io3_wakeup(const bool allowed)
+    bool EEPROMDataManager::is_boot_count_increment_allowed() const
     {
-        this->eeprom_core_data_.software_config.sleep_mode_io3_wakeup_enabled = allowed;
+        return this->eeprom_core_data_.software_config.boot_count_increment_enabled;
     }
 
-    bool EEPROMDataManager::is_boot_count_increment_allowed() const
+    uint16_t EEPROMDataManager::get_board_manufacture_year() const
     {
-        return this->eeprom_core_data_.software_config.boot_count_increment_enabled;
+        return 2020U + this->eeprom_core_data_.hardware_manufacture_date.year_offset_from_2020;
     }
 
-    void EEPROMDataManager::allow_boot_count_increment(const bool allowed)
+    uint8_t EEPROMDataManager::get_board_manufacture_month() const
     {
-        this->eeprom_core_data_.software_config.boot_count_increment_enabled = allowed;
+        return this->eeprom_core_data_.hardware_manufacture_date.month <= 12U
+            ? this->eeprom_core_data_.hardware_manufacture_date.month
+            : EEPROMDataManager::INVALID_MANUFACTURE_MONTH;
     }
 
-    uint16_t EEPROMDataManager::get_board_manufacture_year() const
+    uint32_t EEPROMDataManager::get_boot_count() const
     {
-        return 2020U + this->eeprom_core_data_.hardware_manufacture_date.year_offset_from_2020;
+        return this->eeprom_core_data_.boot_count;
     }
 
-    bool EEPROMDataManager::set_board_manufacture_year(const uint16_t year)
+    bool EEPROMDataManager::get_setting_descriptor(const SettingId id, SettingDescriptor& descriptor)
     {
-        if (year < 2020U || year > 2035U)
+        static_assert(sizeof(EEPROMDataManager::SETTING_DESCRIPTORS) / sizeof(EEPROMDataManager::SETTING_DESCRIPTORS[0]) == static_cast<uint8_t>(SettingId::COUNT), "SETTING_DESCRIPTORS does not match SettingId");
+
+        if (static_cast<uint8_t>(id) >= static_cast<uint8_t>(SettingId::COUNT))
         {
             return false;
         }
-
-        this->eeprom_core_data_.hardware_manufacture_date.year_offset_from_2020 = static_cast<uint8_t>(year - 2020U);
-
+        memcpy_P(&descriptor, &EEPROMDataManager::SETTING_DESCRIPTORS[static_cast<uint8_t>(id)], sizeof(SettingDescriptor));
         return true;
     }
 
-    uint8_t EEPROMDataManager::get_board_manufacture_month() const
+    bool EEPROMDataManager::get_setting(const SettingId id, uint32_t& value) const
     {
-        return this->eeprom_core_data_.hardware_manufacture_date.month <= 12U
-            ? this->eeprom_core_data_.hardware_manufacture_date.month
-            : EEPROMDataManager::INVALID_MANUFACTURE_MONTH;
-    }
-
-    bool EEPROMDataManager::set_board_manufacture_month(const uint8_t month)
-    {
-        if (month < 1U || month > 12U)
+        SettingDescriptor descriptor;
+        if (!EEPROMDataManager::get_setting_descriptor(id, descriptor))
         {
+            value = 0;
             return false;
         }
 
-        this->eeprom_core_data_.hardware_manufacture_date.month = month;
+        uint32_t field = 0;
+        memcpy(&field, reinterpret_cast<const uint8_t*>(&this->eeprom_core_data_) + descriptor.offset, descriptor.size);
 
-        return true;
-    }
+        const uint32_t mask = (descriptor.bit_count >= 32U) ? UINT32_MAX : ((1UL << descriptor.bit_count) - 1U);
+        uint32_t bits = (field >> descriptor.bit_shift) & mask;
+        if ((descriptor.flags & SETTING_FLAG_SIGNED) && (bits & (1UL << (descriptor.bit_count - 1U))))
+        {
+            bits |= ~mask;
+        }
 
-    uint32_t EEPROMDataManager::get_boot_count() const
-    {
-        return this->eeprom_core_data_.boot_count;
+        value = bits + static_cast<int32_t>(descriptor.bias);
+        return value >= descriptor.min && value <= descriptor.max;
     }
 
-    void EEPROMDataManager::set_boot_count(const uint32_t boot_count)
+    bool EEPROMDataManager::set_setting(const SettingId id, const uint32_t value)
     {
-        this->eeprom_core_data_.boot_count = boot_count;
+        SettingDescriptor descriptor;
+        if (!EEPROMDataManager::get_setting_descriptor(id, descriptor) ||
+            (descriptor.flags & SETTING_FLAG_READ_ONLY) ||
+            value < descriptor.min || value > descriptor.max)
+        {
+            return false;
+        }
+
+        uint8_t* const field_address = reinterpret_cast<uint8_t*>(&this->eeprom_core_data_) + descriptor.offset;
+        uint32_t field = 0;
+        memcpy(&field, field_address, descriptor.size);
+
+        const uint32_t mask = (descriptor.bit_count >= 32U) ? UINT32_MAX : ((1UL << descriptor.bit_count) - 1U);
+        const uint32_t bits = (value - static_cast<int32_t>(descriptor.bias)) & mask;
+        field = (field & ~(mask << descriptor.bit_shift)) | (bits << descriptor.bit_shift);
+        memcpy(field_address, &field, descriptor.size);
+
+        return true;
     }
 
     bool EEPROMDataManager::increment_boot_count()
@@ -331,16 +330,6 @@ namespace uirbcore::eeprom
             : this->eeprom_core_data_.uirb_serial_number.number;
     }
 
-    bool EEPROMDataManager::set_uirb_board_serial_number(const uint16_t serial_number)
-    {
-        if (serial_number == 0 || serial_number > EEPROMDataManager::UIRB_SERIAL_NUMBER_MAX)
-        {
-            return false;
-        }
-        this->eeprom_core_data_.uirb_serial_number.number = serial_number;
-        return true;
-    }
-
     bool EEPROMDataManager::set_factory_cp2104_usb_serial_number_cstr(const char* cstr)
     {
         if (strnlen(cstr, DATA_FACTORY_CP2104_SERIAL_NUM_LEN + 1) != DATA_FACTORY_CP2104_SERIAL_NUM_LEN) {
@@ -378,11 +367,28 @@ namespace uirbcore::eeprom
 
     bool EEPROMDataManager::store_to_eeprom(const EEPROMData& data)
     {
+        UIRB_PROFILE_SCOPE(EEPROM_COMMIT);
+        EEPROMCommitTask commit(data);
+        runTask(commit);
+        return commit.isVerified();
+    }
+
+    TaskStatus EEPROMCommitTask::step()
+    {
+        UIRB_TASK_BEGIN(this->coroutine_);
     #if defined(UIRB_EEPROM_BYPASS_DEBUG)
-        EEPROM_DATA = data;
+        EEPROM_DATA = this->data_;
     #else
-        EEPROM.put(EEPROMDataManager::CORE_DATA_ADDR_START, data);
+        for (this->index_ = 0; this->index_ < sizeof(EEPROMData); this->index_++)
+        {
+            UIRB_TASK_WAIT_UNTIL(this->coroutine_, eeprom_is_ready());
+            // Only bytes which differ are written, like EEPROM.put()
+            EEPROM.update(EEPROMDataManager::CORE_DATA_ADDR_START + this->index_,
+                          reinterpret_cast<const uint8_t*>(&this->data_)[this->index_]);
+        }
+        UIRB_TASK_WAIT_UNTIL(this->coroutine_, eeprom_is_ready());
     #endif
-        return EEPROMDataManager::read_from_eeprom() == data;
+        this->verified_ = EEPROMDataManager::read_from_eeprom() == this->data_;
+        UIRB_TASK_END(this->coroutine_);
     }
 }
@@ -0,0 +1,226 @@
+/**
+ * @file EEPROMRingLog.cpp
+ * @brief Implementation of the wear-aware EEPROM circular record log for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::eeprom::EEPROMRingLog class declared in
+ * @ref UIRBcore_EEPROMRingLog.hpp.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_EEPROMRingLog.hpp>
+#include <util/crc16.h>
+
+#if !defined(UIRB_EEPROM_BYPASS_DEBUG)
+    #include <EEPROM.h>
+#endif  // !defined(UIRB_EEPROM_BYPASS_DEBUG)
+
+namespace uirbcore::eeprom
+{
+    uint16_t EEPROMRingLog::slot_address(const uint8_t slot) const
+    {
+        return this->address_ + (static_cast<uint16_t>(slot) * (this->payload_size_ + SLOT_OVERHEAD));
+    }
+
+    uint8_t EEPROMRingLog::next_sequence(const uint8_t sequence)
+    {
+        return (sequence >= (EMPTY_SEQUENCE - 1U)) ? 0U : static_cast<uint8_t>(sequence + 1U);
+    }
+
+#if defined(UIRB_EEPROM_BYPASS_DEBUG)
+    bool EEPROMRingLog::slot_valid(const uint8_t slot, uint8_t& sequence) const
+    {
+        sequence = EMPTY_SEQUENCE;
+        return false;
+    }
+
+    uint8_t EEPROMRingLog::newest_slot(uint8_t& sequence) const
+    {
+        sequence = EMPTY_SEQUENCE;
+        return INVALID_SLOT;
+    }
+
+    bool EEPROMRingLog::append(const void* payload) const
+    {
+        return false;
+    }
+
+    bool EEPROMRingLog::read(const uint8_t age, void* payload) const
+    {
+        return false;
+    }
+
+    uint8_t EEPROMRingLog::count() const
+    {
+        return 0;
+    }
+
+    void EEPROMRingLog::clear() const
+    {
+    }
+#else  // defined(UIRB_EEPROM_BYPASS_DEBUG)
+    bool EEPROMRingLog::slot_valid(const uint8_t slot, uint8_t& sequence) const
+    {
+        uint16_t address = this->slot_address(slot);
+        sequence = EEPROM.read(address);
+        if (sequence == EMPTY_SEQUENCE)
+        {
+            return false;
+        }
+
+        uint8_t crc = _crc8_ccitt_update(0, sequence);
+        for (uint8_t i = 0; i < this->payload_size_; i++)
+        {
+            crc = _crc8_ccitt_update(crc, EEPROM.read(++address));
+        }
+        return crc == EEPROM.read(++address);
+    }
+
+    uint8_t EEPROMRingLog::newest_slot(uint8_t& sequence) const
+    {
+        // Records are written to consecutive slots with consecutive sequence numbers,
+        // the newest one is the valid slot not followed by its successor.
+        uint8_t current_sequence = EMPTY_SEQUENCE;
+        bool current_valid = this->slot_valid(0, current_sequence);
+
+        for (uint8_t slot = 0; slot < this->slots_; slot++)
+        {
+            const uint8_t next_slot = (slot + 1U < this->slots_) ? (slot + 1U) : 0U;
+            uint8_t next_sequence_stored = EMPTY_SEQUENCE;
+            const bool next_valid = this->slot_valid(next_slot, next_sequence_stored);
+
+            if (current_valid && (!next_valid || next_sequence_stored != next_sequence(current_sequence)))
+            {
+                sequence = current_sequence;
+                return slot;
+            }
+
+            current_valid = next_valid;
+            current_sequence = next_sequence_stored;
+        }
+
+        sequence = EMPTY_SEQUENCE;
+        return INVALID_SLOT;
+    }
+
+    bool EEPROMRingLog::append(const void* payload) const
+    {
+        if (payload == nullptr || this->slots_ == 0)
+        {
+            return false;
+        }
+
+        uint8_t sequence = EMPTY_SEQUENCE;
+        uint8_t slot = this->newest_slot(sequence);
+        if (slot == INVALID_SLOT)
+        {
+            slot = 0;
+            sequence = 0;
+        }
+        else
+        {
+            slot = (slot + 1U < this->slots_) ? (slot + 1U) : 0U;
+            sequence = next_sequence(sequence);
+        }
+
+        const uint16_t address = this->slot_address(slot);
+        const uint8_t* data = static_cast<const uint8_t*>(payload);
+
+        // Invalidate the slot first so an interrupted write leaves the older records intact
+        EEPROM.update(address, EMPTY_SEQUENCE);
+
+        uint8_t crc = _crc8_ccitt_update(0, sequence);
+        for (uint8_t i = 0; i < this->payload_size_; i++)
+        {
+            EEPROM.update(address + 1U + i, data[i]);
+            crc = _crc8_ccitt_update(crc, data[i]);
+        }
+        EEPROM.update(address + 1U + this->payload_size_, crc);
+        EEPROM.update(address, sequence);
+
+        uint8_t stored_sequence = EMPTY_SEQUENCE;
+        return this->slot_valid(slot, stored_sequence) && stored_sequence == sequence;
+    }
+
+    bool EEPROMRingLog::read(const uint8_t age, void* payload) const
+    {
+        if (payload == nullptr || age >= this->count())
+        {
+            return false;
+        }
+
+        uint8_t sequence = EMPTY_SEQUENCE;
+        const uint8_t newest = this->newest_slot(sequence);
+        const uint8_t slot = (newest >= age) ? (newest - age) : (newest + this->slots_ - age);
+
+        uint16_t address = this->slot_address(slot);
+        uint8_t* data = static_cast<uint8_t*>(payload);
+        for (uint8_t i = 0; i < this->payload_size_; i++)
+        {
+            data[i] = EEPROM.read(++address);
+        }
+        return true;
+    }
+
+    uint8_t EEPROMRingLog::count() const
+    {
+        uint8_t sequence = EMPTY_SEQUENCE;
+        uint8_t slot = this->newest_slot(sequence);
+        if (slot == INVALID_SLOT)
+        {
+            return 0;
+        }
+
+        uint8_t records = 1;
+        while (records < this->slots_)
+        {
+            slot = (slot > 0U) ? (slot - 1U) : (this->slots_ - 1U);
+            uint8_t older_sequence = EMPTY_SEQUENCE;
+            if (!this->slot_valid(slot, older_sequence) || next_sequence(older_sequence) != sequence)
+            {
+                break;
+            }
+            sequence = older_sequence;
+            records++;
+        }
+        return records;
+    }
+
+    void EEPROMRingLog::clear() const
+    {
+        for (uint8_t slot = 0; slot < this->slots_; slot++)
+        {
+            EEPROM.update(this->slot_address(slot), EMPTY_SEQUENCE);
+        }
+    }
+#endif  // defined(UIRB_EEPROM_BYPASS_DEBUG)
+}  // namespace uirbcore::eeprom
@@ -0,0 +1,1083 @@
+/**
+ * @file IRCodeStore.cpp
+ * @brief Implementation of the IR code library on SPI NOR flash for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::IRCodeStore class. The on-flash layout is described in
+ * @ref UIRBcore_IRCodeStore.hpp. The implementation only depends on the C library and the
+ * @ref uirbcore::SPIFlashDevice interface, so it can also be compiled on a host together with
+ * @ref uirbcore::SimulatedSPIFlash.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore_IRCodeStore.hpp>
+
+#if defined(UIRB_CORE_SPI_FLASH)
+#include <stddef.h>
+#include <string.h>
+
+namespace
+{
+    /**
+     * @brief Magic value of index copy headers ("UIRX").
+     */
+    constexpr uint32_t INDEX_MAGIC = 0x58524955UL;
+
+    /**
+     * @brief Magic value of data sector headers ("UIRD").
+     */
+    constexpr uint32_t DATA_MAGIC = 0x44524955UL;
+
+    /**
+     * @brief Sequence of a data sector which holds no records.
+     */
+    constexpr uint32_t FREE_SEQUENCE = 0xFFFFFFFFUL;
+
+    /**
+     * @brief Highest address reachable with the 24-bit addresses of index entries.
+     */
+    constexpr uint32_t MAX_CAPACITY = 0x1000000UL;
+
+    /**
+     * @brief Header at the start of each index copy.
+     *
+     * `crc` covers `sequence`, `count` and the table entries.
+     */
+    struct IndexHeader
+    {
+        uint32_t magic;
+        uint32_t sequence;
+        uint16_t count;
+        uint16_t crc;
+        uint32_t reserved;
+    };
+
+    /**
+     * @brief Header at the start of each data sector.
+     *
+     * Written with @ref FREE_SEQUENCE right after the erase. The sequence is programmed when the sector
+     * becomes the head, so no erase is needed in between.
+     */
+    struct SectorHeader
+    {
+        uint32_t magic;
+        uint32_t erase_count;
+        uint32_t sequence;
+        uint32_t reserved;
+    };
+
+    /**
+     * @brief Header preceding each record payload.
+     */
+    struct RecordHeader
+    {
+        uint16_t id;
+        uint16_t length;
+        uint16_t crc;
+        uint16_t id_complement;
+    };
+
+    static_assert(sizeof(IndexHeader) == 16, "IndexHeader must be 16 bytes");
+    static_assert(sizeof(SectorHeader) == 16, "SectorHeader must be 16 bytes");
+    static_assert(sizeof(RecordHeader) == 8, "RecordHeader must be 8 bytes");
+
+    /**
+     * @brief Bytes per index entry.
+     */
+    constexpr uint16_t ENTRY_SIZE = 8;
+
+    /**
+     * @brief Number of index entries buffered before programming them during a merge.
+     */
+    constexpr uint8_t MERGE_BUFFER_ENTRIES = 4;
+
+    /**
+     * @brief Bytes copied at once while relocating a record.
+     */
+    constexpr uint8_t COPY_CHUNK_SIZE = 16;
+
+    /**
+     * @brief Updates a CRC-16/CCITT (polynomial `0x1021`).
+     */
+    uint16_t crc16_update(uint16_t crc, const uint8_t data)
+    {
+        crc ^= static_cast<uint16_t>(data) << 8;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x8000U) ? static_cast<uint16_t>((crc << 1) ^ 0x1021U) : static_cast<uint16_t>(crc << 1);
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Updates a CRC-16/CCITT over a buffer.
+     */
+    uint16_t crc16_update(uint16_t crc, const void* data, uint16_t length)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        while (length--)
+        {
+            crc = crc16_update(crc, *bytes++);
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Updates a CRC-8/CCITT (polynomial `0x07`).
+     */
+    uint8_t crc8_update(uint8_t crc, const uint8_t data)
+    {
+        crc ^= data;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            crc = (crc & 0x80U) ? static_cast<uint8_t>((crc << 1) ^ 0x07U) : static_cast<uint8_t>(crc << 1);
+        }
+        return crc;
+    }
+
+    /**
+     * @brief Computes the check byte of an index entry.
+     */
+    uint8_t entry_check(const uint16_t id, const uint16_t length, const uint32_t address)
+    {
+        uint8_t crc = crc8_update(0, static_cast<uint8_t>(id));
+        crc = crc8_update(crc, static_cast<uint8_t>(id >> 8));
+        crc = crc8_update(crc, static_cast<uint8_t>(length));
+        crc = crc8_update(crc, static_cast<uint8_t>(length >> 8));
+        crc = crc8_update(crc, static_cast<uint8_t>(address));
+        crc = crc8_update(crc, static_cast<uint8_t>(address >> 8));
+        return crc8_update(crc, static_cast<uint8_t>(address >> 16));
+    }
+
+    /**
+     * @brief Packs a record address and the entry check byte into an index entry location.
+     */
+    uint32_t make_location(const uint16_t id, const uint16_t length, const uint32_t address)
+    {
+        return (address & 0xFFFFFFUL) | (static_cast<uint32_t>(entry_check(id, length, address)) << 24);
+    }
+
+    /**
+     * @brief Checks if a location holds the check byte of its entry.
+     */
+    bool location_valid(const uint16_t id, const uint16_t length, const uint32_t location)
+    {
+        return (location >> 24) == entry_check(id, length, location & 0xFFFFFFUL);
+    }
+
+    /**
+     * @brief Extracts the record address from a location.
+     */
+    uint32_t location_address(const uint32_t location)
+    {
+        return location & 0xFFFFFFUL;
+    }
+
+    /**
+     * @brief Checks if a record header slot is still erased.
+     */
+    bool record_free(const RecordHeader& header)
+    {
+        return header.id == 0xFFFFU && header.length == 0xFFFFU && header.crc == 0xFFFFU && header.id_complement == 0xFFFFU;
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    StoreResult IRCodeStore::begin()
+    {
+        this->mounted_ = false;
+        if (!this->configure())
+        {
+            return StoreResult::ERROR_INVALID_ARGUMENT;
+        }
+
+        // Select the valid index copy with the highest sequence
+        uint32_t sequence[2] = {0, 0};
+        uint16_t count[2] = {0, 0};
+        bool valid[2];
+        valid[0] = this->check_index(0, sequence[0], count[0]);
+        valid[1] = this->check_index(1, sequence[1], count[1]);
+        if (!valid[0] && !valid[1])
+        {
+            return StoreResult::ERROR_CORRUPTED;
+        }
+        this->active_index_ = (valid[1] && (!valid[0] || sequence[1] > sequence[0])) ? 1 : 0;
+        this->index_sequence_ = sequence[this->active_index_];
+        this->table_count_ = count[this->active_index_];
+
+        IndexEntry entry;
+        this->journal_count_ = 0;
+        while (this->journal_count_ < UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES)
+        {
+            if (!this->cached_read(this->journal_address(this->journal_count_), &entry, ENTRY_SIZE))
+            {
+                return StoreResult::ERROR_DEVICE;
+            }
+            if (entry.id == INVALID_ID && entry.length == 0xFFFFU && entry.location == 0xFFFFFFFFUL)
+            {
+                break;
+            }
+            this->journal_count_++;
+        }
+
+        // Locate the used data sectors, they follow each other in ring order from tail to head
+        uint32_t min_sequence = FREE_SEQUENCE;
+        this->data_sequence_ = 0;
+        this->used_sectors_ = 0;
+        for (uint16_t sector = 0; sector < this->data_sectors_; sector++)
+        {
+            SectorHeader header;
+            if (!this->cached_read(this->sector_address(sector), &header, sizeof(header)))
+            {
+                return StoreResult::ERROR_DEVICE;
+            }
+            if (header.magic != DATA_MAGIC)
+            {
+                // Interrupted reclaim, the erase count is lost
+                if (!this->reset_sector(sector, 1))
+                {
+                    return StoreResult::ERROR_DEVICE;
+                }
+                continue;
+            }
+            if (header.sequence == FREE_SEQUENCE)
+            {
+                continue;
+            }
+
+            this->used_sectors_++;
+            if (header.sequence >= this->data_sequence_)
+            {
+                this->data_sequence_ = header.sequence;
+                this->head_sector_ = sector;
+            }
+            if (header.sequence < min_sequence)
+            {
+                min_sequence = header.sequence;
+                this->tail_sector_ = sector;
+            }
+        }
+
+        if (this->used_sectors_ == 0)
+        {
+            this->tail_sector_ = 0;
+            if (!this->open_sector(0))
+            {
+                return StoreResult::ERROR_DEVICE;
+            }
+        }
+        else
+        {
+            // Find the end of the records in the head sector, an invalid header closes the sector
+            const uint32_t base = this->sector_address(this->head_sector_);
+            uint16_t offset = sizeof(SectorHeader);
+            while (offset + sizeof(RecordHeader) <= this->sector_size_)
+            {
+                RecordHeader header;
+                if (!this->cached_read(base + offset, &header, sizeof(header)))
+                {
+                    return StoreResult::ERROR_DEVICE;
+                }
+                if (record_free(header))
+                {
+                    break;
+                }
+                if (header.id_complement != static_cast<uint16_t>(~header.id) || header.length == 0 ||
+                    header.length > this->sector_size_ - offset - sizeof(RecordHeader))
+                {
+                    offset = this->sector_size_;
+                    break;
+                }
+                offset += sizeof(RecordHeader) + header.length;
+            }
+            this->head_offset_ = offset;
+        }
+
+        // Count the codes and their size, the journal only holds changes relative to the table
+        const uint32_t table = this->index_address(this->active_index_) + sizeof(IndexHeader);
+        this->code_count_ = this->table_count_;
+        this->live_bytes_ = 0;
+        for (uint16_t i = 0; i < this->table_count_; i++)
+        {
+            if (!this->cached_read(table + static_cast<uint32_t>(i) * ENTRY_SIZE, &entry, ENTRY_SIZE))
+            {
+                return StoreResult::ERROR_DEVICE;
+            }
+            this->live_bytes_ += sizeof(RecordHeader) + entry.length;
+        }
+        for (uint16_t slot = this->journal_count_; slot-- > 0;)
+        {
+            if (!this->cached_read(this->journal_address(slot), &entry, ENTRY_SIZE) ||
+                !location_valid(entry.id, entry.length, entry.location))
+            {
+                continue;
+            }
+
+            bool superseded = false;
+            for (uint16_t newer = slot + 1; newer < this->journal_count_ && !superseded; newer++)
+            {
+                IndexEntry newer_entry;
+                superseded = this->cached_read(this->journal_address(newer), &newer_entry, ENTRY_SIZE) &&
+                             location_valid(newer_entry.id, newer_entry.length, newer_entry.location) &&
+                             newer_entry.id == entry.id;
+            }
+            if (superseded)
+            {
+                continue;
+            }
+
+            IndexEntry table_entry;
+            const bool in_table = this->find_in_table(entry.id, table_entry);
+            const bool live = location_address(entry.location) != 0;
+            if (in_table)
+            {
+                this->code_count_--;
+                this->live_bytes_ -= sizeof(RecordHeader) + table_entry.length;
+            }
+            if (live)
+            {
+                this->code_count_++;
+                this->live_bytes_ += sizeof(RecordHeader) + entry.length;
+            }
+        }
+
+        this->mounted_ = true;
+        return StoreResult::SUCCESS;
+    }
+
+    StoreResult IRCodeStore::format()
+    {
+        this->mounted_ = false;
+        if (!this->configure())
+        {
+            return StoreResult::ERROR_INVALID_ARGUMENT;
+        }
+
+        for (uint16_t sector = 0; sector < this->data_sectors_; sector++)
+        {
+            SectorHeader header;
+            if (!this->cached_read(this->sector_address(sector), &header, sizeof(header)))
+            {
+                return StoreResult::ERROR_DEVICE;
+            }
+            const uint32_t erase_count = (header.magic == DATA_MAGIC) ? header.erase_count + 1 : 1;
+            if (!this->reset_sector(sector, erase_count))
+            {
+                return StoreResult::ERROR_DEVICE;
+            }
+        }
+
+        // Erase copy B before writing copy A, so a stale copy B with a higher sequence cannot win
+        for (uint8_t i = 0; i < this->index_sectors_; i++)
+        {
+            if (!this->erase(this->index_address(1) + static_cast<uint32_t>(i) * this->sector_size_))
+            {
+                return StoreResult::ERROR_DEVICE;
+            }
+        }
+        if (!this->write_empty_index(0, 1))
+        {
+            return StoreResult::ERROR_DEVICE;
+        }
+
+        this->active_index_ = 0;
+        this->index_sequence_ = 1;
+        this->table_count_ = 0;
+        this->journal_count_ = 0;
+        this->code_count_ = 0;
+        this->live_bytes_ = 0;
+        this->data_sequence_ = 0;
+        this->used_sectors_ = 0;
+        this->tail_sector_ = 0;
+        if (!this->open_sector(0))
+        {
+            return StoreResult::ERROR_DEVICE;
+        }
+
+        this->mounted_ = true;
+        return StoreResult::SUCCESS;
+    }
+
+    StoreResult IRCodeStore::store(const uint16_t id, const void* data, const uint16_t length)
+    {
+        if (!this->mounted_)
+        {
+            return StoreResult::ERROR_NOT_MOUNTED;
+        }
+        if (id == INVALID_ID || data == nullptr || length == 0 || length > this->getMaxCodeLength())
+        {
+            return StoreResult::ERROR_INVALID_ARGUMENT;
+        }
+
+        IndexEntry entry;
+        const bool exists = this->find(id, entry) && location_address(entry.location) != 0;
+        const uint32_t replaced_bytes = exists ? sizeof(RecordHeader) + entry.length : 0;
+        const uint32_t live_bytes = this->live_bytes_ - replaced_bytes + sizeof(RecordHeader) + length;
+        // Checked up front, reclaiming sectors cannot make room beyond this
+        if ((!exists && this->code_count_ >= this->table_capacity_) || live_bytes > this->getMaxLiveBytes())
+        {
+            return StoreResult::ERROR_FULL;
+        }
+
+        uint32_t address;
+        StoreResult result = this->allocate(id, length, crc16_update(0xFFFFU, data, length), address, false);
+        if (result != StoreResult::SUCCESS)
+        {
+            return result;
+        }
+        if (!this->write(address + sizeof(RecordHeader), data, length))
+        {
+            return StoreResult::ERROR_DEVICE;
+        }
+
+        result = this->append_index(id, length, address);
+        if (result == StoreResult::SUCCESS)
+        {
+            this->code_count_ += exists ? 0 : 1;
+            this->live_bytes_ = live_bytes;
+        }
+        return result;
+    }
+
+    StoreResult IRCodeStore::load(const uint16_t id, void* buffer, const uint16_t capacity, uint16_t& length)
+    {
+        length = 0;
+        if (!this->mounted_)
+        {
+            return StoreResult::ERROR_NOT_MOUNTED;
+        }
+
+        IndexEntry entry;
+        if (!this->find(id, entry) || location_address(entry.location) == 0)
+        {
+            return StoreResult::ERROR_NOT_FOUND;
+        }
+
+        length = entry.length;
+        if (buffer == nullptr || capacity < entry.length)
+        {
+            return StoreResult::ERROR_BUFFER_TOO_SMALL;
+        }
+
+        const uint32_t address = location_address(entry.location);
+        RecordHeader header;
+        if (!this->cached_read(address, &header, sizeof(header)))
+        {
+            return StoreResult::ERROR_DEVICE;
+        }
+        if (header.id != id || header.id_complement != static_cast<uint16_t>(~id) || header.length != entry.length)
+        {
+            return StoreResult::ERROR_CORRUPTED;
+        }
+
+        // Payloads bypass the cache, they would only evict index lines
+        if (!this->device_.read(address + sizeof(RecordHeader), buffer, entry.length))
+        {
+            return StoreResult::ERROR_DEVICE;
+        }
+        return (crc16_update(0xFFFFU, buffer, entry.length) == header.crc) ? StoreResult::SUCCESS : StoreResult::ERROR_CORRUPTED;
+    }
+
+    bool IRCodeStore::contains(const uint16_t id)
+    {
+        IndexEntry entry;
+        return this->mounted_ && this->find(id, entry) && location_address(entry.location) != 0;
+    }
+
+    StoreResult IRCodeStore::remove(const uint16_t id)
+    {
+        if (!this->mounted_)
+        {
+            return StoreResult::ERROR_NOT_MOUNTED;
+        }
+
+        IndexEntry entry;
+        if (!this->find(id, entry) || location_address(entry.location) == 0)
+        {
+            return StoreResult::ERROR_NOT_FOUND;
+        }
+
+        const StoreResult result = this->append_index(id, 0, 0);
+        if (result == StoreResult::SUCCESS)
+        {
+            this->code_count_--;
+            this->live_bytes_ -= sizeof(RecordHeader) + entry.length;
+        }
+        return result;
+    }
+
+    StoreResult IRCodeStore::getStats(StoreStats& stats)
+    {
+        stats = StoreStats();
+        if (!this->mounted_)
+        {
+            return StoreResult::ERROR_NOT_MOUNTED;
+        }
+
+        stats.codes = this->code_count_;
+        stats.max_codes = this->table_capacity_;
+        stats.live_bytes = this->live_bytes_;
+        stats.max_live_bytes = this->getMaxLiveBytes();
+        stats.journal_entries = this->journal_count_;
+        stats.data_sectors = this->data_sectors_;
+        stats.free_sectors = this->data_sectors_ - this->used_sectors_;
+        stats.index_sequence = this->index_sequence_;
+        stats.min_erase_count = UINT32_MAX;
+        for (uint16_t sector = 0; sector < this->data_sectors_; sector++)
+        {
+            SectorHeader header;
+            if (!this->device_.read(this->sector_address(sector), &header, sizeof(header)))
+            {
+                return StoreResult::ERROR_DEVICE;
+            }
+            stats.min_erase_count = min(stats.min_erase_count, header.erase_count);
+            stats.max_erase_count = max(stats.max_erase_count, header.erase_count);
+        }
+        return StoreResult::SUCCESS;
+    }
+
+    uint16_t IRCodeStore::getMaxCodeLength() const
+    {
+        return (this->sector_size_ > sizeof(SectorHeader) + sizeof(RecordHeader)) ?
+                this->sector_size_ - sizeof(SectorHeader) - sizeof(RecordHeader) : 0;
+    }
+
+    uint32_t IRCodeStore::getMaxLiveBytes() const
+    {
+        return (this->data_sectors_ > 1) ?
+                static_cast<uint32_t>(this->data_sectors_ - 1) * (this->sector_size_ - sizeof(SectorHeader)) : 0;
+    }
+
+    bool IRCodeStore::cached_read(uint32_t address, void* data, uint16_t length)
+    {
+        uint8_t* bytes = static_cast<uint8_t*>(data);
+        while (length > 0)
+        {
+            const uint32_t line = address & ~static_cast<uint32_t>(UIRB_CORE_SPI_FLASH_CACHE_SIZE - 1);
+            if (line != this->cache_address_)
+            {
+                const uint32_t capacity = this->device_.capacity();
+                if (line >= capacity)
+                {
+                    return false;
+                }
+                const uint16_t fill = min(static_cast<uint32_t>(UIRB_CORE_SPI_FLASH_CACHE_SIZE), capacity - line);
+                if (!this->device_.read(line, this->cache_, fill))
+                {
+                    this->cache_address_ = UINT32_MAX;
+                    return false;
+                }
+                this->cache_address_ = line;
+            }
+
+            const uint16_t offset = address - line;
+            const uint16_t chunk = min(length, static_cast<uint16_t>(UIRB_CORE_SPI_FLASH_CACHE_SIZE - offset));
+            memcpy(bytes, this->cache_ + offset, chunk);
+            bytes += chunk;
+            address += chunk;
+            length -= chunk;
+        }
+        return true;
+    }
+
+    bool IRCodeStore::write(uint32_t address, const void* data, uint16_t length)
+    {
+        if (this->cache_address_ != UINT32_MAX && address < this->cache_address_ + UIRB_CORE_SPI_FLASH_CACHE_SIZE &&
+            address + length > this->cache_address_)
+        {
+            this->cache_address_ = UINT32_MAX;
+        }
+
+        const uint16_t page_size = this->device_.pageSize();
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        while (length > 0)
+        {
+            const uint16_t chunk = min(length, static_cast<uint16_t>(page_size - address % page_size));
+            if (!this->device_.program(address, bytes, chunk))
+            {
+                return false;
+            }
+            bytes += chunk;
+            address += chunk;
+            length -= chunk;
+        }
+        return true;
+    }
+
+    bool IRCodeStore::erase(const uint32_t address)
+    {
+        if (this->cache_address_ != UINT32_MAX && this->cache_address_ >= address &&
+            this->cache_address_ < address + this->sector_size_)
+        {
+            this->cache_address_ = UINT32_MAX;
+        }
+        return this->device_.eraseSector(address);
+    }
+
+    bool IRCodeStore::find(const uint16_t id, IndexEntry& entry)
+    {
+        for (uint16_t slot = this->journal_count_; slot-- > 0;)
+        {
+            if (this->cached_read(this->journal_address(slot), &entry, ENTRY_SIZE) && entry.id == id &&
+                location_valid(entry.id, entry.length, entry.location))
+            {
+                return true;
+            }
+        }
+        return this->find_in_table(id, entry);
+    }
+
+    bool IRCodeStore::find_in_table(const uint16_t id, IndexEntry& entry)
+    {
+        const uint32_t table = this->index_address(this->active_index_) + sizeof(IndexHeader);
+        uint16_t low = 0;
+        uint16_t high = this->table_count_;
+        while (low < high)
+        {
+            const uint16_t middle = low + (high - low) / 2;
+            if (!this->cached_read(table + static_cast<uint32_t>(middle) * ENTRY_SIZE, &entry, ENTRY_SIZE))
+            {
+                return false;
+            }
+            if (entry.id == id)
+            {
+                return true;
+            }
+            if (entry.id < id)
+            {
+                low = middle + 1;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return false;
+    }
+
+    StoreResult IRCodeStore::append_index(const uint16_t id, const uint16_t length, const uint32_t address)
+    {
+        if (this->journal_count_ >= UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES)
+        {
+            const StoreResult result = this->merge_index();
+            if (result != StoreResult::SUCCESS)
+            {
+                return result;
+            }
+        }
+
+        IndexEntry entry;
+        entry.id = id;
+        entry.length = length;
+        entry.location = make_location(id, length, address);
+        // A failed program still consumes the slot, its check byte marks it invalid
+        return this->write(this->journal_address(this->journal_count_++), &entry, ENTRY_SIZE) ?
+               StoreResult::SUCCESS : StoreResult::ERROR_DEVICE;
+    }
+
+    StoreResult IRCodeStore::merge_index()
+    {
+        // Collect the newest valid journal entry per ID, sorted by ID
+        IndexEntry journal[UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES];
+        uint16_t journal_size = 0;
+        for (uint16_t slot = this->journal_count_; slot-- > 0;)
+        {
+            IndexEntry entry;
+            if (!this->cached_read(this->journal_address(slot), &entry, ENTRY_SIZE))
+            {
+                return StoreResult::ERROR_DEVICE;
+            }
+            if (!location_valid(entry.id, entry.length, entry.location))
+            {
+                continue;
+            }
+
+            uint16_t position = journal_size;
+            bool duplicate = false;
+            while (position > 0 && journal[position - 1].id >= entry.id)
+            {
+                if (journal[position - 1].id == entry.id)
+                {
+                    duplicate = true;
+                    break;
+                }
+                position--;
+            }
+            if (duplicate)
+            {
+                continue;
+            }
+            memmove(&journal[position + 1], &journal[position], (journal_size - position) * sizeof(IndexEntry));
+            journal[position] = entry;
+            journal_size++;
+        }
+
+        const uint8_t target = this->active_index_ ^ 1;
+        for (uint8_t i = 0; i < this->index_sectors_; i++)
+        {
+            if (!this->erase(this->index_address(target) + static_cast<uint32_t>(i) * this->sector_size_))
+            {
+                return StoreResult::ERROR_DEVICE;
+            }
+        }
+
+        IndexHeader header;
+        header.magic = INDEX_MAGIC;
+        header.sequence = this->index_sequence_ + 1;
+        header.count = 0;
+        header.reserved = 0xFFFFFFFFUL;
+
+        const uint32_t source_table = this->index_address(this->active_index_) + sizeof(IndexHeader);
+        const uint32_t target_table = this->index_address(target) + sizeof(IndexHeader);
+        IndexEntry buffer[MERGE_BUFFER_ENTRIES];
+        uint8_t buffered = 0;
+        uint16_t crc = 0xFFFFU;
+        uint16_t table_index = 0;
+        uint16_t journal_index = 0;
+        IndexEntry table_entry;
+        bool table_entry_loaded = false;
+
+        while (table_index < this->table_count_ || journal_index < journal_size || buffered > 0)
+        {
+            if (!table_entry_loaded && table_index < this->table_count_)
+            {
+                if (!this->cached_read(source_table + static_cast<uint32_t>(table_index) * ENTRY_SIZE, &table_entry, ENTRY_SIZE))
+                {
+                    return StoreResult::ERROR_DEVICE;
+                }
+                table_entry_loaded = true;
+            }
+
+            const IndexEntry* output = nullptr;
+            if (journal_index < journal_size && (!table_entry_loaded || journal[journal_index].id <= table_entry.id))
+            {
+                if (table_entry_loaded && journal[journal_index].id == table_entry.id)
+                {
+                    table_index++;
+                    table_entry_loaded = false;
+                }
+                if (location_address(journal[journal_index].location) != 0)
+                {
+                    output = &journal[journal_index];
+                }
+                journal_index++;
+            }
+            else if (table_entry_loaded)
+            {
+                output = &table_entry;
+                table_index++;
+                table_entry_loaded = false;
+            }
+
+            if (output != nullptr)
+            {
+                if (header.count >= this->table_capacity_)
+                {
+                    return StoreResult::ERROR_FULL;
+                }
+                buffer[buffered++] = *output;
+                header.count++;
+            }
+
+            const bool done = table_index >= this->table_count_ && journal_index >= journal_size;
+            if (buffered == MERGE_BUFFER_ENTRIES || (done && buffered > 0))
+            {
+                const uint32_t address = target_table + static_cast<uint32_t>(header.count - buffered) * ENTRY_SIZE;
+                crc = crc16_update(crc, buffer, buffered * ENTRY_SIZE);
+                if (!this->write(address, buffer, buffered * ENTRY_SIZE))
+                {
+                    return StoreResult::ERROR_DEVICE;
+                }
+                buffered = 0;
+            }
+        }
+
+        // The header is programmed last, activating the new copy
+        header.crc = crc16_update(crc16_update(crc, &header.sequence, sizeof(header.sequence)), &header.count, sizeof(header.count));
+        if (!this->write(this->index_address(target), &header, sizeof(header)))
+        {
+            return StoreResult::ERROR_DEVICE;
+        }
+
+        this->active_index_ = target;
+        this->index_sequence_ = header.sequence;
+        this->table_count_ = header.count;
+        this->journal_count_ = 0;
+        this->code_count_ = header.count;
+        return StoreResult::SUCCESS;
+    }
+
+    bool IRCodeStore::write_empty_index(const uint8_t copy, const uint32_t sequence)
+    {
+        for (uint8_t i = 0; i < this->index_sectors_; i++)
+        {
+            if (!this->erase(this->index_address(copy) + static_cast<uint32_t>(i) * this->sector_size_))
+            {
+                return false;
+            }
+        }
+
+        IndexHeader header;
+        header.magic = INDEX_MAGIC;
+        header.sequence = sequence;
+        header.count = 0;
+        header.reserved = 0xFFFFFFFFUL;
+        header.crc = crc16_update(crc16_update(0xFFFFU, &header.sequence, sizeof(header.sequence)), &header.count, sizeof(header.count));
+        return this->write(this->index_address(copy), &header, sizeof(header));
+    }
+
+    bool IRCodeStore::check_index(const uint8_t copy, uint32_t& sequence, uint16_t& count)
+    {
+        IndexHeader header;
+        if (!this->cached_read(this->index_address(copy), &header, sizeof(header)) ||
+            header.magic != INDEX_MAGIC || header.count > this->table_capacity_)
+        {
+            return false;
+        }
+
+        const uint32_t table = this->index_address(copy) + sizeof(IndexHeader);
+        uint16_t crc = 0xFFFFU;
+        for (uint16_t i = 0; i < header.count; i++)
+        {
+            IndexEntry entry;
+            if (!this->cached_read(table + static_cast<uint32_t>(i) * ENTRY_SIZE, &entry, ENTRY_SIZE))
+            {
+                return false;
+            }
+            crc = crc16_update(crc, &entry, ENTRY_SIZE);
+        }
+        crc = crc16_update(crc16_update(crc, &header.sequence, sizeof(header.sequence)), &header.count, sizeof(header.count));
+        if (crc != header.crc)
+        {
+            return false;
+        }
+
+        sequence = header.sequence;
+        count = header.count;
+        return true;
+    }
+
+    StoreResult IRCodeStore::allocate(const uint16_t id, const uint16_t length, const uint16_t crc, uint32_t& address, const bool relocating)
+    {
+        const uint16_t needed = sizeof(RecordHeader) + length;
+        // Every reclaim frees one sector, going around the ring once without fitting the record means the store is full
+        uint16_t reclaims_left = this->data_sectors_;
+
+        while (this->head_offset_ + needed > this->sector_size_)
+        {
+            const uint16_t free_sectors = this->data_sectors_ - this->used_sectors_;
+            if (free_sectors > 1 || (free_sectors == 1 && relocating))
+            {
+                if (!this->open_sector((this->head_sector_ + 1) % this->data_sectors_))
+                {
+                    return StoreResult::ERROR_DEVICE;
+                }
+            }
+            else if (!relocating && reclaims_left-- > 0)
+            {
+                const StoreResult result = this->reclaim_tail();
+                if (result != StoreResult::SUCCESS)
+                {
+                    return result;
+                }
+            }
+            else
+            {
+                return StoreResult::ERROR_FULL;
+            }
+        }
+
+        RecordHeader header;
+        header.id = id;
+        header.length = length;
+        header.crc = crc;
+        header.id_complement = static_cast<uint16_t>(~id);
+        address = this->sector_address(this->head_sector_) + this->head_offset_;
+        this->head_offset_ += needed;
+        return this->write(address, &header, sizeof(header)) ? StoreResult::SUCCESS : StoreResult::ERROR_DEVICE;
+    }
+
+    StoreResult IRCodeStore::reclaim_tail()
+    {
+        const uint16_t sector = this->tail_sector_;
+        if (sector == this->head_sector_)
+        {
+            // Close the head so live records are relocated into the reserve sector
+            this->head_offset_ = this->sector_size_;
+        }
+
+        const uint32_t base = this->sector_address(sector);
+        SectorHeader sector_header;
+        if (!this->cached_read(base, &sector_header, sizeof(sector_header)))
+        {
+            return StoreResult::ERROR_DEVICE;
+        }
+
+        uint16_t offset = sizeof(SectorHeader);
+        while (offset + sizeof(RecordHeader) <= this->sector_size_)
+        {
+            RecordHeader header;
+            if (!this->cached_read(base + offset, &header, sizeof(header)))
+            {
+                return StoreResult::ERROR_DEVICE;
+            }
+            if (record_free(header) || header.id_complement != static_cast<uint16_t>(~header.id) || header.length == 0 ||
+                header.length > this->sector_size_ - offset - sizeof(RecordHeader))
+            {
+                break;
+            }
+
+            // A record is live if the index still points at it
+            IndexEntry entry;
+            if (this->find(header.id, entry) && location_address(entry.location) == base + offset)
+            {
+                uint32_t address;
+                StoreResult result = this->allocate(header.id, header.length, header.crc, address, true);
+                if (result != StoreResult::SUCCESS)
+                {
+                    return result;
+                }
+                if (!this->copy_payload(base + offset + sizeof(RecordHeader), address + sizeof(RecordHeader), header.length))
+                {
+                    return StoreResult::ERROR_DEVICE;
+                }
+                result = this->append_index(header.id, header.length, address);
+                if (result != StoreResult::SUCCESS)
+                {
+                    return result;
+                }
+            }
+            offset += sizeof(RecordHeader) + header.length;
+        }
+
+        if (!this->reset_sector(sector, sector_header.erase_count + 1))
+        {
+            return StoreResult::ERROR_DEVICE;
+        }
+        this->tail_sector_ = (sector + 1) % this->data_sectors_;
+        this->used_sectors_--;
+        return StoreResult::SUCCESS;
+    }
+
+    bool IRCodeStore::copy_payload(uint32_t from, uint32_t to, uint16_t length)
+    {
+        uint8_t buffer[COPY_CHUNK_SIZE];
+        while (length > 0)
+        {
+            const uint16_t chunk = min(length, static_cast<uint16_t>(COPY_CHUNK_SIZE));
+            if (!this->device_.read(from, buffer, chunk) || !this->write(to, buffer, chunk))
+            {
+                return false;
+            }
+            from += chunk;
+            to += chunk;
+            length -= chunk;
+        }
+        return true;
+    }
+
+    bool IRCodeStore::reset_sector(const uint16_t sector, const uint32_t erase_count)
+    {
+        const uint32_t address = this->sector_address(sector);
+        if (!this->erase(address))
+        {
+            return false;
+        }
+
+        SectorHeader header;
+        header.magic = DATA_MAGIC;
+        header.erase_count = erase_count;
+        header.sequence = FREE_SEQUENCE;
+        header.reserved = 0xFFFFFFFFUL;
+        return this->write(address, &header, sizeof(header));
+    }
+
+    bool IRCodeStore::open_sector(const uint16_t sector)
+    {
+        const uint32_t sequence = this->data_sequence_ + 1;
+        if (!this->write(this->sector_address(sector) + offsetof(SectorHeader, sequence), &sequence, sizeof(sequence)))
+        {
+            return false;
+        }
+
+        this->data_sequence_ = sequence;
+        this->head_sector_ = sector;
+        this->head_offset_ = sizeof(SectorHeader);
+        this->used_sectors_++;
+        return true;
+    }
+
+    uint32_t IRCodeStore::sector_address(const uint16_t sector) const
+    {
+        return (static_cast<uint32_t>(this->index_sectors_) * 2 + sector) * this->sector_size_;
+    }
+
+    uint32_t IRCodeStore::index_address(const uint8_t copy) const
+    {
+        return static_cast<uint32_t>(copy) * this->index_sectors_ * this->sector_size_;
+    }
+
+    uint32_t IRCodeStore::journal_address(const uint16_t slot) const
+    {
+        return this->index_address(this->active_index_ + 1) - static_cast<uint32_t>(UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES - slot) * ENTRY_SIZE;
+    }
+
+    bool IRCodeStore::configure()
+    {
+        this->cache_address_ = UINT32_MAX;
+        this->sector_size_ = this->device_.sectorSize();
+        const uint16_t page_size = this->device_.pageSize();
+        const uint32_t capacity = min(this->device_.capacity(), MAX_CAPACITY);
+        if (this->index_sectors_ == 0 || page_size == 0 || this->sector_size_ % page_size != 0 ||
+            this->sector_size_ <= sizeof(SectorHeader) + sizeof(RecordHeader))
+        {
+            return false;
+        }
+
+        const uint32_t sectors = capacity / this->sector_size_;
+        if (sectors < static_cast<uint32_t>(this->index_sectors_) * 2 + 2)
+        {
+            return false;
+        }
+        this->data_sectors_ = min(sectors - static_cast<uint32_t>(this->index_sectors_) * 2, static_cast<uint32_t>(UINT16_MAX));
+
+        const uint32_t copy_size = static_cast<uint32_t>(this->index_sectors_) * this->sector_size_;
+        const uint32_t metadata_size = sizeof(IndexHeader) + static_cast<uint32_t>(UIRB_CORE_IR_CODE_STORE_JOURNAL_ENTRIES) * ENTRY_SIZE;
+        if (copy_size <= metadata_size + ENTRY_SIZE)
+        {
+            return false;
+        }
+        this->table_capacity_ = min((copy_size - metadata_size) / ENTRY_SIZE, static_cast<uint32_t>(UINT16_MAX - 1));
+        return true;
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_SPI_FLASH)
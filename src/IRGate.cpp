@@ -0,0 +1,126 @@
+/**
+ * @file IRGate.cpp
+ * @brief Implementation of the coordination of ADC measurements with IR transmission for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::IRTransmitGate class.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore_IRGate.hpp>
+
+#if defined(UIRB_CORE_IR_TX_GATE)
+namespace
+{
+    volatile bool transmitting = false; /**< A frame is being sent. */
+    volatile uint8_t frame_count = 0; /**< Frames started, wrapping. */
+    volatile uint32_t frame_end_microseconds = 0; /**< `micros()` at the end of the last frame. */
+    uint16_t discarded_samples = 0; /**< Conversions overlapped by a frame. */
+}  // namespace
+
+namespace uirbcore
+{
+    void IRTransmitGate::beginFrame()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        transmitting = true;
+        frame_count++;
+        SREG = oldSREG;
+    }
+
+    void IRTransmitGate::endFrame()
+    {
+        const uint32_t now = micros();
+
+        uint8_t oldSREG = SREG;
+        cli();
+        frame_end_microseconds = now;
+        transmitting = false;
+        SREG = oldSREG;
+    }
+
+    bool IRTransmitGate::isTransmitting()
+    {
+        return transmitting;
+    }
+
+    bool IRTransmitGate::isQuiet()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        const bool busy = transmitting;
+        const uint32_t frame_end = frame_end_microseconds;
+        SREG = oldSREG;
+
+        return !busy && (micros() - frame_end) >= UIRB_CORE_IR_TX_SETTLE_MICROSECONDS;
+    }
+
+    bool IRTransmitGate::beginSample(uint8_t& frame_mark)
+    {
+        frame_mark = frame_count;
+        return IRTransmitGate::isQuiet();
+    }
+
+    bool IRTransmitGate::endSample(const uint8_t frame_mark)
+    {
+        if (frame_mark == frame_count && !transmitting)
+        {
+            return true;
+        }
+        if (discarded_samples < UINT16_MAX)
+        {
+            discarded_samples++;
+        }
+        return false;
+    }
+
+    uint16_t IRTransmitGate::analogReadInGap(const uint8_t pin)
+    {
+        uint8_t frame_mark = 0;
+        uint16_t value = 0;
+        do
+        {
+            while (!IRTransmitGate::beginSample(frame_mark))
+            {
+                yield();
+            }
+            value = analogRead(pin);
+        } while (!IRTransmitGate::endSample(frame_mark));
+        return value;
+    }
+
+    uint16_t IRTransmitGate::getDiscardedSamples()
+    {
+        return discarded_samples;
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_IR_TX_GATE)
@@ -0,0 +1,107 @@
+/**
+ * @file MemoryPlan.cpp
+ * @brief Compile-time SRAM breakdown of the %UIRB system.
+ *
+ * This file checks the @ref uirbcore::MemoryPlan budget in every library build. With @ref UIRB_CORE_SRAM_REPORT,
+ * it also makes the compiler print each entry of the plan as a warning naming the buffer and its size, e.g.
+ * `[with Buffer = uirbcore::sram::TRACE; short unsigned int bytes = 262]`.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore_MemoryPlan.hpp>
+
+#if defined(UIRB_CORE_SRAM_REPORT)
+namespace uirbcore
+{
+    /**
+     * @brief Tags naming the entries of the printed breakdown.
+     */
+    namespace sram
+    {
+        struct SRAM_SIZE;
+        struct CORE_OBJECT;
+        struct SERIAL_QUEUES;
+        struct TRACE;
+        struct PROFILER;
+        struct POST_MORTEM;
+        struct WARM_RESTART;
+        struct PIN_ARBITER;
+        struct TIMER_SLOTS;
+        struct TIMER_WHEEL;
+        struct PIN_CHANGE;
+        struct IR_CODE_STORE;
+        struct STATIC_TOTAL;
+        struct STACK_RESERVE;
+        struct APPLICATION;
+        struct UNPLANNED;
+    }  // namespace sram
+}  // namespace uirbcore
+
+namespace
+{
+    /**
+     * @brief Prints a plan entry through the deprecation warning of its instantiation. Never called.
+     *
+     * @tparam Buffer Tag of @ref uirbcore::sram naming the entry.
+     * @tparam bytes Size of the entry in bytes.
+     */
+    template <typename Buffer, uint16_t bytes>
+    __attribute__((deprecated("UIRB_CORE_SRAM_REPORT, not an error"))) inline void sram_report_entry()
+    {
+    }
+
+    /**
+     * @brief Instantiates one report entry per plan member, in the order of the plan.
+     */
+    __attribute__((unused)) void sram_report()
+    {
+        using uirbcore::MemoryPlan;
+        namespace sram = uirbcore::sram;
+        sram_report_entry<sram::SRAM_SIZE, MemoryPlan::SRAM_BYTES>();
+        sram_report_entry<sram::CORE_OBJECT, MemoryPlan::CORE_OBJECT_BYTES>();
+        sram_report_entry<sram::SERIAL_QUEUES, MemoryPlan::SERIAL_BYTES>();
+        sram_report_entry<sram::TRACE, MemoryPlan::TRACE_BYTES>();
+        sram_report_entry<sram::PROFILER, MemoryPlan::PROFILER_BYTES>();
+        sram_report_entry<sram::POST_MORTEM, MemoryPlan::POST_MORTEM_BYTES>();
+        sram_report_entry<sram::WARM_RESTART, MemoryPlan::WARM_RESTART_BYTES>();
+        sram_report_entry<sram::PIN_ARBITER, MemoryPlan::PIN_ARBITER_BYTES>();
+        sram_report_entry<sram::TIMER_SLOTS, MemoryPlan::TIMER_SLOT_BYTES>();
+        sram_report_entry<sram::TIMER_WHEEL, MemoryPlan::TIMER_WHEEL_BYTES>();
+        sram_report_entry<sram::PIN_CHANGE, MemoryPlan::PIN_CHANGE_BYTES>();
+        sram_report_entry<sram::IR_CODE_STORE, MemoryPlan::IR_CODE_STORE_BYTES>();
+        sram_report_entry<sram::STATIC_TOTAL, MemoryPlan::STATIC_BYTES>();
+        sram_report_entry<sram::STACK_RESERVE, MemoryPlan::STACK_RESERVE_BYTES>();
+        sram_report_entry<sram::APPLICATION, MemoryPlan::APPLICATION_BYTES>();
+        sram_report_entry<sram::UNPLANNED, MemoryPlan::UNPLANNED_BYTES>();
+    }
+}  // namespace
+#endif  // defined(UIRB_CORE_SRAM_REPORT)
@@ -0,0 +1,494 @@
+/**
+ * @file PinArbiter.cpp
+ * @brief Implementation of the shared pin ownership arbiter for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::PinArbiter class. Each shared pin keeps its active holder and at
+ * most one preempted holder, together with the pin state to restore when they release it.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore_PinArbiter.hpp>
+#include <UIRBcore_MemoryPlan.hpp>
+
+#if defined(UIRB_CORE_PIN_ARBITER)
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <string.h>
+
+namespace
+{
+    constexpr uint8_t PIN_COUNT = static_cast<uint8_t>(uirbcore::SharedPin::COUNT);
+    constexpr uint8_t OWNER_COUNT = static_cast<uint8_t>(uirbcore::PinOwner::COUNT);
+
+    /**
+     * @brief Bits of a saved pin state.
+     */
+    enum SavedState : uint8_t
+    {
+        SAVED_DDR = _BV(0), /**< Pin is an output. */
+        SAVED_PORT = _BV(1), /**< Pin is driven high or has its pull-up enabled. */
+        SAVED_PERIPHERAL = _BV(2), /**< `SPE` for SCK, `TXEN0` for TX. */
+        SAVED_UART_INTERRUPT = _BV(3) /**< `UDRIE0` for TX. */
+    };
+
+    /**
+     * @brief Holder of a shared pin.
+     */
+    struct PinHolder
+    {
+        uirbcore::PinOwner owner; /**< Owner, @ref uirbcore::PinOwner::NONE if unused. */
+        uint8_t priority; /**< Claim priority. */
+        uint8_t saved; /**< Pin state before the holder took the pin, see @ref SavedState. */
+        uint32_t since_microseconds; /**< Time of the claim. */
+    };
+
+    /**
+     * @brief Arbitration state of one shared pin.
+     */
+    struct PinSlot
+    {
+        PinHolder active; /**< Owner driving the pin. */
+        PinHolder preempted; /**< Owner waiting for the pin to be given back. */
+    };
+
+    PinSlot slots[PIN_COUNT];
+    uirbcore::PinHoldStats hold_stats[PIN_COUNT][OWNER_COUNT - 1];
+
+    static_assert(sizeof(slots) + sizeof(hold_stats) == uirbcore::MemoryPlan::PIN_ARBITER_BYTES, "Pin arbiter state does not match uirbcore::MemoryPlan");
+
+    /**
+     * @brief Owners preempted since their last @ref uirbcore::PinArbiter::consumePreempted() call, one bit per owner.
+     */
+    volatile uint8_t preempted_owners = 0;
+
+    /**
+     * @brief Default claim priorities, indexed by @ref uirbcore::PinOwner.
+     */
+    const uint8_t DEFAULT_PRIORITIES[OWNER_COUNT] PROGMEM = { 0, 1, 5, 2, 4, 3 };
+
+    const char OWNER_NAME_NONE[] PROGMEM = "NONE";
+    const char OWNER_NAME_STATUS_LED[] PROGMEM = "STATUS_LED";
+    const char OWNER_NAME_IR_RECEIVER[] PROGMEM = "IR_RECEIVER";
+    const char OWNER_NAME_UART[] PROGMEM = "UART";
+    const char OWNER_NAME_SPI[] PROGMEM = "SPI";
+    const char OWNER_NAME_APPLICATION[] PROGMEM = "APPLICATION";
+
+    const char* const OWNER_NAMES[OWNER_COUNT] PROGMEM =
+    {
+        OWNER_NAME_NONE,
+        OWNER_NAME_STATUS_LED,
+        OWNER_NAME_IR_RECEIVER,
+        OWNER_NAME_UART,
+        OWNER_NAME_SPI,
+        OWNER_NAME_APPLICATION
+    };
+
+    const char PIN_NAME_STAT_LED_SCK[] PROGMEM = "STAT_LED_SCK";
+    const char PIN_NAME_IR_RECEIVE_MISO[] PROGMEM = "IR_RECEIVE_MISO";
+    const char PIN_NAME_TX_SLAVE_SELECT[] PROGMEM = "TX_SLAVE_SELECT";
+
+    const char* const PIN_NAMES[PIN_COUNT] PROGMEM =
+    {
+        PIN_NAME_STAT_LED_SCK,
+        PIN_NAME_IR_RECEIVE_MISO,
+        PIN_NAME_TX_SLAVE_SELECT
+    };
+
+    /**
+     * @brief Returns the port bit of a shared pin.
+     */
+    uint8_t pin_bit(const uint8_t pin)
+    {
+        switch (static_cast<uirbcore::SharedPin>(pin))
+        {
+            case uirbcore::SharedPin::STAT_LED_SCK:
+                return _BV(PB5);
+            case uirbcore::SharedPin::IR_RECEIVE_MISO:
+                return _BV(PB4);
+            default:
+                return _BV(PD1);
+        }
+    }
+
+    /**
+     * @brief Captures the current state of a shared pin.
+     */
+    uint8_t capture(const uint8_t pin)
+    {
+        const uint8_t bit = pin_bit(pin);
+        uint8_t saved = 0;
+        if (pin == static_cast<uint8_t>(uirbcore::SharedPin::TX_SLAVE_SELECT))
+        {
+            saved |= (DDRD & bit) ? SAVED_DDR : 0;
+            saved |= (PORTD & bit) ? SAVED_PORT : 0;
+            saved |= (UCSR0B & _BV(TXEN0)) ? SAVED_PERIPHERAL : 0;
+            saved |= (UCSR0B & _BV(UDRIE0)) ? SAVED_UART_INTERRUPT : 0;
+        }
+        else
+        {
+            saved |= (DDRB & bit) ? SAVED_DDR : 0;
+            saved |= (PORTB & bit) ? SAVED_PORT : 0;
+            if (pin == static_cast<uint8_t>(uirbcore::SharedPin::STAT_LED_SCK))
+            {
+                saved |= (SPCR & _BV(SPE)) ? SAVED_PERIPHERAL : 0;
+            }
+        }
+        return saved;
+    }
+
+    /**
+     * @brief Restores a shared pin to a captured state.
+     */
+    void restore(const uint8_t pin, const uint8_t saved)
+    {
+        const uint8_t bit = pin_bit(pin);
+        if (pin == static_cast<uint8_t>(uirbcore::SharedPin::TX_SLAVE_SELECT))
+        {
+            PORTD = (saved & SAVED_PORT) ? (PORTD | bit) : (PORTD & ~bit);
+            DDRD = (saved & SAVED_DDR) ? (DDRD | bit) : (DDRD & ~bit);
+            // Enable the transmitter before its buffer interrupt, so buffered data continues on the pin
+            UCSR0B = (saved & SAVED_PERIPHERAL) ? (UCSR0B | _BV(TXEN0)) : (UCSR0B & ~_BV(TXEN0));
+            UCSR0B = (saved & SAVED_UART_INTERRUPT) ? (UCSR0B | _BV(UDRIE0)) : (UCSR0B & ~_BV(UDRIE0));
+        }
+        else
+        {
+            PORTB = (saved & SAVED_PORT) ? (PORTB | bit) : (PORTB & ~bit);
+            DDRB = (saved & SAVED_DDR) ? (DDRB | bit) : (DDRB & ~bit);
+            if (pin == static_cast<uint8_t>(uirbcore::SharedPin::STAT_LED_SCK))
+            {
+                SPCR = (saved & SAVED_PERIPHERAL) ? (SPCR | _BV(SPE)) : (SPCR & ~_BV(SPE));
+            }
+        }
+    }
+
+    /**
+     * @brief Drains the UART transmitter before a claim takes the TX pin, with the interrupt state of the caller.
+     *
+     * `UDRIE0` is masked first so `Serial` stops feeding the data register, then the data register and shift
+     * register are given up to two frame times to drain. Called before the critical section of a claim, so
+     * Timer0 and the IR capture keep running while waiting.
+     *
+     * @return bool `UDRIE0` was set and is masked now, `Serial` has data queued.
+     */
+    bool drain_uart()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        const bool enabled = (UCSR0B & _BV(TXEN0)) != 0;
+        const bool queued = enabled && (UCSR0B & _BV(UDRIE0));
+        UCSR0B &= ~_BV(UDRIE0);
+        SREG = oldSREG;
+        if (!enabled)
+        {
+            return false;
+        }
+
+        // Two 10-bit frames, the loop takes at least 8 cycles per iteration
+        const uint8_t cycles_per_bit = (UCSR0A & _BV(U2X0)) ? 8 : 16;
+        uint32_t iterations = (static_cast<uint32_t>(UBRR0) + 1U) * cycles_per_bit * 20U / 8U;
+        while ((UCSR0A & (_BV(UDRE0) | _BV(TXC0))) != (_BV(UDRE0) | _BV(TXC0)) && iterations-- > 0)
+        {
+            __asm__ __volatile__ ("nop");
+        }
+        return queued;
+    }
+
+    /**
+     * @brief Checks if `Serial` refilled the data register after @ref drain_uart(), must be called with interrupts
+     * disabled.
+     */
+    bool uart_busy()
+    {
+        return (UCSR0B & _BV(TXEN0)) && ((UCSR0B & _BV(UDRIE0)) || !(UCSR0A & _BV(UDRE0)));
+    }
+
+    /**
+     * @brief Applies the switch-over needed when an owner takes a pin.
+     */
+    void take_over(const uint8_t pin, const uirbcore::PinOwner owner)
+    {
+        if (pin == static_cast<uint8_t>(uirbcore::SharedPin::STAT_LED_SCK) && owner != uirbcore::PinOwner::SPI)
+        {
+            SPCR &= ~_BV(SPE);
+        }
+        else if (pin == static_cast<uint8_t>(uirbcore::SharedPin::TX_SLAVE_SELECT) && owner != uirbcore::PinOwner::UART)
+        {
+            // Drained by claim(), at most a frame written right after is still shifted out by the hardware
+            UCSR0B &= ~_BV(TXEN0);
+        }
+    }
+
+    /**
+     * @brief Adds a finished hold to the statistics.
+     */
+    void record_hold(const uint8_t pin, const PinHolder& holder)
+    {
+        const uint32_t held = micros() - holder.since_microseconds;
+        uirbcore::PinHoldStats& stats = hold_stats[pin][static_cast<uint8_t>(holder.owner) - 1];
+        stats.total_microseconds += held;
+        if (held > stats.max_microseconds)
+        {
+            stats.max_microseconds = held;
+        }
+    }
+
+    /**
+     * @brief Checks if an owner is valid for claims.
+     */
+    bool valid_owner(const uirbcore::PinOwner owner)
+    {
+        return owner != uirbcore::PinOwner::NONE && static_cast<uint8_t>(owner) < OWNER_COUNT;
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    bool PinArbiter::claim(const PinOwner owner, const uint8_t pins, const uint8_t priority)
+    {
+        if (!valid_owner(owner) || pins == 0 || pins >= _BV(PIN_COUNT))
+        {
+            return false;
+        }
+
+        // The transmitter is drained with interrupts enabled, the critical section only checks it stayed idle
+        const uint8_t tx_pin = static_cast<uint8_t>(SharedPin::TX_SLAVE_SELECT);
+        const bool takes_uart = (pins & _BV(tx_pin)) && owner != PinOwner::UART && slots[tx_pin].active.owner != owner;
+        const bool uart_queued = takes_uart && drain_uart();
+
+        uint8_t oldSREG = SREG;
+        cli();
+
+        bool available = !(takes_uart && uart_busy());
+        for (uint8_t pin = 0; available && pin < PIN_COUNT; pin++)
+        {
+            if (!(pins & _BV(pin)))
+            {
+                continue;
+            }
+            const PinSlot& slot = slots[pin];
+            if (slot.active.owner == owner || slot.active.owner == PinOwner::NONE)
+            {
+                continue;
+            }
+            if (slot.preempted.owner != PinOwner::NONE || priority <= slot.active.priority)
+            {
+                available = false;
+            }
+        }
+        if (!available)
+        {
+            if (uart_queued && !(UCSR0B & _BV(UDRIE0)))
+            {
+                UCSR0B |= _BV(UDRIE0); // Serial continues with its queued data
+            }
+            SREG = oldSREG;
+            return false;
+        }
+
+        const uint32_t now = micros();
+        for (uint8_t pin = 0; pin < PIN_COUNT; pin++)
+        {
+            if (!(pins & _BV(pin)))
+            {
+                continue;
+            }
+            PinSlot& slot = slots[pin];
+            if (slot.active.owner == owner)
+            {
+                slot.active.priority = priority;
+                continue;
+            }
+            if (slot.active.owner != PinOwner::NONE)
+            {
+                const uint8_t preempted = static_cast<uint8_t>(slot.active.owner);
+                preempted_owners |= _BV(preempted);
+                PinHoldStats& stats = hold_stats[pin][preempted - 1];
+                if (stats.preemptions < UINT8_MAX)
+                {
+                    stats.preemptions++;
+                }
+                slot.preempted = slot.active;
+            }
+
+            slot.active.owner = owner;
+            slot.active.priority = priority;
+            slot.active.saved = capture(pin);
+            if (pin == tx_pin && uart_queued)
+            {
+                slot.active.saved |= SAVED_UART_INTERRUPT; // Masked by drain_uart()
+            }
+            slot.active.since_microseconds = now;
+            hold_stats[pin][static_cast<uint8_t>(owner) - 1].claims++;
+            take_over(pin, owner);
+        }
+
+        SREG = oldSREG;
+        return true;
+    }
+
+    void PinArbiter::release(const PinOwner owner, const uint8_t pins)
+    {
+        if (!valid_owner(owner))
+        {
+            return;
+        }
+
+        uint8_t oldSREG = SREG;
+        cli();
+
+        for (uint8_t pin = 0; pin < PIN_COUNT; pin++)
+        {
+            if (!(pins & _BV(pin)))
+            {
+                continue;
+            }
+            PinSlot& slot = slots[pin];
+            if (slot.active.owner == owner)
+            {
+                record_hold(pin, slot.active);
+                restore(pin, slot.active.saved);
+                slot.active = slot.preempted;
+                slot.preempted.owner = PinOwner::NONE;
+            }
+            else if (slot.preempted.owner == owner)
+            {
+                // The active holder now restores the state from before the preempted owner
+                record_hold(pin, slot.preempted);
+                slot.active.saved = slot.preempted.saved;
+                slot.preempted.owner = PinOwner::NONE;
+            }
+        }
+
+        SREG = oldSREG;
+    }
+
+    PinOwner PinArbiter::getOwner(const SharedPin pin)
+    {
+        const uint8_t index = static_cast<uint8_t>(pin);
+        return (index < PIN_COUNT) ? slots[index].active.owner : PinOwner::NONE;
+    }
+
+    bool PinArbiter::isOwner(const PinOwner owner, const uint8_t pins)
+    {
+        if (!valid_owner(owner) || pins == 0)
+        {
+            return false;
+        }
+        for (uint8_t pin = 0; pin < PIN_COUNT; pin++)
+        {
+            if ((pins & _BV(pin)) && slots[pin].active.owner != owner)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool PinArbiter::consumePreempted(const PinOwner owner)
+    {
+        if (!valid_owner(owner))
+        {
+            return false;
+        }
+
+        const uint8_t bit = _BV(static_cast<uint8_t>(owner));
+        uint8_t oldSREG = SREG;
+        cli();
+        const bool preempted = preempted_owners & bit;
+        preempted_owners &= ~bit;
+        SREG = oldSREG;
+        return preempted;
+    }
+
+    uint8_t PinArbiter::getDefaultPriority(const PinOwner owner)
+    {
+        const uint8_t index = static_cast<uint8_t>(owner);
+        return (index < OWNER_COUNT) ? pgm_read_byte(&DEFAULT_PRIORITIES[index]) : 0;
+    }
+
+    bool PinArbiter::getStats(const SharedPin pin, const PinOwner owner, PinHoldStats& stats)
+    {
+        const uint8_t index = static_cast<uint8_t>(pin);
+        if (index >= PIN_COUNT || !valid_owner(owner))
+        {
+            return false;
+        }
+
+        uint8_t oldSREG = SREG;
+        cli();
+        stats = hold_stats[index][static_cast<uint8_t>(owner) - 1];
+        SREG = oldSREG;
+        return true;
+    }
+
+    void PinArbiter::resetStats()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        memset(hold_stats, 0, sizeof(hold_stats));
+        SREG = oldSREG;
+    }
+
+    void PinArbiter::dump(Print& output)
+    {
+        output.println(F("pin\towner\tclaims\tpreempted\ttotal_us\tmax_us"));
+        for (uint8_t pin = 0; pin < PIN_COUNT; pin++)
+        {
+            const PinOwner active = PinArbiter::getOwner(static_cast<SharedPin>(pin));
+            output.print(reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&PIN_NAMES[pin])));
+            output.print(F("\tactive="));
+            output.println(reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&OWNER_NAMES[static_cast<uint8_t>(active)])));
+
+            for (uint8_t owner = 1; owner < OWNER_COUNT; owner++)
+            {
+                PinHoldStats stats;
+                PinArbiter::getStats(static_cast<SharedPin>(pin), static_cast<PinOwner>(owner), stats);
+                if (stats.claims == 0)
+                {
+                    continue;
+                }
+
+                output.print('\t');
+                output.print(reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&OWNER_NAMES[owner])));
+                output.print('\t');
+                output.print(stats.claims);
+                output.print('\t');
+                output.print(stats.preemptions);
+                output.print('\t');
+                output.print(stats.total_microseconds);
+                output.print('\t');
+                output.println(stats.max_microseconds);
+            }
+        }
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_PIN_ARBITER)
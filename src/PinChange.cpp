@@ -0,0 +1,195 @@
+/**
+ * @file PinChange.cpp
+ * @brief Implementation of the pin change interrupt dispatcher of the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::PinChangeDispatcher class and defines the `PCINT0_vect`, `PCINT1_vect`
+ * and `PCINT2_vect` interrupt vectors.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore_PinChange.hpp>
+#include <UIRBcore_MemoryPlan.hpp>
+#include <UIRBcore_Profiler.hpp>
+#include <avr/interrupt.h>
+
+#if defined(UIRB_CORE_PCINT_DISPATCHER)
+
+namespace
+{
+    constexpr uint8_t GROUP_COUNT = 3; /**< Pin change groups of the ATmega328P. */
+    constexpr uint8_t PINS_PER_GROUP = 8; /**< Pins of a group, one port. */
+
+    uirbcore::PinChangeHandler handlers[GROUP_COUNT][PINS_PER_GROUP] = {}; /**< Handler per group and port bit. */
+    uint8_t attached_pins[GROUP_COUNT] = {}; /**< Port bits with a handler, per group. */
+    uint8_t last_levels[GROUP_COUNT] = {}; /**< Input port value at the previous interrupt, per group. */
+
+    static_assert(sizeof(handlers) + sizeof(attached_pins) + sizeof(last_levels) == uirbcore::MemoryPlan::PIN_CHANGE_BYTES,
+                  "Pin change dispatcher tables does not match uirbcore::MemoryPlan");
+
+    /**
+     * @brief Arduino pin number of the first port bit of each group.
+     */
+    constexpr uint8_t GROUP_FIRST_PIN[GROUP_COUNT] = { 8, 14, 0 };
+
+    /**
+     * @brief Returns the input port value of a group.
+     */
+    inline uint8_t read_group(const uint8_t group)
+    {
+        switch (group)
+        {
+            case 0:
+                return PINB;
+            case 1:
+                return PINC;
+            default:
+                return PIND;
+        }
+    }
+
+    /**
+     * @brief Calls the handlers of the changed pins of a group.
+     *
+     * @param[in] group Pin change group.
+     * @param[in] level Input port value read on entry of the interrupt.
+     */
+    inline void dispatch(const uint8_t group, const uint8_t level)
+    {
+        uint8_t changed = (level ^ last_levels[group]) & attached_pins[group];
+        last_levels[group] = level;
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+        if (changed == 0)
+        {
+            return;
+        }
+        // A change while masked sets the group flag and raises the interrupt again once unmasked
+        PCICR &= ~_BV(group);
+        sei();
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
+        for (uint8_t bit = 0; changed != 0; bit++, changed >>= 1)
+        {
+            if (changed & 1U)
+            {
+                const uirbcore::PinChangeHandler handler = handlers[group][bit];
+                if (handler != nullptr)
+                {
+                    handler(GROUP_FIRST_PIN[group] + bit, level & _BV(bit));
+                }
+            }
+        }
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+        cli();
+        if (attached_pins[group] != 0)
+        {
+            PCICR |= _BV(group);
+        }
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
+    }
+}  // namespace
+
+ISR(PCINT0_vect)
+{
+    dispatch(0, PINB);
+}
+
+ISR(PCINT1_vect)
+{
+    dispatch(1, PINC);
+}
+
+ISR(PCINT2_vect)
+{
+    const uint8_t level = PIND;
+    UIRB_PROFILE_SCOPE(ISR_PCINT2);
+    dispatch(2, level);
+}
+
+namespace uirbcore
+{
+    bool PinChangeDispatcher::attach(const uint8_t pin, const PinChangeHandler handler)
+    {
+        if (digitalPinToPCICR(pin) == nullptr || handler == nullptr)
+        {
+            return false;
+        }
+
+        const uint8_t group = digitalPinToPCICRbit(pin);
+        const uint8_t mask = _BV(digitalPinToPCMSKbit(pin));
+        bool attached = false;
+
+        uint8_t oldSREG = SREG;
+        cli();
+        if (!(attached_pins[group] & mask))
+        {
+            handlers[group][digitalPinToPCMSKbit(pin)] = handler;
+            attached_pins[group] |= mask;
+            last_levels[group] = (last_levels[group] & ~mask) | (read_group(group) & mask);
+            *digitalPinToPCMSK(pin) |= mask;
+            PCICR |= _BV(group);
+            attached = true;
+        }
+        SREG = oldSREG;
+        return attached;
+    }
+
+    void PinChangeDispatcher::detach(const uint8_t pin)
+    {
+        if (digitalPinToPCICR(pin) == nullptr)
+        {
+            return;
+        }
+
+        const uint8_t group = digitalPinToPCICRbit(pin);
+        const uint8_t mask = _BV(digitalPinToPCMSKbit(pin));
+
+        uint8_t oldSREG = SREG;
+        cli();
+        *digitalPinToPCMSK(pin) &= ~mask;
+        attached_pins[group] &= ~mask;
+        handlers[group][digitalPinToPCMSKbit(pin)] = nullptr;
+        if (attached_pins[group] == 0)
+        {
+            PCICR &= ~_BV(group);
+        }
+        SREG = oldSREG;
+    }
+
+    bool PinChangeDispatcher::isAttached(const uint8_t pin)
+    {
+        if (digitalPinToPCICR(pin) == nullptr)
+        {
+            return false;
+        }
+        return attached_pins[digitalPinToPCICRbit(pin)] & _BV(digitalPinToPCMSKbit(pin));
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_PCINT_DISPATCHER)
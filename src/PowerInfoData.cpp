@@ -45,6 +45,44 @@
 #include <UIRBcore.hpp>
 #include <Utility.hpp>
 
+#if defined(UIRB_CORE_BATTERY_CYCLES) || defined(UIRB_CORE_CHARGE_LOG)
+namespace
+{
+    uint32_t charged_milliamp_seconds = 0; /**< Charge delivered since reset, wrapping. */
+    uint16_t charge_remainder = 0; /**< Integrated charge below one milliamp second, in milliamp milliseconds. */
+    uint16_t last_current_miliamps = 0; /**< Charging current of the previous valid update. */
+    bool last_charging = false; /**< The previous valid update saw the battery charging. */
+    uint32_t last_update_milliseconds = 0; /**< @ref uirbcore::UIRB::getUptimeMilliseconds() of the previous valid update. */
+
+    /**
+     * @brief Adds the charge since the previous valid update to @ref charged_milliamp_seconds.
+     *
+     * @param[in] charging_current_miliamps Charging current sampled now.
+     * @param[in] charging The battery is charging now.
+     */
+    void integrate_charge(const uint16_t charging_current_miliamps, const bool charging)
+    {
+        const uint32_t now = uirbcore::UIRB::getUptimeMilliseconds();
+        if (last_charging)
+        {
+            const uint32_t elapsed = now - last_update_milliseconds;
+            uint32_t seconds = elapsed / 1000U;
+            if (seconds > UINT16_MAX) // Keeps the product below 2^32
+            {
+                seconds = UINT16_MAX;
+            }
+            // Below 2^32: 65535 mA times 999 ms plus a remainder below 1000
+            const uint32_t fraction = static_cast<uint32_t>(last_current_miliamps) * (elapsed % 1000U) + charge_remainder;
+            charged_milliamp_seconds += static_cast<uint32_t>(last_current_miliamps) * seconds + fraction / 1000U;
+            charge_remainder = static_cast<uint16_t>(fraction % 1000U);
+        }
+        last_update_milliseconds = now;
+        last_current_miliamps = charging_current_miliamps;
+        last_charging = charging;
+    }
+}  // namespace
+#endif  // defined(UIRB_CORE_BATTERY_CYCLES) || defined(UIRB_CORE_CHARGE_LOG)
+
 namespace uirbcore
 {
     bool PowerInfoData::update(uint8_t samples)
@@ -56,6 +94,7 @@ namespace uirbcore
         {
             return false;
         }
+        UIRB_PROFILE_SCOPE(POWER_INFO_UPDATE);
 
         // false if any of the sampled data is invalid
         bool sampled_data_valid = true;
@@ -84,14 +123,47 @@ namespace uirbcore
 
             if(sampled_data_valid)
             {
+            #if defined(UIRB_CORE_TRACE)
+                const ChargerState old_charger_state = this->estimated_charger_state_;
+                const BatteryState old_battery_state = this->estimated_battery_state_;
+            #endif  // defined(UIRB_CORE_TRACE)
+
                 this->estimated_charger_state_ = get_estimated_charger_state();
                 this->estimated_battery_state_ = get_estimated_battery_state();
+
+            #if defined(UIRB_CORE_TRACE)
+                if (old_charger_state != this->estimated_charger_state_)
+                {
+                    UIRB_TRACE(CHARGER_STATE, this->estimated_charger_state_);
+                }
+                if (old_battery_state != this->estimated_battery_state_)
+                {
+                    UIRB_TRACE(BATTERY_STATE, this->estimated_battery_state_);
+                }
+            #endif  // defined(UIRB_CORE_TRACE)
+
+            #if defined(UIRB_CORE_BATTERY_CYCLES) || defined(UIRB_CORE_CHARGE_LOG)
+                integrate_charge(this->charging_current_miliamps_, this->isBatteryCharging());
+            #endif  // defined(UIRB_CORE_BATTERY_CYCLES) || defined(UIRB_CORE_CHARGE_LOG)
+            #if defined(UIRB_CORE_BATTERY_CYCLES)
+                BatteryHealth::track_charge(this->estimated_battery_state_);
+            #endif  // defined(UIRB_CORE_BATTERY_CYCLES)
+            #if defined(UIRB_CORE_CHARGE_LOG)
+                ChargeSessionLog::track(this->charging_current_miliamps_, this->estimated_charger_state_);
+            #endif  // defined(UIRB_CORE_CHARGE_LOG)
             }
         }
 
         return sampled_data_valid;
     }
     
+#if defined(UIRB_CORE_BATTERY_CYCLES) || defined(UIRB_CORE_CHARGE_LOG)
+    uint32_t PowerInfoData::getChargedMilliampSeconds()
+    {
+        return charged_milliamp_seconds;
+    }
+#endif  // defined(UIRB_CORE_BATTERY_CYCLES) || defined(UIRB_CORE_CHARGE_LOG)
+
     bool PowerInfoData::isValid() const
     {
         return this->supply_voltage_milivolts_  != UIRB::INVALID_VOLTAGE_MILIVOLTS &&
@@ -0,0 +1,164 @@
+/**
+ * @file PowerMonitor.cpp
+ * @brief Implementation of the adaptive rate power monitor of the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::PowerMonitor class.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+#include <UIRBcore_PowerMonitor.hpp>
+#include <UIRBcore_TimerWheel.hpp>
+
+#if defined(UIRB_CORE_POWER_MONITOR)
+namespace
+{
+    /**
+     * @brief Marks the update as due, run from the Timer1 compare interrupt.
+     *
+     * @param[in] timer Expired timer.
+     */
+    void update_due(uirbcore::SoftTimer& timer);
+
+    uirbcore::SoftTimer update_timer(update_due); /**< Timer of the next update. */
+    volatile bool due = false; /**< An update is due. */
+    bool running = false; /**< Started by @ref uirbcore::PowerMonitor::begin(). */
+    bool has_previous = false; /**< The previous update was valid and can be compared. */
+    uint32_t period_milliseconds = uirbcore::PowerMonitor::MIN_PERIOD_MILLISECONDS; /**< Current period. */
+    uint32_t update_count = 0; /**< Updates since the monitor was started. */
+    uint16_t previous_supply_milivolts = 0; /**< Supply voltage of the previous update. */
+    uint16_t previous_current_miliamps = 0; /**< Charging current of the previous update. */
+    uirbcore::ChargerState previous_charger_state = uirbcore::ChargerState::ERROR; /**< Charger state of the previous update. */
+    uirbcore::BatteryState previous_battery_state = uirbcore::BatteryState::ERROR; /**< Battery state of the previous update. */
+
+    void update_due(uirbcore::SoftTimer&)
+    {
+        due = true;
+    }
+
+    /**
+     * @brief Returns the absolute difference of two readings.
+     *
+     * @param[in] a First reading.
+     * @param[in] b Second reading.
+     * @return uint16_t Difference.
+     */
+    uint16_t difference(const uint16_t a, const uint16_t b)
+    {
+        return (a > b) ? (a - b) : (b - a);
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    void PowerMonitor::begin()
+    {
+        TimerWheel::cancel(update_timer);
+        has_previous = false;
+        period_milliseconds = PowerMonitor::MIN_PERIOD_MILLISECONDS;
+        update_count = 0;
+        running = true;
+        due = true;
+    }
+
+    void PowerMonitor::end()
+    {
+        running = false;
+        TimerWheel::cancel(update_timer);
+        due = false;
+    }
+
+    const PowerInfoData* PowerMonitor::poll(UIRB& uirb)
+    {
+        if (!running || !due)
+        {
+            return nullptr;
+        }
+        due = false;
+
+        const PowerInfoData& power = uirb.getPowerInfo(PowerMonitor::SAMPLES, false);
+        update_count++;
+
+        if (!power.isValid())
+        {
+            // Retry soon, the previous readings stay the reference
+            period_milliseconds = PowerMonitor::MIN_PERIOD_MILLISECONDS;
+        }
+        else
+        {
+            if (!has_previous ||
+                power.estimated_charger_state_ != previous_charger_state ||
+                power.estimated_battery_state_ != previous_battery_state)
+            {
+                period_milliseconds = PowerMonitor::MIN_PERIOD_MILLISECONDS;
+            }
+            else if (difference(power.supply_voltage_milivolts_, previous_supply_milivolts) >= PowerMonitor::VOLTAGE_DELTA_MILIVOLTS ||
+                     difference(power.charging_current_miliamps_, previous_current_miliamps) >= PowerMonitor::CURRENT_DELTA_MILIAMPS)
+            {
+                period_milliseconds /= 2U;
+                if (period_milliseconds < PowerMonitor::MIN_PERIOD_MILLISECONDS)
+                {
+                    period_milliseconds = PowerMonitor::MIN_PERIOD_MILLISECONDS;
+                }
+            }
+            else
+            {
+                period_milliseconds = (period_milliseconds >= PowerMonitor::MAX_PERIOD_MILLISECONDS / 2U) ? PowerMonitor::MAX_PERIOD_MILLISECONDS : (period_milliseconds * 2U);
+            }
+
+            has_previous = true;
+            previous_supply_milivolts = power.supply_voltage_milivolts_;
+            previous_current_miliamps = power.charging_current_miliamps_;
+            previous_charger_state = power.estimated_charger_state_;
+            previous_battery_state = power.estimated_battery_state_;
+        }
+
+        TimerWheel::start(update_timer, period_milliseconds);
+        return &power;
+    }
+
+    void PowerMonitor::requestUpdate()
+    {
+        due = true;
+    }
+
+    uint32_t PowerMonitor::getPeriodMilliseconds()
+    {
+        return period_milliseconds;
+    }
+
+    uint32_t PowerMonitor::getUpdateCount()
+    {
+        return update_count;
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_POWER_MONITOR)
@@ -0,0 +1,208 @@
+/**
+ * @file Profiler.cpp
+ * @brief Implementation of the Timer1-based hot-path profiler for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::Profiler class declared in @ref UIRBcore_Profiler.hpp.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore_Profiler.hpp>
+#include <UIRBcore_MemoryPlan.hpp>
+#include <util/atomic.h>
+#include <avr/power.h>
+
+#if defined(UIRB_CORE_PROFILER)
+namespace
+{
+    constexpr uint8_t PROBE_COUNT = static_cast<uint8_t>(uirbcore::ProfileProbe::COUNT);
+    constexpr uint8_t HISTOGRAM_BUCKETS = sizeof(uirbcore::ProfileStats::histogram);
+
+    uirbcore::ProfileStats profile_stats[PROBE_COUNT];
+
+    static_assert(sizeof(profile_stats) == uirbcore::MemoryPlan::PROFILER_BYTES, "Profiler statistics does not match uirbcore::MemoryPlan");
+
+#if !defined(UIRB_CORE_TIMER_MANAGER)
+    /**
+     * @brief Timer1 clock select bits for @ref UIRB_CORE_PROFILER_PRESCALER.
+     */
+    constexpr uint8_t TIMER1_CLOCK_SELECT =
+    #if UIRB_CORE_PROFILER_PRESCALER == 1
+        _BV(CS10);
+    #elif UIRB_CORE_PROFILER_PRESCALER == 8
+        _BV(CS11);
+    #elif UIRB_CORE_PROFILER_PRESCALER == 64
+        _BV(CS11) | _BV(CS10);
+    #elif UIRB_CORE_PROFILER_PRESCALER == 256
+        _BV(CS12);
+    #else
+        _BV(CS12) | _BV(CS10);
+    #endif
+#endif  // !defined(UIRB_CORE_TIMER_MANAGER)
+
+    const char PROBE_NAME_ADC_BANDGAP[] PROGMEM = "ADC_BANDGAP";
+    const char PROBE_NAME_ADC_PROG[] PROGMEM = "ADC_PROG";
+    const char PROBE_NAME_POWER_INFO_UPDATE[] PROGMEM = "POWER_INFO_UPDATE";
+    const char PROBE_NAME_EEPROM_COMMIT[] PROGMEM = "EEPROM_COMMIT";
+    const char PROBE_NAME_POWER_DOWN[] PROGMEM = "POWER_DOWN";
+    const char PROBE_NAME_ISR_BUTTON_WAKEUP[] PROGMEM = "ISR_BUTTON_WAKEUP";
+    const char PROBE_NAME_ISR_PCINT2[] PROGMEM = "ISR_PCINT2";
+    const char PROBE_NAME_ISR_WDT[] PROGMEM = "ISR_WDT";
+    const char PROBE_NAME_SLEEP[] PROGMEM = "SLEEP";
+
+    const char* const PROBE_NAMES[PROBE_COUNT] PROGMEM =
+    {
+        PROBE_NAME_ADC_BANDGAP,
+        PROBE_NAME_ADC_PROG,
+        PROBE_NAME_POWER_INFO_UPDATE,
+        PROBE_NAME_EEPROM_COMMIT,
+        PROBE_NAME_POWER_DOWN,
+        PROBE_NAME_ISR_BUTTON_WAKEUP,
+        PROBE_NAME_ISR_PCINT2,
+        PROBE_NAME_ISR_WDT,
+        PROBE_NAME_SLEEP
+    };
+}  // namespace
+
+namespace uirbcore
+{
+    bool Profiler::begin()
+    {
+#if defined(UIRB_CORE_TIMER_MANAGER)
+        if (!TimerManager::acquire(HardwareTimer::TIMER1, TimerClient::PROFILER, TimerMode::FREE_RUNNING,
+                                   UIRB_CORE_PROFILER_PRESCALER))
+        {
+            return false;
+        }
+#else
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            power_timer1_enable();
+            TCCR1A = 0; // Normal mode, output compare pins disconnected
+            TCCR1B = TIMER1_CLOCK_SELECT;
+        }
+#endif  // defined(UIRB_CORE_TIMER_MANAGER)
+        Profiler::reset();
+        return true;
+    }
+
+    void Profiler::reset()
+    {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            for (uint8_t i = 0; i < PROBE_COUNT; i++)
+            {
+                profile_stats[i] = ProfileStats();
+                profile_stats[i].min_ticks = UINT16_MAX;
+            }
+        }
+    }
+
+    void Profiler::record(const ProfileProbe probe, const uint16_t ticks)
+    {
+        const uint8_t index = static_cast<uint8_t>(probe);
+        if (index >= PROBE_COUNT)
+        {
+            return;
+        }
+
+        // Base-4 buckets: bucket 0 holds [0, 4), bucket i holds [4^i, 4^(i+1)), the last bucket holds everything longer
+        uint8_t bucket = 0;
+        for (uint16_t remaining = ticks >> 2; remaining != 0 && bucket < (HISTOGRAM_BUCKETS - 1U); remaining >>= 2)
+        {
+            bucket++;
+        }
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            ProfileStats& stats = profile_stats[index];
+            if (stats.count != UINT16_MAX)
+            {
+                stats.count++;
+            }
+            if (ticks < stats.min_ticks)
+            {
+                stats.min_ticks = ticks;
+            }
+            if (ticks > stats.max_ticks)
+            {
+                stats.max_ticks = ticks;
+            }
+            if (stats.histogram[bucket] != UINT8_MAX)
+            {
+                stats.histogram[bucket]++;
+            }
+        }
+    }
+
+    bool Profiler::getStats(const ProfileProbe probe, ProfileStats& stats)
+    {
+        const uint8_t index = static_cast<uint8_t>(probe);
+        if (index >= PROBE_COUNT)
+        {
+            return false;
+        }
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            stats = profile_stats[index];
+        }
+        return true;
+    }
+
+    void Profiler::dump(Print& output)
+    {
+        output.print(F("tick_ns\t"));
+        output.println(Profiler::TICK_NANOSECONDS);
+        output.println(F("probe\tcount\tmin\tmax\t<4\t<16\t<64\t<256\t<1K\t<4K\t<16K\t>=16K"));
+
+        for (uint8_t i = 0; i < PROBE_COUNT; i++)
+        {
+            ProfileStats stats;
+            Profiler::getStats(static_cast<ProfileProbe>(i), stats);
+
+            output.print(reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&PROBE_NAMES[i])));
+            output.print('\t');
+            output.print(stats.count);
+            output.print('\t');
+            output.print(stats.count == 0 ? 0U : stats.min_ticks);
+            output.print('\t');
+            output.print(stats.max_ticks);
+            for (uint8_t bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+            {
+                output.print('\t');
+                output.print(stats.histogram[bucket]);
+            }
+            output.println();
+        }
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_PROFILER)
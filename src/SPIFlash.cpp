@@ -0,0 +1,347 @@
+/**
+ * @file SPIFlash.cpp
+ * @brief Implementation of the JEDEC SPI NOR flash driver and the simulated flash device for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::JedecSPIFlash and @ref uirbcore::SimulatedSPIFlash classes.
+ * The simulated device only depends on the C library, so it can also be compiled on a host.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore_SPIFlash.hpp>
+
+#if defined(UIRB_CORE_SPI_FLASH)
+#include <SPI.h>
+#include <string.h>
+
+namespace
+{
+    /**
+     * @brief JEDEC SPI NOR flash commands.
+     */
+    enum FlashCommand : uint8_t
+    {
+        CMD_PAGE_PROGRAM = 0x02,
+        CMD_READ_DATA = 0x03,
+        CMD_WRITE_DISABLE = 0x04,
+        CMD_READ_STATUS = 0x05,
+        CMD_WRITE_ENABLE = 0x06,
+        CMD_SECTOR_ERASE = 0x20,
+        CMD_RELEASE_POWER_DOWN = 0xAB,
+        CMD_JEDEC_ID = 0x9F,
+        CMD_POWER_DOWN = 0xB9
+    };
+
+    /**
+     * @brief Busy (write in progress) bit of the status register.
+     */
+    constexpr uint8_t STATUS_BUSY = 0x01;
+
+    /**
+     * @brief Maximum page program time in milliseconds, with margin over typical datasheet values (3ms).
+     */
+    constexpr uint16_t PAGE_PROGRAM_TIMEOUT_MILLISECONDS = 10;
+
+    /**
+     * @brief Maximum 4KB sector erase time in milliseconds, with margin over typical datasheet values (400ms).
+     */
+    constexpr uint16_t SECTOR_ERASE_TIMEOUT_MILLISECONDS = 500;
+
+    /**
+     * @brief Smallest and largest supported capacity codes (`2^code` bytes), 64KB to 16MB.
+     */
+    constexpr uint8_t CAPACITY_CODE_MIN = 16;
+    constexpr uint8_t CAPACITY_CODE_MAX = 24;
+
+    /**
+     * @brief SPI settings shared by all transactions.
+     */
+    const SPISettings FLASH_SPI_SETTINGS(uirbcore::JedecSPIFlash::SPI_CLOCK_HZ, MSBFIRST, SPI_MODE0);
+}  // namespace
+
+namespace uirbcore
+{
+    bool JedecSPIFlash::begin()
+    {
+        digitalWrite(this->chip_select_pin_, HIGH);
+        pinMode(this->chip_select_pin_, OUTPUT);
+        SPI.begin();
+
+        this->wakeup();
+        delayMicroseconds(50); // tRES1, release from power-down
+
+        if (!this->select())
+        {
+            return false;
+        }
+        SPI.transfer(CMD_JEDEC_ID);
+        uint32_t id = SPI.transfer(0);
+        id = (id << 8) | SPI.transfer(0);
+        id = (id << 8) | SPI.transfer(0);
+        this->deselect();
+
+        const uint8_t capacity_code = id & 0xFF;
+        if (id == 0 || id == 0xFFFFFFUL || capacity_code < CAPACITY_CODE_MIN || capacity_code > CAPACITY_CODE_MAX)
+        {
+            this->jedec_id_ = 0;
+            this->capacity_ = 0;
+            return false;
+        }
+
+        this->jedec_id_ = id;
+        this->capacity_ = 1UL << capacity_code;
+        return this->wait_ready(SECTOR_ERASE_TIMEOUT_MILLISECONDS);
+    }
+
+    bool JedecSPIFlash::sleep()
+    {
+        return this->command(CMD_POWER_DOWN);
+    }
+
+    bool JedecSPIFlash::wakeup()
+    {
+        return this->command(CMD_RELEASE_POWER_DOWN);
+    }
+
+    bool JedecSPIFlash::read(const uint32_t address, void* data, const uint16_t length)
+    {
+        if (this->capacity_ == 0 || address >= this->capacity_ || length > this->capacity_ - address)
+        {
+            return false;
+        }
+
+        uint8_t* bytes = static_cast<uint8_t*>(data);
+        if (!this->begin_command(CMD_READ_DATA, address))
+        {
+            return false;
+        }
+        for (uint16_t i = 0; i < length; i++)
+        {
+            bytes[i] = SPI.transfer(0xFF);
+        }
+        this->end_command();
+        return true;
+    }
+
+    bool JedecSPIFlash::program(const uint32_t address, const void* data, const uint16_t length)
+    {
+        if (this->capacity_ == 0 || length == 0 || address >= this->capacity_ ||
+            (address % JedecSPIFlash::PAGE_SIZE) + length > JedecSPIFlash::PAGE_SIZE)
+        {
+            return false;
+        }
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        if (!this->command(CMD_WRITE_ENABLE))
+        {
+            return false;
+        }
+        if (!this->begin_command(CMD_PAGE_PROGRAM, address))
+        {
+            // Do not leave the write enable latch set for a stray command
+            this->command(CMD_WRITE_DISABLE);
+            return false;
+        }
+        for (uint16_t i = 0; i < length; i++)
+        {
+            SPI.transfer(bytes[i]);
+        }
+        this->end_command();
+        return this->wait_ready(PAGE_PROGRAM_TIMEOUT_MILLISECONDS);
+    }
+
+    bool JedecSPIFlash::eraseSector(const uint32_t address)
+    {
+        if (this->capacity_ == 0 || address >= this->capacity_)
+        {
+            return false;
+        }
+
+        if (!this->command(CMD_WRITE_ENABLE))
+        {
+            return false;
+        }
+        if (!this->begin_command(CMD_SECTOR_ERASE, address))
+        {
+            // Do not leave the write enable latch set for a stray command
+            this->command(CMD_WRITE_DISABLE);
+            return false;
+        }
+        this->end_command();
+        return this->wait_ready(SECTOR_ERASE_TIMEOUT_MILLISECONDS);
+    }
+
+    bool JedecSPIFlash::wait_ready(const uint16_t timeout_milliseconds)
+    {
+        uint32_t start = millis();
+        uint8_t status = STATUS_BUSY;
+        do
+        {
+            // Pins are released between polls, so higher priority owners can use them during long erases
+            if (this->select())
+            {
+                SPI.transfer(CMD_READ_STATUS);
+                status = SPI.transfer(0xFF);
+                this->deselect();
+            }
+        } while ((status & STATUS_BUSY) && (millis() - start) < timeout_milliseconds);
+
+        return !(status & STATUS_BUSY);
+    }
+
+    bool JedecSPIFlash::command(const uint8_t command)
+    {
+        if (!this->select())
+        {
+            return false;
+        }
+        SPI.transfer(command);
+        this->deselect();
+        return true;
+    }
+
+    bool JedecSPIFlash::begin_command(const uint8_t command, const uint32_t address)
+    {
+        if (!this->select())
+        {
+            return false;
+        }
+        SPI.transfer(command);
+        SPI.transfer(static_cast<uint8_t>(address >> 16));
+        SPI.transfer(static_cast<uint8_t>(address >> 8));
+        SPI.transfer(static_cast<uint8_t>(address));
+        return true;
+    }
+
+    void JedecSPIFlash::end_command()
+    {
+        this->deselect();
+    }
+
+    bool JedecSPIFlash::select()
+    {
+#if defined(UIRB_CORE_PIN_ARBITER)
+        if (!PinArbiter::claim(PinOwner::SPI, this->shared_pins()))
+        {
+            return false;
+        }
+        // The arbiter restores the pin states of the previous owner on release, so the bus is set up on every claim
+        pinMode(this->chip_select_pin_, OUTPUT);
+        pinMode(PIN_SPI_SCK, OUTPUT);
+        SPCR |= _BV(SPE);
+#endif  // defined(UIRB_CORE_PIN_ARBITER)
+        SPI.beginTransaction(FLASH_SPI_SETTINGS);
+        digitalWrite(this->chip_select_pin_, LOW);
+        return true;
+    }
+
+    void JedecSPIFlash::deselect()
+    {
+        digitalWrite(this->chip_select_pin_, HIGH);
+        SPI.endTransaction();
+#if defined(UIRB_CORE_PIN_ARBITER)
+        PinArbiter::release(PinOwner::SPI, this->shared_pins());
+#endif  // defined(UIRB_CORE_PIN_ARBITER)
+    }
+
+#if defined(UIRB_CORE_PIN_ARBITER)
+    uint8_t JedecSPIFlash::shared_pins() const
+    {
+        uint8_t pins = sharedPinMask(SharedPin::STAT_LED_SCK) | sharedPinMask(SharedPin::IR_RECEIVE_MISO);
+        if (this->chip_select_pin_ == PIN_TX)
+        {
+            pins |= sharedPinMask(SharedPin::TX_SLAVE_SELECT);
+        }
+        return pins;
+    }
+#endif  // defined(UIRB_CORE_PIN_ARBITER)
+
+    SimulatedSPIFlash::SimulatedSPIFlash(uint8_t* memory, const uint32_t capacity, const uint16_t sector_size, const uint16_t page_size)
+        : memory_(memory), capacity_(capacity), sector_size_(sector_size), page_size_(page_size)
+    {
+        memset(this->memory_, 0xFF, this->capacity_);
+    }
+
+    bool SimulatedSPIFlash::read(const uint32_t address, void* data, const uint16_t length)
+    {
+        if (address >= this->capacity_ || length > this->capacity_ - address)
+        {
+            return false;
+        }
+
+        memcpy(data, this->memory_ + address, length);
+        return true;
+    }
+
+    bool SimulatedSPIFlash::program(const uint32_t address, const void* data, const uint16_t length)
+    {
+        if (length == 0 || address >= this->capacity_ || (address % this->page_size_) + length > this->page_size_ ||
+            !this->consume_operation())
+        {
+            return false;
+        }
+
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (uint16_t i = 0; i < length; i++)
+        {
+            this->memory_[address + i] &= bytes[i];
+        }
+        this->program_count_++;
+        return true;
+    }
+
+    bool SimulatedSPIFlash::eraseSector(const uint32_t address)
+    {
+        if (address >= this->capacity_ || !this->consume_operation())
+        {
+            return false;
+        }
+
+        memset(this->memory_ + (address - address % this->sector_size_), 0xFF, this->sector_size_);
+        this->erase_count_++;
+        return true;
+    }
+
+    bool SimulatedSPIFlash::consume_operation()
+    {
+        if (this->operations_left_ == SimulatedSPIFlash::NEVER_FAIL)
+        {
+            return true;
+        }
+        if (this->operations_left_ == 0)
+        {
+            return false;
+        }
+        this->operations_left_--;
+        return true;
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_SPI_FLASH)
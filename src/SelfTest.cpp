@@ -0,0 +1,646 @@
+/**
+ * @file SelfTest.cpp
+ * @brief Implementation of the power-on self-test for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::SelfTest class declared in @ref UIRBcore_SelfTest.hpp.
+ *
+ * @details
+ * ADC conversions are started directly through the `ADMUX` and `ADCSRA` registers and polled with a
+ * timeout, as `analogRead()` cannot select the bandgap and ground channels. The IR carrier is generated
+ * with Timer2 in phase correct PWM mode on `OC2B` (@ref PIN_IR_LED), the same way IR libraries do.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+#include <UIRBcore_SelfTest.hpp>
+#include <Utility.hpp>
+
+namespace
+{
+    constexpr uint8_t ADMUX_REFERENCE_AVCC = _BV(REFS0);
+    constexpr uint8_t ADMUX_REFERENCE_1V1 = _BV(REFS1) | _BV(REFS0);
+    constexpr uint8_t ADMUX_CHANNEL_BANDGAP = _BV(MUX3) | _BV(MUX2) | _BV(MUX1);
+    constexpr uint8_t ADMUX_CHANNEL_GND = _BV(MUX3) | _BV(MUX2) | _BV(MUX1) | _BV(MUX0);
+
+    // Keep the ADC clock within 50-200kHz
+    constexpr uint8_t ADCSRA_PRESCALER = (F_CPU > 12000000UL) ? (_BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0)) : (_BV(ADPS2) | _BV(ADPS1));
+
+    constexpr uint16_t ADC_CONVERSION_TIMEOUT_US = 500U;
+    constexpr uint16_t ADC_REFERENCE_SETTLE_TIMEOUT_US = 10000U;
+    constexpr uint8_t ADC_SETTLE_CONVERSIONS_MAX = 8U;
+    constexpr uint8_t ADC_SETTLE_TOLERANCE = 2U;
+    constexpr uint16_t ADC_GND_SAMPLE_MAX = 8U;
+    constexpr uint16_t ADC_BANDGAP_1V1_SAMPLE_MIN = 990U;
+
+    constexpr uint16_t BANDGAP_MILIVOLTS_MIN = 1000U;
+    constexpr uint16_t BANDGAP_MILIVOLTS_MAX = 1200U;
+
+    constexpr uint16_t PIN_IDLE_WINDOW_US = 200U;
+    constexpr uint8_t PIN_DISCHARGE_US = 2U;
+
+    constexpr uint32_t IR_CARRIER_HZ = 38000UL;
+    constexpr uint8_t IR_CARRIER_TOP = static_cast<uint8_t>(F_CPU / 2UL / IR_CARRIER_HZ);
+    constexpr uint16_t IR_LOOPBACK_BURST_US = 600U;
+    constexpr uint16_t IR_LOOPBACK_RESPONSE_US = 400U;
+
+    static_assert(F_CPU / 2UL / IR_CARRIER_HZ <= 0xFFUL, "IR carrier does not fit into Timer2 with prescaler 1");
+
+    /**
+     * @brief Checks of a single input pin, combined as flags.
+     */
+    enum PinCheck : uint8_t
+    {
+        CHECK_IDLE_HIGH = _BV(0), /**< Reads HIGH within @ref PIN_IDLE_WINDOW_US with its idle pull-up. */
+        CHECK_IDLE_LOW = _BV(1), /**< Reads LOW as a plain input (external pulldown). */
+        CHECK_DISCHARGE = _BV(2) /**< Reads LOW right after being driven LOW and released (no pull-up). */
+    };
+
+    /**
+     * @brief Input pin checked by @ref uirbcore::SelfTestItem::INPUT_PINS, in @ref uirbcore::SelfTestReport::stuck_pins bit order.
+     */
+    struct InputPin
+    {
+        uint8_t pin;
+        uint8_t idle_mode;
+        uint8_t checks;
+    };
+
+    constexpr InputPin INPUT_PINS[] = {
+        { PIN_BUTTON_WAKEUP, INPUT_PULLUP, CHECK_IDLE_HIGH | CHECK_DISCHARGE },
+        { PIN_BUTTON_OPTION_1, INPUT_PULLUP, CHECK_IDLE_HIGH | CHECK_DISCHARGE },
+        { PIN_BUTTON_OPTION_2, INPUT_PULLUP, CHECK_IDLE_HIGH | CHECK_DISCHARGE },
+        { PIN_BUTTON_OPTION_3, INPUT_PULLUP, CHECK_IDLE_HIGH | CHECK_DISCHARGE },
+        { PIN_USB_IO3, INPUT_PULLUP, CHECK_DISCHARGE },
+        { PIN_IR_RECEIVE, PIN_IR_RECEIVE_PULLUP ? INPUT_PULLUP : INPUT, CHECK_IDLE_HIGH },
+        { PIN_PULLDOWN_RESISTOR, INPUT, CHECK_IDLE_LOW }
+    };
+
+    static_assert(sizeof(INPUT_PINS) / sizeof(INPUT_PINS[0]) <= 8U, "Stuck pin mask is limited to 8 pins");
+
+    /**
+     * @brief Timer2 registers saved while the IR carrier is generated.
+     */
+    struct Timer2State
+    {
+        uint8_t tccr2a;
+        uint8_t tccr2b;
+        uint8_t ocr2a;
+        uint8_t ocr2b;
+        uint8_t timsk2;
+    };
+
+    /**
+     * @brief Returns microseconds elapsed since @p start, valid for intervals below 65ms.
+     */
+    uint16_t elapsed_since(const uint16_t start)
+    {
+        return static_cast<uint16_t>(micros()) - start;
+    }
+
+    /**
+     * @brief Runs a single ADC conversion of the given `ADMUX` setting.
+     *
+     * @return bool `false` if the conversion did not complete within @ref ADC_CONVERSION_TIMEOUT_US.
+     */
+    bool adc_convert(const uint8_t admux, uint16_t& result)
+    {
+        ADMUX = admux;
+        ADCSRA |= _BV(ADSC);
+        const uint16_t start = static_cast<uint16_t>(micros());
+        while (bit_is_set(ADCSRA, ADSC))
+        {
+            if (elapsed_since(start) > ADC_CONVERSION_TIMEOUT_US)
+            {
+                return false;
+            }
+        }
+        result = ADC;
+        return true;
+    }
+
+    /**
+     * @brief Converts until two consecutive results are within @ref ADC_SETTLE_TOLERANCE.
+     *
+     * @return bool `false` on conversion timeout or if the input did not settle.
+     */
+    bool adc_settle(const uint8_t admux, uint16_t& result)
+    {
+        uint16_t previous = 0;
+        if (!adc_convert(admux, previous))
+        {
+            return false;
+        }
+
+        for (uint8_t i = 0; i < ADC_SETTLE_CONVERSIONS_MAX; i++)
+        {
+            uint16_t current = 0;
+            if (!adc_convert(admux, current))
+            {
+                return false;
+            }
+            if ((current > previous ? current - previous : previous - current) <= ADC_SETTLE_TOLERANCE)
+            {
+                result = current;
+                return true;
+            }
+            previous = current;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Converts until @p accept returns `true` for the result or @ref ADC_REFERENCE_SETTLE_TIMEOUT_US expires.
+     *
+     * Used after switching the reference, as the time the `AREF` pin needs to settle depends on the board.
+     */
+    template <typename Predicate>
+    bool adc_wait_for(const uint8_t admux, uint16_t& result, Predicate accept)
+    {
+        const uint16_t start = static_cast<uint16_t>(micros());
+        do
+        {
+            if (!adc_convert(admux, result))
+            {
+                return false;
+            }
+            if (accept(result))
+            {
+                return true;
+            }
+        } while (elapsed_since(start) < ADC_REFERENCE_SETTLE_TIMEOUT_US);
+        return false;
+    }
+
+    /**
+     * @brief Converts a bandgap sample taken against AVcc to the AVcc voltage in millivolts.
+     */
+    uint16_t avcc_milivolts(const uint16_t bandgap_sample, const uint16_t bandgap_milivolts)
+    {
+        uint32_t milivolts = static_cast<uint32_t>(1024U) * bandgap_milivolts;
+        milivolts += bandgap_sample / 2U;
+        return static_cast<uint16_t>(milivolts / bandgap_sample);
+    }
+
+    /**
+     * @brief Reads the input register of a pin without touching its timer, unlike `digitalRead()`.
+     */
+    bool read_pin(const uint8_t pin)
+    {
+        return *portInputRegister(digitalPinToPort(pin)) & digitalPinToBitMask(pin);
+    }
+
+    /**
+     * @brief Starts a 33% duty cycle carrier on @ref PIN_IR_LED, saving the Timer2 configuration.
+     *
+     * @return bool `false` if Timer2 is held by another @ref uirbcore::TimerManager client.
+     */
+    bool ir_carrier_start(Timer2State& state)
+    {
+#if defined(UIRB_CORE_TIMER_MANAGER) && !defined(UIRB_CORE_RESERVE_TIMER2)
+        if (!uirbcore::TimerManager::acquire(uirbcore::HardwareTimer::TIMER2, uirbcore::TimerClient::SELF_TEST,
+                                             uirbcore::TimerMode::EXCLUSIVE))
+        {
+            return false;
+        }
+#endif  // defined(UIRB_CORE_TIMER_MANAGER) && !defined(UIRB_CORE_RESERVE_TIMER2)
+        state.tccr2a = TCCR2A;
+        state.tccr2b = TCCR2B;
+        state.ocr2a = OCR2A;
+        state.ocr2b = OCR2B;
+        state.timsk2 = TIMSK2;
+
+        digitalWrite(PIN_IR_LED, LOW);
+        pinMode(PIN_IR_LED, OUTPUT);
+
+        TIMSK2 = 0;
+        TCCR2B = 0;
+        TCNT2 = 0;
+        OCR2A = IR_CARRIER_TOP;
+        OCR2B = IR_CARRIER_TOP / 3U;
+        TCCR2A = _BV(COM2B1) | _BV(WGM20); // Phase correct PWM, TOP = OCR2A, non-inverting OC2B
+        TCCR2B = _BV(WGM22) | _BV(CS20);
+        return true;
+    }
+
+    /**
+     * @brief Stops the carrier, turns the IR LED off and restores the Timer2 configuration.
+     */
+    void ir_carrier_stop(const Timer2State& state)
+    {
+        TCCR2B = 0;
+        TCCR2A = 0;
+        digitalWrite(PIN_IR_LED, LOW);
+
+        OCR2A = state.ocr2a;
+        OCR2B = state.ocr2b;
+        TCNT2 = 0;
+        TCCR2A = state.tccr2a & ~(_BV(COM2B1) | _BV(COM2B0)); // Never leave the LED connected to the timer
+        TIMSK2 = state.timsk2;
+        TCCR2B = state.tccr2b;
+#if defined(UIRB_CORE_TIMER_MANAGER) && !defined(UIRB_CORE_RESERVE_TIMER2)
+        uirbcore::TimerManager::release(uirbcore::HardwareTimer::TIMER2, uirbcore::TimerClient::SELF_TEST);
+#endif  // defined(UIRB_CORE_TIMER_MANAGER) && !defined(UIRB_CORE_RESERVE_TIMER2)
+    }
+
+    /**
+     * @brief Returns the name of a test for @ref uirbcore::SelfTest::print().
+     */
+    const __FlashStringHelper* test_name(const uirbcore::SelfTestItem item)
+    {
+        switch (item)
+        {
+            case uirbcore::SelfTestItem::ADC_REFERENCES: return F("ADC_REFERENCES");
+            case uirbcore::SelfTestItem::BANDGAP: return F("BANDGAP");
+            case uirbcore::SelfTestItem::INPUT_PINS: return F("INPUT_PINS");
+            case uirbcore::SelfTestItem::EEPROM_DATA: return F("EEPROM_DATA");
+            case uirbcore::SelfTestItem::IR_LED: return F("IR_LED");
+            case uirbcore::SelfTestItem::IR_LOOPBACK: return F("IR_LOOPBACK");
+            default: return F("UNKNOWN");
+        }
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    const uint16_t SelfTest::TEST_BUDGET_MICROSECONDS[static_cast<uint8_t>(SelfTestItem::COUNT)] = {
+        2U * ADC_REFERENCE_SETTLE_TIMEOUT_US, // ADC_REFERENCES: two reference switches
+        1500U, // BANDGAP
+        2000U, // INPUT_PINS
+        1000U, // EEPROM_DATA
+        1500U, // IR_LED
+        IR_LOOPBACK_BURST_US + IR_LOOPBACK_RESPONSE_US + 500U // IR_LOOPBACK
+    };
+
+    SelfTestReport SelfTest::report_ = {};
+    bool SelfTest::has_run_ = false;
+
+    const SelfTestReport& SelfTest::run(const uint8_t tests)
+    {
+        static bool (*const TESTS[static_cast<uint8_t>(SelfTestItem::COUNT)])(SelfTestReport&) = {
+            SelfTest::test_adc_references,
+            SelfTest::test_bandgap,
+            SelfTest::test_input_pins,
+            SelfTest::test_eeprom_data,
+            SelfTest::test_ir_led,
+            SelfTest::test_ir_loopback
+        };
+
+        SelfTestReport report = {};
+        report.requested = tests & ALL_TESTS;
+    #if defined(AVR_DEBUG)
+        report.requested &= ~(selfTestMask(SelfTestItem::IR_LED) | selfTestMask(SelfTestItem::IR_LOOPBACK));
+    #endif  // defined(AVR_DEBUG)
+
+        const uint8_t oldADMUX = ADMUX;
+        const uint8_t oldADCSRA = ADCSRA;
+        ADCSRA = _BV(ADEN) | ADCSRA_PRESCALER;
+
+        const uint16_t start = static_cast<uint16_t>(micros());
+        for (uint8_t i = 0; i < static_cast<uint8_t>(SelfTestItem::COUNT); i++)
+        {
+            const uint8_t item_mask = static_cast<uint8_t>(1U << i);
+            if (!(report.requested & item_mask))
+            {
+                continue;
+            }
+
+            // Skip this and all following tests once the budget cannot accommodate them
+            if (static_cast<uint32_t>(elapsed_since(start)) + SelfTest::TEST_BUDGET_MICROSECONDS[i] > SelfTest::BUDGET_MICROSECONDS)
+            {
+                break;
+            }
+
+            const uint16_t test_start = static_cast<uint16_t>(micros());
+            const bool passed = TESTS[i](report);
+            report.duration_microseconds[i] = elapsed_since(test_start);
+
+            report.executed |= item_mask;
+            if (!passed)
+            {
+                report.failed |= item_mask;
+            }
+            if (report.duration_microseconds[i] > SelfTest::TEST_BUDGET_MICROSECONDS[i])
+            {
+                report.over_budget |= item_mask;
+            }
+        }
+        report.total_microseconds = elapsed_since(start);
+
+        ADCSRA = oldADCSRA;
+        ADMUX = oldADMUX;
+
+        if (!report.passed())
+        {
+            UIRB_TRACE(ERROR, CoreResult::ERROR_SELF_TEST_FAILED);
+        }
+
+        SelfTest::report_ = report;
+        SelfTest::has_run_ = true;
+        return SelfTest::report_;
+    }
+
+    const SelfTestReport& SelfTest::getReport()
+    {
+        return SelfTest::report_;
+    }
+
+    bool SelfTest::hasRun()
+    {
+        return SelfTest::has_run_;
+    }
+
+    void SelfTest::print(const SelfTestReport& report, Print& output)
+    {
+        for (uint8_t i = 0; i < static_cast<uint8_t>(SelfTestItem::COUNT); i++)
+        {
+            const uint8_t item_mask = static_cast<uint8_t>(1U << i);
+            if (!(report.requested & item_mask))
+            {
+                continue;
+            }
+
+            output.print(F("POST "));
+            output.print(test_name(static_cast<SelfTestItem>(i)));
+            if (!(report.executed & item_mask))
+            {
+                output.println(F(" SKIP"));
+                continue;
+            }
+            output.print((report.failed & item_mask) ? F(" FAIL ") : F(" PASS "));
+            output.print(report.duration_microseconds[i]);
+            output.println((report.over_budget & item_mask) ? F("us OVER BUDGET") : F("us"));
+        }
+
+        output.print(F("POST "));
+        output.print(report.passed() ? F("PASSED ") : F("FAILED "));
+        output.print(report.total_microseconds);
+        output.print(F("us, AVcc "));
+        output.print(report.supply_milivolts);
+        output.print(F("mV, stuck pins 0x"));
+        output.println(report.stuck_pins, HEX);
+    }
+
+    bool SelfTest::test_adc_references(SelfTestReport& report)
+    {
+        (void)report;
+        uint16_t sample = 0;
+
+        // Ground and bandgap against AVcc
+        if (!adc_settle(ADMUX_REFERENCE_AVCC | ADMUX_CHANNEL_GND, sample) || sample > ADC_GND_SAMPLE_MAX)
+        {
+            return false;
+        }
+        uint16_t bandgap_avcc = 0;
+        if (!adc_settle(ADMUX_REFERENCE_AVCC | ADMUX_CHANNEL_BANDGAP, bandgap_avcc) ||
+            bandgap_avcc <= UIRB::ADC_BANDGAP_AVCC_SAMPLE_MIN || bandgap_avcc >= UIRB::ADC_SAMPLE_MAX)
+        {
+            return false;
+        }
+
+        // Bandgap against itself must read full scale once the internal reference settled
+        if (!adc_wait_for(ADMUX_REFERENCE_1V1 | ADMUX_CHANNEL_BANDGAP, sample,
+                          [](const uint16_t value) { return value >= ADC_BANDGAP_1V1_SAMPLE_MIN; }))
+        {
+            return false;
+        }
+        if (!adc_settle(ADMUX_REFERENCE_1V1 | ADMUX_CHANNEL_GND, sample) || sample > ADC_GND_SAMPLE_MAX)
+        {
+            return false;
+        }
+
+        // Back to AVcc, the bandgap reading has to return to where it was
+        return adc_wait_for(ADMUX_REFERENCE_AVCC | ADMUX_CHANNEL_BANDGAP, sample,
+                            [bandgap_avcc](const uint16_t value) {
+                                return (value > bandgap_avcc ? value - bandgap_avcc : bandgap_avcc - value) <= ADC_SETTLE_TOLERANCE;
+                            });
+    }
+
+    bool SelfTest::test_bandgap(SelfTestReport& report)
+    {
+        const uint16_t bandgap_milivolts = UIRB::getInstance().getInternalBandgapReferenceVoltageMilivolts();
+        if (bandgap_milivolts < BANDGAP_MILIVOLTS_MIN || bandgap_milivolts > BANDGAP_MILIVOLTS_MAX)
+        {
+            return false;
+        }
+
+        uint16_t sample = 0;
+        if (!adc_settle(ADMUX_REFERENCE_AVCC | ADMUX_CHANNEL_BANDGAP, sample) || sample <= UIRB::ADC_BANDGAP_AVCC_SAMPLE_MIN)
+        {
+            return false;
+        }
+
+        report.supply_milivolts = avcc_milivolts(sample, bandgap_milivolts);
+        return report.supply_milivolts >= UIRB::AVCC_MILIVOLTS_8MHZ_MIN && report.supply_milivolts <= UIRB::AVCC_MILIVOLTS_MAX;
+    }
+
+    bool SelfTest::test_input_pins(SelfTestReport& report)
+    {
+        // Driving the pins must not be mistaken for a wakeup or user event
+        const uint8_t oldSREG = SREG;
+        cli();
+        const uint8_t oldEIMSK = EIMSK;
+        const uint8_t oldPCICR = PCICR;
+        EIMSK = 0;
+        PCICR = 0;
+        SREG = oldSREG;
+
+        report.stuck_pins = 0;
+        for (uint8_t i = 0; i < sizeof(INPUT_PINS) / sizeof(INPUT_PINS[0]); i++)
+        {
+            const InputPin& input = INPUT_PINS[i];
+            const uint8_t oldMode = getPinMode(input.pin);
+            const uint8_t oldState = read_pin(input.pin);
+            bool stuck = false;
+
+            if (input.checks & CHECK_IDLE_HIGH)
+            {
+                pinMode(input.pin, input.idle_mode);
+                bool high = false;
+                const uint16_t start = static_cast<uint16_t>(micros());
+                do
+                {
+                    high = read_pin(input.pin);
+                } while (!high && elapsed_since(start) < PIN_IDLE_WINDOW_US);
+                stuck |= !high;
+            }
+
+            if (input.checks & CHECK_IDLE_LOW)
+            {
+                pinMode(input.pin, INPUT);
+                delayMicroseconds(PIN_DISCHARGE_US);
+                stuck |= read_pin(input.pin);
+            }
+
+            if (input.checks & CHECK_DISCHARGE)
+            {
+                // INPUT first clears the pull-up, so the pin is never driven HIGH
+                pinMode(input.pin, INPUT);
+                pinMode(input.pin, OUTPUT);
+                delayMicroseconds(PIN_DISCHARGE_US);
+                pinMode(input.pin, INPUT);
+                delayMicroseconds(PIN_DISCHARGE_US);
+                stuck |= read_pin(input.pin);
+            }
+
+            if (oldMode == OUTPUT)
+            {
+                digitalWrite(input.pin, oldState);
+            }
+            if (oldMode != INVALID_PIN_MODE)
+            {
+                pinMode(input.pin, oldMode);
+            }
+
+            if (stuck)
+            {
+                report.stuck_pins |= static_cast<uint8_t>(1U << i);
+            }
+        }
+
+        cli();
+        EIFR = _BV(INTF1) | _BV(INTF0);
+        PCIFR = _BV(PCIF2) | _BV(PCIF1) | _BV(PCIF0);
+        EIMSK = oldEIMSK;
+        PCICR = oldPCICR;
+        SREG = oldSREG;
+
+        return report.stuck_pins == 0;
+    }
+
+    bool SelfTest::test_eeprom_data(SelfTestReport& report)
+    {
+        (void)report;
+        const eeprom::EEPROMDataManager& data = UIRB::getInstance().eepromDataManager_;
+
+        if (!data.hardware_version_matches() ||
+            data.get_charger_prog_resistor_ohms() == eeprom::EEPROMDataManager::INVALID_CHARGER_PROG_RESISTANCE ||
+            data.get_bandgap_reference_milivolts() < BANDGAP_MILIVOLTS_MIN ||
+            data.get_bandgap_reference_milivolts() > BANDGAP_MILIVOLTS_MAX)
+        {
+            return false;
+        }
+
+    #if !defined(UIRB_EEPROM_BYPASS_DEBUG)
+        // Unstable cells show up as differences between two consecutive reads
+        eeprom::EEPROMData first;
+        eeprom::EEPROMData second;
+        eeprom::EEPROMDataManager::read_from_eeprom(first);
+        eeprom::EEPROMDataManager::read_from_eeprom(second);
+        if (first != second || first.hardware_version.version_byte != eeprom::UIRB_HW_VER.version_byte)
+        {
+            return false;
+        }
+    #endif  // !defined(UIRB_EEPROM_BYPASS_DEBUG)
+
+        return true;
+    }
+
+    bool SelfTest::test_ir_led(SelfTestReport& report)
+    {
+        const uint16_t bandgap_milivolts = UIRB::getInstance().getInternalBandgapReferenceVoltageMilivolts();
+
+        uint16_t idle_sample = 0;
+        if (!adc_settle(ADMUX_REFERENCE_AVCC | ADMUX_CHANNEL_BANDGAP, idle_sample) || idle_sample <= UIRB::ADC_BANDGAP_AVCC_SAMPLE_MIN)
+        {
+            return false;
+        }
+
+        Timer2State timer2;
+        if (!ir_carrier_start(timer2))
+        {
+            return false;
+        }
+
+        // The driver input must follow the carrier, a shorted pin stays at one level
+        bool seen_high = false;
+        bool seen_low = false;
+        for (uint8_t i = 0; i < 64U && !(seen_high && seen_low); i++)
+        {
+            if (read_pin(PIN_IR_LED))
+            {
+                seen_high = true;
+            }
+            else
+            {
+                seen_low = true;
+            }
+        }
+
+        uint16_t burst_sample = 0;
+        const bool converted = adc_convert(ADMUX_REFERENCE_AVCC | ADMUX_CHANNEL_BANDGAP, burst_sample);
+
+        ir_carrier_stop(timer2);
+
+        if (!converted || burst_sample <= UIRB::ADC_BANDGAP_AVCC_SAMPLE_MIN)
+        {
+            return false;
+        }
+
+        const uint16_t idle_milivolts = avcc_milivolts(idle_sample, bandgap_milivolts);
+        const uint16_t burst_milivolts = avcc_milivolts(burst_sample, bandgap_milivolts);
+        report.ir_droop_milivolts = (idle_milivolts > burst_milivolts) ? (idle_milivolts - burst_milivolts) : 0U;
+
+        return seen_high && seen_low && report.ir_droop_milivolts <= SelfTest::IR_DROOP_MAX_MV;
+    }
+
+    bool SelfTest::test_ir_loopback(SelfTestReport& report)
+    {
+        (void)report;
+
+        // Ambient IR activity makes the result meaningless
+        if (!read_pin(PIN_IR_RECEIVE))
+        {
+            return false;
+        }
+
+        Timer2State timer2;
+        bool detected = false;
+        if (!ir_carrier_start(timer2))
+        {
+            return false;
+        }
+        uint16_t start = static_cast<uint16_t>(micros());
+        while (!detected && elapsed_since(start) < IR_LOOPBACK_BURST_US)
+        {
+            detected = !read_pin(PIN_IR_RECEIVE);
+        }
+        ir_carrier_stop(timer2);
+
+        // The receiver output lags the burst by several carrier periods
+        start = static_cast<uint16_t>(micros());
+        while (!detected && elapsed_since(start) < IR_LOOPBACK_RESPONSE_US)
+        {
+            detected = !read_pin(PIN_IR_RECEIVE);
+        }
+        return detected;
+    }
+}  // namespace uirbcore
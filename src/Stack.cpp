@@ -0,0 +1,137 @@
+/**
+ * @file Stack.cpp
+ * @brief Implementation of the stack painting and high-water mark measurement for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::StackMonitor class and the `.init3` hook painting the free RAM.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore_Defs.h>
+#include <UIRBcore_Stack.hpp>
+
+#if defined(UIRB_CORE_STACK_MONITOR)
+/**
+ * @brief Start of the heap, right after `.noinit`, defined by the linker script.
+ */
+extern uint8_t __heap_start;
+
+/**
+ * @brief Top of the heap maintained by `malloc()`, `nullptr` before the first allocation.
+ */
+extern uint8_t* __brkval;
+
+extern "C" void uirb_stack_paint() __attribute__((naked, used, section(".init3")));
+
+/**
+ * @brief Fills the RAM from the start of the heap up to the stack pointer with @ref uirbcore::StackMonitor::CANARY.
+ *
+ * Runs from `.init3`, after the stack pointer is set in `.init2`. The `.init` sections are entered by falling
+ * through, so nothing is on the stack yet and all RAM up to `RAMEND` is painted.
+ */
+void uirb_stack_paint()
+{
+    for (uint8_t* address = &__heap_start; address <= reinterpret_cast<uint8_t*>(SP); address++)
+    {
+        *address = uirbcore::StackMonitor::CANARY;
+    }
+}
+
+namespace
+{
+    /**
+     * @brief Returns the first address above the heap.
+     *
+     * @return uint8_t* `__brkval`, or `&__heap_start` if `malloc()` was never used.
+     */
+    uint8_t* heap_top()
+    {
+        return (__brkval != nullptr) ? __brkval : &__heap_start;
+    }
+
+    /**
+     * @brief Finds the lowest address written by the stack.
+     *
+     * @return uint8_t* First byte above the heap which does not hold the canary, at most the current stack pointer.
+     */
+    uint8_t* lowest_written()
+    {
+        uint8_t* address = heap_top();
+        const uint8_t* const stack_pointer = reinterpret_cast<uint8_t*>(SP);
+        while (address < stack_pointer && *address == uirbcore::StackMonitor::CANARY)
+        {
+            address++;
+        }
+        return address;
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    uint16_t StackMonitor::getPeakStackBytes()
+    {
+        return static_cast<uint16_t>(reinterpret_cast<uint8_t*>(RAMEND) - lowest_written());
+    }
+
+    uint16_t StackMonitor::getUnusedBytes()
+    {
+        return static_cast<uint16_t>(lowest_written() - heap_top());
+    }
+
+    uint16_t StackMonitor::getFreeBytes()
+    {
+        return static_cast<uint16_t>(reinterpret_cast<uint8_t*>(SP) - heap_top());
+    }
+
+    void StackMonitor::resetPeak()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        // The byte at SP is free, everything above it belongs to the frames of the callers
+        const uint8_t* const stack_pointer = reinterpret_cast<uint8_t*>(SP);
+        for (uint8_t* address = heap_top(); address <= stack_pointer; address++)
+        {
+            *address = StackMonitor::CANARY;
+        }
+        SREG = oldSREG;
+    }
+
+    void StackMonitor::dump(Print& output)
+    {
+        output.print(F("peak\t"));
+        output.println(StackMonitor::getPeakStackBytes());
+        output.print(F("unused\t"));
+        output.println(StackMonitor::getUnusedBytes());
+        output.print(F("free\t"));
+        output.println(StackMonitor::getFreeBytes());
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_STACK_MONITOR)
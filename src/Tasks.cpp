@@ -0,0 +1,175 @@
+/**
+ * @file Tasks.cpp
+ * @brief Implementation of the resumable library tasks of the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::StatusLedPatternTask and @ref uirbcore::BandgapSampleTask classes.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+#include <UIRBcore_Tasks.hpp>
+#include <UIRBcore_IRGate.hpp>
+#include <Utility.hpp>
+
+namespace uirbcore
+{
+    const uint16_t StatusLedPatternTask::LOW_BATTERY_PATTERN[StatusLedPatternTask::LOW_BATTERY_PATTERN_LENGTH] PROGMEM =
+    {
+        500, // Pause
+        50, 200, // Dot
+        200, 200, // Dash
+        50, 200, // Dot
+        50, 500 // Dot, pause
+    };
+
+    TaskStatus StatusLedPatternTask::step()
+    {
+        UIRB_TASK_BEGIN(this->coroutine_);
+#if defined(UIRB_CORE_PIN_ARBITER)
+        if (!PinArbiter::claim(PinOwner::STATUS_LED, sharedPinMask(SharedPin::STAT_LED_SCK)))
+        {
+            UIRB_TASK_EXIT(this->coroutine_);
+        }
+#endif  // defined(UIRB_CORE_PIN_ARBITER)
+        this->old_mode_ = getPinMode(PIN_STAT_LED);
+        this->old_state_ = digitalRead(PIN_STAT_LED);
+        if (this->old_mode_ != OUTPUT)
+        {
+            pinMode(PIN_STAT_LED, OUTPUT);
+        }
+
+        for (this->index_ = 0; this->index_ < this->length_; this->index_++)
+        {
+            digitalWrite(PIN_STAT_LED, (this->index_ & 1U) ? HIGH : LOW);
+            UIRB_TASK_DELAY(this->coroutine_, pgm_read_word(&this->pattern_[this->index_]));
+        }
+        digitalWrite(PIN_STAT_LED, LOW);
+
+        if (this->old_mode_ != INVALID_PIN_MODE)
+        {
+            pinMode(PIN_STAT_LED, this->old_mode_);
+            if (this->old_mode_ == OUTPUT)
+            {
+                digitalWrite(PIN_STAT_LED, this->old_state_);
+            }
+        }
+#if defined(UIRB_CORE_PIN_ARBITER)
+        PinArbiter::release(PinOwner::STATUS_LED, sharedPinMask(SharedPin::STAT_LED_SCK));
+#endif  // defined(UIRB_CORE_PIN_ARBITER)
+        UIRB_TASK_END(this->coroutine_);
+    }
+
+    bool BandgapSampleTask::selectBandgapInput()
+    {
+        ADCSRA |= bit (ADPS0) |  bit (ADPS1) | bit (ADPS2);  // Prescaler of 128
+        if (ADMUX == BandgapSampleTask::ADMUX_BANDGAP)
+        {
+            return false;
+        }
+        // wiring library applies 0x07 mask to MUX[3..0] turning it into MUX[2..0] (ADMUX register)
+        // analogReference() and analogRead() Can set REFS1/REFS0 but mask in analogRead
+        // does not allow setting of MUX3 bit required for any other Single Ended Input
+        // that is not ADC channel or temperature sensor. Vbg => MUX[3..0] = 0b1110
+        ADMUX = BandgapSampleTask::ADMUX_BANDGAP; // sets `DEFAULT` analog reference and 1v1 as analog input
+        return true;
+    }
+
+    TaskStatus BandgapSampleTask::step()
+    {
+        UIRB_TASK_BEGIN(this->coroutine_);
+        if (this->samples_ == 0)
+        {
+            UIRB_TASK_EXIT(this->coroutine_);
+        }
+
+#if !defined(UIRB_CORE_IR_TX_GATE)
+        // Make sure that the IR LED is off
+        digitalWrite(PIN_IR_LED, LOW);
+#endif  // !defined(UIRB_CORE_IR_TX_GATE)
+
+        this->old_adc_reference_ = getAnalogReference();
+        this->old_adcsra_ = ADCSRA;
+
+        // Read 1.1V reference against AVcc manually. Do first conversion with 1.1V reference
+        BandgapSampleTask::selectBandgapInput();
+        ADCSRA |= _BV(ADSC); // Convert
+        UIRB_TASK_WAIT_UNTIL(this->coroutine_, bit_is_clear(ADCSRA, ADSC)); // Wait for conversion to complete
+        UIRB_TASK_DELAY(this->coroutine_, UIRB::ADC_VREF_SETTLE_DELAY_MS); // Wait for Vref to settle
+
+        for (this->sample_index_ = 0; this->sample_index_ < this->samples_; this->sample_index_++)
+        {
+            // delay all but first sample
+            if (this->sample_index_ > 0)
+            {
+                UIRB_TASK_DELAY(this->coroutine_, UIRB::ADC_SAMPLE_DELAY_MS);
+            }
+            for (;;)
+            {
+#if defined(UIRB_CORE_IR_TX_GATE)
+                // Convert in a gap between IR frames, again if a frame started meanwhile
+                UIRB_TASK_WAIT_UNTIL(this->coroutine_, IRTransmitGate::beginSample(this->frame_mark_));
+#endif  // defined(UIRB_CORE_IR_TX_GATE)
+                // Other ADC users may have switched the input while the task waited
+                if (BandgapSampleTask::selectBandgapInput())
+                {
+                    ADCSRA |= _BV(ADSC); // Convert and discard
+                    UIRB_TASK_WAIT_UNTIL(this->coroutine_, bit_is_clear(ADCSRA, ADSC)); // Wait for conversion to complete
+                    UIRB_TASK_DELAY(this->coroutine_, UIRB::ADC_VREF_SETTLE_DELAY_MS); // Wait for Vref to settle
+                    continue;
+                }
+                ADCSRA |= _BV(ADSC); // Convert
+                UIRB_TASK_WAIT_UNTIL(this->coroutine_, bit_is_clear(ADCSRA, ADSC)); // Wait for conversion to complete
+                // An input switched during the conversion comes with another user's conversion and result
+                if (ADMUX == BandgapSampleTask::ADMUX_BANDGAP
+#if defined(UIRB_CORE_IR_TX_GATE)
+                    && IRTransmitGate::endSample(this->frame_mark_)
+#endif  // defined(UIRB_CORE_IR_TX_GATE)
+                   )
+                {
+                    break;
+                }
+            }
+            // ADC macro takes care of reading ADC register.
+            // avr-gcc implements the proper reading order: ADCL is read first.
+            this->sample_sum_ += ADC;
+        }
+        this->sample_sum_ += (this->samples_ / static_cast<uint8_t>(2U)); // https://stackoverflow.com/a/2422723
+        this->result_ = static_cast<uint16_t>(this->sample_sum_ / this->samples_);
+
+        ADCSRA = this->old_adcsra_;
+        if (this->old_adc_reference_ != INVALID_ANALOG_REF && this->old_adc_reference_ != DEFAULT) // default was already used by this task
+        {
+            setAnalogReference(this->old_adc_reference_);
+        }
+        UIRB_TASK_END(this->coroutine_);
+    }
+}  // namespace uirbcore
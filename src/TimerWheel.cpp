@@ -0,0 +1,412 @@
+/**
+ * @file TimerWheel.cpp
+ * @brief Implementation of the hierarchical software timer wheel for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::TimerWheel class. Slots are intrusive lists of
+ * @ref uirbcore::SoftTimer objects, each timer keeping a pointer to the link pointing at it, so it can be
+ * unlinked without knowing its slot.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+#include <UIRBcore_TimerWheel.hpp>
+#include <UIRBcore_MemoryPlan.hpp>
+
+#if defined(UIRB_CORE_TIMER_WHEEL)
+#include <avr/io.h>
+
+namespace
+{
+    constexpr uint8_t LEVELS = UIRB_CORE_TIMER_WHEEL_LEVELS;
+    constexpr uint8_t SLOTS = uirbcore::TimerWheel::SLOTS_PER_LEVEL;
+    constexpr uint8_t SLOT_BITS = 4;
+    constexpr uint8_t SLOT_MASK = SLOTS - 1U;
+
+    static_assert(SLOTS == (1U << SLOT_BITS), "Slot index is taken from 4 bits of the wheel time");
+
+    /**
+     * @brief First delay not fitting into the top level. Timers further away are parked at the horizon.
+     */
+    constexpr uint32_t HORIZON = 1UL << (SLOT_BITS * LEVELS);
+
+    /**
+     * @brief Timer1 counts per second. Counts per millisecond are not integral for the prescalers 256 and 1024.
+     */
+    constexpr uint32_t TIMER1_COUNTS_PER_SECOND = F_CPU / UIRB_CORE_TIMER1_SHARED_PRESCALER;
+
+    /**
+     * @brief Longest compare distance, half the counter range. Later events are reached in several steps.
+     */
+    constexpr uint32_t MAX_COMPARE_COUNTS = 0x8000UL;
+
+    /**
+     * @brief Longest time programmed into the compare channel at once.
+     */
+    constexpr uint32_t MAX_COMPARE_MILLISECONDS = MAX_COMPARE_COUNTS * 1000UL / TIMER1_COUNTS_PER_SECOND;
+
+    /**
+     * @brief Shortest compare distance, about 16µs, so the match is not passed before the register is written.
+     */
+    constexpr uint16_t MIN_COMPARE_COUNTS = static_cast<uint16_t>(TIMER1_COUNTS_PER_SECOND / 62500UL) + 2U;
+
+    static_assert(MAX_COMPARE_MILLISECONDS >= 1U, "Timer1 prescaler too small for a 1ms wheel resolution");
+
+    /**
+     * @brief Slot list heads, indexed by level and slot.
+     */
+    uirbcore::SoftTimer* slots[LEVELS][SLOTS];
+
+    static_assert(sizeof(slots) == uirbcore::MemoryPlan::TIMER_WHEEL_BYTES, "Timer wheel slots does not match uirbcore::MemoryPlan");
+
+    /**
+     * @brief Non-empty slots of each level, one bit per slot.
+     */
+    uint16_t occupied[LEVELS];
+
+    uint32_t wheel_time = 0; /**< Wheel time processed last. All timers due until then have run. */
+    uint32_t next_event = 0; /**< Wheel time of the next slot to process, valid if @ref has_next_event. */
+    bool has_next_event = false; /**< At least one timer is linked. */
+    bool in_service = false; /**< Timers are being processed, starts from callbacks do not touch the hardware. */
+
+    /**
+     * @brief Signed distance between two wheel times, valid across the 32-bit wrap.
+     */
+    inline int32_t time_difference(const uint32_t a, const uint32_t b)
+    {
+        return static_cast<int32_t>(a - b);
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    bool TimerWheel::begin()
+    {
+        if (!TimerManager::acquire(HardwareTimer::TIMER1, TimerClient::SCHEDULER, TimerMode::FREE_RUNNING,
+                                   UIRB_CORE_TIMER1_SHARED_PRESCALER))
+        {
+            return false;
+        }
+
+        // A repeated begin() keeps the running timers
+        TimerManager::detach(TimerVector::TIMER1_COMPA, TimerClient::SCHEDULER);
+        if (!TimerManager::attach(TimerVector::TIMER1_COMPA, TimerClient::SCHEDULER, TimerWheel::service, true))
+        {
+            return false;
+        }
+
+        uint8_t oldSREG = SREG;
+        cli();
+        if (!has_next_event)
+        {
+            wheel_time = TimerWheel::now();
+        }
+        TimerWheel::program_compare();
+        SREG = oldSREG;
+        return true;
+    }
+
+    void TimerWheel::start(SoftTimer& timer, const uint32_t delay_milliseconds, const uint32_t period_milliseconds)
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+
+        if (timer.isActive())
+        {
+            TimerWheel::unlink(timer);
+        }
+
+        const uint32_t current = TimerWheel::now();
+        if (!in_service && (!has_next_event || time_difference(next_event, current) > 0))
+        {
+            // No slot is due before the current time, so the wheel can skip ahead without processing
+            wheel_time = current;
+        }
+
+        timer.expiry_milliseconds_ = current + delay_milliseconds;
+        if (time_difference(timer.expiry_milliseconds_, wheel_time) <= 0)
+        {
+            timer.expiry_milliseconds_ = wheel_time + 1U;
+        }
+        timer.period_milliseconds_ = period_milliseconds;
+
+        const uint32_t slot_time = TimerWheel::link(timer);
+        if (!has_next_event || time_difference(slot_time, next_event) < 0)
+        {
+            next_event = slot_time;
+            has_next_event = true;
+            if (!in_service)
+            {
+                TimerWheel::program_compare();
+            }
+        }
+
+        SREG = oldSREG;
+    }
+
+    void TimerWheel::cancel(SoftTimer& timer)
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        if (timer.isActive())
+        {
+            TimerWheel::unlink(timer);
+        }
+        // Also stops a periodic timer cancelled from its own callback
+        timer.period_milliseconds_ = 0;
+        SREG = oldSREG;
+        // The compare channel is left as it is, an event for an emptied slot does nothing
+    }
+
+    uint32_t TimerWheel::now()
+    {
+        return UIRB::getUptimeMilliseconds();
+    }
+
+    uint32_t TimerWheel::getMillisecondsToNextExpiry()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        uint32_t remaining = TimerWheel::NO_EXPIRY;
+        if (has_next_event)
+        {
+            const int32_t difference = time_difference(next_event, TimerWheel::now());
+            remaining = (difference > 0) ? static_cast<uint32_t>(difference) : 0U;
+        }
+        SREG = oldSREG;
+        return remaining;
+    }
+
+    uint32_t TimerWheel::link(SoftTimer& timer)
+    {
+        uint32_t when = timer.expiry_milliseconds_;
+        uint32_t delay = when - wheel_time;
+        if (time_difference(when, wheel_time) < 0)
+        {
+            when = wheel_time;
+            delay = 0;
+        }
+        else if (delay >= HORIZON)
+        {
+            when = wheel_time + HORIZON - 1U;
+            delay = HORIZON - 1U;
+        }
+
+        uint8_t level = 0;
+        while (level < LEVELS - 1U && delay >= (1UL << (SLOT_BITS * (level + 1U))))
+        {
+            level++;
+        }
+
+        const uint8_t shift = SLOT_BITS * level;
+        const uint8_t slot = static_cast<uint8_t>(when >> shift) & SLOT_MASK;
+        SoftTimer*& head = slots[level][slot];
+
+        timer.next_ = head;
+        timer.pprev_ = &head;
+        if (head != nullptr)
+        {
+            head->pprev_ = &timer.next_;
+        }
+        head = &timer;
+        occupied[level] |= _BV(slot);
+
+        // Level 0 slots are processed at the expiry, higher levels at the start of the slot
+        return (when >> shift) << shift;
+    }
+
+    void TimerWheel::unlink(SoftTimer& timer)
+    {
+        SoftTimer** const pprev = timer.pprev_;
+        *pprev = timer.next_;
+        if (timer.next_ != nullptr)
+        {
+            timer.next_->pprev_ = pprev;
+        }
+        timer.next_ = nullptr;
+        timer.pprev_ = nullptr;
+
+        // Timers unlinked from a slot head may empty the slot, detached lists are not part of the wheel
+        SoftTimer** const first = &slots[0][0];
+        if (*pprev == nullptr && pprev >= first && pprev < first + (LEVELS * SLOTS))
+        {
+            const uint8_t index = static_cast<uint8_t>(pprev - first);
+            occupied[index / SLOTS] &= ~_BV(index % SLOTS);
+        }
+    }
+
+    void TimerWheel::run_event(const uint32_t event)
+    {
+        wheel_time = event;
+
+        // Move timers down first, a timer reaching its expiry lands in the level 0 slot processed below
+        for (uint8_t level = LEVELS - 1U; level > 0; level--)
+        {
+            const uint8_t shift = SLOT_BITS * level;
+            const uint8_t slot = static_cast<uint8_t>(event >> shift) & SLOT_MASK;
+            if ((event & ((1UL << shift) - 1U)) != 0 || !(occupied[level] & _BV(slot)))
+            {
+                continue;
+            }
+
+            SoftTimer* pending = slots[level][slot];
+            slots[level][slot] = nullptr;
+            occupied[level] &= ~_BV(slot);
+            pending->pprev_ = &pending;
+            while (pending != nullptr)
+            {
+                SoftTimer& timer = *pending;
+                TimerWheel::unlink(timer);
+                TimerWheel::link(timer);
+            }
+        }
+
+        const uint8_t slot = static_cast<uint8_t>(event) & SLOT_MASK;
+        if (!(occupied[0] & _BV(slot)))
+        {
+            return;
+        }
+
+        SoftTimer* expired = slots[0][slot];
+        slots[0][slot] = nullptr;
+        occupied[0] &= ~_BV(slot);
+        expired->pprev_ = &expired;
+        while (expired != nullptr)
+        {
+            SoftTimer& timer = *expired;
+            TimerWheel::unlink(timer);
+            if (time_difference(timer.expiry_milliseconds_, event) > 0)
+            {
+                TimerWheel::link(timer);
+                continue;
+            }
+
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+            // The compare interrupt stays masked until program_compare(), so the service is never nested
+            TIMSK1 &= ~_BV(OCIE1A);
+            sei();
+            timer.callback_(timer);
+            cli();
+#else  // defined(UIRB_CORE_IRQ_PRIORITY)
+            timer.callback_(timer);
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
+
+            // Restart unless the callback restarted or cancelled the timer
+            if (!timer.isActive() && timer.period_milliseconds_ != 0)
+            {
+                // Periods already missed, e.g. after sleeping, are skipped instead of run back to back
+                const uint32_t period = timer.period_milliseconds_;
+                const uint32_t current = TimerWheel::now();
+                timer.expiry_milliseconds_ += period;
+                if (time_difference(timer.expiry_milliseconds_, current) <= 0)
+                {
+                    timer.expiry_milliseconds_ += ((current - timer.expiry_milliseconds_) / period + 1U) * period;
+                }
+                TimerWheel::link(timer);
+            }
+        }
+    }
+
+    void TimerWheel::update_next_event()
+    {
+        has_next_event = false;
+        for (uint8_t level = 0; level < LEVELS; level++)
+        {
+            const uint16_t mask = occupied[level];
+            if (mask == 0)
+            {
+                continue;
+            }
+
+            const uint8_t shift = SLOT_BITS * level;
+            const uint8_t current = static_cast<uint8_t>(wheel_time >> shift) & SLOT_MASK;
+            uint8_t ahead = 1;
+            while (!(mask & _BV((current + ahead) & SLOT_MASK)))
+            {
+                ahead++;
+            }
+
+            const uint32_t candidate = ((wheel_time >> shift) + ahead) << shift;
+            if (!has_next_event || time_difference(candidate, next_event) < 0)
+            {
+                next_event = candidate;
+                has_next_event = true;
+            }
+        }
+    }
+
+    void TimerWheel::program_compare()
+    {
+        if (!has_next_event)
+        {
+            TIMSK1 &= ~_BV(OCIE1A);
+            return;
+        }
+
+        uint16_t counts = MIN_COMPARE_COUNTS;
+        const int32_t difference = time_difference(next_event, TimerWheel::now());
+        if (difference > 0)
+        {
+            const uint32_t milliseconds = (static_cast<uint32_t>(difference) < MAX_COMPARE_MILLISECONDS) ?
+                                          static_cast<uint32_t>(difference) : MAX_COMPARE_MILLISECONDS;
+            const uint32_t scaled = milliseconds * TIMER1_COUNTS_PER_SECOND / 1000UL;
+            counts = (scaled > MIN_COMPARE_COUNTS) ? static_cast<uint16_t>(scaled) : MIN_COMPARE_COUNTS;
+        }
+
+        // Clear a stale match before arming, a match after the write then raises the interrupt
+        TIFR1 = _BV(OCF1A);
+        OCR1A = TCNT1 + counts;
+        TIMSK1 |= _BV(OCIE1A);
+    }
+
+    void TimerWheel::service()
+    {
+        in_service = true;
+        const uint32_t current = TimerWheel::now();
+        while (has_next_event && time_difference(next_event, current) <= 0)
+        {
+            TimerWheel::run_event(next_event);
+            TimerWheel::update_next_event();
+        }
+        wheel_time = current;
+        in_service = false;
+        TimerWheel::program_compare();
+    }
+
+    void TimerWheel::resume_after_sleep()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        TimerWheel::service();
+        SREG = oldSREG;
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_TIMER_WHEEL)
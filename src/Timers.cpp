@@ -0,0 +1,836 @@
+/**
+ * @file Timers.cpp
+ * @brief Implementation of the hardware timer allocation for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::TimerManager class and the interrupt vectors of all timers not
+ * reserved with `UIRB_CORE_RESERVE_TIMERn`. Each vector dispatches to the handler slots attached to it.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore_Timers.hpp>
+#include <UIRBcore_MemoryPlan.hpp>
+
+#if defined(UIRB_CORE_TIMER_MANAGER)
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <avr/power.h>
+#include <string.h>
+
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+extern "C"
+{
+    /**
+     * @brief `millis()` and `micros()` state of the Arduino core (`wiring.c`), advanced by the Timer0 overflow.
+     */
+    extern volatile unsigned long timer0_millis;
+    extern volatile unsigned long timer0_overflow_count;
+}
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
+
+namespace
+{
+    constexpr uint8_t TIMER_COUNT = static_cast<uint8_t>(uirbcore::HardwareTimer::COUNT);
+    constexpr uint8_t VECTOR_COUNT = static_cast<uint8_t>(uirbcore::TimerVector::COUNT);
+    constexpr uint8_t CLIENT_COUNT = static_cast<uint8_t>(uirbcore::TimerClient::COUNT);
+    constexpr uint8_t SLOT_COUNT = UIRB_CORE_TIMER_HANDLER_SLOTS;
+
+    /**
+     * @brief Prescaler of Timer0 set by the Arduino core.
+     */
+    constexpr uint16_t TIMER0_PRESCALER = 64;
+
+    /**
+     * @brief Handler slot shared by all vectors.
+     */
+    struct HandlerSlot
+    {
+        uirbcore::TimerHandler handler; /**< Handler, `nullptr` if the slot is free. */
+        uirbcore::TimerClient client; /**< Client owning the slot. */
+    };
+
+    /**
+     * @brief Allocation state of one timer.
+     */
+    struct TimerState
+    {
+        uint16_t clients; /**< Holding clients, one bit per client. */
+        uint16_t prescaler; /**< Prescaler when free-running, `0` otherwise. */
+    };
+
+    HandlerSlot handler_slots[SLOT_COUNT];
+
+    static_assert(sizeof(handler_slots) == uirbcore::MemoryPlan::TIMER_SLOT_BYTES, "Timer handler slots does not match uirbcore::MemoryPlan");
+    TimerState timer_states[TIMER_COUNT];
+
+    /**
+     * @brief Handler slots attached to each vector, one bit per slot. Read by the interrupts.
+     */
+    volatile uint8_t vector_slots[VECTOR_COUNT];
+
+    /**
+     * @brief Vectors attached exclusively, one bit per vector.
+     */
+    uint16_t exclusive_vectors = 0;
+
+    /**
+     * @brief Handler slots attached as @ref uirbcore::InterruptPriority::PREEMPTIBLE, one bit per slot.
+     */
+    uint8_t preemptible_slots = 0;
+
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+    /**
+     * @brief Preemptible vectors whose handlers are running with interrupts enabled, one bit per vector.
+     */
+    volatile uint16_t running_vectors = 0;
+
+    /**
+     * @brief Preemptible vectors raised again while running, their handlers run once more, one bit per vector.
+     */
+    volatile uint16_t repeated_vectors = 0;
+
+    /**
+     * @brief State of a suspended Timer0 tick.
+     */
+    struct Timer0Suspension
+    {
+        bool active; /**< The overflow interrupt is masked. */
+        uint16_t start_ticks; /**< `TCNT0` at suspension, plus 256 for an overflow not yet counted. */
+        uint16_t start_timer1; /**< `TCNT1` at suspension. */
+        uint16_t carry_microseconds; /**< Microseconds not yet added to `millis()`, below 1000. */
+    };
+
+    Timer0Suspension timer0_suspension = { false, 0, 0, 0 };
+
+    /**
+     * @brief Microseconds per Timer0 overflow, as counted by the Arduino core.
+     */
+    constexpr uint16_t MICROSECONDS_PER_TIMER0_OVERFLOW = clockCyclesToMicroseconds(64U * 256U);
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
+
+    static_assert(SLOT_COUNT <= 8U, "Handler slots of a vector are kept in an 8-bit mask");
+    static_assert(CLIENT_COUNT <= 16U, "Timer clients are kept in a 16-bit mask");
+    static_assert(VECTOR_COUNT <= 16U, "Exclusive vectors are kept in a 16-bit mask");
+
+    /**
+     * @brief Timer and interrupt mask bit of a vector.
+     */
+    struct VectorInfo
+    {
+        uint8_t timer; /**< @ref uirbcore::HardwareTimer of the vector. */
+        uint8_t bit; /**< Bit in `TIMSKn` and `TIFRn`. */
+    };
+
+    const VectorInfo VECTOR_INFO[VECTOR_COUNT] PROGMEM =
+    {
+        { 0, OCIE0A },
+        { 0, OCIE0B },
+        { 1, OCIE1A },
+        { 1, OCIE1B },
+        { 1, ICIE1 },
+        { 1, TOIE1 },
+        { 2, OCIE2A },
+        { 2, OCIE2B },
+        { 2, TOIE2 }
+    };
+
+    const char TIMER_NAME_0[] PROGMEM = "TIMER0";
+    const char TIMER_NAME_1[] PROGMEM = "TIMER1";
+    const char TIMER_NAME_2[] PROGMEM = "TIMER2";
+
+    const char* const TIMER_NAMES[TIMER_COUNT] PROGMEM =
+    {
+        TIMER_NAME_0,
+        TIMER_NAME_1,
+        TIMER_NAME_2
+    };
+
+    const char VECTOR_NAME_TIMER0_COMPA[] PROGMEM = "TIMER0_COMPA";
+    const char VECTOR_NAME_TIMER0_COMPB[] PROGMEM = "TIMER0_COMPB";
+    const char VECTOR_NAME_TIMER1_COMPA[] PROGMEM = "TIMER1_COMPA";
+    const char VECTOR_NAME_TIMER1_COMPB[] PROGMEM = "TIMER1_COMPB";
+    const char VECTOR_NAME_TIMER1_CAPT[] PROGMEM = "TIMER1_CAPT";
+    const char VECTOR_NAME_TIMER1_OVF[] PROGMEM = "TIMER1_OVF";
+    const char VECTOR_NAME_TIMER2_COMPA[] PROGMEM = "TIMER2_COMPA";
+    const char VECTOR_NAME_TIMER2_COMPB[] PROGMEM = "TIMER2_COMPB";
+    const char VECTOR_NAME_TIMER2_OVF[] PROGMEM = "TIMER2_OVF";
+
+    const char* const VECTOR_NAMES[VECTOR_COUNT] PROGMEM =
+    {
+        VECTOR_NAME_TIMER0_COMPA,
+        VECTOR_NAME_TIMER0_COMPB,
+        VECTOR_NAME_TIMER1_COMPA,
+        VECTOR_NAME_TIMER1_COMPB,
+        VECTOR_NAME_TIMER1_CAPT,
+        VECTOR_NAME_TIMER1_OVF,
+        VECTOR_NAME_TIMER2_COMPA,
+        VECTOR_NAME_TIMER2_COMPB,
+        VECTOR_NAME_TIMER2_OVF
+    };
+
+    const char CLIENT_NAME_NONE[] PROGMEM = "NONE";
+    const char CLIENT_NAME_PROFILER[] PROGMEM = "PROFILER";
+    const char CLIENT_NAME_SELF_TEST[] PROGMEM = "SELF_TEST";
+    const char CLIENT_NAME_IR_CARRIER[] PROGMEM = "IR_CARRIER";
+    const char CLIENT_NAME_IR_CAPTURE[] PROGMEM = "IR_CAPTURE";
+    const char CLIENT_NAME_SCHEDULER[] PROGMEM = "SCHEDULER";
+    const char CLIENT_NAME_DEBOUNCE[] PROGMEM = "DEBOUNCE";
+    const char CLIENT_NAME_LED_PWM[] PROGMEM = "LED_PWM";
+    const char CLIENT_NAME_APPLICATION[] PROGMEM = "APPLICATION";
+
+    const char* const CLIENT_NAMES[CLIENT_COUNT] PROGMEM =
+    {
+        CLIENT_NAME_NONE,
+        CLIENT_NAME_PROFILER,
+        CLIENT_NAME_SELF_TEST,
+        CLIENT_NAME_IR_CARRIER,
+        CLIENT_NAME_IR_CAPTURE,
+        CLIENT_NAME_SCHEDULER,
+        CLIENT_NAME_DEBOUNCE,
+        CLIENT_NAME_LED_PWM,
+        CLIENT_NAME_APPLICATION
+    };
+
+    /**
+     * @brief Prints a string from a PROGMEM pointer table.
+     */
+    void print_name(Print& output, const char* const* table, const uint8_t index)
+    {
+        output.print(reinterpret_cast<const __FlashStringHelper*>(pgm_read_ptr(&table[index])));
+    }
+
+    /**
+     * @brief Returns the interrupt mask register of a timer.
+     */
+    volatile uint8_t& timer_mask_register(const uint8_t timer)
+    {
+        switch (timer)
+        {
+            case 0:
+                return TIMSK0;
+            case 1:
+                return TIMSK1;
+            default:
+                return TIMSK2;
+        }
+    }
+
+    /**
+     * @brief Returns the interrupt flag register of a timer.
+     */
+    volatile uint8_t& timer_flag_register(const uint8_t timer)
+    {
+        switch (timer)
+        {
+            case 0:
+                return TIFR0;
+            case 1:
+                return TIFR1;
+            default:
+                return TIFR2;
+        }
+    }
+
+    /**
+     * @brief Returns the clock select bits for a prescaler, `0` if the timer does not support it.
+     */
+    uint8_t clock_select(const uint8_t timer, const uint16_t prescaler)
+    {
+        if (timer == 2)
+        {
+            switch (prescaler)
+            {
+                case 1: return 1;
+                case 8: return 2;
+                case 32: return 3;
+                case 64: return 4;
+                case 128: return 5;
+                case 256: return 6;
+                case 1024: return 7;
+                default: return 0;
+            }
+        }
+
+        switch (prescaler)
+        {
+            case 1: return 1;
+            case 8: return 2;
+            case 64: return 3;
+            case 256: return 4;
+            case 1024: return 5;
+            default: return 0;
+        }
+    }
+
+    /**
+     * @brief Checks if a timer is reserved at build time.
+     */
+    bool timer_reserved(const uint8_t timer)
+    {
+        switch (timer)
+        {
+            case 0:
+#if defined(UIRB_CORE_RESERVE_TIMER0)
+                return true;
+#else
+                return false;
+#endif  // defined(UIRB_CORE_RESERVE_TIMER0)
+            case 1:
+#if defined(UIRB_CORE_RESERVE_TIMER1)
+                return true;
+#else
+                return false;
+#endif  // defined(UIRB_CORE_RESERVE_TIMER1)
+            default:
+#if defined(UIRB_CORE_RESERVE_TIMER2)
+                return true;
+#else
+                return false;
+#endif  // defined(UIRB_CORE_RESERVE_TIMER2)
+        }
+    }
+
+    /**
+     * @brief Checks if a client is valid.
+     */
+    bool valid_client(const uirbcore::TimerClient client)
+    {
+        return client != uirbcore::TimerClient::NONE && static_cast<uint8_t>(client) < CLIENT_COUNT;
+    }
+
+    /**
+     * @brief Frees a handler slot and disables the vector interrupt with its last handler.
+     *
+     * @note Must be called with interrupts disabled.
+     */
+    void free_slot(const uint8_t vector, const uint8_t slot)
+    {
+        vector_slots[vector] &= ~_BV(slot);
+        preemptible_slots &= ~_BV(slot);
+        handler_slots[slot].handler = nullptr;
+        handler_slots[slot].client = uirbcore::TimerClient::NONE;
+
+        if (vector_slots[vector] == 0)
+        {
+            exclusive_vectors &= ~_BV(vector);
+            const uint8_t timer = pgm_read_byte(&VECTOR_INFO[vector].timer);
+            timer_mask_register(timer) &= ~_BV(pgm_read_byte(&VECTOR_INFO[vector].bit));
+        }
+    }
+
+    /**
+     * @brief Calls every handler of a slot mask.
+     */
+    inline void call_handlers(uint8_t slots)
+    {
+        for (uint8_t slot = 0; slots != 0; slot++, slots >>= 1)
+        {
+            if (slots & 1U)
+            {
+                // A nested interrupt may have detached the handler of a preemptible vector
+                const uirbcore::TimerHandler handler = handler_slots[slot].handler;
+                if (handler != nullptr)
+                {
+                    handler();
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Calls every handler attached to a vector.
+     *
+     * Vectors with only @ref uirbcore::InterruptPriority::PREEMPTIBLE handlers run them with interrupts enabled.
+     * A nested raise of the same vector only marks it, and the running dispatch calls the handlers once more.
+     */
+    inline void dispatch(const uint8_t vector)
+    {
+        const uint8_t slots = vector_slots[vector];
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+        if (slots != 0 && (slots & ~preemptible_slots) == 0)
+        {
+            const uint16_t mask = static_cast<uint16_t>(1U << vector);
+            if (running_vectors & mask)
+            {
+                repeated_vectors |= mask;
+                return;
+            }
+
+            running_vectors |= mask;
+            do
+            {
+                repeated_vectors &= ~mask;
+                sei();
+                call_handlers(vector_slots[vector]);
+                cli();
+            } while (repeated_vectors & mask);
+            running_vectors &= ~mask;
+            return;
+        }
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
+        call_handlers(slots);
+    }
+}  // namespace
+
+#if !defined(UIRB_CORE_RESERVE_TIMER0)
+ISR(TIMER0_COMPA_vect)
+{
+    dispatch(static_cast<uint8_t>(uirbcore::TimerVector::TIMER0_COMPA));
+}
+
+ISR(TIMER0_COMPB_vect)
+{
+    dispatch(static_cast<uint8_t>(uirbcore::TimerVector::TIMER0_COMPB));
+}
+#endif  // !defined(UIRB_CORE_RESERVE_TIMER0)
+
+#if !defined(UIRB_CORE_RESERVE_TIMER1)
+ISR(TIMER1_COMPA_vect)
+{
+    dispatch(static_cast<uint8_t>(uirbcore::TimerVector::TIMER1_COMPA));
+}
+
+ISR(TIMER1_COMPB_vect)
+{
+    dispatch(static_cast<uint8_t>(uirbcore::TimerVector::TIMER1_COMPB));
+}
+
+ISR(TIMER1_CAPT_vect)
+{
+    dispatch(static_cast<uint8_t>(uirbcore::TimerVector::TIMER1_CAPT));
+}
+
+ISR(TIMER1_OVF_vect)
+{
+    dispatch(static_cast<uint8_t>(uirbcore::TimerVector::TIMER1_OVF));
+}
+#endif  // !defined(UIRB_CORE_RESERVE_TIMER1)
+
+#if !defined(UIRB_CORE_RESERVE_TIMER2)
+ISR(TIMER2_COMPA_vect)
+{
+    dispatch(static_cast<uint8_t>(uirbcore::TimerVector::TIMER2_COMPA));
+}
+
+ISR(TIMER2_COMPB_vect)
+{
+    dispatch(static_cast<uint8_t>(uirbcore::TimerVector::TIMER2_COMPB));
+}
+
+ISR(TIMER2_OVF_vect)
+{
+    dispatch(static_cast<uint8_t>(uirbcore::TimerVector::TIMER2_OVF));
+}
+#endif  // !defined(UIRB_CORE_RESERVE_TIMER2)
+
+namespace uirbcore
+{
+    bool TimerManager::acquire(const HardwareTimer timer, const TimerClient client, const TimerMode mode,
+                               const uint16_t prescaler)
+    {
+        const uint8_t index = static_cast<uint8_t>(timer);
+        if (index >= TIMER_COUNT || !valid_client(client) || timer_reserved(index))
+        {
+            return false;
+        }
+
+        uint8_t select = 0;
+        if (mode == TimerMode::FREE_RUNNING)
+        {
+            select = clock_select(index, prescaler);
+            if (select == 0 || (index == 0 && prescaler != TIMER0_PRESCALER))
+            {
+                return false;
+            }
+        }
+        else if (index == 0)
+        {
+            // Timer0 keeps running millis()
+            return false;
+        }
+
+        bool acquired = false;
+        uint8_t oldSREG = SREG;
+        cli();
+
+        TimerState& state = timer_states[index];
+        const uint16_t client_bit = _BV(static_cast<uint8_t>(client));
+        if (state.clients == 0)
+        {
+            state.clients = client_bit;
+            if (mode == TimerMode::FREE_RUNNING)
+            {
+                state.prescaler = prescaler;
+                if (index == 1)
+                {
+                    power_timer1_enable();
+                    TCCR1B = 0;
+                    TCCR1A = 0; // Normal mode, output compare pins disconnected
+                    TCNT1 = 0;
+                    TCCR1B = select;
+                }
+                else if (index == 2)
+                {
+                    power_timer2_enable();
+                    TCCR2B = 0;
+                    TCCR2A = 0;
+                    TCNT2 = 0;
+                    TCCR2B = select;
+                }
+            }
+            else
+            {
+                state.prescaler = 0;
+                if (index == 1)
+                {
+                    power_timer1_enable();
+                }
+                else
+                {
+                    power_timer2_enable();
+                }
+            }
+            acquired = true;
+        }
+        else if (mode == TimerMode::FREE_RUNNING && state.prescaler == prescaler)
+        {
+            state.clients |= client_bit;
+            acquired = true;
+        }
+        else if (mode == TimerMode::EXCLUSIVE && state.prescaler == 0 && state.clients == client_bit)
+        {
+            acquired = true;
+        }
+
+        SREG = oldSREG;
+        return acquired;
+    }
+
+    void TimerManager::release(const HardwareTimer timer, const TimerClient client)
+    {
+        const uint8_t index = static_cast<uint8_t>(timer);
+        if (index >= TIMER_COUNT || !valid_client(client))
+        {
+            return;
+        }
+
+        uint8_t oldSREG = SREG;
+        cli();
+
+        TimerState& state = timer_states[index];
+        const uint16_t client_bit = _BV(static_cast<uint8_t>(client));
+        if (state.clients & client_bit)
+        {
+            for (uint8_t vector = 0; vector < VECTOR_COUNT; vector++)
+            {
+                if (pgm_read_byte(&VECTOR_INFO[vector].timer) == index)
+                {
+                    TimerManager::detach(static_cast<TimerVector>(vector), client);
+                }
+            }
+
+            state.clients &= ~client_bit;
+            if (state.clients == 0)
+            {
+                // Only a timer configured by the manager is stopped, an exclusive client left it as it wants
+                if (state.prescaler != 0 && index == 1)
+                {
+                    TCCR1B = 0;
+                }
+                else if (state.prescaler != 0 && index == 2)
+                {
+                    TCCR2B = 0;
+                }
+                state.prescaler = 0;
+            }
+        }
+
+        SREG = oldSREG;
+    }
+
+    bool TimerManager::attach(const TimerVector vector, const TimerClient client, const TimerHandler handler,
+                              const bool exclusive, const InterruptPriority priority)
+    {
+        const uint8_t index = static_cast<uint8_t>(vector);
+        if (index >= VECTOR_COUNT || !valid_client(client) || handler == nullptr)
+        {
+            return false;
+        }
+
+        const uint8_t timer = pgm_read_byte(&VECTOR_INFO[index].timer);
+        bool attached = false;
+        uint8_t oldSREG = SREG;
+        cli();
+
+        const uint8_t attached_slots = vector_slots[index];
+        bool conflict = !(timer_states[timer].clients & _BV(static_cast<uint8_t>(client))) ||
+                        (exclusive_vectors & _BV(index)) || (exclusive && attached_slots != 0);
+        for (uint8_t slot = 0; slot < SLOT_COUNT && !conflict; slot++)
+        {
+            conflict = (attached_slots & _BV(slot)) && handler_slots[slot].client == client;
+        }
+
+        for (uint8_t slot = 0; slot < SLOT_COUNT && !conflict; slot++)
+        {
+            if (handler_slots[slot].handler != nullptr)
+            {
+                continue;
+            }
+
+            handler_slots[slot].handler = handler;
+            handler_slots[slot].client = client;
+            vector_slots[index] = attached_slots | _BV(slot);
+            if (priority == InterruptPriority::PREEMPTIBLE)
+            {
+                preemptible_slots |= _BV(slot);
+            }
+            if (exclusive)
+            {
+                exclusive_vectors |= _BV(index);
+            }
+
+            if (attached_slots == 0)
+            {
+                // Drop a flag raised before the attach, then enable the interrupt
+                const uint8_t bit = _BV(pgm_read_byte(&VECTOR_INFO[index].bit));
+                timer_flag_register(timer) = bit;
+                timer_mask_register(timer) |= bit;
+            }
+            attached = true;
+            break;
+        }
+
+        SREG = oldSREG;
+        return attached;
+    }
+
+    void TimerManager::detach(const TimerVector vector, const TimerClient client)
+    {
+        const uint8_t index = static_cast<uint8_t>(vector);
+        if (index >= VECTOR_COUNT || !valid_client(client))
+        {
+            return;
+        }
+
+        uint8_t oldSREG = SREG;
+        cli();
+
+        for (uint8_t slot = 0; slot < SLOT_COUNT; slot++)
+        {
+            if ((vector_slots[index] & _BV(slot)) && handler_slots[slot].client == client)
+            {
+                free_slot(index, slot);
+                break;
+            }
+        }
+
+        SREG = oldSREG;
+    }
+
+    uint16_t TimerManager::getClients(const HardwareTimer timer)
+    {
+        const uint8_t index = static_cast<uint8_t>(timer);
+        if (index >= TIMER_COUNT)
+        {
+            return 0;
+        }
+
+        uint8_t oldSREG = SREG;
+        cli();
+        const uint16_t clients = timer_states[index].clients;
+        SREG = oldSREG;
+        return clients;
+    }
+
+    uint16_t TimerManager::getPrescaler(const HardwareTimer timer)
+    {
+        const uint8_t index = static_cast<uint8_t>(timer);
+        if (index >= TIMER_COUNT)
+        {
+            return 0;
+        }
+
+        uint8_t oldSREG = SREG;
+        cli();
+        const uint16_t prescaler = timer_states[index].prescaler;
+        SREG = oldSREG;
+        return prescaler;
+    }
+
+    bool TimerManager::isReserved(const HardwareTimer timer)
+    {
+        const uint8_t index = static_cast<uint8_t>(timer);
+        return index < TIMER_COUNT && timer_reserved(index);
+    }
+
+    void TimerManager::dump(Print& output)
+    {
+        output.println(F("timer\tprescaler\tclients"));
+        for (uint8_t timer = 0; timer < TIMER_COUNT; timer++)
+        {
+            print_name(output, TIMER_NAMES, timer);
+            output.print('\t');
+            if (timer_reserved(timer))
+            {
+                output.println(F("RESERVED"));
+                continue;
+            }
+
+            const uint16_t clients = TimerManager::getClients(static_cast<HardwareTimer>(timer));
+            const uint16_t prescaler = TimerManager::getPrescaler(static_cast<HardwareTimer>(timer));
+            if (clients != 0 && prescaler == 0)
+            {
+                output.print(F("EXCLUSIVE"));
+            }
+            else
+            {
+                output.print(prescaler);
+            }
+            for (uint8_t client = 1; client < CLIENT_COUNT; client++)
+            {
+                if (clients & _BV(client))
+                {
+                    output.print('\t');
+                    print_name(output, CLIENT_NAMES, client);
+                }
+            }
+            output.println();
+        }
+
+        output.println(F("vector\tmode\thandlers"));
+        for (uint8_t vector = 0; vector < VECTOR_COUNT; vector++)
+        {
+            uint8_t oldSREG = SREG;
+            cli();
+            const uint8_t slots = vector_slots[vector];
+            const bool exclusive = exclusive_vectors & _BV(vector);
+            const uint8_t preemptible = preemptible_slots;
+            HandlerSlot attached[SLOT_COUNT];
+            memcpy(attached, handler_slots, sizeof(attached));
+            SREG = oldSREG;
+
+            if (slots == 0)
+            {
+                continue;
+            }
+
+            print_name(output, VECTOR_NAMES, vector);
+            output.print(exclusive ? F("\tEXCLUSIVE") : F("\tSHARED"));
+            for (uint8_t slot = 0; slot < SLOT_COUNT; slot++)
+            {
+                if (slots & _BV(slot))
+                {
+                    output.print('\t');
+                    print_name(output, CLIENT_NAMES, static_cast<uint8_t>(attached[slot].client));
+                    if (preemptible & _BV(slot))
+                    {
+                        output.print(F("(P)"));
+                    }
+                }
+            }
+            output.println();
+        }
+    }
+
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+    bool TimerManager::suspendTimer0Tick()
+    {
+        if (timer_reserved(0) || timer_reserved(1))
+        {
+            return false;
+        }
+
+        uint8_t oldSREG = SREG;
+        cli();
+        if (timer0_suspension.active || timer_states[1].prescaler == 0)
+        {
+            SREG = oldSREG;
+            return false;
+        }
+
+        // At 255 the counter may wrap between reading it and checking the overflow flag
+        while (TCNT0 == 0xFF)
+        {
+        }
+        timer0_suspension.start_timer1 = TCNT1;
+        timer0_suspension.start_ticks = TCNT0;
+        if (TIFR0 & _BV(TOV0))
+        {
+            // The overflow interrupt is pending, it is counted on resume instead
+            timer0_suspension.start_ticks += 256;
+        }
+        TIMSK0 &= ~_BV(TOIE0);
+        timer0_suspension.active = true;
+        SREG = oldSREG;
+        return true;
+    }
+
+    void TimerManager::resumeTimer0Tick()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        if (!timer0_suspension.active)
+        {
+            SREG = oldSREG;
+            return;
+        }
+
+        while (TCNT0 == 0xFF)
+        {
+        }
+        const uint16_t elapsed_timer1 = TCNT1 - timer0_suspension.start_timer1;
+        const uint8_t ticks_now = TCNT0;
+        TIFR0 = _BV(TOV0); // Overflows until now are counted below
+
+        // Timer0 and Timer1 share the prescaler, Timer1 only tells the number of Timer0 wraps
+        int32_t total = timer0_suspension.start_ticks +
+                        static_cast<int32_t>(static_cast<uint32_t>(elapsed_timer1) * timer_states[1].prescaler / TIMER0_PRESCALER);
+        total += static_cast<int8_t>(ticks_now - static_cast<uint8_t>(total));
+        const uint32_t overflows = static_cast<uint32_t>(total) >> 8;
+
+        const uint32_t microseconds = overflows * MICROSECONDS_PER_TIMER0_OVERFLOW + timer0_suspension.carry_microseconds;
+        timer0_overflow_count += overflows;
+        timer0_millis += microseconds / 1000U;
+        timer0_suspension.carry_microseconds = microseconds % 1000U;
+
+        TIMSK0 |= _BV(TOIE0);
+        timer0_suspension.active = false;
+        SREG = oldSREG;
+    }
+
+    bool TimerManager::isTimer0TickSuspended()
+    {
+        return timer0_suspension.active;
+    }
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_TIMER_MANAGER)
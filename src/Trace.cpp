@@ -0,0 +1,164 @@
+/**
+ * @file Trace.cpp
+ * @brief Implementation of the post-mortem event trace ring buffer for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::Trace class declared in @ref UIRBcore_Trace.hpp.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+#include <UIRBcore_Trace.hpp>
+#include <UIRBcore_MemoryPlan.hpp>
+
+#if defined(UIRB_CORE_TRACE)
+namespace
+{
+    constexpr uint16_t TRACE_MAGIC = 0x5452U; // "TR"
+    constexpr uint16_t TRACE_INDEX_MASK = UIRB_CORE_TRACE_ENTRIES - 1U;
+
+    /**
+     * @brief Trace buffer layout kept in `.noinit` RAM.
+     */
+    struct TraceBuffer
+    {
+        uint16_t magic;
+        uint16_t head; /**< Index of the next entry to write. */
+        uint16_t count; /**< Number of valid entries. */
+        uirbcore::TraceEntry entries[UIRB_CORE_TRACE_ENTRIES];
+    };
+
+    TraceBuffer trace_buffer __attribute__((section(".noinit")));
+
+    static_assert(sizeof(trace_buffer) == uirbcore::MemoryPlan::TRACE_BYTES, "Trace buffer does not match uirbcore::MemoryPlan");
+}  // namespace
+
+extern "C" void uirb_trace_init() __attribute__((naked, used, section(".init5")));
+
+/**
+ * @brief Validates or clears the trace buffer before static constructors can log into it.
+ *
+ * Runs from `.init5`, after `.bss` and `.data` are initialized and before static constructors run.
+ * The buffer is kept only if the reset preserved RAM and the header is consistent.
+ */
+void uirb_trace_init()
+{
+    const uint8_t reset_flags = uirbcore::WatchdogSupervisor::getResetFlags();
+    const bool ram_retained = reset_flags != 0 && !(reset_flags & (_BV(PORF) | _BV(BORF)));
+
+    if (!ram_retained || trace_buffer.magic != TRACE_MAGIC || trace_buffer.count > UIRB_CORE_TRACE_ENTRIES)
+    {
+        trace_buffer.magic = TRACE_MAGIC;
+        trace_buffer.count = 0;
+    }
+    trace_buffer.head &= TRACE_INDEX_MASK;
+}
+
+namespace uirbcore
+{
+    void Trace::log(const TraceEvent type, const uint8_t argument)
+    {
+        // millis() stops in power-down, the uptime keeps the time slept between SLEEP and WAKE
+        const uint16_t timestamp = static_cast<uint16_t>(UIRB::getUptimeMilliseconds());
+
+        uint8_t oldSREG = SREG;
+        cli();
+        TraceEntry& entry = trace_buffer.entries[trace_buffer.head];
+        entry.timestamp = timestamp;
+        entry.type = type;
+        entry.argument = argument;
+        trace_buffer.head = (trace_buffer.head + 1U) & TRACE_INDEX_MASK;
+        if (trace_buffer.count < UIRB_CORE_TRACE_ENTRIES)
+        {
+            trace_buffer.count++;
+        }
+        SREG = oldSREG;
+    }
+
+    uint16_t Trace::count()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        uint16_t entries = trace_buffer.count;
+        SREG = oldSREG;
+        return entries;
+    }
+
+    bool Trace::read(const uint16_t age, TraceEntry& entry)
+    {
+        bool found = false;
+        uint8_t oldSREG = SREG;
+        cli();
+        if (age < trace_buffer.count)
+        {
+            entry = trace_buffer.entries[(trace_buffer.head - 1U - age) & TRACE_INDEX_MASK];
+            found = true;
+        }
+        SREG = oldSREG;
+        return found;
+    }
+
+    void Trace::clear()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        trace_buffer.count = 0;
+        SREG = oldSREG;
+    }
+
+    void Trace::dump(Print& output)
+    {
+        const uint16_t entries = Trace::count();
+
+        output.print(F("#UIRB-TRACE "));
+        output.print(Trace::DUMP_FORMAT_VERSION);
+        output.print(' ');
+        output.println(entries);
+
+        // Entries logged while dumping push older ones further back, read from the oldest by age
+        for (uint16_t age = entries; age > 0; age--)
+        {
+            TraceEntry entry;
+            if (!Trace::read(age - 1U, entry))
+            {
+                continue;
+            }
+            output.print(entry.timestamp, HEX);
+            output.print(' ');
+            output.print(static_cast<uint8_t>(entry.type), HEX);
+            output.print(' ');
+            output.println(entry.argument, HEX);
+        }
+
+        output.println(F("#UIRB-TRACE-END"));
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_TRACE)
@@ -45,6 +45,61 @@
 using namespace uirbcore;
 
 static volatile bool pcint2_interrupt_flag = false;
+static uint32_t slept_milliseconds = 0; // Time spent in powerDown(), added to millis() by UIRB::getUptimeMilliseconds()
+
+#if defined(UIRB_CORE_PCINT_DISPATCHER)
+/**
+ * @brief Pin change handler of @ref PIN_USB_IO3, attached to @ref PinChangeDispatcher while sleeping.
+ */
+static void usb_io3_pin_change(const uint8_t, const bool)
+{
+    pcint2_interrupt_flag = true;
+}
+#endif  // defined(UIRB_CORE_PCINT_DISPATCHER)
+
+/**
+ * @brief Converts @ref PIN_PROG, in a gap between IR frames when @ref UIRB_CORE_IR_TX_GATE is defined.
+ *
+ * @return uint16_t Raw 10-bit ADC value.
+ */
+static uint16_t read_prog_adc()
+{
+#if defined(UIRB_CORE_IR_TX_GATE)
+    return IRTransmitGate::analogReadInGap(PIN_PROG);
+#else  // defined(UIRB_CORE_IR_TX_GATE)
+    return analogRead(PIN_PROG);
+#endif  // defined(UIRB_CORE_IR_TX_GATE)
+}
+
+/**
+ * @brief Enters the selected sleep mode until an interrupt wakes the MCU up.
+ *
+ * `sei()` and `sleep_cpu()` stay adjacent: the instruction after `sei()` runs before any pending interrupt, so an
+ * interrupt arriving meanwhile wakes the MCU up instead of being handled before it sleeps. Only the wake edge is
+ * marked with the @ref ProfileProbe::SLEEP probe, and @ref PIN_PULLDOWN_RESISTOR is held low while asleep.
+ */
+static void sleep_until_interrupt()
+{
+#if defined(UIRB_CORE_DEBUG_STROBE)
+    // An enclosing probe such as POWER_DOWN keeps the strobe high, which would load the pulldown while asleep
+    PORTD &= ~_BV(PORTD5);
+#endif  // defined(UIRB_CORE_DEBUG_STROBE)
+    cli();
+    sleep_enable();
+    sei();
+    sleep_cpu(); // enter sleep mode
+    {
+        UIRB_PROFILE_SCOPE(SLEEP);
+    }
+    sleep_disable();
+    sei();
+#if defined(UIRB_CORE_DEBUG_STROBE)
+    if (GPIOR0 != 0)
+    {
+        PORTD |= _BV(PORTD5);
+    }
+#endif  // defined(UIRB_CORE_DEBUG_STROBE)
+}
 
 bool UIRB::getButtonWakeupISRFlag() const
 {
@@ -143,12 +198,49 @@ void UIRB::setIO3WakeupCallback(void (*callback)())
     this->io3_wakeup_user_callback_ = callback;
 #endif  // !defined(AVR_DEBUG)
 }
+#if defined(UIRB_CORE_DEFERRED_WORK)
+void UIRB::run_button_wakeup_callback(DeferredWork&)
+{
+    UIRB& instance = UIRB::getInstance();
+    if (instance.button_wakeup_user_callback_ != nullptr)
+    {
+        instance.button_wakeup_user_callback_();
+    }
+}
+
+void UIRB::run_io3_wakeup_callback(DeferredWork&)
+{
+    UIRB& instance = UIRB::getInstance();
+    if (instance.io3_wakeup_user_callback_ != nullptr)
+    {
+        instance.io3_wakeup_user_callback_();
+    }
+}
+#endif  // defined(UIRB_CORE_DEFERRED_WORK)
+
 void UIRB::button_wakeup_isr()
 {
 #if !defined(AVR_DEBUG)
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+    // INT0 is masked so a bouncing button cannot nest, other interrupts preempt the rest of the handler
+    const uint8_t oldEIMSK = EIMSK;
+    EIMSK = oldEIMSK & ~_BV(INT0);
+    sei();
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
+    UIRB_PROFILE_SCOPE(ISR_BUTTON_WAKEUP);
     UIRB& instance = UIRB::getInstance();
     instance.isr_wakeup_button_flag_ = true;
     instance.isr_wakeup_button_flag_internal_ = true;
+#if defined(UIRB_CORE_DEFERRED_WORK)
+    if (instance.button_wakeup_user_callback_ != nullptr)
+    {
+        DeferredQueue::schedule(instance.button_wakeup_work_);
+    }
+#endif  // defined(UIRB_CORE_DEFERRED_WORK)
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+    cli();
+    EIMSK |= oldEIMSK & _BV(INT0);
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
 #endif  // !defined(AVR_DEBUG)
 }
 
@@ -163,63 +255,146 @@ void UIRB::usb_io3_wakeup_isr()
 
 PowerInfoData& UIRB::getPowerInfo(const uint8_t samples, const bool flashSTATOnLowBattery)
 {
+    WatchdogSupervisor::markEvent(CoreEvent::POWER_INFO_UPDATE);
     this->powerInfoData_.update(samples);
+#if defined(UIRB_CORE_WARM_RESTART)
+    WarmRestart::store_power_info(this->powerInfoData_);
+#endif  // defined(UIRB_CORE_WARM_RESTART)
     this->powerInfoData_.isBatteryLow(flashSTATOnLowBattery);
     return this->powerInfoData_;
 }
 
 UIRB::UIRB()
+#if defined(UIRB_CORE_WARM_RESTART)
+    : powerInfoData_(WarmRestart::isWarmStart() ? WarmRestart::power_info() : PowerInfoData()),
+      eepromDataManager_(WarmRestart::isWarmStart() ? eeprom::EEPROMDataManager(WarmRestart::eeprom_data()) : eeprom::EEPROMDataManager())
+#endif  // defined(UIRB_CORE_WARM_RESTART)
 {
+    WatchdogSupervisor::markEvent(CoreEvent::BOOT);
+    UIRB_TRACE(BOOT, WatchdogSupervisor::getResetFlags());
+
     // Check this first to prevent damage to hardware
     if (!this->eepromDataManager_.hardware_version_matches())
     {
         this->initializationResult_ = CoreResult::ERROR_EEPROM_HW_VER_MISMATCH;
+        WatchdogSupervisor::markEvent(CoreEvent::HW_VERSION_MISMATCH);
+        UIRB_TRACE(INIT_RESULT, CoreResult::ERROR_EEPROM_HW_VER_MISMATCH);
         wdt_enable(WDTO_2S);
         while (1);
     }
+    UIRB_TRACE(INIT_PHASE, TracePhase::HW_VERSION_CHECKED);
 
     pinMode(PIN_IR_LED, OUTPUT);    digitalWrite(PIN_IR_LED, LOW); 
     pinMode(PIN_STAT_LED, OUTPUT);  digitalWrite(PIN_STAT_LED, HIGH);
     pinMode(PIN_PROG, INPUT);
+#if defined(UIRB_CORE_DEBUG_STROBE)
+    GPIOR0 = 0;
+    pinMode(PIN_PULLDOWN_RESISTOR, OUTPUT); digitalWrite(PIN_PULLDOWN_RESISTOR, LOW);
+#else  // defined(UIRB_CORE_DEBUG_STROBE)
     pinMode(PIN_PULLDOWN_RESISTOR, INPUT);
+#endif  // defined(UIRB_CORE_DEBUG_STROBE)
     pinMode(PIN_USB_IO3, INPUT_PULLUP);
     pinMode(PIN_BUTTON_OPTION_1, INPUT_PULLUP);
     pinMode(PIN_BUTTON_OPTION_2, INPUT_PULLUP);
     pinMode(PIN_BUTTON_OPTION_3, INPUT_PULLUP);
     pinMode(PIN_BUTTON_WAKEUP, INPUT_PULLUP);
+#if defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
+    // Wakeup interrupts stay configured, powerDown() only unmasks them
+    EICRA = (EICRA & ~(_BV(ISC01) | _BV(ISC00))) | _BV(ISC01); // INT0 on the falling edge
+#if !defined(UIRB_CORE_PCINT_DISPATCHER) && !defined(UIRB_CORE_NO_PCINT_VECTORS)
+    *digitalPinToPCMSK(PIN_USB_IO3) |= _BV(digitalPinToPCMSKbit(PIN_USB_IO3));
+#endif  // !defined(UIRB_CORE_PCINT_DISPATCHER) && !defined(UIRB_CORE_NO_PCINT_VECTORS)
+#endif  // defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
+    UIRB_TRACE(INIT_PHASE, TracePhase::PINS_CONFIGURED);
+
+#if defined(UIRB_CORE_WDT_SUPERVISOR)
+    WatchdogSupervisor::log_reset();
+#endif  // defined(UIRB_CORE_WDT_SUPERVISOR)
+
+#if defined(UIRB_CORE_WARM_RESTART)
+    // Data restored from .noinit RAM already matches EEPROM, skip the EEPROM round trip
+    if (!WarmRestart::isWarmStart())
+#endif  // defined(UIRB_CORE_WARM_RESTART)
+    {
+    #if defined(UIRB_CORE_WARM_RESTART)
+        WarmRestart::invalidate();
+    #endif  // defined(UIRB_CORE_WARM_RESTART)
+
+        this->eepromDataManager_.increment_boot_count();
+        
+    #if defined(AVR_DEBUG)
+        this->eepromDataManager_.set_avr_serial_debugger(true);
+        #warning "AVR debugger detected. Serial debugging setting will be set to enabled."
+    #else  // defined(AVR_DEBUG)
+        this->eepromDataManager_.set_avr_serial_debugger(false);
+    #endif  // defined(AVR_DEBUG)
+        
+        if (!this->eepromDataManager_.save_to_eeprom())
+        {
+            this->initializationResult_ = CoreResult::ERROR_EEPROM_SAVE_FAILED;
+            UIRB_TRACE(INIT_RESULT, CoreResult::ERROR_EEPROM_SAVE_FAILED);
+            return;
+        }
+        UIRB_TRACE(INIT_PHASE, TracePhase::EEPROM_SAVED);
 
-    this->eepromDataManager_.increment_boot_count();
-    
-#if defined(AVR_DEBUG)
-    this->eepromDataManager_.set_avr_serial_debugger(true);
-    #warning "AVR debugger detected. Serial debugging setting will be set to enabled."
-#else  // defined(AVR_DEBUG)
-    this->eepromDataManager_.set_avr_serial_debugger(false);
-#endif  // defined(AVR_DEBUG)
-    
-    if (!this->eepromDataManager_.save_to_eeprom())
+    #if defined(UIRB_CORE_WARM_RESTART)
+        WarmRestart::store_eeprom_data(this->eepromDataManager_.get());
+    #endif  // defined(UIRB_CORE_WARM_RESTART)
+    }
+#if defined(UIRB_CORE_WARM_RESTART)
+    else
     {
-        this->initializationResult_ = CoreResult::ERROR_EEPROM_SAVE_FAILED;
-        return;
+        UIRB_TRACE(INIT_PHASE, TracePhase::EEPROM_RESTORED);
     }
+#endif  // defined(UIRB_CORE_WARM_RESTART)
 
     if (this->eepromDataManager_.get_charger_prog_resistor_ohms() == eeprom::EEPROMDataManager::INVALID_CHARGER_PROG_RESISTANCE)
     {
         this->initializationResult_ = CoreResult::ERROR_EEPROM_CHARGER_PROG_RESISTANCE_INVALID;
+        UIRB_TRACE(INIT_RESULT, CoreResult::ERROR_EEPROM_CHARGER_PROG_RESISTANCE_INVALID);
         return;
     }
+#if defined(UIRB_CORE_ADC_CALIBRATION)
+    AdcCalibration::begin();
+#endif  // defined(UIRB_CORE_ADC_CALIBRATION)
     digitalWrite(PIN_STAT_LED, LOW);
     this->initializationResult_ = CoreResult::SUCCESS;
+    UIRB_TRACE(INIT_RESULT, CoreResult::SUCCESS);
 }
 
 CoreResult UIRB::begin() const
 {
+#if defined(UIRB_CORE_SELF_TEST)
+    if (this->initializationResult_ == CoreResult::SUCCESS)
+    {
+        if (!SelfTest::hasRun())
+        {
+            SelfTest::run(SelfTest::DEFAULT_TESTS);
+        }
+        if (!SelfTest::getReport().passed())
+        {
+            return CoreResult::ERROR_SELF_TEST_FAILED;
+        }
+    }
+#endif  // defined(UIRB_CORE_SELF_TEST)
     return this->initializationResult_;
 }
 
 bool UIRB::reloadFromEEPROM()
 {
+    WatchdogSupervisor::markEvent(CoreEvent::EEPROM_LOAD);
     this->eepromDataManager_.load_from_eeprom();
+    UIRB_TRACE(EEPROM_RELOAD, this->eepromDataManager_.hardware_version_matches());
+#if defined(UIRB_CORE_WARM_RESTART)
+    if (this->eepromDataManager_.hardware_version_matches())
+    {
+        WarmRestart::store_eeprom_data(this->eepromDataManager_.get());
+    }
+    else
+    {
+        WarmRestart::invalidate();
+    }
+#endif  // defined(UIRB_CORE_WARM_RESTART)
 
     return this->getChargerProgResistorResistance() != eeprom::EEPROMDataManager::INVALID_CHARGER_PROG_RESISTANCE;
 }
@@ -235,7 +410,17 @@ bool UIRB::saveToEEPROM()
     {
         return false;
     }
-    return this->eepromDataManager_.save_to_eeprom();
+    WatchdogSupervisor::markEvent(CoreEvent::EEPROM_SAVE);
+    const bool saved = this->eepromDataManager_.save_to_eeprom();
+    UIRB_TRACE(EEPROM_COMMIT, saved);
+    if (!saved)
+    {
+        return false;
+    }
+#if defined(UIRB_CORE_WARM_RESTART)
+    WarmRestart::store_eeprom_data(this->eepromDataManager_.get());
+#endif  // defined(UIRB_CORE_WARM_RESTART)
+    return true;
 }
 
 eeprom::EEPROMData UIRB::getDataStoredInRAM() const
@@ -248,6 +433,67 @@ void UIRB::getDataStoredInRAM(eeprom::EEPROMData& data) const
     return this->eepromDataManager_.get(data);
 }
 
+bool UIRB::getSetting(const eeprom::SettingId id, uint32_t& value) const
+{
+    return this->eepromDataManager_.get_setting(id, value);
+}
+
+bool UIRB::setSetting(const eeprom::SettingId id, const uint32_t value, const bool saveToEEPROM)
+{
+    bool res = this->setSetting(id, value);
+    if (!saveToEEPROM)
+    {
+        return false;
+    }
+    return res && this->saveToEEPROM();
+}
+
+bool UIRB::setSetting(const eeprom::SettingId id, const uint32_t value)
+{
+    eeprom::SettingDescriptor descriptor;
+    return eeprom::EEPROMDataManager::get_setting_descriptor(id, descriptor) &&
+           (descriptor.flags & eeprom::SETTING_FLAG_USER_WRITABLE) &&
+           this->eepromDataManager_.set_setting(id, value);
+}
+
+bool UIRB::getSettings(const eeprom::SettingId* ids, uint32_t* values, const uint8_t count) const
+{
+    bool valid = true;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        valid &= this->eepromDataManager_.get_setting(ids[i], values[i]);
+    }
+    return valid;
+}
+
+bool UIRB::setSettings(const eeprom::SettingId* ids, const uint32_t* values, const uint8_t count, const bool saveToEEPROM)
+{
+    bool res = this->setSettings(ids, values, count);
+    if (!saveToEEPROM)
+    {
+        return false;
+    }
+    return res && this->saveToEEPROM();
+}
+
+bool UIRB::setSettings(const eeprom::SettingId* ids, const uint32_t* values, const uint8_t count)
+{
+    eeprom::EEPROMDataManager pending(this->eepromDataManager_.get());
+    for (uint8_t i = 0; i < count; i++)
+    {
+        eeprom::SettingDescriptor descriptor;
+        if (!eeprom::EEPROMDataManager::get_setting_descriptor(ids[i], descriptor) ||
+            !(descriptor.flags & eeprom::SETTING_FLAG_USER_WRITABLE) ||
+            !pending.set_setting(ids[i], values[i]))
+        {
+            return false;
+        }
+    }
+
+    this->eepromDataManager_.set(pending);
+    return true;
+}
+
 void UIRB::powerDown(const uint32_t sleeptime_milliseconds, const WakeupInterrupt wakeupSource)
 {
 #if defined(AVR_DEBUG)
@@ -257,6 +503,30 @@ void UIRB::powerDown(const uint32_t sleeptime_milliseconds, const WakeupInterrup
     {
         return;
     }
+
+#if defined(UIRB_CORE_DEFERRED_WORK)
+    // Pending work would otherwise wait for the wakeup, it may also start software timers bounding the sleep time
+    DeferredQueue::run();
+#endif  // defined(UIRB_CORE_DEFERRED_WORK)
+    const uint16_t wdt_intervals[] = {16, 32, 64, 125, 250, 500, 1000, 2000, 4000, 8000}; // ms for WDTO_15MS to WDTO_8S
+    uint32_t remaining_time = sleeptime_milliseconds;
+#if defined(UIRB_CORE_TIMER_WHEEL)
+    // Software timers bound the sleep time, sleeping shorter than the shortest watchdog interval is not possible
+    const uint32_t wheel_time = TimerWheel::getMillisecondsToNextExpiry();
+    const bool wheel_bounded = wheel_time != TimerWheel::NO_EXPIRY && (remaining_time == UIRB::SLEEP_FOREVER || wheel_time < remaining_time);
+    if (wheel_bounded)
+    {
+        if (wheel_time < wdt_intervals[0])
+        {
+            return;
+        }
+        remaining_time = wheel_time;
+    }
+#endif  // defined(UIRB_CORE_TIMER_WHEEL)
+    uint32_t slept_time = 0;
+
+    WatchdogSupervisor::markEvent(CoreEvent::POWER_DOWN);
+    UIRB_PROFILE_SCOPE(POWER_DOWN);
     bool attachWake = wakeupSource == WakeupInterrupt::WAKE_BUTTON || wakeupSource == WakeupInterrupt::WAKE_BUTTON_AND_USB_IO3;
     bool attachIO3 = this->isWakeupFromIO3Allowed() && (wakeupSource == WakeupInterrupt::USB_IO3 ||
                                                         wakeupSource == WakeupInterrupt::WAKE_BUTTON_AND_USB_IO3);
@@ -275,13 +545,47 @@ void UIRB::powerDown(const uint32_t sleeptime_milliseconds, const WakeupInterrup
 
     set_sleep_mode(SLEEP_MODE_PWR_DOWN);
 
+#if defined(UIRB_CORE_WDT_SUPERVISOR)
+    // The watchdog is used as the sleep timer, supervision is resumed after waking up
+    const bool resumeSupervisor = WatchdogSupervisor::suspend_for_sleep();
+#endif  // defined(UIRB_CORE_WDT_SUPERVISOR)
+
     noInterrupts();
     
     if (attachWake)
     {
+#if defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
+        // The edge is configured since construction, a press while awake is latched and would wake up right away
+        EIFR = _BV(INTF0);
+        EIMSK |= _BV(INT0);
+#else  // defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
         attachInterrupt(digitalPinToInterrupt(PIN_BUTTON_WAKEUP), button_wakeup_isr, FALLING);
+#endif  // defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
     }
     
+#if defined(UIRB_CORE_PCINT_DISPATCHER)
+    // The pin may already be used by the application, the wakeup is skipped then
+    if (attachIO3 && !PinChangeDispatcher::isAttached(PIN_USB_IO3))
+    {
+        io3Mode_old = getPinMode(PIN_USB_IO3);
+        io3State_old = digitalRead(PIN_USB_IO3);
+        pinMode(PIN_USB_IO3, INPUT_PULLUP);
+        PinChangeDispatcher::attach(PIN_USB_IO3, usb_io3_pin_change);
+    }
+    else
+    {
+        attachIO3 = false;
+    }
+#elif defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
+    if (attachIO3)
+    {
+        io3Mode_old = getPinMode(PIN_USB_IO3);
+        io3State_old = digitalRead(PIN_USB_IO3);
+        pinMode(PIN_USB_IO3, INPUT_PULLUP);
+        PCIFR = _BV(digitalPinToPCICRbit(PIN_USB_IO3)); // Drop changes latched while awake
+        PCICR |= _BV(digitalPinToPCICRbit(PIN_USB_IO3)); // The pin is already in PCMSK
+    }
+#else  // defined(UIRB_CORE_PCINT_DISPATCHER)
     if (attachIO3)
     {
         volatile uint8_t* pcicr = digitalPinToPCICR(PIN_USB_IO3);
@@ -299,19 +603,26 @@ void UIRB::powerDown(const uint32_t sleeptime_milliseconds, const WakeupInterrup
             attachIO3 = false;
         }
     }
+#endif  // defined(UIRB_CORE_PCINT_DISPATCHER)
 
-    uint32_t remaining_time = sleeptime_milliseconds;
-    const uint16_t wdt_intervals[] = {16, 32, 64, 125, 250, 500, 1000, 2000, 4000, 8000}; // ms for WDTO_15MS to WDTO_8S
     uint8_t wdt_period = 0;
     
     this->isr_wakeup_button_flag_internal_ = false;
     this->isr_wakeup_io3_flag_internal_ = false;
     pcint2_interrupt_flag = false;
+    UIRB_TRACE(SLEEP, wakeupSource);
 
-    if (sleeptime_milliseconds > 0)
+    if (remaining_time > 0)
     {
         while (remaining_time > 0)
         {
+#if defined(UIRB_CORE_TIMER_WHEEL)
+            // Waking up early is fine, overshooting the next timer is not
+            if (wheel_bounded && remaining_time < wdt_intervals[0])
+            {
+                break;
+            }
+#endif  // defined(UIRB_CORE_TIMER_WHEEL)
             // Find the largest interval less than or equal to remaining_time
             for (int8_t i = sizeof(wdt_intervals) / sizeof(wdt_intervals[0]) - 1; i >= 0; --i)
             {
@@ -326,15 +637,15 @@ void UIRB::powerDown(const uint32_t sleeptime_milliseconds, const WakeupInterrup
             wdt_enable(wdt_period);
             bitSet(WDTCSR, WDIE); // Set Watchdog interrupt enable
 
-            cli();
-            sleep_enable();
-            sei();
-            sleep_cpu(); // enter sleep mode
-            sleep_disable();
-            sei();
+            sleep_until_interrupt();
 
             // Disable watchdog after waking up
             wdt_disable();
+            // The part of an interval cut short by an IO wakeup is unknown and not counted
+            if (!this->isr_wakeup_button_flag_internal_ && !pcint2_interrupt_flag)
+            {
+                slept_time += wdt_intervals[wdt_period];
+            }
             // Calculate remaining time, set to 0 if wakeup was triggered from IO
             if (this->isr_wakeup_button_flag_internal_ || pcint2_interrupt_flag)
             {
@@ -352,28 +663,38 @@ void UIRB::powerDown(const uint32_t sleeptime_milliseconds, const WakeupInterrup
     }
     else
     {
-        cli();
-        sleep_enable();
-        sei();
-        sleep_cpu(); // enters sleep mode
-        sleep_disable();
-        sei();
+        sleep_until_interrupt();
     }
 
+    // Account the time slept before anything, including the WAKE trace entry, reads the uptime
+    noInterrupts();
+    slept_milliseconds += slept_time;
+    interrupts();
+
     if (pcint2_interrupt_flag)
     {
         noInterrupts();
         UIRB::usb_io3_wakeup_isr();
         interrupts();
     }
+    UIRB_TRACE(WAKE, (this->isr_wakeup_button_flag_internal_ ? 0x01U : 0x00U) | (pcint2_interrupt_flag ? 0x02U : 0x00U));
 
     if (attachWake)
     {
+#if defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
+        EIMSK &= ~_BV(INT0);
+#else  // defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
         detachInterrupt(digitalPinToInterrupt(PIN_BUTTON_WAKEUP));
+#endif  // defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
     }
 
     if (attachIO3)
     {
+#if defined(UIRB_CORE_PCINT_DISPATCHER)
+        PinChangeDispatcher::detach(PIN_USB_IO3);
+#elif defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
+        PCICR &= ~_BV(digitalPinToPCICRbit(PIN_USB_IO3));
+#else  // defined(UIRB_CORE_PCINT_DISPATCHER)
         volatile uint8_t* pcicr = digitalPinToPCICR(PIN_USB_IO3);
         volatile uint8_t* pcmsk = digitalPinToPCMSK(PIN_USB_IO3);
         if (pcicr != nullptr && pcmsk != nullptr)
@@ -381,6 +702,7 @@ void UIRB::powerDown(const uint32_t sleeptime_milliseconds, const WakeupInterrup
             *pcicr &= ~(1 << digitalPinToPCICRbit(PIN_USB_IO3)); // Disable the PCINT group in PCICR
             *pcmsk &= ~(1 << digitalPinToPCMSKbit(PIN_USB_IO3)); // Disable specific pin interrupt in PCMSK
         }
+#endif  // defined(UIRB_CORE_PCINT_DISPATCHER)
 
         if (io3Mode_old != INVALID_PIN_MODE)
         {
@@ -389,6 +711,14 @@ void UIRB::powerDown(const uint32_t sleeptime_milliseconds, const WakeupInterrup
         }
     }
 
+#if defined(UIRB_CORE_WDT_SUPERVISOR)
+    WatchdogSupervisor::resume_after_sleep(resumeSupervisor);
+#endif  // defined(UIRB_CORE_WDT_SUPERVISOR)
+
+#if defined(UIRB_CORE_TIMER_WHEEL)
+    TimerWheel::resume_after_sleep();
+#endif  // defined(UIRB_CORE_TIMER_WHEEL)
+
     power_adc_enable();
     ADCSRA = adcsra_old; // restore adc state
     ACSR = acsr_old; // restore comparator state
@@ -398,6 +728,16 @@ void UIRB::powerDown(const uint32_t sleeptime_milliseconds, const WakeupInterrup
         setAnalogReference(oldAnalogRef);
     }
 
+#if defined(UIRB_CORE_DEFERRED_WORK)
+    // The button callback was scheduled by its interrupt, both run from the queue with any other pending work
+    if (attachIO3 && this->isr_wakeup_io3_flag_internal_ && this->io3_wakeup_user_callback_ != nullptr)
+    {
+        DeferredQueue::schedule(this->io3_wakeup_work_);
+    }
+    this->isr_wakeup_button_flag_internal_ = false;
+    this->isr_wakeup_io3_flag_internal_ = false;
+    DeferredQueue::run();
+#else  // defined(UIRB_CORE_DEFERRED_WORK)
     if (this->isr_wakeup_button_flag_internal_ && this->button_wakeup_user_callback_ != nullptr)
     {
         this->button_wakeup_user_callback_();
@@ -409,19 +749,54 @@ void UIRB::powerDown(const uint32_t sleeptime_milliseconds, const WakeupInterrup
         this->io3_wakeup_user_callback_();
     }
     this->isr_wakeup_io3_flag_internal_ = false;
+#endif  // defined(UIRB_CORE_DEFERRED_WORK)
 #endif  // defined(AVR_DEBUG)
 }
 
+uint32_t UIRB::getUptimeMilliseconds()
+{
+    uint8_t oldSREG = SREG;
+    cli();
+    const uint32_t slept = slept_milliseconds;
+    SREG = oldSREG;
+    return millis() + slept;
+}
+
 #if !defined(AVR_DEBUG)
+#if !defined(UIRB_CORE_WDT_SUPERVISOR)
+// Supervisor provides its own handler in Watchdog.cpp, which also covers sleep timing
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+ISR (WDT_vect, ISR_NOBLOCK)
+#else  // defined(UIRB_CORE_IRQ_PRIORITY)
 ISR (WDT_vect)
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
 {
+    UIRB_PROFILE_SCOPE(ISR_WDT);
     wdt_disable();
 }
+#endif  // !defined(UIRB_CORE_WDT_SUPERVISOR)
 
+#if defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
+// Replaces the function pointer table of attachInterrupt(), the handler is inlined.
+// WInterrupts.c defines INT0_vect and INT1_vect together, so attachInterrupt() cannot be linked in at all.
+ISR (INT0_vect)
+{
+    UIRB::button_wakeup_isr();
+}
+#endif  // defined(UIRB_CORE_STATIC_WAKEUP_VECTORS)
+
+#if !defined(UIRB_CORE_PCINT_DISPATCHER) && !defined(UIRB_CORE_NO_PCINT_VECTORS)
+// The dispatcher defines PCINT2_vect itself and reports PIN_USB_IO3 through usb_io3_pin_change()
+#if defined(UIRB_CORE_IRQ_PRIORITY)
+ISR (PCINT2_vect, ISR_NOBLOCK)
+#else  // defined(UIRB_CORE_IRQ_PRIORITY)
 ISR (PCINT2_vect)
+#endif  // defined(UIRB_CORE_IRQ_PRIORITY)
 {
+    UIRB_PROFILE_SCOPE(ISR_PCINT2);
     pcint2_interrupt_flag = true;
 }
+#endif  // !defined(UIRB_CORE_PCINT_DISPATCHER) && !defined(UIRB_CORE_NO_PCINT_VECTORS)
 #endif
 
 uint8_t UIRB::getVersionMajor() const
@@ -467,17 +842,12 @@ uint8_t UIRB::getStatusLEDBrightness() const
 
 bool UIRB::setStatusLEDBrightness(const uint8_t brightness, const bool saveToEEPROM)
 {
-    this->eepromDataManager_.set_stat_led_brightness(brightness);
-    if (!saveToEEPROM)
-    {
-        return false;
-    }
-    return this->saveToEEPROM();
+    return this->setSetting(eeprom::SettingId::STAT_LED_BRIGHTNESS, brightness, saveToEEPROM);
 }
 
 void UIRB::setStatusLEDBrightness(const uint8_t brightness)
 {
-    this->eepromDataManager_.set_stat_led_brightness(brightness);
+    this->setSetting(eeprom::SettingId::STAT_LED_BRIGHTNESS, brightness);
 }
 
 uint16_t UIRB::getChargerProgResistorResistance() const
@@ -501,41 +871,31 @@ bool UIRB::isSleepingAllowed() const
 
 bool UIRB::setSleepingAllowed(const bool allowed, const bool saveToEEPROM)
 {
-    this->eepromDataManager_.allow_sleep_mode(allowed);
-    if (!saveToEEPROM)
-    {
-        return false;
-    }
-    return this->saveToEEPROM();
+    return this->setSetting(eeprom::SettingId::SLEEP_MODE_ALLOWED, allowed, saveToEEPROM);
 }
 
 void UIRB::setSleepingAllowed(const bool allowed)
 {
-    this->eepromDataManager_.allow_sleep_mode(allowed);
+    this->setSetting(eeprom::SettingId::SLEEP_MODE_ALLOWED, allowed);
 }
 
 bool UIRB::isWakeupFromIO3Allowed() const
 {
-#if defined(AVR_DEBUG)
+#if defined(AVR_DEBUG) || defined(UIRB_CORE_NO_PCINT_VECTORS)
     return false;
 #else  // defined(AVR_DEBUG)
     return this->eepromDataManager_.is_sleep_mode_io3_wakeup_allowed();
-#endif  // defined(AVR_DEBUG)
+#endif  // defined(AVR_DEBUG) || defined(UIRB_CORE_NO_PCINT_VECTORS)
 }
 
 bool UIRB::setWakeupFromIO3Allowed(const bool allowed, const bool saveToEEPROM)
 {
-    this->eepromDataManager_.allow_sleep_mode_io3_wakeup(allowed);
-    if (!saveToEEPROM)
-    {
-        return false;
-    }
-    return this->saveToEEPROM();
+    return this->setSetting(eeprom::SettingId::SLEEP_MODE_IO3_WAKEUP, allowed, saveToEEPROM);
 }
 
 void UIRB::setWakeupFromIO3Allowed(const bool allowed)
 {
-    this->eepromDataManager_.allow_sleep_mode_io3_wakeup(allowed);
+    this->setSetting(eeprom::SettingId::SLEEP_MODE_IO3_WAKEUP, allowed);
 }
 
 bool UIRB::isBootCountingEnabled() const
@@ -588,17 +948,12 @@ uint16_t UIRB::getInternalBandgapReferenceVoltageMilivolts() const
 
 bool UIRB::setInternalBandgapReferenceVoltageMilivolts(const uint16_t milivolts, const bool saveToEEPROM)
 {
-    bool res = this->setInternalBandgapReferenceVoltageMilivolts(milivolts);
-    if (!saveToEEPROM)
-    {
-        return false;
-    }
-    return res && this->saveToEEPROM();
+    return this->setSetting(eeprom::SettingId::BANDGAP_REFERENCE_MILIVOLTS, milivolts, saveToEEPROM);
 }
 
 bool UIRB::setInternalBandgapReferenceVoltageMilivolts(const uint16_t milivolts)
 {
-    return this->eepromDataManager_.set_bandgap_reference_milivolts(milivolts);
+    return this->setSetting(eeprom::SettingId::BANDGAP_REFERENCE_MILIVOLTS, milivolts);
 }
 
 float UIRB::getInternalBandgapReferenceVoltage() const
@@ -615,6 +970,9 @@ uint16_t UIRB::getProgVoltageMilivolts(const uint8_t samples)
     {
         return UIRB::INVALID_VOLTAGE_MILIVOLTS;
     }
+#if defined(UIRB_CORE_ADC_CALIBRATION)
+    result_prog_raw = AdcCalibration::correct(result_prog_raw, (adcRef == DEFAULT) ? AdcReference::AVCC : AdcReference::BANDGAP_1V1);
+#endif  // defined(UIRB_CORE_ADC_CALIBRATION)
 
     uint16_t reference_voltage_milivolts = this->getInternalBandgapReferenceVoltageMilivolts();
 
@@ -641,8 +999,13 @@ uint16_t UIRB::getSupplyVoltageMilivolts(const uint8_t samples)
     // Expected higher than ADC_BANDGAP_AVCC_SAMPLE_MIN, lower than 1024, higher the value, lower the AVcc
     uint16_t result_avcc_raw = 0;
     
-    // Check if adc samling was successful and if the result is in valid range (most important not 0)
-    if (!this->get_raw_bandgap_adc_sample(&result_avcc_raw, samples) || result_avcc_raw <= UIRB::ADC_BANDGAP_AVCC_SAMPLE_MIN || result_avcc_raw > UIRB::ADC_RESOLUTION_DEC - 1)
+    if (!this->get_raw_bandgap_adc_sample(&result_avcc_raw, samples))
+    {
+        return UIRB::INVALID_VOLTAGE_MILIVOLTS;
+    }
+
+    // Check if the result is in valid range (most important not 0)
+    if (result_avcc_raw <= UIRB::ADC_BANDGAP_AVCC_SAMPLE_MIN || result_avcc_raw > UIRB::ADC_RESOLUTION_DEC - 1)
     {
         return UIRB::INVALID_VOLTAGE_MILIVOLTS;
     }
@@ -657,45 +1020,9 @@ uint16_t UIRB::getSupplyVoltageMilivolts(const uint8_t samples)
 
 void UIRB::notifyStatusLowBattery()
 {
-    uint8_t oldMode = getPinMode(PIN_STAT_LED);
-    uint8_t oldState = digitalRead(PIN_STAT_LED);
-    
-    if (oldMode != OUTPUT)
-    {
-        pinMode(PIN_STAT_LED, OUTPUT);
-    }
-
-    digitalWrite(PIN_STAT_LED, LOW);
-    delay(500); // Pause
-    // Morse code for "L": dot-dash-dot-dot
-    digitalWrite(PIN_STAT_LED, HIGH); // Dot
-    delay(50);
-    digitalWrite(PIN_STAT_LED, LOW);
-    delay(200);
-
-    digitalWrite(PIN_STAT_LED, HIGH); // Dash
-    delay(200);
-    digitalWrite(PIN_STAT_LED, LOW);
-    delay(200);
-
-    digitalWrite(PIN_STAT_LED, HIGH); // Dot
-    delay(50);
-    digitalWrite(PIN_STAT_LED, LOW);
-    delay(200);
-
-    digitalWrite(PIN_STAT_LED, HIGH); // Dot
-    delay(50);
-    digitalWrite(PIN_STAT_LED, LOW);
-    delay(500); // Pause
-
-    if (oldMode != INVALID_PIN_MODE)
-    {
-        pinMode(PIN_STAT_LED, oldMode);
-        if (oldMode == OUTPUT)
-        {
-            digitalWrite(PIN_STAT_LED, oldState);
-        }
-    }
+    WatchdogSupervisor::markEvent(CoreEvent::LOW_BATTERY_NOTIFY);
+    StatusLedPatternTask pattern(StatusLedPatternTask::LOW_BATTERY_PATTERN, StatusLedPatternTask::LOW_BATTERY_PATTERN_LENGTH);
+    runTask(pattern);
 }
 
 CoreResult UIRB::get_raw_bandgap_adc_sample(uint16_t* result, const uint8_t samples)
@@ -704,61 +1031,12 @@ CoreResult UIRB::get_raw_bandgap_adc_sample(uint16_t* result, const uint8_t samp
     {
         return CoreResult::ERROR_INVALID_ARGUMENT;
     }
+    WatchdogSupervisor::markEvent(CoreEvent::ADC_BANDGAP);
+    UIRB_PROFILE_SCOPE(ADC_BANDGAP);
 
-    // Make sure that the IR LED is off
-    digitalWrite(PIN_IR_LED, LOW);
-
-    // Can store up to 256 10bit samples, should not exceed 18 bits
-    uint32_t sample_sum = 0;
-
-    // wiring library applies 0x07 mask to MUX[3..0] turning it into MUX[2..0] (ADMUX register) 
-    // analogReference() and analogRead() Can set REFS1/REFS0 but mask in analogRead 
-    // does not allow setting of MUX3 bit required for any other Single Ended Input
-    // that is not ADC channel or temperature sensor. Vbg => MUX[3..0] = 0b1110
-    uint8_t oldADCRef = getAnalogReference();
-    uint8_t oldADCSRA = ADCSRA;
-    
-    ADCSRA |= bit (ADPS0) |  bit (ADPS1) | bit (ADPS2);  // Prescaler of 128
-    // Read 1.1V reference against AVcc manually. Do first conversion with 1.1V reference
-    ADMUX = _BV(REFS0) | _BV(MUX3) | _BV(MUX2) | _BV(MUX1); // sets `DEFAULT` analog reference and 1v1 as analog input
-    ADCSRA |= _BV(ADSC); // Convert
-    while (bit_is_set(ADCSRA,ADSC)); // Wait for conversion to complete
-    delay(UIRB::ADC_VREF_SETTLE_DELAY_MS); // Wait for Vref to settle
-
-    for(uint8_t i = 0; i < samples; i++)
-    {
-        ADCSRA |= _BV(ADSC); // Convert
-        while (bit_is_set(ADCSRA,ADSC)); // Wait for conversion to complete
-        // ADC macro takes care of reading ADC register.
-        // avr-gcc implements the proper reading order: ADCL is read first.
-
-        // if samples is set to 1, store result and return
-        if (samples == 1)
-        {
-            *result = ADC;
-            ADCSRA = oldADCSRA;
-            if (oldADCRef != INVALID_ANALOG_REF && oldADCRef != DEFAULT) // default was already used by this method
-            {
-                setAnalogReference(oldADCRef);
-            }
-            return CoreResult::SUCCESS;
-        }
-
-        sample_sum += ADC;
-        // delay all but last sample
-        if (i < (samples - 1U))
-        {
-            delay(UIRB::ADC_SAMPLE_DELAY_MS);
-        }
-    }
-    sample_sum += (samples / static_cast<uint8_t>(2U)); // https://stackoverflow.com/a/2422723
-    // Store average in result
-    *result = static_cast<uint16_t>(sample_sum / samples);
-    ADCSRA = oldADCSRA;
-    if (oldADCRef != DEFAULT) // default was already used by this method
-    {
-        setAnalogReference(oldADCRef);
-    }
+    BandgapSampleTask sample(samples);
+    runTask(sample);
+    *result = sample.getResult();
     return CoreResult::SUCCESS;
 }
 
@@ -768,9 +1046,13 @@ CoreResult UIRB::get_raw_prog_adc_sample(uint16_t* result, uint8_t& adcReference
     {
         return CoreResult::ERROR_INVALID_ARGUMENT;
     }
+    WatchdogSupervisor::markEvent(CoreEvent::ADC_PROG);
+    UIRB_PROFILE_SCOPE(ADC_PROG);
 
+#if !defined(UIRB_CORE_IR_TX_GATE)
     // Make sure that the IR LED is off
     digitalWrite(PIN_IR_LED, LOW);
+#endif  // !defined(UIRB_CORE_IR_TX_GATE)
     bool oldPinMode = digitalRead(PIN_PROG);
     pinMode(PIN_PROG, INPUT); // It might be set to input_pullup or output with specific state
 
@@ -790,14 +1072,14 @@ CoreResult UIRB::get_raw_prog_adc_sample(uint16_t* result, uint8_t& adcReference
         delay(UIRB::ADC_VREF_SETTLE_DELAY_MS); // Wait for Vref to settle
         if (samples == 1)
         {
-            sample_adc = analogRead(PIN_PROG);
+            sample_adc = read_prog_adc();
         }
         else
         {
             sample_adc = 0;
             for(uint8_t i = 0; i < samples; i++)
             {
-                sample_adc += analogRead(PIN_PROG);
+                sample_adc += read_prog_adc();
                 // delay all but last sample
                 if (i < (samples - 1U))
                 {
@@ -811,6 +1093,7 @@ CoreResult UIRB::get_raw_prog_adc_sample(uint16_t* result, uint8_t& adcReference
         if ((adcReference == INTERNAL1V1) && (sample_adc == UIRB::ADC_SAMPLE_MAX))
         {
             adcReference = DEFAULT;
+            UIRB_TRACE(ADC_REFERENCE, DEFAULT);
             outOfRange = true;
         } 
         else
@@ -0,0 +1,151 @@
+/**
+ * @file WarmRestart.cpp
+ * @brief Implementation of the warm restart fast path for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::WarmRestart class declared in @ref UIRBcore_WarmRestart.hpp.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+#include <UIRBcore_WarmRestart.hpp>
+#include <UIRBcore_MemoryPlan.hpp>
+#include <util/crc16.h>
+
+#if defined(UIRB_CORE_WARM_RESTART)
+namespace
+{
+    /**
+     * @brief Magic value marking an initialized state block.
+     */
+    constexpr uint16_t WARM_RESTART_MAGIC = 0x5752U; // "WR"
+
+    static_assert(__is_trivially_copyable(uirbcore::PowerInfoData), "PowerInfoData must be trivially copyable to be kept in .noinit RAM");
+
+    /**
+     * @brief State block layout. Raw storage is used for @ref uirbcore::PowerInfoData so no constructor 
+     * runs on it at startup.
+     */
+    struct WarmRestartState
+    {
+        uint16_t magic;
+        uirbcore::eeprom::EEPROMData eeprom_data;
+        uint8_t power_info[sizeof(uirbcore::PowerInfoData)];
+        uint16_t crc;
+    };
+
+    WarmRestartState warm_restart_state __attribute__((section(".noinit")));
+
+    static_assert(sizeof(warm_restart_state) == uirbcore::MemoryPlan::WARM_RESTART_BYTES, "Warm restart state does not match uirbcore::MemoryPlan");
+
+    enum class WarmStartStatus : uint8_t
+    {
+        UNCHECKED = 0,
+        WARM,
+        COLD
+    };
+
+    WarmStartStatus warm_start_status = WarmStartStatus::UNCHECKED;
+
+    uint16_t state_crc()
+    {
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(&warm_restart_state);
+        uint16_t crc = 0xFFFFU;
+        for (uint8_t i = 0; i < offsetof(WarmRestartState, crc); i++)
+        {
+            crc = _crc16_update(crc, data[i]);
+        }
+        return crc;
+    }
+
+    void seal_state()
+    {
+        warm_restart_state.magic = WARM_RESTART_MAGIC;
+        warm_restart_state.crc = state_crc();
+    }
+}  // namespace
+
+namespace uirbcore
+{
+    bool WarmRestart::isWarmStart()
+    {
+        if (warm_start_status == WarmStartStatus::UNCHECKED)
+        {
+            const uint8_t reset_flags = WatchdogSupervisor::getResetFlags();
+            const bool ram_retained = reset_flags != 0 && !(reset_flags & (_BV(PORF) | _BV(BORF)));
+
+            warm_start_status = (ram_retained && 
+                                 warm_restart_state.magic == WARM_RESTART_MAGIC && 
+                                 warm_restart_state.crc == state_crc()) ? WarmStartStatus::WARM : WarmStartStatus::COLD;
+        }
+        return warm_start_status == WarmStartStatus::WARM;
+    }
+
+    void WarmRestart::invalidate()
+    {
+        warm_restart_state.magic = 0;
+    }
+
+    const eeprom::EEPROMData& WarmRestart::eeprom_data()
+    {
+        return warm_restart_state.eeprom_data;
+    }
+
+    PowerInfoData WarmRestart::power_info()
+    {
+        PowerInfoData power_info;
+        memcpy(&power_info, warm_restart_state.power_info, sizeof(power_info));
+        return power_info;
+    }
+
+    void WarmRestart::store_eeprom_data(const eeprom::EEPROMData& data)
+    {
+        // A cold start stores the EEPROM image before the first power snapshot exists
+        if (warm_restart_state.magic != WARM_RESTART_MAGIC)
+        {
+            const PowerInfoData empty_power_info;
+            memcpy(warm_restart_state.power_info, &empty_power_info, sizeof(empty_power_info));
+        }
+        warm_restart_state.eeprom_data = data;
+        seal_state();
+    }
+
+    void WarmRestart::store_power_info(const PowerInfoData& power_info)
+    {
+        if (warm_restart_state.magic != WARM_RESTART_MAGIC)
+        {
+            return;
+        }
+        memcpy(warm_restart_state.power_info, &power_info, sizeof(power_info));
+        seal_state();
+    }
+}  // namespace uirbcore
+#endif  // defined(UIRB_CORE_WARM_RESTART)
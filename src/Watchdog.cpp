@@ -0,0 +1,319 @@
+/**
+ * @file Watchdog.cpp
+ * @brief Implementation of the watchdog supervisor and reset cause tracking for the %UIRB system.
+ *
+ * This file implements the @ref uirbcore::WatchdogSupervisor class. It provides:
+ * - An `.init3` hook that mirrors `MCUSR` into `.noinit` RAM and disables the watchdog before
+ *   static constructors run.
+ * - The watchdog interrupt handler shared between the supervisor and @ref uirbcore::UIRB::powerDown().
+ * - The EEPROM reset log used to persist abnormal resets.
+ *
+ * @details
+ * The watchdog interrupt is split in two parts when @ref UIRB_CORE_WDT_SUPERVISOR is defined. A naked
+ * entry stub reads the return address pushed by the interrupt before any register is saved, then jumps to
+ * a regular signal handler. This keeps the captured address independent of the handler's prologue.
+ *
+ * @author 
+ * Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * @version 0.2.0.0
+ * @date 2026-10-18
+ * 
+ * @copyright Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * MIT License
+ * 
+ * Copyright (c) 2024 Djordje Mandic (https://linktr.ee/djordjemandic)
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <Arduino.h>
+#include <UIRBcore.hpp>
+#include <UIRBcore_Watchdog.hpp>
+#include <UIRBcore_MemoryPlan.hpp>
+#include <UIRBcore_EEPROMRingLog.hpp>
+#include <avr/wdt.h>
+#include <avr/interrupt.h>
+
+#if defined(UIRB_CORE_WDT_SUPERVISOR) && defined(AVR_DEBUG)
+    #error "UIRB_CORE_WDT_SUPERVISOR cannot be used together with the AVR serial debugger (AVR_DEBUG)."
+#endif  // defined(UIRB_CORE_WDT_SUPERVISOR) && defined(AVR_DEBUG)
+
+namespace
+{
+    /**
+     * @brief `MCUSR` value captured in `.init3`. Placed in `.noinit` because `.bss` is cleared after `.init3`.
+     */
+    uint8_t reset_flags __attribute__((section(".noinit")));
+
+#if defined(UIRB_CORE_WDT_SUPERVISOR)
+    /**
+     * @brief Magic value marking a valid @ref PostMortem capture.
+     */
+    constexpr uint16_t POST_MORTEM_MAGIC = 0x5744U; // "WD"
+
+    /**
+     * @brief Hang record written by the watchdog interrupt, guarded by a magic value and its complement.
+     */
+    struct PostMortem
+    {
+        uint16_t magic;
+        uirbcore::ResetRecord record;
+        uint16_t magic_complement;
+    };
+
+    /**
+     * @brief Hang record surviving the watchdog reset.
+     */
+    PostMortem post_mortem __attribute__((section(".noinit")));
+
+    static_assert(sizeof(post_mortem) == uirbcore::MemoryPlan::POST_MORTEM_BYTES, "Post-mortem record does not match uirbcore::MemoryPlan");
+
+    /**
+     * @brief Set in `.init3` if @ref post_mortem belongs to the reset that just happened.
+     */
+    bool post_mortem_valid __attribute__((section(".noinit")));
+
+    /**
+     * @brief Watchdog operating modes, selecting the behavior of the watchdog interrupt.
+     */
+    enum class WatchdogMode : uint8_t
+    {
+        DISABLED = 0, /**< The watchdog is not used. */
+        SLEEP_TIMER, /**< The watchdog times @ref uirbcore::UIRB::powerDown() intervals. */
+        SUPERVISOR /**< The watchdog supervises the application. */
+    };
+
+    volatile WatchdogMode watchdog_mode = WatchdogMode::DISABLED;
+    uint8_t supervisor_timeout = WDTO_2S;
+
+    /**
+     * @brief Word address of the interrupted instruction, written by the naked watchdog entry stub.
+     */
+    volatile uint16_t fault_word_address = 0;
+
+    /**
+     * @brief Reset log stored in EEPROM right after the core data block.
+     */
+    constexpr uirbcore::eeprom::EEPROMRingLog RESET_LOG(UIRB_EEPROM_RESET_LOG_ADDR_START, UIRB_CORE_WDT_RESET_LOG_SLOTS, sizeof(uirbcore::ResetRecord));
+
+    static_assert(UIRB_EEPROM_RESET_LOG_ADDR_START + uirbcore::eeprom::EEPROMRingLog::regionSize(UIRB_CORE_WDT_RESET_LOG_SLOTS, sizeof(uirbcore::ResetRecord)) <= (E2END + 1U),
+                  "Watchdog reset log does not fit into EEPROM");
+    static_assert(RESET_LOG.size() == UIRB_EEPROM_RESET_LOG_SIZE, "Watchdog reset log does not match UIRB_EEPROM_RESET_LOG_SIZE");
+#endif  // defined(UIRB_CORE_WDT_SUPERVISOR)
+}  // namespace
+
+extern "C" void uirb_capture_reset_flags() __attribute__((naked, used, section(".init3")));
+
+/**
+ * @brief Captures and clears the reset cause, then disables the watchdog.
+ *
+ * Runs from `.init3`, before `.bss` is cleared and before static constructors run. Clearing `WDRF` and
+ * disabling the watchdog here prevents an endless reset loop after a watchdog reset, as the watchdog
+ * stays enabled with the shortest timeout after it fires.
+ *
+ * @note Optiboot clears `MCUSR` before starting the application and passes its value in `r2`.
+ */
+void uirb_capture_reset_flags()
+{
+    uint8_t flags = MCUSR;
+    if (flags == 0)
+    {
+        __asm__ __volatile__ ("mov %0, r2" : "=r" (flags));
+    }
+    MCUSR = 0;
+    wdt_disable();
+    reset_flags = flags;
+
+#if defined(UIRB_CORE_WDT_SUPERVISOR)
+    post_mortem_valid = (flags & _BV(WDRF)) &&
+                        post_mortem.magic == POST_MORTEM_MAGIC &&
+                        post_mortem.magic_complement == static_cast<uint16_t>(~POST_MORTEM_MAGIC);
+    // Consume the capture so a later watchdog reset without a hang is not attributed to it
+    post_mortem.magic = 0;
+#endif  // defined(UIRB_CORE_WDT_SUPERVISOR)
+}
+
+namespace uirbcore
+{
+    uint8_t WatchdogSupervisor::getResetFlags()
+    {
+        return reset_flags;
+    }
+
+    bool WatchdogSupervisor::wasWatchdogReset()
+    {
+        return reset_flags & _BV(WDRF);
+    }
+
+    bool WatchdogSupervisor::wasBrownOutReset()
+    {
+        return reset_flags & _BV(BORF);
+    }
+
+#if defined(UIRB_CORE_WDT_SUPERVISOR)
+    volatile CoreEvent WatchdogSupervisor::last_event_ = CoreEvent::NONE;
+
+    void WatchdogSupervisor::begin(const uint8_t timeout)
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        supervisor_timeout = timeout;
+        watchdog_mode = WatchdogMode::SUPERVISOR;
+        wdt_enable(timeout);
+        bitSet(WDTCSR, WDIE); // Interrupt first, reset on the following timeout
+        SREG = oldSREG;
+    }
+
+    void WatchdogSupervisor::end()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        watchdog_mode = WatchdogMode::DISABLED;
+        wdt_disable();
+        SREG = oldSREG;
+    }
+
+    bool WatchdogSupervisor::isActive()
+    {
+        return watchdog_mode == WatchdogMode::SUPERVISOR;
+    }
+
+    bool WatchdogSupervisor::getPostMortem(ResetRecord& record)
+    {
+        if (post_mortem_valid)
+        {
+            record = post_mortem.record;
+        }
+        else
+        {
+            record = ResetRecord();
+        }
+        record.reset_flags = reset_flags;
+        return post_mortem_valid;
+    }
+
+    uint8_t WatchdogSupervisor::getResetLogCount()
+    {
+        return RESET_LOG.count();
+    }
+
+    bool WatchdogSupervisor::readResetLog(const uint8_t age, ResetRecord& record)
+    {
+        return RESET_LOG.read(age, &record);
+    }
+
+    void WatchdogSupervisor::clearResetLog()
+    {
+        RESET_LOG.clear();
+    }
+
+    bool WatchdogSupervisor::suspend_for_sleep()
+    {
+        uint8_t oldSREG = SREG;
+        cli();
+        bool resume = watchdog_mode == WatchdogMode::SUPERVISOR;
+        wdt_disable();
+        watchdog_mode = WatchdogMode::SLEEP_TIMER;
+        SREG = oldSREG;
+        return resume;
+    }
+
+    void WatchdogSupervisor::resume_after_sleep(const bool resume)
+    {
+        if (resume)
+        {
+            WatchdogSupervisor::begin(supervisor_timeout);
+        }
+        else
+        {
+            watchdog_mode = WatchdogMode::DISABLED;
+        }
+    }
+
+    void WatchdogSupervisor::log_reset()
+    {
+        if (!(reset_flags & (_BV(WDRF) | _BV(BORF))))
+        {
+            return;
+        }
+
+        ResetRecord record;
+        WatchdogSupervisor::getPostMortem(record);
+        RESET_LOG.append(&record);
+    }
+#endif  // defined(UIRB_CORE_WDT_SUPERVISOR)
+}  // namespace uirbcore
+
+#if defined(UIRB_CORE_WDT_SUPERVISOR)
+extern "C" void __vector_uirb_wdt_handler(void) __attribute__((signal, used, externally_visible));
+
+/**
+ * @brief Body of the watchdog interrupt, entered from the naked `WDT_vect` stub.
+ *
+ * In sleep timer mode the watchdog is simply disabled. In supervisor mode the hang is recorded into
+ * `.noinit` RAM and the watchdog is reprogrammed to reset the MCU as soon as possible.
+ */
+void __vector_uirb_wdt_handler(void)
+{
+    if (watchdog_mode != WatchdogMode::SUPERVISOR)
+    {
+        UIRB_PROFILE_SCOPE(ISR_WDT);
+        wdt_disable();
+        return;
+    }
+
+    post_mortem.record.reset_flags = 0;
+    post_mortem.record.last_event = uirbcore::WatchdogSupervisor::getLastEvent();
+    post_mortem.record.fault_address = fault_word_address << 1;
+    post_mortem.record.uptime_milliseconds = millis();
+    post_mortem.magic_complement = static_cast<uint16_t>(~POST_MORTEM_MAGIC);
+    post_mortem.magic = POST_MORTEM_MAGIC;
+
+    wdt_enable(WDTO_15MS);
+    while (1);
+}
+
+/**
+ * @brief Naked watchdog interrupt entry.
+ *
+ * The interrupt pushed the return address high byte at `SP+1` and low byte at `SP+2`. After saving three
+ * registers they are found at `SP+4` and `SP+5`. The stub stores them and continues in
+ * @ref __vector_uirb_wdt_handler, which returns to the interrupted code with `reti`.
+ */
+ISR (WDT_vect, ISR_NAKED)
+{
+    __asm__ __volatile__ (
+        "push r0"                           "\n\t"
+        "push r30"                          "\n\t"
+        "push r31"                          "\n\t"
+        "in r30, __SP_L__"                  "\n\t"
+        "in r31, __SP_H__"                  "\n\t"
+        "ldd r0, Z+4"                       "\n\t"
+        "sts %[address]+1, r0"              "\n\t"
+        "ldd r0, Z+5"                       "\n\t"
+        "sts %[address], r0"                "\n\t"
+        "pop r31"                           "\n\t"
+        "pop r30"                           "\n\t"
+        "pop r0"                            "\n\t"
+        "jmp __vector_uirb_wdt_handler"     "\n\t"
+        :: [address] "i" (&fault_word_address)
+    );
+}
+#endif  // defined(UIRB_CORE_WDT_SUPERVISOR)